@@ -34,6 +34,7 @@ void ActiveDreamer::start()
 void ActiveDreamer::executeState()
 {
     LOG (DBUG) << "ActiveDreamer thread is starting up";
+    Tracer::setThreadName ("ActiveDreamer");
 
     state = &ActiveDreamer::waitingForMessages;
 
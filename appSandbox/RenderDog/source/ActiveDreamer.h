@@ -30,7 +30,7 @@ class ActiveDreamer
     std::unique_ptr<Dreamer> impl;
 
     // messaging
-    MsgReceiver incoming;
+    MsgReceiver incoming{"qms queue depth: Dreamer"};
 
     // message arguments
     MessageService messengers;
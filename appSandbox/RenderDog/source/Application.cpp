@@ -54,31 +54,31 @@ class Application : public Jahley::App
         view->getCanvas()->inputEmitter.connect<&App::onInputEvent> (*this);
 
         std::string resourceFolder = getResourcePath (APP_NAME);
-        properties.renderProps->setValue (RenderKey::ResourceFolder, resourceFolder);
+        properties.setRender<RenderKey::ResourceFolder> (resourceFolder);
 
         std::string repoFolder = getRepositoryPath (APP_NAME);
-        properties.renderProps->setValue (RenderKey::RepoFolder, repoFolder);
+        properties.setRender<RenderKey::RepoFolder> (repoFolder);
 
         std::string commonFolder = getCommonContentFolder();
-        properties.renderProps->setValue (RenderKey::CommonFolder, commonFolder);
+        properties.setRender<RenderKey::CommonFolder> (commonFolder);
 
         std::string externalContent = getExternalContentFolder();
-        properties.renderProps->setValue (RenderKey::ExternalContentFolder, externalContent);
+        properties.setRender<RenderKey::ExternalContentFolder> (externalContent);
 
         // framegrabs are stored in the resource/screenshot folder
-        properties.renderProps->setValue (RenderKey::FramegrabFolder, resourceFolder + "/screenshots");
+        properties.setRender<RenderKey::FramegrabFolder> (resourceFolder + "/screenshots");
 
         //  build configuration for CUDA kernel compilation strategy
-        properties.renderProps->setValue (RenderKey::SoftwareReleaseMode, true);
-        properties.renderProps->setValue (RenderKey::UseEmbeddedPTX, true);
+        properties.setRender<RenderKey::SoftwareReleaseMode> (true);
+        properties.setRender<RenderKey::UseEmbeddedPTX> (true);
 
         std::string contentFolder = "E:/common_content/models";
-        properties.renderProps->setValue (RenderKey::ContentFolder, contentFolder);
+        properties.setRender<RenderKey::ContentFolder> (contentFolder);
 
-        properties.renderProps->setValue (RenderKey::RenderPasses, 2u);
-        properties.renderProps->setValue (RenderKey::RenderScale, PreviewScaleFactor::x1);
+        properties.setRender<RenderKey::RenderPasses> (2u);
+        properties.setRender<RenderKey::RenderScale> (PreviewScaleFactor::x1);
 
-        properties.renderProps->setValue (RenderKey::UseEmbeddedPTX, true);
+        properties.setRender<RenderKey::UseEmbeddedPTX> (true);
     }
 
     void onInit() override
@@ -178,7 +178,7 @@ class Application : public Jahley::App
     void update() override
     {
         /*  envRotation += 0.5;
-          properties.renderProps->setValue (RenderKey::EnviroRotation, envRotation);
+          properties.setRender<RenderKey::EnviroRotation> (envRotation);
 
           if (envRotation >= 360) envRotation = 0.0;*/
 
@@ -196,18 +196,8 @@ class Application : public Jahley::App
 
         lastInput = InputEvent{};
 
-        // get the render
-        const OIIO::ImageBuf& img = view->getCamera()->getSensor()->getHDRImage();
-
-        bool needsNewRenderTexture = (img.spec().width != lastImageWidth ||
-                                      img.spec().height != lastImageHeight ||
-                                      img.spec().nchannels != lastChannelCount);
-
-        lastImageWidth = img.spec().width;
-        lastImageHeight = img.spec().height;
-        lastChannelCount = img.spec().nchannels;
-
-        view->getCanvas()->updateRender (std::move (img), needsNewRenderTexture);
+        // hand the newest render to the canvas
+        view->getCanvas()->updateRender (*view->getCamera()->getSensor());
 
         if (socketServer)
         {
@@ -277,13 +267,9 @@ class Application : public Jahley::App
     RenderableNode cube = nullptr;
     // Socket server for remote connections
     std::unique_ptr<ActiveSocketServer> socketServer;
-    MsgReceiver incoming;
+    MsgReceiver incoming{"qms queue depth: Application"};
     MessageService messengers;
 
-   
-    uint32_t lastImageWidth = 0;
-    uint32_t lastImageHeight = 0;
-    uint32_t lastChannelCount = 0;
 
     InputEvent lastInput;
     //  MouseMode lastMouseMode;
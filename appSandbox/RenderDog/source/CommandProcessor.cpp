@@ -11,6 +11,7 @@ CommandProcessor::CommandProcessor (View* gui, const PropertyService& properties
 
 std::string CommandProcessor::processCommand (const std::string& cmd)
 {
+    TRACE_SCOPE_CAT ("socket", "CommandProcessor::processCommand");
     LOG (DBUG) << cmd;
 
     // Handle ping command
@@ -102,6 +103,17 @@ std::string CommandProcessor::processCommand (const std::string& cmd)
         return processGetAvailablePipelinesCommand();
     }
 
+    // Handle tracing commands
+    if (cmd.substr (0, 11) == "EnableTrace")
+    {
+        return processEnableTraceCommand (cmd);
+    }
+
+    if (cmd.substr (0, 9) == "DumpTrace")
+    {
+        return processDumpTraceCommand (cmd);
+    }
+
     // Unknown command
     return "Unknown command: " + cmd;
 }
@@ -110,9 +122,9 @@ std::string CommandProcessor::processGetRenderSettingsCommand()
 {
     try
     {
-        uint32_t renderPasses = properties.renderProps->getVal<uint32_t> (RenderKey::RenderPasses);
-        PreviewScaleFactor previewScale = properties.renderProps->getVal<PreviewScaleFactor> (RenderKey::RenderScale);
-        std::string contentFolder = properties.renderProps->getVal<std::string> (RenderKey::ContentFolder);
+        uint32_t renderPasses = properties.getRender<RenderKey::RenderPasses>();
+        PreviewScaleFactor previewScale = properties.getRender<RenderKey::RenderScale>();
+        std::string contentFolder = properties.getRender<RenderKey::ContentFolder>();
 
         std::ostringstream response;
         response << "{"
@@ -250,7 +262,7 @@ std::string CommandProcessor::processSetRenderPassesCommand (const std::string&
 
     try
     {
-        properties.renderProps->setValue (RenderKey::RenderPasses, passes);
+        properties.setRender<RenderKey::RenderPasses> (passes);
 
         std::ostringstream response;
         response << "Render passes set to " << passes;
@@ -292,7 +304,7 @@ std::string CommandProcessor::processSetPreviewScaleCommand (const std::string&
 
     try
     {
-        properties.renderProps->setValue (RenderKey::RenderScale, scale);
+        properties.setRender<RenderKey::RenderScale> (scale);
 
         std::ostringstream response;
         response << "Preview scale factor set to x" << scaleFactor;
@@ -396,7 +408,7 @@ std::string CommandProcessor::processSetContentDirectoryCommand (const std::stri
         }
 
         // Set the content directory property
-        properties.renderProps->setValue (RenderKey::ContentFolder, contentPath);
+        properties.setRender<RenderKey::ContentFolder> (contentPath);
 
         std::ostringstream response;
         response << "Content directory set to: " << contentPath;
@@ -652,4 +664,61 @@ std::string CommandProcessor::processGetAvailablePipelinesCommand()
     // For now, return the hardcoded list. In a full implementation,
     // this could query the backend for available pipelines
     return "Available pipelines: realtime, quality, sequential";
-}
\ No newline at end of file
+}
+
+std::string CommandProcessor::processEnableTraceCommand (const std::string& cmd)
+{
+    // Parse command: "EnableTrace 0|1"
+    std::istringstream iss (cmd);
+    std::string command;
+    int enable;
+
+    if (!(iss >> command >> enable))
+    {
+        return "Error: Invalid EnableTrace format. Expected: EnableTrace 0|1";
+    }
+
+    Tracer::enable (enable != 0);
+    return Tracer::isEnabled() ? "Tracing enabled" : "Tracing disabled";
+}
+
+std::string CommandProcessor::processDumpTraceCommand (const std::string& cmd)
+{
+    // Parse command: "DumpTrace [seconds] [path]", no seconds dumps everything still recorded
+    std::istringstream iss (cmd);
+    std::string command, tracePath;
+    double seconds = 0.0;
+
+    iss >> command;
+    if (!(iss >> seconds))
+    {
+        seconds = 0.0;
+        iss.clear();
+    }
+
+    std::getline (iss, tracePath);
+    tracePath.erase (0, tracePath.find_first_not_of (" \t"));
+
+    if (seconds < 0.0)
+    {
+        return "Error: DumpTrace seconds must not be negative";
+    }
+
+    try
+    {
+        std::filesystem::path path = tracePath.empty()
+                                         ? Tracer::defaultTracePath (properties.getRender<RenderKey::ResourceFolder>())
+                                         : std::filesystem::path (tracePath);
+
+        if (!Tracer::writeChromeTrace (path, seconds))
+        {
+            return "Error: Could not write trace to " + path.generic_string();
+        }
+
+        return "Trace written to " + path.generic_string();
+    }
+    catch (const std::exception& e)
+    {
+        return "Error writing trace: " + std::string (e.what());
+    }
+}
@@ -49,6 +49,8 @@ class CommandProcessor
     std::string processLoadGltfFolderCommand (const std::string& cmd);
     std::string processSetPipelineCommand (const std::string& cmd);
     std::string processGetAvailablePipelinesCommand();
+    std::string processEnableTraceCommand (const std::string& cmd);
+    std::string processDumpTraceCommand (const std::string& cmd);
 
     // Helper methods
     bool validateColorValues (int r, int g, int b, int a);
@@ -125,26 +125,26 @@ void Controller::onInputEvent (const InputEvent& input, CameraHandle camera)
         {
             if (input.getKey() == 262)
             {
-                float value = properties.renderProps->getVal<float> (RenderKey::EnviroRotation);
-                properties.renderProps->setValue (RenderKey::EnviroRotation, value + 0.0075f);
+                double value = properties.getRender<RenderKey::EnviroRotation>();
+                properties.setRender<RenderKey::EnviroRotation> (value + 0.0075f);
             }
 
             if (input.getKey() == 263)
             {
-                float value = properties.renderProps->getVal<float> (RenderKey::EnviroRotation);
-                properties.renderProps->setValue (RenderKey::EnviroRotation, value + -0.0075f);
+                double value = properties.getRender<RenderKey::EnviroRotation>();
+                properties.setRender<RenderKey::EnviroRotation> (value + -0.0075f);
             }
 
             if (input.getKey() == 265)
             {
-                float value = properties.renderProps->getVal<float> (RenderKey::EnviroIntensity);
-                properties.renderProps->setValue (RenderKey::EnviroIntensity, value + 0.0075f);
+                double value = properties.getRender<RenderKey::EnviroIntensity>();
+                properties.setRender<RenderKey::EnviroIntensity> (value + 0.0075f);
             }
 
             if (input.getKey() == 264)
             {
-                float value = properties.renderProps->getVal<float> (RenderKey::EnviroIntensity);
-                properties.renderProps->setValue (RenderKey::EnviroIntensity, value + -0.0075f);
+                double value = properties.getRender<RenderKey::EnviroIntensity>();
+                properties.setRender<RenderKey::EnviroIntensity> (value + -0.0075f);
             }
 
             camera->setDirty (true);
@@ -158,26 +158,26 @@ void Controller::onInputEvent (const InputEvent& input, CameraHandle camera)
 
             if (input.getKey() == 262)
             {
-                float value = properties.renderProps->getVal<float> (RenderKey::EnviroRotation);
-                properties.renderProps->setValue (RenderKey::EnviroRotation, value + 0.01f);
+                double value = properties.getRender<RenderKey::EnviroRotation>();
+                properties.setRender<RenderKey::EnviroRotation> (value + 0.01f);
             }
 
             if (input.getKey() == 263)
             {
-                float value = properties.renderProps->getVal<float> (RenderKey::EnviroRotation);
-                properties.renderProps->setValue (RenderKey::EnviroRotation, value + -0.01f);
+                double value = properties.getRender<RenderKey::EnviroRotation>();
+                properties.setRender<RenderKey::EnviroRotation> (value + -0.01f);
             }
 
             if (input.getKey() == 265)
             {
-                float value = properties.renderProps->getVal<float> (RenderKey::EnviroIntensity);
-                properties.renderProps->setValue (RenderKey::EnviroIntensity, value + 0.0075f);
+                double value = properties.getRender<RenderKey::EnviroIntensity>();
+                properties.setRender<RenderKey::EnviroIntensity> (value + 0.0075f);
             }
 
             if (input.getKey() == 264)
             {
-                float value = properties.renderProps->getVal<float> (RenderKey::EnviroIntensity);
-                properties.renderProps->setValue (RenderKey::EnviroIntensity, value + -0.0075f);
+                double value = properties.getRender<RenderKey::EnviroIntensity>();
+                properties.setRender<RenderKey::EnviroIntensity> (value + -0.0075f);
             }
             // space bar for toggle between mouse modes
             if (input.getKey() == 32)
@@ -223,6 +223,22 @@ void Controller::onInputEvent (const InputEvent& input, CameraHandle camera)
                 }
             }
 
+            // t toggles tracing
+            if (input.getKey() == 84)
+            {
+                // control 't' dumps the last 10 seconds as a Chrome trace
+                if (input.getKeyboardModifiers() == static_cast<uint32_t> (InputEvent::Modifier::Ctrl))
+                {
+                    std::filesystem::path folder = properties.getRender<RenderKey::ResourceFolder>();
+                    Tracer::writeChromeTrace (Tracer::defaultTracePath (folder), 10.0);
+                }
+                else
+                {
+                    Tracer::enable (!Tracer::isEnabled());
+                    LOG (INFO) << "Tracing " << (Tracer::isEnabled() ? "enabled" : "disabled");
+                }
+            }
+
             break;
         }
     }
@@ -231,7 +247,7 @@ void Controller::onInputEvent (const InputEvent& input, CameraHandle camera)
 void Controller::onEnvironmentIntensityChange(float intensity)
 {
     // intensity is already a coefficient (0-2 range)
-    properties.renderProps->setValue(RenderKey::EnviroIntensity, intensity);
+    properties.setRender<RenderKey::EnviroIntensity> (intensity);
     
     // Reset accumulation by making camera dirty
     if (camera)
@@ -241,7 +257,7 @@ void Controller::onEnvironmentIntensityChange(float intensity)
 void Controller::onEnvironmentRotationChange(float rotation)
 {
     // rotation is in degrees (-180 to 180)
-    properties.renderProps->setValue(RenderKey::EnviroRotation, rotation);
+    properties.setRender<RenderKey::EnviroRotation> (rotation);
     
     // Reset accumulation by making camera dirty
     if (camera)
@@ -251,7 +267,7 @@ void Controller::onEnvironmentRotationChange(float rotation)
 void Controller::onAreaLightIntensityChange(float intensity)
 {
     // Store area light power coefficient
-    properties.renderProps->setValue(RenderKey::AreaLightPower, intensity);
+    properties.setRender<RenderKey::AreaLightPower> (intensity);
     
     // Reset accumulation by making camera dirty
     if (camera)
@@ -261,7 +277,7 @@ void Controller::onAreaLightIntensityChange(float intensity)
 void Controller::onAreaLightEnable(bool enable)
 {
     // Store area light enable state
-    properties.renderProps->setValue(RenderKey::EnableAreaLights, enable);
+    properties.setRender<RenderKey::EnableAreaLights> (enable);
     
     // Reset accumulation by making camera dirty
     if (camera)
@@ -0,0 +1,255 @@
+#include "DisplayPipeline.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // linear [0, 1] to sRGB code values in [0, 255], fine enough that the darkest
+    // step is well under one code value
+    constexpr int SRGB_LUT_SIZE = 16384;
+
+    const float* srgbLUT()
+    {
+        static const std::vector<float> lut = []
+        {
+            std::vector<float> table (SRGB_LUT_SIZE);
+            for (int i = 0; i < SRGB_LUT_SIZE; ++i)
+            {
+                const float linear = static_cast<float> (i) / (SRGB_LUT_SIZE - 1);
+                const float encoded = linear <= 0.0031308f ? 12.92f * linear
+                                                           : 1.055f * std::pow (linear, 1.0f / 2.4f) - 0.055f;
+                table[i] = encoded * 255.0f;
+            }
+            return table;
+        }();
+        return lut.data();
+    }
+
+    // 4x4 Bayer matrix as offsets in code values, centred on zero
+    constexpr float BAYER4[4][4] = {
+        {-0.46875f, 0.03125f, -0.34375f, 0.15625f},
+        {0.28125f, -0.21875f, 0.40625f, -0.09375f},
+        {-0.28125f, 0.21875f, -0.40625f, 0.09375f},
+        {0.46875f, -0.03125f, 0.34375f, -0.15625f}};
+
+    inline float tonemapScalar (float x, DisplayTonemap tonemap)
+    {
+        switch (tonemap)
+        {
+            case DisplayTonemap::Reinhard:
+                return x / (1.0f + x);
+            case DisplayTonemap::ACES:
+                // Narkowicz's fit of the ACES filmic curve
+                return (x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f);
+            default:
+                return x;
+        }
+    }
+
+    inline uint8_t encodeColour (float x, const float* lut, float dither)
+    {
+        x = std::clamp (x, 0.0f, 1.0f);
+        const float code = lut[static_cast<int> (x * (SRGB_LUT_SIZE - 1) + 0.5f)];
+        return static_cast<uint8_t> (std::clamp (code + 0.5f + dither, 0.0f, 255.0f));
+    }
+
+    inline uint8_t encodeAlpha (float a)
+    {
+        return static_cast<uint8_t> (std::clamp (a, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+#if defined(__AVX2__)
+    // two RGBA pixels per register, alpha lanes are passed through untouched by the tonemap
+    inline __m256 tonemapAVX2 (__m256 x, DisplayTonemap tonemap)
+    {
+        const __m256 one = _mm256_set1_ps (1.0f);
+        switch (tonemap)
+        {
+            case DisplayTonemap::Reinhard:
+                return _mm256_div_ps (x, _mm256_add_ps (one, x));
+            case DisplayTonemap::ACES:
+            {
+                const __m256 num = _mm256_mul_ps (x, _mm256_add_ps (_mm256_mul_ps (_mm256_set1_ps (2.51f), x), _mm256_set1_ps (0.03f)));
+                const __m256 den = _mm256_add_ps (_mm256_mul_ps (x, _mm256_add_ps (_mm256_mul_ps (_mm256_set1_ps (2.43f), x), _mm256_set1_ps (0.59f))), _mm256_set1_ps (0.14f));
+                return _mm256_div_ps (num, den);
+            }
+            default:
+                return x;
+        }
+    }
+
+    // converts 8 floats (2 pixels) to 8 int32 code values
+    inline __m256i encodeAVX2 (__m256 rgba, __m256 exposure, __m256 dither, DisplayTonemap tonemap, const float* lut)
+    {
+        const __m256 alphaMask = _mm256_castsi256_ps (_mm256_setr_epi32 (0, 0, 0, -1, 0, 0, 0, -1));
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps (1.0f);
+        const __m256 half = _mm256_set1_ps (0.5f);
+
+        __m256 colour = tonemapAVX2 (_mm256_mul_ps (rgba, exposure), tonemap);
+        colour = _mm256_min_ps (_mm256_max_ps (colour, zero), one);
+        const __m256 alpha = _mm256_min_ps (_mm256_max_ps (rgba, zero), one);
+
+        const __m256i index = _mm256_cvttps_epi32 (_mm256_add_ps (_mm256_mul_ps (colour, _mm256_set1_ps (SRGB_LUT_SIZE - 1)), half));
+        const __m256 coded = _mm256_add_ps (_mm256_i32gather_ps (lut, index, 4), dither);
+        const __m256 alphaCoded = _mm256_mul_ps (alpha, _mm256_set1_ps (255.0f));
+
+        __m256 out = _mm256_blendv_ps (coded, alphaCoded, alphaMask);
+        out = _mm256_min_ps (_mm256_max_ps (_mm256_add_ps (out, half), zero), _mm256_set1_ps (255.0f));
+        return _mm256_cvttps_epi32 (out);
+    }
+#endif
+} // namespace
+
+DisplayPipeline::DisplayPipeline() :
+    pool (std::max (1u, std::thread::hardware_concurrency() / 2))
+{
+    // build the LUT now rather than on the first frame
+    srgbLUT();
+}
+
+DisplayPipeline::~DisplayPipeline()
+{
+    pool.wait();
+}
+
+int DisplayPipeline::freeSlot() const
+{
+    const int readySlot = ready.load (std::memory_order_acquire);
+    for (int i = 0; i < RING_SIZE; ++i)
+    {
+        if (i != readySlot && i != uploading)
+            return i;
+    }
+    return NO_SLOT;
+}
+
+bool DisplayPipeline::submit (sabi::CameraSensor& sensor)
+{
+    // never block the UI thread, the next frame will be along shortly
+    if (busy.load (std::memory_order_acquire))
+        return false;
+
+    const int slot = freeSlot();
+    if (slot == NO_SLOT)
+        return false;
+
+    // the sensor only swaps with an image shaped like its own, this allocates on resize only
+    const Eigen::Vector2i resolution = sensor.getPixelResolution();
+    const OIIO::ImageSpec& staged = staging.spec();
+    if (staged.width != resolution.x() || staged.height != resolution.y() || !staging.localpixels())
+    {
+        if (resolution.x() <= 0 || resolution.y() <= 0)
+            return false;
+
+        staging.reset (OIIO::ImageSpec (resolution.x(), resolution.y(), 4, OIIO::TypeDesc::FLOAT), OIIO::InitializePixels::No);
+        hasFrame = false;
+    }
+
+    if (sensor.takeHDRImage (staging))
+        hasFrame = true;
+    else if (!hasFrame || !settingsChanged)
+        return false;
+
+    settingsChanged = false;
+
+    const OIIO::ImageSpec& spec = staging.spec();
+    const float* src = static_cast<const float*> (staging.localpixels());
+
+    DisplayFrame& frame = ring[slot];
+    frame.width = spec.width;
+    frame.height = spec.height;
+    frame.pixels.resize (static_cast<size_t> (spec.width) * spec.height * 4);
+
+    const float exposureScale = std::exp2 (settings.exposure);
+    const DisplayTonemap tonemap = settings.tonemap;
+    const bool dither = settings.dither;
+    uint8_t* dst = frame.pixels.data();
+    const int width = spec.width;
+
+    // bands of 4 rows keep the dither pattern aligned and give the pool plenty of tiles
+    const int numBands = (spec.height + 3) / 4;
+    const int height = spec.height;
+    auto remaining = std::make_shared<std::atomic<int>> (numBands);
+
+    busy.store (true, std::memory_order_release);
+
+    pool.detach_blocks (0, numBands, [=, this] (const int start, const int end)
+    {
+        convertRows (src, dst, width, start * 4, std::min (end * 4, height), exposureScale, tonemap, dither);
+
+        // the last block to finish publishes the frame
+        if (remaining->fetch_sub (end - start, std::memory_order_acq_rel) == end - start)
+        {
+            ready.store (slot, std::memory_order_release);
+            busy.store (false, std::memory_order_release);
+        }
+    });
+
+    return true;
+}
+
+const DisplayFrame* DisplayPipeline::acquireFrame()
+{
+    const int slot = ready.exchange (NO_SLOT, std::memory_order_acq_rel);
+    if (slot == NO_SLOT)
+        return nullptr;
+
+    uploading = slot;
+    return &ring[slot];
+}
+
+void DisplayPipeline::convertRows (const float* src, uint8_t* dst, int width, int rowBegin, int rowEnd,
+                                   float exposureScale, DisplayTonemap tonemap, bool dither)
+{
+    const float* lut = srgbLUT();
+
+    for (int y = rowBegin; y < rowEnd; ++y)
+    {
+        const float* in = src + static_cast<size_t> (y) * width * 4;
+        uint8_t* out = dst + static_cast<size_t> (y) * width * 4;
+        const float* bayerRow = BAYER4[y & 3];
+        int x = 0;
+
+#if defined(__AVX2__)
+        const __m256 exposure = _mm256_setr_ps (exposureScale, exposureScale, exposureScale, 1.0f,
+                                                exposureScale, exposureScale, exposureScale, 1.0f);
+        const __m256i gather = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+
+        // 4 pixels per iteration, two registers packed down to 16 bytes
+        for (; x + 4 <= width; x += 4)
+        {
+            __m256 d0 = _mm256_setzero_ps();
+            __m256 d1 = _mm256_setzero_ps();
+            if (dither)
+            {
+                const float b0 = bayerRow[x & 3], b1 = bayerRow[(x + 1) & 3];
+                const float b2 = bayerRow[(x + 2) & 3], b3 = bayerRow[(x + 3) & 3];
+                d0 = _mm256_setr_ps (b0, b0, b0, 0.0f, b1, b1, b1, 0.0f);
+                d1 = _mm256_setr_ps (b2, b2, b2, 0.0f, b3, b3, b3, 0.0f);
+            }
+
+            const __m256i p01 = encodeAVX2 (_mm256_loadu_ps (in + x * 4), exposure, d0, tonemap, lut);
+            const __m256i p23 = encodeAVX2 (_mm256_loadu_ps (in + x * 4 + 8), exposure, d1, tonemap, lut);
+
+            // packs work per 128 bit lane, the words come out as p0 p2 p0 p2 | p1 p3 p1 p3
+            const __m256i words = _mm256_packus_epi32 (p01, p23);
+            const __m256i bytes = _mm256_packus_epi16 (words, words);
+            const __m256i ordered = _mm256_permutevar8x32_epi32 (bytes, gather);
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (out + x * 4), _mm256_castsi256_si128 (ordered));
+        }
+#endif
+
+        for (; x < width; ++x)
+        {
+            const float* p = in + x * 4;
+            uint8_t* o = out + x * 4;
+            const float d = dither ? bayerRow[x & 3] : 0.0f;
+            for (int c = 0; c < 3; ++c)
+                o[c] = encodeColour (tonemapScalar (p[c] * exposureScale, tonemap), lut, d);
+            o[3] = encodeAlpha (p[3]);
+        }
+    }
+}
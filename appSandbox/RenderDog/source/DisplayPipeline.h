@@ -0,0 +1,94 @@
+#pragma once
+
+// DisplayPipeline turns the float RGBA render from the camera sensor into an 8 bit
+// RGBA frame ready for upload, off the UI thread.
+//
+// Per pixel: exposure -> tonemap (ACES, Reinhard or none) -> sRGB OETF via LUT -> ordered dither
+//
+// Threading:
+// - submit() splits the frame into row bands on a worker pool and returns immediately
+// - Results go into a ring of reusable buffers, one being written, one ready, one being uploaded
+// - The UI thread calls acquireFrame() and only uploads, a frame submitted while the
+//   previous one is still converting is dropped rather than queued
+//
+// submit() takes the sensor's newest render by swapping it with the pipeline's staging image
+// (CameraSensor::takeHDRImage), so the UI thread does constant work per frame and the render
+// thread is free to write its next frame while this one converts. Only one frame converts at
+// a time, so one staging image is enough. Without a new render the last one is converted
+// again only when the settings have changed.
+
+#include <sabi_core/sabi_core.h>
+
+enum class DisplayTonemap
+{
+    None,
+    Reinhard,
+    ACES
+};
+
+struct DisplaySettings
+{
+    float exposure = 0.0f; // in stops
+    DisplayTonemap tonemap = DisplayTonemap::ACES;
+    bool dither = true;
+};
+
+// 8 bit RGBA frame owned by the pipeline's ring
+struct DisplayFrame
+{
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+class DisplayPipeline
+{
+ public:
+    DisplayPipeline();
+    ~DisplayPipeline();
+
+    DisplayPipeline (const DisplayPipeline&) = delete;
+    DisplayPipeline& operator= (const DisplayPipeline&) = delete;
+
+    // Applies to frames submitted after this call
+    void setSettings (const DisplaySettings& settings)
+    {
+        this->settings = settings;
+        settingsChanged = true;
+    }
+    const DisplaySettings& getSettings() const { return settings; }
+
+    // Starts converting the sensor's newest render, returns false if nothing was started
+    bool submit (sabi::CameraSensor& sensor);
+
+    // Newest finished frame, or nullptr if nothing new since the last call
+    // The frame stays untouched until the next acquireFrame()
+    const DisplayFrame* acquireFrame();
+
+    // Converts rows [rowBegin, rowEnd) of tightly packed RGBA floats, exposed for testing
+    static void convertRows (const float* src, uint8_t* dst, int width, int rowBegin, int rowEnd,
+                             float exposureScale, DisplayTonemap tonemap, bool dither);
+
+ private:
+    static constexpr int RING_SIZE = 3;
+    static constexpr int NO_SLOT = -1;
+
+    DisplaySettings settings;
+    std::array<DisplayFrame, RING_SIZE> ring;
+
+    // float RGBA frame being converted, swapped with the sensor's newest render and only
+    // touched while not busy
+    OIIO::ImageBuf staging;
+    bool hasFrame = false;        // staging holds a render
+    bool settingsChanged = false; // settings differ from the ones staging was last converted with
+
+    // slot indices, the workers publish 'ready' and the UI thread takes it into 'uploading'
+    std::atomic<int> ready = NO_SLOT;
+    int uploading = NO_SLOT;
+    std::atomic<bool> busy = false;
+
+    BS::thread_pool pool;
+
+    int freeSlot() const;
+
+}; // end class DisplayPipeline
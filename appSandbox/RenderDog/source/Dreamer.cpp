@@ -6,78 +6,99 @@
 
 using namespace OIIO;
 
+Dreamer::~Dreamer()
+{
+    // drop whatever is still queued, the app is going away
+    cancelLoading = true;
+    pool.purge();
+    pool.wait();
+}
+
 void Dreamer::init (MessageService messengers, const PropertyService& properties)
 {
     this->messengers = messengers;
     this->properties = properties;
+
+    // thumbnails live with the app's other generated resources
+    std::filesystem::path cacheFolder;
+    std::string resourceFolder = properties.getRender<RenderKey::ResourceFolder>();
+    if (resourceFolder.empty())
+        cacheFolder = std::filesystem::temp_directory_path() / "cook" / "thumbnails";
+    else
+        cacheFolder = std::filesystem::path (resourceFolder) / "cache" / "thumbnails";
+
+    thumbnailCache = ThumbnailCache::create (cacheFolder);
 }
 
 void Dreamer::loadImagesAsync (const PathList& imagePaths)
 {
-    #if 0
-    ScopedStopWatch sw ("LOAD THUMBNAILS");
     uint32_t count = imagePaths.size();
     if (!count) return;
 
+    if (!thumbnailCache)
+    {
+        LOG (WARNING) << "Dreamer has not been initialized, can't load thumbnails";
+        return;
+    }
+
     // check the first path for icons
     std::filesystem::path p = imagePaths[0];
-    if (pathContainsIgnoreCase (p, "hdri_thumbs"))
+    if (properties.ioProps)
     {
-        properties.ioProps->setValue (IOKey::EnviroIconCount, count);
+        if (pathContainsIgnoreCase (p, "hdri_thumbs"))
+        {
+            properties.ioProps->setValue (IOKey::EnviroIconCount, count);
+        }
+
+        if (pathContainsIgnoreCase (p, "model_thumbs"))
+        {
+            properties.ioProps->setValue (IOKey::ModelIconCount, count);
+        }
     }
 
-    if (pathContainsIgnoreCase (p, "model_thumbs"))
+    // the pool runs tasks in submission order, so queue the cheap cache hits
+    // first and the browser fills in immediately while misses are decoded
+    PathList misses;
+    uint32_t hits = 0;
+    for (const auto& path : imagePaths)
     {
-        properties.ioProps->setValue (IOKey::ModelIconCount, count);
+        if (thumbnailCache->contains (path))
+        {
+            pool.detach_task ([this, path]
+                              { loadThumbnail (path); });
+            ++hits;
+        }
+        else
+        {
+            misses.push_back (path);
+        }
     }
 
-    BS::thread_pool pool;
-
-    pool.detach_blocks (0u, (uint32_t)imagePaths.size(),
-                    [&] (const uint32_t start, const uint32_t end)
-                    {
-                        for (uint32_t i = start; i < end; ++i)
-                        {
-                            const std::filesystem::path& path = imagePaths[i];
-
-                            // create ImagBuf from file path
-                            OIIO::ImageBuf image (path.generic_string());
-                            if (image.has_error())
-                            {
-                                LOG (CRITICAL) << image.geterror();
-                            }
-                            else
-                            {
-                                int nChan = image.spec().nchannels;
-                                if (nChan == 3)
-                                {
-                                    // add an alpha channel
-                                    int channelorder[] = {0, 1, 2, 3};
-                                    float channelvalues[] = {0 /*ignore*/, 0 /*ignore*/, 0 /*ignore*/, 1.0f};
-                                    std::string channelnames[] = {"", "", "", "A"};
-                                    OIIO::ImageBuf rgba = OIIO::ImageBufAlgo::channels (image, 4, channelorder, channelvalues, channelnames);
-
-                                    // save the full path as an attribute
-                                    OIIO::ImageSpec& rgbaSpec = rgba.specmod();
-                                    rgbaSpec.attribute ("fullpath", path.generic_string());
-
-                                    imageQueue.enqueue (std::move (rgba));
-                                }
-                                else if (nChan == 4)
-                                {
-                                    // save the full path as an attribute
-                                    OIIO::ImageSpec& spc = image.specmod();
-                                    spc.attribute ("fullpath", path.generic_string());
-
-                                    imageQueue.enqueue (std::move (image));
-                                }
-                            }
-                        }
-                    });
+    for (const auto& path : misses)
+    {
+        pool.detach_task ([this, path]
+                          { loadThumbnail (path); });
+    }
 
-    pool.wait();
+    LOG (DBUG) << "Queued " << count << " thumbnails, " << hits << " from cache";
+}
+
+void Dreamer::loadThumbnail (const std::filesystem::path& path)
+{
+    if (cancelLoading) return;
 
-    LOG (DBUG) << "Processed " << imagePaths.size() << " images";
+    try
+    {
+        ImageBuf thumb = thumbnailCache->fetch (path);
+        if (!thumb.initialized()) return;
+
+        // save the full path as an attribute
+        thumb.specmod().attribute ("fullpath", path.generic_string());
 
-    #endif
+        imageQueue.enqueue (std::move (thumb));
+    }
+    catch (std::exception& e)
+    {
+        LOG (WARNING) << "Failed to load thumbnail " << path.generic_string() << ": " << e.what();
+    }
 }
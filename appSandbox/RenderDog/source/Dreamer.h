@@ -12,9 +12,12 @@ class Dreamer
 {
  public:
     Dreamer() = default;
-    ~Dreamer() = default;
+    ~Dreamer();
 
     void init (MessageService messengers, const PropertyService& properties);
+
+    // streams RGBA thumbnails into imageQueue from the background pool
+    // imagePaths is in visibility order, cached thumbnails go out first
     void loadImagesAsync (const PathList& imagePaths);
 
 
@@ -48,4 +51,12 @@ class Dreamer
     OIIO::ImageBuf nextImage;
 
     ErrorQueue errorQueue;
+
+    ThumbnailCachePtr thumbnailCache = nullptr;
+    std::atomic<bool> cancelLoading = false;
+
+    void loadThumbnail (const std::filesystem::path& path);
+
+    // declared last so it is destroyed first, queued tasks reference the members above
+    BS::thread_pool pool;
 }; // end class Dreamer
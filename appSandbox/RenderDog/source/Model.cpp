@@ -25,7 +25,7 @@ void Model::loadHDRIfromIcon (const std::filesystem::path& iconPath)
 {
     // the full hdr image should have the same name as the icon image
     std::string hdrName = iconPath.stem().string();
-    std::string contentFolder = properties.renderProps->getVal<std::string> (RenderKey::ExternalContentFolder);
+    std::string contentFolder = properties.getRender<RenderKey::ExternalContentFolder>();
     std::filesystem::path hdrPath (contentFolder + "/HDRI/" + hdrName + ".hdr");
     if (!std::filesystem::exists (hdrPath))
         throw std::runtime_error ("file does not exist: " + hdrPath.string());
@@ -36,7 +36,7 @@ void Model::loadHDRIfromIcon (const std::filesystem::path& iconPath)
 void Model::loadCgModelfromIcon (const std::filesystem::path& iconPath)
 {
     std::string modelName = iconPath.stem().string();
-    std::string contentFolder = properties.renderProps->getVal<std::string> (RenderKey::ExternalContentFolder);
+    std::string contentFolder = properties.getRender<RenderKey::ExternalContentFolder>();
     std::filesystem::path cgModelFolder (contentFolder + "/models/" + modelName);
     if (!std::filesystem::exists (cgModelFolder))
         throw std::runtime_error ("file does not exist: " + cgModelFolder.string());
@@ -138,6 +138,9 @@ class Model : public Observer
                     newTransform.translation() = position;
                     
                     spacetime.worldTransform = newTransform;
+
+                    // renderer picks up all the moved nodes in one batch next frame
+                    sceneJournal->recordTransform (node);
                 }
             }
             
@@ -238,6 +241,7 @@ class Model : public Observer
 
  private:
     ActiveFramework framework;
+    sabi::SceneChangeJournalPtr sceneJournal = framework.render.getSceneJournal();
     ImageCacheHandlerPtr imageCache = nullptr;
     PhysicsEngineState engineState = PhysicsEngineState::Pause;
     PropertyService properties;
@@ -139,9 +139,9 @@ RenderCanvas::RenderCanvas (Widget* parent, bool postProcess) :
 
                 vec4 value = texture(image, uv);
         
-                // comment out these 2 lines to stop post processing for standard images
-                // instead of renders coming from OptiX
-                vec3 postProcess = gamma_correct( tonemap(adjust (vignette( uv ) *chromatic(uv)) ));
+                // renders arrive exposed, tonemapped and sRGB encoded by the DisplayPipeline,
+                // only the lens effects are left to do here
+                vec3 postProcess = adjust (vignette( uv ) * chromatic(uv));
                 value.rgb = postProcess.rgb;
 
                 frag_color = (1.0 - value.a) * background + value.a * vec4(value.rgb, 1.0);
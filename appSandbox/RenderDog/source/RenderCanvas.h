@@ -31,6 +31,8 @@
 
 #include <GLFW/glfw3.h>
 
+#include "DisplayPipeline.h"
+
 using nanogui::Button;
 using nanogui::FloatBox;
 using nanogui::ImagePanel;
@@ -60,8 +62,41 @@ class RenderCanvas : public Canvas
  public:
     RenderCanvas (Widget* parent, bool postProcess = true);
 
+    // HDR renders are taken from the sensor and converted to 8 bit on the display pipeline's
+    // workers, this thread only uploads whichever frame finished last
+    void updateRender (sabi::CameraSensor& sensor)
+    {
+        displayPipeline.submit (sensor);
+
+        const DisplayFrame* frame = displayPipeline.acquireFrame();
+        if (!frame) return;
+
+        if (!imageTexture || size.x() != frame->width || size.y() != frame->height ||
+            imageTexture->pixel_format() != nanogui::Texture::PixelFormat::RGBA ||
+            imageTexture->component_format() != nanogui::Texture::ComponentFormat::UInt8)
+        {
+            size.x() = frame->width;
+            size.y() = frame->height;
+
+            LOG (DBUG) << "New screen size: " << frame->width << " x " << frame->height;
+
+            imageTexture = new nanogui::Texture (
+                nanogui::Texture::PixelFormat::RGBA,
+                nanogui::Texture::ComponentFormat::UInt8,
+                size,
+                nanogui::Texture::InterpolationMode::Nearest,
+                nanogui::Texture::InterpolationMode::Nearest);
+        }
+
+        imageTexture->upload (frame->pixels.data());
+        set_image (imageTexture);
+    }
+
+    // Uploads an image as is
     void updateRender (const OIIO::ImageBuf& render, bool needsNewTexture = false)
     {
+        const OIIO::ImageSpec& spec = render.spec();
+
         if (imageTexture && !needsNewTexture)
         {
             imageTexture->upload ((uint8_t*)render.localpixels());
@@ -69,7 +104,6 @@ class RenderCanvas : public Canvas
         }
         else if (needsNewTexture)
         {
-            const OIIO::ImageSpec& spec = render.spec();
             size.x() = spec.width;
             size.y() = spec.height;
             OIIO::TypeDesc type = spec.format;
@@ -77,8 +111,6 @@ class RenderCanvas : public Canvas
             LOG (DBUG) << "New screen size: " << spec.width << " x " << spec.height;
 
             imageTexture = new nanogui::Texture (
-                // Texture::PixelFormat::RGBA,
-                // Texture::ComponentFormat::Float32,
                 spec.nchannels == 3 ? nanogui::Texture::PixelFormat::RGB : nanogui::Texture::PixelFormat::RGBA,
                 type == OIIO::TypeDesc::UINT8 ? nanogui::Texture::ComponentFormat::UInt8 : nanogui::Texture::ComponentFormat::Float32,
                 size,
@@ -90,6 +122,9 @@ class RenderCanvas : public Canvas
         }
     }
 
+    // exposure, tonemap and dither for HDR renders
+    DisplayPipeline& getDisplayPipeline() { return displayPipeline; }
+
     /// Set the currently active image
     void set_image (nanogui::Texture* image);
 
@@ -124,6 +159,8 @@ class RenderCanvas : public Canvas
 
     InputEvent::MouseButton buttonPressed = InputEvent::MouseButton::Left;
 
+    DisplayPipeline displayPipeline;
+
     void captureAndSaveFrame()
     {
         // make sure to exclude the header and footer widgets from the screen grab
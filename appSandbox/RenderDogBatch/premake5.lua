@@ -0,0 +1,118 @@
+local ROOT = "../../"
+
+project  "RenderDogBatch"
+	if _ACTION == "vs2019" then
+		cppdialect "C++17"
+		location (ROOT .. "builds/VisualStudio2019/projects")
+    end
+	if _ACTION == "vs2022" then
+		cppdialect "C++20"
+		location (ROOT .. "builds/VisualStudio2022/projects")
+    end
+
+	kind "ConsoleApp"
+	cppdialect "C++20"
+
+	local FRAMEWORK_ROOT = ROOT .. "framework/"
+	local PROPS = FRAMEWORK_ROOT .. "properties_core/"
+	local CPU_RENDER = FRAMEWORK_ROOT .. "cpu_render_core/"
+
+	local SOURCE_DIR = "source/*"
+	local MODULE_DIR = ROOT .. "modules/"
+    files
+    {
+      SOURCE_DIR .. "**.h",
+      SOURCE_DIR .. "**.hpp",
+      SOURCE_DIR .. "**.c",
+      SOURCE_DIR .. "**.cpp",
+
+	  PROPS .. "**.h",
+	  PROPS .. "**.cpp",
+	  CPU_RENDER .. "**.h",
+	  CPU_RENDER .. "**.cpp",
+
+	  -- the modules are built straight into the app so it does not need AppCore,
+	  -- which pulls in the window and the Windows only log sinks
+	  MODULE_DIR .. "mace_core/mace_core.cpp",
+	  MODULE_DIR .. "oiio_core/oiio_core.cpp",
+	  MODULE_DIR .. "wabi_core/wabi_core.cpp",
+	  MODULE_DIR .. "sabi_core/sabi_core.cpp",
+    }
+
+	includedirs
+	{
+		FRAMEWORK_ROOT,
+	}
+
+	filter "system:windows"
+		staticruntime "On"
+		systemversion "latest"
+		defines {"_CRT_SECURE_NO_WARNINGS",
+			"CPPTRACE_STATIC_DEFINE", "NOMINMAX",
+			"CPPTRACE_GET_SYMBOLS_WITH_DBGHELP",
+			"CPPTRACE_UNWIND_WITH_DBGHELP",
+			"CPPTRACE_DEMANGLE_WITH_WINAPI",
+			"LIBASSERT_LOWERCASE",
+			"LIBASSERT_SAFE_COMPARISONS",
+			"USE_OIIO",
+			"LIBASSERT_STATIC_DEFINE"}
+		disablewarnings { "5030" , "4305", "4316", "4267"}
+		vpaths
+		{
+		  ["Header Files/*"] = {
+			SOURCE_DIR .. "**.h",
+			SOURCE_DIR .. "**.hxx",
+			SOURCE_DIR .. "**.hpp",
+		  },
+		  ["Source Files/*"] = {
+			SOURCE_DIR .. "**.c",
+			SOURCE_DIR .. "**.cxx",
+			SOURCE_DIR .. "**.cpp",
+		  },
+		}
+
+	filter "system:linux"
+		toolset "gcc"
+		buildoptions { "-mavx2", "-Wno-unknown-pragmas" }
+		defines { "G3_DYNAMIC_LOGGING", "CHANGE_G3LOG_DEBUG_TO_DBUG", "_USE_MATH_DEFINES",
+			"USE_OIIO", "CPPTRACE_STATIC_DEFINE", "LIBASSERT_LOWERCASE",
+			"LIBASSERT_SAFE_COMPARISONS", "LIBASSERT_STATIC_DEFINE" }
+		includedirs
+		{
+			ROOT .. "appCore/source/",
+			ROOT .. "appCore/source/jahley/",
+			MODULE_DIR,
+			ROOT .. "thirdparty/",
+			ROOT .. "thirdparty/g3log/src",
+			ROOT .. "thirdparty/json",
+			ROOT .. "thirdparty/binarytools/src",
+			ROOT .. "thirdparty/fastgltf/include",
+			ROOT .. "thirdparty/cpptrace/include",
+			ROOT .. "thirdparty/libassert/include",
+			ROOT .. "thirdparty/nanogui/include",
+		}
+		targetdir (ROOT .. "builds/bin/" .. outputdir .. "/%{prj.name}")
+		objdir (ROOT .. "builds/bin-int/" .. outputdir .. "/%{prj.name}")
+		libdirs { ROOT .. "thirdparty/builds/bin/" .. outputdir .. "/**" }
+		links
+		{
+			"fastgltf",
+			"binarytools",
+			"g3log",
+			"libassert",
+			"cpptrace",
+			"OpenImageIO",
+			"OpenImageIO_Util",
+			"pthread",
+			"dl",
+		}
+
+	filter {} -- clear filter!
+	filter { "files:../../framework/**/excludeFromBuild/**.cpp"}
+	flags {"ExcludeFromBuild"}
+	filter {} -- clear filter!
+
+-- add settings common to all project
+if os.istarget ("windows") then
+	dofile("../../buildTools/common.lua")
+end
@@ -0,0 +1,166 @@
+// RenderDogBatch: headless asset conversion and rendering for RenderDog content.
+//
+// Runs the RenderDog import and processing path (importers, MeshOps, PropertyService)
+// without nanogui, GLFW or a GPU so ingestion and throughput tests can run on servers.
+//
+// Linux:
+//   cd thirdparty && premake5 gmake2 && make -C builds config=release fastgltf binarytools g3log cpptrace libassert
+//   premake5 gmake2 && make -C builds config=release RenderDogBatch
+//   builds/bin/Release-linux-x86_64/RenderDogBatch/RenderDogBatch -o out --render --turntable 36 models/
+
+#include "BatchRunner.h"
+
+const std::string APP_NAME = "RenderDogBatch";
+
+namespace
+{
+    // plain console sink, the AppCore sinks need a window
+    class ConsoleSink
+    {
+     public:
+        void receiveLogMessage (g3::LogMessageMover message)
+        {
+            std::cerr << message.get().toString();
+        }
+    };
+
+    void printUsage()
+    {
+        std::cout << "usage: " << APP_NAME << " [options] <file or folder>...\n"
+                  << "  -o, --output <folder>   output folder (batch_out)\n"
+                  << "  -j, --jobs <n>          files processed at once, 0 uses every core (0)\n"
+                  << "  --no-cook               skip writing .cgb files\n"
+                  << "  --render                render a still of each file with the CPU renderer\n"
+                  << "  --turntable <frames>    render a turntable instead of a still\n"
+                  << "  --passes <n>            samples per pixel (64)\n"
+                  << "  --size <w> <h>          image size (640 360)\n"
+                  << "  --bounces <n>           maximum path length (8)\n"
+                  << "  --hdr <file>            equirectangular environment\n"
+                  << "  --hdr-intensity <x>     environment scale (1)\n"
+                  << "  --hdr-rotation <deg>    environment rotation about +y (0)\n"
+                  << "  --report <file>         json report (<output>/batch_report.json)\n";
+    }
+
+    // throws on a missing or malformed value so typos are reported instead of ignored
+    template <typename T>
+    T nextArg (int& i, int argc, char** argv)
+    {
+        const std::string option = argv[i];
+        if (++i >= argc)
+            throw std::invalid_argument (option + " needs a value");
+
+        if constexpr (std::is_same_v<T, std::string>)
+        {
+            return argv[i];
+        }
+        else
+        {
+            std::istringstream in (argv[i]);
+            T value;
+            if (!(in >> value) || !in.eof())
+                throw std::invalid_argument (std::string ("bad value for ") + option + ": " + argv[i]);
+            return value;
+        }
+    }
+} // namespace
+
+int main (int argc, char** argv)
+{
+    auto logWorker = g3::LogWorker::createLogWorker();
+    logWorker->addSink (std::make_unique<ConsoleSink>(), &ConsoleSink::receiveLogMessage);
+    g3::initializeLogging (logWorker.get());
+
+    PropertyService properties;
+    properties.init();
+    properties.setRender<RenderKey::RenderPasses> (64u);
+    properties.setRender<RenderKey::RenderSize> (Eigen::Vector2i (640, 360));
+    properties.setRender<RenderKey::BounceLimit> (8u);
+
+    BatchSettings settings;
+    fs::path reportPath;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "-h" || arg == "--help")
+            {
+                printUsage();
+                return 0;
+            }
+            else if (arg == "-o" || arg == "--output")
+                settings.outputFolder = nextArg<std::string> (i, argc, argv);
+            else if (arg == "-j" || arg == "--jobs")
+                settings.fileThreads = nextArg<uint32_t> (i, argc, argv);
+            else if (arg == "--no-cook")
+                settings.cook = false;
+            else if (arg == "--render")
+                settings.render = true;
+            else if (arg == "--turntable")
+            {
+                settings.turntableFrames = nextArg<uint32_t> (i, argc, argv);
+                settings.render = true;
+            }
+            else if (arg == "--passes")
+                properties.setRender<RenderKey::RenderPasses> (nextArg<uint32_t> (i, argc, argv));
+            else if (arg == "--size")
+            {
+                const int w = nextArg<int> (i, argc, argv);
+                const int h = nextArg<int> (i, argc, argv);
+                if (w <= 0 || h <= 0)
+                    throw std::invalid_argument ("--size must be positive");
+                properties.setRender<RenderKey::RenderSize> (Eigen::Vector2i (w, h));
+            }
+            else if (arg == "--bounces")
+                properties.setRender<RenderKey::BounceLimit> (nextArg<uint32_t> (i, argc, argv));
+            else if (arg == "--hdr")
+                properties.setRender<RenderKey::HDRImagePath> (nextArg<std::string> (i, argc, argv));
+            else if (arg == "--hdr-intensity")
+                properties.setRender<RenderKey::EnviroIntensity> (nextArg<double> (i, argc, argv));
+            else if (arg == "--hdr-rotation")
+                properties.setRender<RenderKey::EnviroRotation> (nextArg<double> (i, argc, argv));
+            else if (arg == "--report")
+                reportPath = nextArg<std::string> (i, argc, argv);
+            else if (arg.starts_with ("-"))
+                throw std::invalid_argument ("unknown option " + arg);
+            else
+                settings.inputs.push_back (arg);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 2;
+    }
+
+    if (settings.inputs.empty())
+    {
+        printUsage();
+        return 2;
+    }
+
+    if (!settings.cook && !settings.render)
+        LOG (INFO) << "Neither cooking nor rendering, only import and processing will be timed";
+
+    const auto start = std::chrono::steady_clock::now();
+
+    BatchRunner runner (settings, properties);
+    const std::vector<BatchResult> results = runner.run();
+
+    const double wallSeconds = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+
+    if (reportPath.empty())
+        reportPath = settings.outputFolder / "batch_report.json";
+    runner.writeReport (results, reportPath, wallSeconds);
+
+    const size_t failed = std::count_if (results.begin(), results.end(), [] (const BatchResult& r)
+                                         { return !r.ok; });
+
+    std::cout << results.size() - failed << " of " << results.size() << " files processed in "
+              << std::fixed << std::setprecision (2) << wallSeconds << "s, report in " << reportPath.generic_string() << "\n";
+
+    g3::internal::shutDownLogging();
+    return failed || results.empty() ? 1 : 0;
+}
@@ -0,0 +1,380 @@
+#include "BatchRunner.h"
+
+using sabi::RenderableNode;
+
+namespace
+{
+    // .cgb layout, all values little endian
+    //   char[4] "CGB1", uint32 version
+    //   float[16] world transform, column major
+    //   uint32 vertexCount, float[3 * vertexCount] V, float[3 * vertexCount] N
+    //   uint32 uvCount, float[2 * uvCount] UV0 (uvCount is 0 or vertexCount)
+    //   uint32 surfaceCount, then per surface:
+    //     null terminated name, null terminated material name, uint32 triangleCount, uint32[3 * triangleCount] F
+    constexpr uint32_t COOKED_VERSION = 1;
+
+    double secondsSince (std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool isBatchMeshFile (const fs::path& path)
+    {
+        std::string ext = path.extension().string();
+        std::transform (ext.begin(), ext.end(), ext.begin(), [] (unsigned char c)
+                        { return static_cast<char> (std::tolower (c)); });
+        return ext == ".gltf" || ext == ".glb" || ext == ".lwo";
+    }
+} // namespace
+
+BatchRunner::BatchRunner (const BatchSettings& settings, const PropertyService& properties) :
+    settings (settings),
+    properties (properties)
+{
+}
+
+std::vector<BatchInput> BatchRunner::collectInputs (const std::vector<fs::path>& inputs)
+{
+    std::vector<BatchInput> files;
+    for (const auto& input : inputs)
+    {
+        std::error_code ec;
+        if (fs::is_directory (input, ec))
+        {
+            for (const auto& entry : fs::recursive_directory_iterator (input, fs::directory_options::skip_permission_denied, ec))
+            {
+                if (entry.is_regular_file() && isBatchMeshFile (entry.path()))
+                    files.push_back ({entry.path(), entry.path().lexically_relative (input)});
+            }
+        }
+        else if (fs::is_regular_file (input, ec) && isBatchMeshFile (input))
+        {
+            files.push_back ({input, input.filename()});
+        }
+        else
+        {
+            LOG (WARNING) << "Skipping " << input.generic_string() << ", not a glTF/LWO3 file or folder";
+        }
+    }
+
+    std::sort (files.begin(), files.end(), [] (const BatchInput& a, const BatchInput& b)
+               { return a.source < b.source; });
+    files.erase (std::unique (files.begin(), files.end(), [] (const BatchInput& a, const BatchInput& b)
+                              { return a.source == b.source; }),
+                 files.end());
+    return files;
+}
+
+fs::path BatchRunner::outputStem (const BatchInput& input, const fs::path& outputFolder)
+{
+    // a.gltf and a.glb in one folder must not overwrite each other either
+    const fs::path& relative = input.relative;
+    return outputFolder / relative.parent_path() / (relative.stem().string() + "_" + relative.extension().string().substr (1));
+}
+
+std::vector<BatchResult> BatchRunner::run()
+{
+    const std::vector<BatchInput> files = collectInputs (settings.inputs);
+    std::vector<BatchResult> results (files.size());
+    if (files.empty())
+    {
+        LOG (WARNING) << "No input files";
+        return results;
+    }
+
+    std::error_code ec;
+    fs::create_directories (settings.outputFolder, ec);
+    if (ec)
+    {
+        LOG (CRITICAL) << "Could not create " << settings.outputFolder.generic_string() << ": " << ec.message();
+        return results;
+    }
+
+    // files that would write the same outputs fail here instead of silently overwriting each other
+    std::vector<fs::path> stems (files.size());
+    std::unordered_map<std::string, size_t> stemOwners;
+    std::vector<size_t> jobs;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        results[i].source = files[i].source;
+        stems[i] = outputStem (files[i], settings.outputFolder);
+
+        // compared without case so the check also holds on case insensitive file systems
+        std::string key = stems[i].lexically_normal().generic_string();
+        std::transform (key.begin(), key.end(), key.begin(), [] (unsigned char c)
+                        { return static_cast<char> (std::tolower (c)); });
+
+        auto [owner, inserted] = stemOwners.try_emplace (key, i);
+        if (!inserted)
+        {
+            results[i].error = "output " + stems[i].generic_string() + " is already written by " + files[owner->second].source.generic_string();
+            LOG (WARNING) << files[i].source.generic_string() << ": " << results[i].error;
+            continue;
+        }
+
+        fs::create_directories (stems[i].parent_path(), ec);
+        if (ec)
+        {
+            results[i].error = "could not create " + stems[i].parent_path().generic_string() + ": " + ec.message();
+            LOG (WARNING) << files[i].source.generic_string() << ": " << results[i].error;
+            continue;
+        }
+        jobs.push_back (i);
+    }
+    if (jobs.empty())
+        return results;
+
+    const uint32_t cores = std::max (1u, std::thread::hardware_concurrency());
+    const uint32_t fileThreads = std::min<uint32_t> (settings.fileThreads ? settings.fileThreads : cores, static_cast<uint32_t> (jobs.size()));
+    const uint32_t renderThreads = std::max (1u, cores / fileThreads);
+
+    LOG (INFO) << "Processing " << jobs.size() << " files, " << fileThreads << " at a time";
+
+    BS::thread_pool pool (fileThreads);
+    std::atomic<uint32_t> finished = 0;
+    for (size_t i : jobs)
+    {
+        pool.detach_task ([&, i]()
+                          {
+                              results[i] = processFile (files[i].source, stems[i], renderThreads);
+                              const uint32_t done = ++finished;
+                              LOG (INFO) << "[" << done << "/" << jobs.size() << "] " << files[i].source.filename().generic_string()
+                                         << (results[i].ok ? " ok" : " FAILED: " + results[i].error); });
+    }
+    pool.wait();
+
+    return results;
+}
+
+BatchResult BatchRunner::processFile (const fs::path& path, const fs::path& outStem, uint32_t renderThreads) const
+{
+    TRACE_SCOPE_CAT ("batch", "BatchRunner::processFile");
+
+    BatchResult result;
+    result.source = path;
+
+    // exceptions stay with the file that raised them so one bad asset can't stop the batch
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        sabi::CgModelPtr model = importModel (path);
+        result.importSeconds = secondsSince (start);
+
+        RenderableNode node = sabi::WorldItem::create();
+        node->setClientID (node->getID());
+        node->setName (getFileNameWithoutExtension (path));
+        node->setModel (model);
+        node->getState().state |= sabi::PRenderableState::Visible;
+
+        for (auto& s : model->S)
+            s.vertexCount = model->vertexCount();
+
+        start = std::chrono::steady_clock::now();
+        sabi::MeshOps::processCgModel (node, settings.meshOptions);
+
+        result.vertexCount = model->vertexCount();
+        result.triangleCount = model->triangleCount();
+        result.surfaceCount = model->S.size();
+
+        if (settings.cook)
+        {
+            const fs::path cookedPath = outStem.string() + ".cgb";
+            writeCooked (node, cookedPath);
+            result.outputs.push_back (cookedPath);
+        }
+        result.cookSeconds = secondsSince (start);
+
+        if (settings.render)
+        {
+            start = std::chrono::steady_clock::now();
+            renderNode (node, outStem, renderThreads, result);
+            result.renderSeconds = secondsSince (start);
+        }
+
+        result.ok = true;
+    }
+    catch (const std::exception& e)
+    {
+        result.error = e.what();
+    }
+
+    return result;
+}
+
+sabi::CgModelPtr BatchRunner::importModel (const fs::path& path) const
+{
+    std::string ext = path.extension().string();
+    std::transform (ext.begin(), ext.end(), ext.begin(), [] (unsigned char c)
+                    { return static_cast<char> (std::tolower (c)); });
+
+    if (ext == ".lwo")
+    {
+        sabi::LWO3Reader reader;
+        if (!reader.read (path))
+            throw std::runtime_error ("LWO3 read failed: " + reader.getError());
+
+        const auto& layers = reader.getLayers();
+        if (layers.empty())
+            throw std::runtime_error ("LWO3 file has no layers");
+
+        sabi::LWO3ToCgModelConverter converter (sabi::LWO3ToCgModelConverter::ConversionFlags::Complete);
+        converter.setContentDirectory (path.parent_path());
+
+        sabi::CgModelPtr model = converter.convert (layers);
+        if (!model)
+            throw std::runtime_error ("LWO3 conversion failed: " + converter.getError());
+        return model;
+    }
+
+    GLTFImporter gltf;
+    auto [model, animations] = gltf.importModel (path.generic_string());
+    if (!model)
+        throw std::runtime_error ("glTF import failed");
+    return model;
+}
+
+void BatchRunner::writeCooked (const RenderableNode& node, const fs::path& cookedPath) const
+{
+    TRACE_SCOPE_CAT ("batch", "BatchRunner::writeCooked");
+
+    const sabi::CgModelPtr model = node->getModel();
+    const uint32_t vertexCount = static_cast<uint32_t> (model->V.cols());
+    const uint32_t uvCount = model->UV0.cols() == model->V.cols() ? vertexCount : 0;
+
+    BinaryWriter writer (cookedPath.string());
+    writer.WriteFixedLengthString ("CGB1");
+    writer.WriteUint32 (COOKED_VERSION);
+
+    const Eigen::Matrix4f world = node->getSpaceTime().worldTransform.matrix();
+    writer.WriteFromMemory (world.data(), sizeof (float) * 16);
+
+    writer.WriteUint32 (vertexCount);
+    writer.WriteFromMemory (model->V.data(), sizeof (float) * 3 * vertexCount);
+    writer.WriteFromMemory (model->N.data(), sizeof (float) * 3 * vertexCount);
+
+    writer.WriteUint32 (uvCount);
+    if (uvCount)
+        writer.WriteFromMemory (model->UV0.data(), sizeof (float) * 2 * uvCount);
+
+    writer.WriteUint32 (static_cast<uint32_t> (model->S.size()));
+    for (const auto& s : model->S)
+    {
+        writer.WriteNullTerminatedString (s.name);
+        writer.WriteNullTerminatedString (s.cgMaterial.name);
+        writer.WriteUint32 (static_cast<uint32_t> (s.F.cols()));
+        writer.WriteFromMemory (s.F.data(), sizeof (uint32_t) * 3 * s.F.cols());
+    }
+    writer.Flush();
+}
+
+void BatchRunner::renderNode (const RenderableNode& node, const fs::path& stem, uint32_t renderThreads, BatchResult& result) const
+{
+    TRACE_SCOPE_CAT ("batch", "BatchRunner::renderNode");
+
+    const Eigen::Vector2i size = properties.getRender<RenderKey::RenderSize>();
+    const uint32_t passes = std::max (1u, properties.getRender<RenderKey::RenderPasses>());
+
+    CpuScenePtr scene = CpuScene::create();
+    scene->addRenderable (node);
+
+    const std::string hdrPath = properties.getRender<RenderKey::HDRImagePath>();
+    if (hdrPath != UNSET_PATH && scene->setEnvironment (fs::path (hdrPath)))
+    {
+        scene->setEnvironmentIntensity (static_cast<float> (properties.getRender<RenderKey::EnviroIntensity>()));
+        scene->setEnvironmentRotation (static_cast<float> (properties.getRender<RenderKey::EnviroRotation>()) * std::numbers::pi_v<float> / 180.0f);
+    }
+    else
+    {
+        // something to see by when no HDR is given
+        scene->setEnvironmentColor (RGBf::Constant (1.0f));
+    }
+
+    CpuRenderer::Settings renderSettings;
+    renderSettings.threadCount = renderThreads;
+    renderSettings.maxPathLength = std::max (1u, properties.getRender<RenderKey::BounceLimit>());
+    renderSettings.maxRadiance = properties.getRender<RenderKey::MaxRadiance>();
+
+    CpuRendererPtr renderer = CpuRenderer::create (renderSettings);
+    renderer->setScene (scene);
+
+    // the renderer fills the camera's own sensor, each file gets its own camera
+    sabi::CameraHandle camera = std::make_shared<sabi::CameraBody>();
+    camera->getSensor()->setPixelResolution (size.x(), size.y());
+    camera->setFocalLength (0.055f);
+
+    // frame the bounding sphere, generateRay spans +-fov vertically in tangent space
+    const Eigen::AlignedBox3f& bounds = scene->bounds();
+    const Eigen::Vector3f target = bounds.center();
+    const float radius = std::max (0.5f * bounds.diagonal().norm(), 1e-3f);
+    const float distance = radius * std::sqrt (1.0f + 1.0f / (camera->getVerticalFOVradians() * camera->getVerticalFOVradians()));
+    const Eigen::Vector3f offset = Eigen::Vector3f (0.5f, 0.35f, 1.0f).normalized() * distance;
+
+    const uint32_t frames = std::max (1u, settings.turntableFrames);
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+        const float angle = 2.0f * std::numbers::pi_v<float> * frame / frames;
+        const Eigen::Vector3f eye = target + Eigen::AngleAxisf (angle, Eigen::Vector3f::UnitY()) * offset;
+        camera->lookAt (eye, target, Eigen::Vector3f::UnitY());
+
+        renderer->render (camera, passes);
+
+        OIIO::ImageBuf image;
+        if (!camera->getSensor()->getHDRImageCopy (image))
+            throw std::runtime_error ("no image in the camera sensor");
+
+        const fs::path imagePath = settings.turntableFrames
+                                       ? fs::path (tfm::format ("%s_%04d.exr", stem.string(), frame))
+                                       : fs::path (stem.string() + ".exr");
+        if (!image.write (imagePath.string()))
+            throw std::runtime_error ("could not write " + imagePath.generic_string() + ": " + image.geterror());
+
+        result.outputs.push_back (imagePath);
+    }
+}
+
+bool BatchRunner::writeReport (const std::vector<BatchResult>& results, const fs::path& reportPath, double wallSeconds) const
+{
+    json report;
+    report["wallSeconds"] = wallSeconds;
+
+    size_t okCount = 0;
+    size_t totalTriangles = 0;
+    json files = json::array();
+    for (const auto& r : results)
+    {
+        json entry;
+        entry["source"] = r.source.generic_string();
+        entry["ok"] = r.ok;
+        if (!r.ok) entry["error"] = r.error;
+        entry["vertices"] = r.vertexCount;
+        entry["triangles"] = r.triangleCount;
+        entry["surfaces"] = r.surfaceCount;
+        entry["importSeconds"] = r.importSeconds;
+        entry["cookSeconds"] = r.cookSeconds;
+        entry["renderSeconds"] = r.renderSeconds;
+
+        json outputs = json::array();
+        for (const auto& o : r.outputs)
+            outputs.push_back (o.generic_string());
+        entry["outputs"] = outputs;
+
+        files.push_back (entry);
+
+        okCount += r.ok ? 1 : 0;
+        totalTriangles += r.triangleCount;
+    }
+
+    report["files"] = files;
+    report["fileCount"] = results.size();
+    report["failedCount"] = results.size() - okCount;
+    report["trianglesPerSecond"] = wallSeconds > 0.0 ? static_cast<double> (totalTriangles) / wallSeconds : 0.0;
+
+    std::ofstream out (reportPath);
+    if (!out)
+    {
+        LOG (WARNING) << "Could not write " << reportPath.generic_string();
+        return false;
+    }
+    out << report.dump (4);
+    return true;
+}
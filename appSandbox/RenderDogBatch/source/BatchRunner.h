@@ -0,0 +1,81 @@
+#pragma once
+
+// BatchRunner converts a list of glTF/LWO3 files to the engine's processed form and
+// optionally renders them, without a window or a GPU context.
+//
+// - Each file is imported, run through MeshOps::processCgModel with the same MeshOptions
+//   RenderDog uses and written to <output>/<relative folder>/<name>_<ext>.cgb, mirroring
+//   the file's place under the input folder (see writeCooked for the layout)
+// - Files that would write the same outputs are reported as failed rather than processed
+// - Stills and turntables are rendered with the CPU path tracer and saved as EXR
+// - Files are processed in parallel, a renderer gets the cores left over by the files
+//   running beside it so the machine is never oversubscribed
+// - Render settings come from the PropertyService, like the interactive app
+
+#include <properties_core/properties_core.h>
+#include <cpu_render_core/cpu_render_core.h>
+
+struct BatchSettings
+{
+    std::vector<fs::path> inputs; // files or folders, folders are searched recursively
+    fs::path outputFolder = "batch_out";
+    uint32_t fileThreads = 0;     // files processed at once, 0 uses every core
+    bool cook = true;
+    bool render = false;
+    uint32_t turntableFrames = 0; // 0 renders a single still
+    sabi::MeshOptions meshOptions = sabi::MeshOptions::CenterVertices | sabi::MeshOptions::NormalizeSize | sabi::MeshOptions::RestOnGround;
+};
+
+// a mesh file and its path relative to the input folder it was found in,
+// just the file name when it was given directly
+struct BatchInput
+{
+    fs::path source;
+    fs::path relative;
+};
+
+struct BatchResult
+{
+    fs::path source;
+    bool ok = false;
+    std::string error;
+
+    size_t vertexCount = 0;
+    size_t triangleCount = 0;
+    size_t surfaceCount = 0;
+
+    double importSeconds = 0.0;
+    double cookSeconds = 0.0;
+    double renderSeconds = 0.0;
+
+    std::vector<fs::path> outputs;
+};
+
+class BatchRunner
+{
+ public:
+    BatchRunner (const BatchSettings& settings, const PropertyService& properties);
+    ~BatchRunner() = default;
+
+    // processes every input, results are in input order
+    std::vector<BatchResult> run();
+
+    // writes per file results and totals as json
+    bool writeReport (const std::vector<BatchResult>& results, const fs::path& reportPath, double wallSeconds) const;
+
+    // expands folders into the mesh files they contain, sorted for a stable order
+    static std::vector<BatchInput> collectInputs (const std::vector<fs::path>& inputs);
+
+    // <outputFolder>/<relative folder>/<name>_<ext>, the outputs add their own extensions
+    static fs::path outputStem (const BatchInput& input, const fs::path& outputFolder);
+
+ private:
+    BatchSettings settings;
+    PropertyService properties;
+
+    BatchResult processFile (const fs::path& path, const fs::path& outStem, uint32_t renderThreads) const;
+
+    sabi::CgModelPtr importModel (const fs::path& path) const;
+    void writeCooked (const sabi::RenderableNode& node, const fs::path& cookedPath) const;
+    void renderNode (const sabi::RenderableNode& node, const fs::path& stem, uint32_t renderThreads, BatchResult& result) const;
+};
@@ -0,0 +1,89 @@
+#include "SyntheticData.h"
+#include <benchmark/benchmark.h>
+
+using wabi::BBox3f;
+using wabi::GridAccelf;
+using wabi::Ray3f;
+using wabi::Triangle3f;
+
+namespace
+{
+    std::vector<Triangle3f> gridTriangles (const CgModelPtr& model)
+    {
+        const MatrixXu& F = model->S[0].F;
+        std::vector<Triangle3f> triangles;
+        triangles.reserve (F.cols());
+        for (Eigen::Index i = 0; i < F.cols(); ++i)
+        {
+            triangles.emplace_back (Eigen::Vector3f (model->V.col (F (0, i))),
+                                    Eigen::Vector3f (model->V.col (F (1, i))),
+                                    Eigen::Vector3f (model->V.col (F (2, i))));
+        }
+        return triangles;
+    }
+
+    BBox3f modelBound (const CgModelPtr& model)
+    {
+        return BBox3f (Eigen::Vector3f (model->V.rowwise().minCoeff()), Eigen::Vector3f (model->V.rowwise().maxCoeff()));
+    }
+} // namespace
+
+static void BM_GridAccelBuild (benchmark::State& state)
+{
+    CgModelPtr model = synthetic::makeGridModel (static_cast<uint32_t> (state.range (0)));
+    const std::vector<Triangle3f> triangles = gridTriangles (model);
+    const BBox3f bound = modelBound (model);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto grid = std::make_unique<GridAccelf>();
+        grid->triangles = triangles;
+        state.ResumeTiming();
+
+        grid->construct (bound);
+        grid->populate();
+        benchmark::DoNotOptimize (grid->getVoxelCount());
+
+        state.PauseTiming();
+        grid.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed (state.iterations() * triangles.size());
+}
+BENCHMARK (BM_GridAccelBuild)->Arg (128)->Arg (512)->Unit (benchmark::kMillisecond);
+
+// vertical rays dropped onto the height field from random points above it
+static void BM_GridAccelTraverse (benchmark::State& state)
+{
+    CgModelPtr model = synthetic::makeGridModel (static_cast<uint32_t> (state.range (0)));
+
+    GridAccelf grid;
+    grid.triangles = gridTriangles (model);
+    grid.construct (modelBound (model));
+    grid.populate();
+
+    constexpr size_t RAY_COUNT = 4096;
+    std::mt19937 rng (11);
+    std::uniform_real_distribution<float> xz (-0.49f, 0.49f);
+    std::vector<Eigen::Vector3f> origins (RAY_COUNT);
+    for (auto& o : origins)
+        o = Eigen::Vector3f (xz (rng), 1.0f, xz (rng));
+
+    const Eigen::Vector3f down (0.0f, -1.0f, 0.0f);
+    size_t hits = 0;
+
+    for (auto _ : state)
+    {
+        for (const auto& origin : origins)
+        {
+            Ray3f ray (origin, down);
+            hits += grid.testForIntersection (ray);
+        }
+    }
+
+    benchmark::DoNotOptimize (hits);
+    state.SetItemsProcessed (state.iterations() * RAY_COUNT);
+}
+BENCHMARK (BM_GridAccelTraverse)->Arg (128)->Arg (512)->Unit (benchmark::kMicrosecond);
@@ -0,0 +1,44 @@
+// CookBench: google-benchmark suite for the CPU hot paths.
+//
+// All inputs are generated (see SyntheticData.h), no content library needed.
+// Results go to the console and, unless --benchmark_out is given, to
+// cookbench_<timestamp>.json in the working directory for regression tracking.
+//
+// Linux:
+//   cd thirdparty && premake5 gmake2 && make -C builds config=release benchmark g3log fastgltf binarytools cpptrace libassert
+//   cd bench && premake5 gmake2 && make -C builds config=release
+//   builds/bin/Release-linux-x86_64/CookBench/CookBench --benchmark_filter=Mesh   (from the repository root)
+
+#include "SyntheticData.h"
+#include <benchmark/benchmark.h>
+
+int main (int argc, char** argv)
+{
+    // no sinks, the benchmarks time the code and not the console
+    auto logWorker = g3::LogWorker::createLogWorker();
+    g3::initializeLogging (logWorker.get());
+
+    std::vector<char*> args (argv, argv + argc);
+    const bool hasOutput = std::any_of (args.begin(), args.end(), [] (const char* arg)
+                                        { return std::string_view (arg).starts_with ("--benchmark_out="); });
+
+    std::string outArg = "--benchmark_out=cookbench" + createTimestampString() + ".json";
+    std::string formatArg = "--benchmark_out_format=json";
+    if (!hasOutput)
+    {
+        args.push_back (outArg.data());
+        args.push_back (formatArg.data());
+    }
+
+    int count = static_cast<int> (args.size());
+    benchmark::Initialize (&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments (count, args.data()))
+        return 1;
+
+    benchmark::AddCustomContext ("scratch", synthetic::scratchFolder().generic_string());
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    g3::internal::shutDownLogging();
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "SyntheticData.h"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    constexpr int IMAGE_SIZE = 2048;
+
+    ImageCacheHandlerPtr cacheHandler()
+    {
+        static ImageCacheHandlerPtr handler = ImageCacheHandler::create();
+        return handler;
+    }
+} // namespace
+
+// decode from disk every time, the cache is invalidated between iterations
+static void BM_ImageCacheColdDecode (benchmark::State& state)
+{
+    const std::string path = synthetic::writeImage (IMAGE_SIZE, IMAGE_SIZE).string();
+    ImageCacheHandlerPtr handler = cacheHandler();
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        handler->clear();
+        state.ResumeTiming();
+
+        PinnedImagePtr image = handler->getPinnedImage (path);
+        benchmark::DoNotOptimize (image.get());
+
+        state.PauseTiming();
+        image.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetBytesProcessed (state.iterations() * int64_t (IMAGE_SIZE) * IMAGE_SIZE * 4 * sizeof (float));
+}
+BENCHMARK (BM_ImageCacheColdDecode)->Unit (benchmark::kMillisecond);
+
+// a second reader of an image someone still holds
+static void BM_ImageCachePinnedHit (benchmark::State& state)
+{
+    const std::string path = synthetic::writeImage (IMAGE_SIZE, IMAGE_SIZE).string();
+    ImageCacheHandlerPtr handler = cacheHandler();
+    PinnedImagePtr held = handler->getPinnedImage (path);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize (handler->getPinnedImage (path).get());
+}
+BENCHMARK (BM_ImageCachePinnedHit)->ThreadRange (1, 8)->UseRealTime();
+
+static void BM_ImageCacheOwnedCopy (benchmark::State& state)
+{
+    const std::string path = synthetic::writeImage (IMAGE_SIZE, IMAGE_SIZE).string();
+    ImageCacheHandlerPtr handler = cacheHandler();
+    PinnedImagePtr held = handler->getPinnedImage (path);
+
+    for (auto _ : state)
+    {
+        OIIO::ImageBuf image = handler->getCachedImage (path, false);
+        benchmark::DoNotOptimize (image.localpixels());
+    }
+
+    state.SetBytesProcessed (state.iterations() * static_cast<int64_t> (held->sizeInBytes()));
+}
+BENCHMARK (BM_ImageCacheOwnedCopy)->Unit (benchmark::kMillisecond);
+
+// every 64x64 tile of the image, zero copy
+static void BM_ImageCacheTiles (benchmark::State& state)
+{
+    const std::string path = synthetic::writeImage (IMAGE_SIZE, IMAGE_SIZE).string();
+    ImageCacheHandlerPtr handler = cacheHandler();
+    size_t tiles = 0;
+
+    for (auto _ : state)
+    {
+        for (int y = 0; y < IMAGE_SIZE; y += 64)
+        {
+            for (int x = 0; x < IMAGE_SIZE; x += 64)
+            {
+                TileView tile = handler->getTile (path, x, y);
+                benchmark::DoNotOptimize (tile.data());
+                ++tiles;
+            }
+        }
+    }
+
+    state.SetItemsProcessed (static_cast<int64_t> (tiles));
+}
+BENCHMARK (BM_ImageCacheTiles)->Unit (benchmark::kMillisecond);
+
+static void BM_ImageCacheScanlines (benchmark::State& state)
+{
+    const std::string path = synthetic::writeImage (IMAGE_SIZE, IMAGE_SIZE).string();
+    ImageCacheHandlerPtr handler = cacheHandler();
+    const int band = static_cast<int> (state.range (0));
+    std::vector<float> rows (static_cast<size_t> (band) * IMAGE_SIZE * 4);
+
+    for (auto _ : state)
+    {
+        for (int y = 0; y < IMAGE_SIZE; y += band)
+            handler->readScanlines (path, y, y + band, OIIO::TypeDesc::FLOAT, rows.data());
+        benchmark::DoNotOptimize (rows.data());
+    }
+
+    state.SetBytesProcessed (state.iterations() * int64_t (IMAGE_SIZE) * IMAGE_SIZE * 4 * sizeof (float));
+}
+BENCHMARK (BM_ImageCacheScanlines)->Arg (64)->Unit (benchmark::kMillisecond);
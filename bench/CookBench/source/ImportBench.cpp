@@ -0,0 +1,103 @@
+#include "SyntheticData.h"
+#include <benchmark/benchmark.h>
+
+// range(0) grid resolution, range(1) node count sharing the mesh
+static void BM_GltfImport (benchmark::State& state)
+{
+    const fs::path path = synthetic::writeGltf (static_cast<uint32_t> (state.range (0)),
+                                                static_cast<uint32_t> (state.range (1)));
+
+    for (auto _ : state)
+    {
+        GLTFImporter importer;
+        auto [model, animations] = importer.importModel (path.string());
+        benchmark::DoNotOptimize (model.get());
+    }
+
+    state.SetBytesProcessed (state.iterations() * static_cast<int64_t> (fs::file_size (path.parent_path() / (path.stem().string() + ".bin"))));
+}
+BENCHMARK (BM_GltfImport)->Args ({256, 1})->Args ({1024, 1})->Args ({256, 16})->Unit (benchmark::kMillisecond);
+
+// range(0) threads decoding 16 embedded 512 x 512 PNGs, real time should drop as threads are added
+static void BM_GltfImportImages (benchmark::State& state)
+{
+    const fs::path path = synthetic::writeTexturedGltf (16, 512);
+
+    BS::thread_pool pool (static_cast<BS::concurrency_t> (state.range (0)));
+
+    for (auto _ : state)
+    {
+        GLTFImporter importer;
+        auto [model, animations] = importer.importModel (path.string(), &pool);
+        benchmark::DoNotOptimize (model.get());
+    }
+}
+BENCHMARK (BM_GltfImportImages)->RangeMultiplier (2)->Range (1, 16)->UseRealTime()->Unit (benchmark::kMillisecond);
+
+// importing keeps the PNGs encoded, so this should not depend on the image count
+static void BM_GltfImportLazyImages (benchmark::State& state)
+{
+    const fs::path path = synthetic::writeTexturedGltf (static_cast<uint32_t> (state.range (0)), 512);
+
+    for (auto _ : state)
+    {
+        GLTFImporter importer;
+        auto [model, animations] = importer.importModel (path.string());
+        benchmark::DoNotOptimize (model.get());
+    }
+
+    state.counters["residentMB"] = static_cast<double> (sabi::CgImageCache::get().getResidentBytes()) / (1 << 20);
+}
+BENCHMARK (BM_GltfImportLazyImages)->Arg (4)->Arg (16)->Arg (64)->Unit (benchmark::kMillisecond);
+
+static void BM_LWO3TreeRead (benchmark::State& state)
+{
+    const fs::path path = synthetic::writeLwo3 (static_cast<uint32_t> (state.range (0)));
+
+    for (auto _ : state)
+    {
+        sabi::LWO3Tree tree;
+        auto root = tree.read (path);
+        benchmark::DoNotOptimize (root.get());
+    }
+
+    state.SetBytesProcessed (state.iterations() * static_cast<int64_t> (fs::file_size (path)));
+}
+BENCHMARK (BM_LWO3TreeRead)->Arg (256)->Arg (1024)->Unit (benchmark::kMillisecond);
+
+// range(0) layer count of an 8x8 grid each, time should grow linearly with it
+static void BM_LWO3ReadLayers (benchmark::State& state)
+{
+    const fs::path path = synthetic::writeLwo3 (8, static_cast<uint32_t> (state.range (0)));
+
+    for (auto _ : state)
+    {
+        sabi::LWO3Reader reader;
+        reader.read (path);
+        benchmark::DoNotOptimize (reader.getLayers().data());
+    }
+
+    state.SetComplexityN (state.range (0));
+}
+BENCHMARK (BM_LWO3ReadLayers)->RangeMultiplier (4)->Range (16, 4096)->Complexity (benchmark::oN)->Unit (benchmark::kMillisecond);
+
+// range(0) threads converting 64 layers of a 64x64 grid, real time should drop as threads are added
+static void BM_LWO3ConvertLayers (benchmark::State& state)
+{
+    const fs::path path = synthetic::writeLwo3 (64, 64);
+
+    sabi::LWO3Reader reader;
+    reader.read (path);
+
+    BS::thread_pool pool (static_cast<BS::concurrency_t> (state.range (0)));
+    sabi::LWO3ToCgModelConverter converter (sabi::LWO3ToCgModelConverter::ConversionFlags::StandardGeometry);
+
+    for (auto _ : state)
+    {
+        sabi::CgModelPtr model = converter.convert (reader.getLayers(), &pool);
+        benchmark::DoNotOptimize (model.get());
+    }
+
+    state.counters["layers"] = static_cast<double> (reader.getLayers().size());
+}
+BENCHMARK (BM_LWO3ConvertLayers)->RangeMultiplier (2)->Range (1, 16)->UseRealTime()->Unit (benchmark::kMillisecond);
@@ -0,0 +1,67 @@
+#include "SyntheticData.h"
+#include <benchmark/benchmark.h>
+
+// range(0) grid resolution, range(1) deterministic
+static void BM_GenerateNormals (benchmark::State& state)
+{
+    CgModelPtr model = synthetic::makeGridModel (static_cast<uint32_t> (state.range (0)));
+    const bool deterministic = state.range (1) != 0;
+    MatrixXf N, FN;
+
+    for (auto _ : state)
+    {
+        MeshOps::generate_normals (model->S[0].F, model->V, N, FN, deterministic);
+        benchmark::DoNotOptimize (N.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed (state.iterations() * model->S[0].F.cols());
+}
+BENCHMARK (BM_GenerateNormals)->ArgsProduct ({{256, 1024}, {0, 1}})->Unit (benchmark::kMillisecond);
+
+static void BM_UnweldMesh (benchmark::State& state)
+{
+    CgModelPtr source = synthetic::makeGridModel (static_cast<uint32_t> (state.range (0)));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        CgModelPtr model = std::make_shared<CgModel> (*source);
+        state.ResumeTiming();
+
+        MeshOps::unweldMesh (model);
+        benchmark::DoNotOptimize (model->V.data());
+
+        state.PauseTiming();
+        model.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed (state.iterations() * source->S[0].F.cols());
+}
+BENCHMARK (BM_UnweldMesh)->Arg (256)->Arg (1024)->Unit (benchmark::kMillisecond);
+
+// normalize, center, rest on ground and generate the missing normals
+static void BM_ProcessCgModel (benchmark::State& state)
+{
+    CgModelPtr source = synthetic::makeGridModel (static_cast<uint32_t> (state.range (0)));
+    const MeshOptions options = MeshOptions::NormalizeSize | MeshOptions::CenterVertices | MeshOptions::RestOnGround;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        RenderableNode node = sabi::WorldItem::create();
+        node->setModel (std::make_shared<CgModel> (*source));
+        state.ResumeTiming();
+
+        MeshOps::processCgModel (node, options);
+        benchmark::DoNotOptimize (node->getModel()->N.data());
+
+        state.PauseTiming();
+        node.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed (state.iterations() * source->S[0].F.cols());
+}
+BENCHMARK (BM_ProcessCgModel)->Arg (256)->Arg (1024)->Unit (benchmark::kMillisecond);
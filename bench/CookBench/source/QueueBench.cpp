@@ -0,0 +1,92 @@
+#include "SyntheticData.h"
+#include <benchmark/benchmark.h>
+#include <qms_core/qms_core.h>
+
+using qms::QmsID;
+
+namespace
+{
+    struct BenchMessage
+    {
+        QmsID id = QmsID::Init;
+        QmsID realID = QmsID::Init;
+        uint64_t sequence = 0;
+    };
+
+    constexpr uint64_t STOP = std::numeric_limits<uint64_t>::max();
+
+    uint64_t sequenceOf (const std::shared_ptr<qms::message_base>& msg)
+    {
+        return static_cast<qms::wrapped_message<BenchMessage>*> (msg.get())->contents.sequence;
+    }
+} // namespace
+
+// single thread, a batch of pushes followed by the same number of pops
+static void BM_QueuePushPop (benchmark::State& state)
+{
+    qms::queue q;
+    const int64_t batch = state.range (0);
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < batch; ++i)
+            q.push (BenchMessage {QmsID::Init, QmsID::Init, static_cast<uint64_t> (i)});
+        for (int64_t i = 0; i < batch; ++i)
+            benchmark::DoNotOptimize (q.wait_and_pop());
+    }
+
+    state.SetItemsProcessed (state.iterations() * batch);
+}
+BENCHMARK (BM_QueuePushPop)->Arg (1)->Arg (1024);
+
+// one producer thread, the benchmark thread consumes
+static void BM_QueueProducerConsumer (benchmark::State& state)
+{
+    const int64_t batch = state.range (0);
+
+    for (auto _ : state)
+    {
+        qms::queue q;
+        std::thread producer ([&]
+                              {
+                                  for (int64_t i = 0; i < batch; ++i)
+                                      q.push (BenchMessage {QmsID::Init, QmsID::Init, static_cast<uint64_t> (i)}); });
+
+        for (int64_t i = 0; i < batch; ++i)
+            benchmark::DoNotOptimize (q.wait_and_pop());
+
+        producer.join();
+    }
+
+    state.SetItemsProcessed (state.iterations() * batch);
+}
+BENCHMARK (BM_QueueProducerConsumer)->Arg (1 << 14)->UseRealTime();
+
+// wake up latency, one message bounced through an echo thread per iteration
+static void BM_QueueRoundTrip (benchmark::State& state)
+{
+    qms::queue ping;
+    qms::queue pong;
+
+    std::thread echo ([&]
+                      {
+                          for (;;)
+                          {
+                              auto msg = ping.wait_and_pop();
+                              const uint64_t sequence = sequenceOf (msg);
+                              pong.push (BenchMessage {QmsID::Init, QmsID::Init, sequence});
+                              if (sequence == STOP) break;
+                          } });
+
+    uint64_t sequence = 0;
+    for (auto _ : state)
+    {
+        ping.push (BenchMessage {QmsID::Init, QmsID::Init, sequence++});
+        benchmark::DoNotOptimize (pong.wait_and_pop());
+    }
+
+    ping.push (BenchMessage {QmsID::Init, QmsID::Init, STOP});
+    pong.wait_and_pop();
+    echo.join();
+}
+BENCHMARK (BM_QueueRoundTrip)->UseRealTime();
@@ -0,0 +1,358 @@
+#pragma once
+
+// Deterministic stand ins for the content library so the benchmarks run anywhere.
+// Everything is generated from a size and a seed and written under a scratch folder
+// that lives for the whole run.
+
+#include <sabi_core/sabi_core.h>
+#include <stb_image/stb_image_write.h>
+
+using sabi::CgModel;
+using sabi::CgModelPtr;
+using sabi::CgModelSurface;
+
+namespace synthetic
+{
+    // scratch folder for generated files, removed when the process exits
+    inline const fs::path& scratchFolder()
+    {
+        static struct Scratch
+        {
+            fs::path path = fs::temp_directory_path() / ("cookbench_" + std::to_string (std::chrono::steady_clock::now().time_since_epoch().count()));
+            Scratch() { fs::create_directories (path); }
+            ~Scratch()
+            {
+                std::error_code ec;
+                fs::remove_all (path, ec);
+            }
+        } scratch;
+        return scratch.path;
+    }
+
+    // height field on a (resolution + 1)^2 vertex grid, two triangles per cell
+    inline CgModelPtr makeGridModel (uint32_t resolution, uint32_t seed = 1)
+    {
+        std::mt19937 rng (seed);
+        std::uniform_real_distribution<float> jitter (-0.01f, 0.01f);
+
+        const uint32_t side = resolution + 1;
+        CgModelPtr model = CgModel::create();
+        model->V.resize (3, side * side);
+        model->UV0.resize (2, side * side);
+
+        for (uint32_t y = 0; y < side; ++y)
+        {
+            for (uint32_t x = 0; x < side; ++x)
+            {
+                const float u = static_cast<float> (x) / resolution;
+                const float v = static_cast<float> (y) / resolution;
+                const float h = 0.1f * std::sin (u * 12.0f) * std::cos (v * 9.0f) + jitter (rng);
+                model->V.col (y * side + x) = Eigen::Vector3f (u - 0.5f, h, v - 0.5f);
+                model->UV0.col (y * side + x) = Eigen::Vector2f (u, v);
+            }
+        }
+
+        CgModelSurface surface;
+        surface.F.resize (3, resolution * resolution * 2);
+        uint32_t t = 0;
+        for (uint32_t y = 0; y < resolution; ++y)
+        {
+            for (uint32_t x = 0; x < resolution; ++x)
+            {
+                const uint32_t i0 = y * side + x;
+                const uint32_t i1 = i0 + 1;
+                const uint32_t i2 = i0 + side;
+                const uint32_t i3 = i2 + 1;
+                surface.F.col (t++) = Vector3u (i0, i2, i1);
+                surface.F.col (t++) = Vector3u (i1, i2, i3);
+            }
+        }
+        surface.vertexCount = static_cast<uint32_t> (model->V.cols());
+        model->S.push_back (std::move (surface));
+        model->triCount = t;
+
+        return model;
+    }
+
+    // glTF with an external .bin holding positions, normals, uvs and 32 bit indices,
+    // 'meshCount' copies of the grid each on its own node
+    inline fs::path writeGltf (uint32_t resolution, uint32_t meshCount = 1)
+    {
+        const fs::path gltfPath = scratchFolder() / ("grid_" + std::to_string (resolution) + "_" + std::to_string (meshCount) + ".gltf");
+        if (fs::exists (gltfPath)) return gltfPath;
+
+        CgModelPtr model = makeGridModel (resolution);
+        MatrixXf N, FN;
+        MeshOps::generate_normals (model->S[0].F, model->V, N, FN, true);
+
+        const size_t vertexCount = model->V.cols();
+        const size_t indexCount = model->S[0].F.size();
+        const size_t positionBytes = vertexCount * 3 * sizeof (float);
+        const size_t uvBytes = vertexCount * 2 * sizeof (float);
+        const size_t indexBytes = indexCount * sizeof (uint32_t);
+
+        const fs::path binPath = gltfPath.parent_path() / (gltfPath.stem().string() + ".bin");
+        {
+            std::ofstream bin (binPath, std::ios::binary);
+            bin.write (reinterpret_cast<const char*> (model->V.data()), positionBytes);
+            bin.write (reinterpret_cast<const char*> (N.data()), positionBytes);
+            bin.write (reinterpret_cast<const char*> (model->UV0.data()), uvBytes);
+            bin.write (reinterpret_cast<const char*> (model->S[0].F.data()), indexBytes);
+        }
+
+        const Eigen::Vector3f lo = model->V.rowwise().minCoeff();
+        const Eigen::Vector3f hi = model->V.rowwise().maxCoeff();
+
+        json doc;
+        doc["asset"] = {{"version", "2.0"}, {"generator", "CookBench"}};
+        doc["buffers"] = json::array ({{{"uri", binPath.filename().string()}, {"byteLength", 2 * positionBytes + uvBytes + indexBytes}}});
+        doc["bufferViews"] = json::array ({
+            {{"buffer", 0}, {"byteOffset", 0}, {"byteLength", positionBytes}, {"target", 34962}},
+            {{"buffer", 0}, {"byteOffset", positionBytes}, {"byteLength", positionBytes}, {"target", 34962}},
+            {{"buffer", 0}, {"byteOffset", 2 * positionBytes}, {"byteLength", uvBytes}, {"target", 34962}},
+            {{"buffer", 0}, {"byteOffset", 2 * positionBytes + uvBytes}, {"byteLength", indexBytes}, {"target", 34963}},
+        });
+        doc["accessors"] = json::array ({
+            {{"bufferView", 0}, {"componentType", 5126}, {"count", vertexCount}, {"type", "VEC3"},
+             {"min", {lo.x(), lo.y(), lo.z()}}, {"max", {hi.x(), hi.y(), hi.z()}}},
+            {{"bufferView", 1}, {"componentType", 5126}, {"count", vertexCount}, {"type", "VEC3"}},
+            {{"bufferView", 2}, {"componentType", 5126}, {"count", vertexCount}, {"type", "VEC2"}},
+            {{"bufferView", 3}, {"componentType", 5125}, {"count", indexCount}, {"type", "SCALAR"}},
+        });
+        doc["materials"] = json::array ({{{"name", "grid"}, {"pbrMetallicRoughness", {{"baseColorFactor", {0.8, 0.8, 0.8, 1.0}}, {"metallicFactor", 0.0}, {"roughnessFactor", 0.5}}}}});
+        doc["meshes"] = json::array ({{{"name", "grid"}, {"primitives", json::array ({{{"attributes", {{"POSITION", 0}, {"NORMAL", 1}, {"TEXCOORD_0", 2}}}, {"indices", 3}, {"material", 0}}})}}});
+
+        json nodes = json::array();
+        json sceneNodes = json::array();
+        for (uint32_t i = 0; i < meshCount; ++i)
+        {
+            nodes.push_back ({{"name", "grid" + std::to_string (i)}, {"mesh", 0}, {"translation", {1.1 * i, 0.0, 0.0}}});
+            sceneNodes.push_back (i);
+        }
+        doc["nodes"] = nodes;
+        doc["scenes"] = json::array ({{{"nodes", sceneNodes}}});
+        doc["scene"] = 0;
+
+        std::ofstream (gltfPath) << doc.dump();
+        return gltfPath;
+    }
+
+    // glTF with one quad and 'imageCount' RGBA PNGs of 'imageSize' pixels square, stored in
+    // buffer views of the .bin like a GLB would hold them
+    inline fs::path writeTexturedGltf (uint32_t imageCount, uint32_t imageSize, uint32_t seed = 5)
+    {
+        const fs::path gltfPath = scratchFolder() / ("textured_" + std::to_string (imageCount) + "_" + std::to_string (imageSize) + ".gltf");
+        if (fs::exists (gltfPath)) return gltfPath;
+
+        std::mt19937 rng (seed);
+        std::uniform_int_distribution<int> noise (0, 31);
+
+        const float positions[] = {-0.5f, 0.0f, -0.5f, 0.5f, 0.0f, -0.5f, 0.5f, 0.0f, 0.5f, -0.5f, 0.0f, 0.5f};
+        const uint32_t indices[] = {0, 2, 1, 0, 3, 2};
+
+        std::vector<uint8_t> bin;
+        auto append = [&] (const void* data, size_t bytes)
+        {
+            while (bin.size() % 4)
+                bin.push_back (0);
+            const size_t offset = bin.size();
+            bin.insert (bin.end(), static_cast<const uint8_t*> (data), static_cast<const uint8_t*> (data) + bytes);
+            return offset;
+        };
+
+        json bufferViews = json::array();
+        bufferViews.push_back ({{"buffer", 0}, {"byteOffset", append (positions, sizeof (positions))}, {"byteLength", sizeof (positions)}});
+        bufferViews.push_back ({{"buffer", 0}, {"byteOffset", append (indices, sizeof (indices))}, {"byteLength", sizeof (indices)}});
+
+        json images = json::array();
+        json textures = json::array();
+        std::vector<uint8_t> pixels (static_cast<size_t> (imageSize) * imageSize * 4);
+        for (uint32_t i = 0; i < imageCount; ++i)
+        {
+            for (uint32_t y = 0; y < imageSize; ++y)
+            {
+                for (uint32_t x = 0; x < imageSize; ++x)
+                {
+                    uint8_t* p = &pixels[(static_cast<size_t> (y) * imageSize + x) * 4];
+                    p[0] = static_cast<uint8_t> (x * 224 / imageSize + noise (rng));
+                    p[1] = static_cast<uint8_t> (y * 224 / imageSize + noise (rng));
+                    p[2] = static_cast<uint8_t> (i * 37 + noise (rng));
+                    p[3] = 255;
+                }
+            }
+
+            std::vector<uint8_t> png;
+            stbi_write_png_to_func ([] (void* context, void* data, int size)
+                                    {
+                auto* out = static_cast<std::vector<uint8_t>*> (context);
+                out->insert (out->end(), static_cast<uint8_t*> (data), static_cast<uint8_t*> (data) + size); },
+                                    &png, imageSize, imageSize, 4, pixels.data(), imageSize * 4);
+
+            bufferViews.push_back ({{"buffer", 0}, {"byteOffset", append (png.data(), png.size())}, {"byteLength", png.size()}});
+            images.push_back ({{"name", "image" + std::to_string (i)}, {"bufferView", bufferViews.size() - 1}, {"mimeType", "image/png"}});
+            textures.push_back ({{"source", i}});
+        }
+
+        const fs::path binPath = gltfPath.parent_path() / (gltfPath.stem().string() + ".bin");
+        std::ofstream (binPath, std::ios::binary).write (reinterpret_cast<const char*> (bin.data()), bin.size());
+
+        json doc;
+        doc["asset"] = {{"version", "2.0"}, {"generator", "CookBench"}};
+        doc["buffers"] = json::array ({{{"uri", binPath.filename().string()}, {"byteLength", bin.size()}}});
+        doc["bufferViews"] = bufferViews;
+        doc["accessors"] = json::array ({
+            {{"bufferView", 0}, {"componentType", 5126}, {"count", 4}, {"type", "VEC3"},
+             {"min", {-0.5, 0.0, -0.5}}, {"max", {0.5, 0.0, 0.5}}},
+            {{"bufferView", 1}, {"componentType", 5125}, {"count", 6}, {"type", "SCALAR"}},
+        });
+        doc["images"] = images;
+        doc["textures"] = textures;
+        doc["materials"] = json::array ({{{"name", "textured"}, {"pbrMetallicRoughness", {{"baseColorTexture", {{"index", 0}}}}}}});
+        doc["meshes"] = json::array ({{{"name", "quad"}, {"primitives", json::array ({{{"attributes", {{"POSITION", 0}}}, {"indices", 1}, {"material", 0}}})}}});
+        doc["nodes"] = json::array ({{{"name", "quad"}, {"mesh", 0}}});
+        doc["scenes"] = json::array ({{{"nodes", {0}}}});
+        doc["scene"] = 0;
+
+        std::ofstream (gltfPath) << doc.dump();
+        return gltfPath;
+    }
+
+    // minimal big endian LWO3: 'layers' layers, each with PNTS and a FACE POLS chunk of quads
+    inline fs::path writeLwo3 (uint32_t resolution, uint32_t layers = 1)
+    {
+        const std::string suffix = layers > 1 ? "_x" + std::to_string (layers) : "";
+        const fs::path lwoPath = scratchFolder() / ("grid_" + std::to_string (resolution) + suffix + ".lwo");
+        if (fs::exists (lwoPath)) return lwoPath;
+
+        std::vector<uint8_t> body;
+        auto u16 = [&] (uint16_t v)
+        {
+            body.push_back (static_cast<uint8_t> (v >> 8));
+            body.push_back (static_cast<uint8_t> (v));
+        };
+        auto u32 = [&] (uint32_t v)
+        {
+            u16 (static_cast<uint16_t> (v >> 16));
+            u16 (static_cast<uint16_t> (v));
+        };
+        auto f32 = [&] (float f)
+        {
+            uint32_t bits;
+            std::memcpy (&bits, &f, sizeof (bits));
+            u32 (bits);
+        };
+        // chunk sizes are patched once the payload is written
+        auto beginChunk = [&] (uint32_t id)
+        {
+            u32 (id);
+            u32 (0);
+            return body.size();
+        };
+        auto endChunk = [&] (size_t start)
+        {
+            const uint32_t size = static_cast<uint32_t> (body.size() - start);
+            for (int i = 0; i < 4; ++i)
+                body[start - 4 + i] = static_cast<uint8_t> (size >> (24 - 8 * i));
+            if (size & 1) body.push_back (0);
+        };
+        // variable length index, 2 bytes below 0xFF00
+        auto vx = [&] (uint32_t index)
+        {
+            if (index < 0xFF00)
+                u16 (static_cast<uint16_t> (index));
+            else
+                u32 (index | 0xFF000000u);
+        };
+
+        CgModelPtr model = makeGridModel (resolution);
+        const uint32_t side = resolution + 1;
+
+        for (uint32_t layer = 0; layer < layers; ++layer)
+        {
+            size_t chunk = beginChunk (sabi::LWO::LAYR);
+            u16 (static_cast<uint16_t> (layer));
+            u16 (0);
+            f32 (0.0f);
+            f32 (0.0f);
+            f32 (0.0f);
+            u16 (0);
+            endChunk (chunk);
+
+            chunk = beginChunk (sabi::LWO::PNTS);
+            for (Eigen::Index i = 0; i < model->V.cols(); ++i)
+            {
+                f32 (model->V (0, i));
+                f32 (model->V (1, i));
+                f32 (model->V (2, i));
+            }
+            endChunk (chunk);
+
+            chunk = beginChunk (sabi::LWO::POLS);
+            u32 (sabi::LWO::FACE);
+            for (uint32_t y = 0; y < resolution; ++y)
+            {
+                for (uint32_t x = 0; x < resolution; ++x)
+                {
+                    const uint32_t i0 = y * side + x;
+                    u16 (4);
+                    vx (i0);
+                    vx (i0 + side);
+                    vx (i0 + side + 1);
+                    vx (i0 + 1);
+                }
+            }
+            endChunk (chunk);
+        }
+
+        std::vector<uint8_t> file;
+        auto put32 = [&] (uint32_t v)
+        {
+            for (int i = 0; i < 4; ++i)
+                file.push_back (static_cast<uint8_t> (v >> (24 - 8 * i)));
+        };
+        put32 (sabi::LWO::FORM);
+        put32 (static_cast<uint32_t> (body.size() + 4));
+        put32 (sabi::LWO::LWO3);
+        file.insert (file.end(), body.begin(), body.end());
+
+        std::ofstream (lwoPath, std::ios::binary).write (reinterpret_cast<const char*> (file.data()), file.size());
+        return lwoPath;
+    }
+
+    // tiled RGBA half float EXR with a smooth gradient and some noise
+    inline fs::path writeImage (int width, int height, uint32_t seed = 3)
+    {
+        const fs::path imagePath = scratchFolder() / ("image_" + std::to_string (width) + "x" + std::to_string (height) + ".exr");
+        if (fs::exists (imagePath)) return imagePath;
+
+        std::mt19937 rng (seed);
+        std::uniform_real_distribution<float> noise (0.0f, 0.05f);
+
+        OIIO::ImageSpec spec (width, height, 4, OIIO::TypeDesc::FLOAT);
+        std::vector<float> pixels (static_cast<size_t> (width) * height * 4);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                float* p = &pixels[(static_cast<size_t> (y) * width + x) * 4];
+                p[0] = static_cast<float> (x) / width + noise (rng);
+                p[1] = static_cast<float> (y) / height + noise (rng);
+                p[2] = 0.5f + noise (rng);
+                p[3] = 1.0f;
+            }
+        }
+
+        OIIO::ImageSpec fileSpec (width, height, 4, OIIO::TypeDesc::HALF);
+        fileSpec.tile_width = 64;
+        fileSpec.tile_height = 64;
+
+        auto out = OIIO::ImageOutput::create (imagePath.string());
+        if (!out || !out->open (imagePath.string(), fileSpec))
+            throw std::runtime_error ("Could not write " + imagePath.string());
+        out->write_image (OIIO::TypeDesc::FLOAT, pixels.data());
+        out->close();
+
+        return imagePath;
+    }
+
+} // namespace synthetic
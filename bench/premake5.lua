@@ -0,0 +1,26 @@
+-- https://github.com/JohannesMP/Premake-for-Beginners
+
+workspace "Benchmarks"
+	architecture "x64"
+	location ("builds")
+	
+if _ACTION == "vs2022" then
+   location ("builds/VisualStudio2022")
+end
+if _ACTION == "vs2019" then
+   location ("builds/VisualStudio2019")
+end
+
+	configurations 
+	{ 
+		"Debug", 
+        "Release",
+    }
+	vectorextensions "AVX2"
+	filter "configurations:Debug"    defines { "DEBUG" }  symbols  "On"
+    filter "configurations:Release"  defines { "NDEBUG", "MACE_LOG_MIN_LEVEL=500" } optimize "On"
+    
+	outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
+
+	
+	include "CookBench"
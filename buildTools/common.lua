@@ -39,6 +39,7 @@ local ROOT = "../"
 		THIRD_PARTY_DIR .. "nanogui/ext/glad/include",
 		THIRD_PARTY_DIR .. "nanogui/ext/nanovg/src",
 		THIRD_PARTY_DIR .. "fastgltf/include",
+		THIRD_PARTY_DIR .. "earcut/include/mapbox",
 	}
 	
 	targetdir (ROOT .. "builds/bin/" .. outputdir .. "/%{prj.name}")
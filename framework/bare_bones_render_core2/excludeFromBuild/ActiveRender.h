@@ -23,7 +23,7 @@ private:
     std::unique_ptr<Renderer> impl;
     
     // messaging
-    MsgReceiver incoming;
+    MsgReceiver incoming{"qms queue depth: Renderer"};
     
     // message arguments
     uint32_t frameNumber = 0;
@@ -0,0 +1,5 @@
+#include "cpu_render_core.h"
+
+#include "excludeFromBuild/Bvh4.cpp"
+#include "excludeFromBuild/CpuScene.cpp"
+#include "excludeFromBuild/CpuRenderer.cpp"
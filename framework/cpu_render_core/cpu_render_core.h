@@ -0,0 +1,19 @@
+#pragma once
+
+// Headless CPU reference renderer, consumes the same RenderableNode/CgModel/CameraBody
+// scene as dog_core without CUDA or OptiX
+
+#include "sabi_core/sabi_core.h"
+
+#include <bit>
+#include <map>
+#include <optional>
+
+// CUDA free and shared with dog_core's EnvironmentHandler
+#include "dog_core/excludeFromBuild/tools/EnvImportanceMap.h"
+
+#include "excludeFromBuild/CpuShared.h"
+#include "excludeFromBuild/HostPrincipledDisney.h"
+#include "excludeFromBuild/Bvh4.h"
+#include "excludeFromBuild/CpuScene.h"
+#include "excludeFromBuild/CpuRenderer.h"
@@ -0,0 +1,561 @@
+#include "Bvh4.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define BVH4_USE_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr uint32_t NumBins = 16;
+
+    // subtrees larger than this are handed to the pool
+    constexpr uint32_t ParallelThreshold = 8192;
+
+    // leaves larger than MaxLeafSize are accepted when SAH prefers them, never beyond this
+    constexpr uint32_t MaxSahLeafSize = 16;
+
+    // binary levels needed to halve count triangles down to leaves of maxLeafSize
+    uint32_t halvingLevels (uint32_t count, uint32_t maxLeafSize)
+    {
+        uint32_t levels = 0;
+        for (uint32_t leaves = (count + maxLeafSize - 1) / maxLeafSize; leaves > 1; leaves = (leaves + 1) / 2)
+            ++levels;
+        return levels;
+    }
+
+    float halfArea (const Eigen::AlignedBox3f& box)
+    {
+        if (box.isEmpty()) return 0.0f;
+        const Eigen::Vector3f d = box.sizes();
+        return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+    }
+} // namespace
+
+struct Bvh4::BuildContext
+{
+    const std::vector<Eigen::AlignedBox3f>& boxes;
+    const std::vector<Eigen::Vector3f>& centroids;
+    std::vector<uint32_t>& indices;
+    std::vector<BuildNode>& tree;
+    std::atomic<uint32_t> nextNode = 1;
+    BS::thread_pool* pool = nullptr;
+
+    // subtrees still building on the pool
+    uint32_t pending = 0;
+    std::mutex pendingMutex;
+    std::condition_variable pendingDone;
+
+    void started()
+    {
+        std::lock_guard<std::mutex> lock (pendingMutex);
+        ++pending;
+    }
+
+    // decrements under the lock so wait() cannot return, and the context go away, before the notify
+    void finished()
+    {
+        std::lock_guard<std::mutex> lock (pendingMutex);
+        if (--pending == 0) pendingDone.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock (pendingMutex);
+        pendingDone.wait (lock, [this]
+                          { return pending == 0; });
+    }
+
+    void build (uint32_t nodeIndex, uint32_t first, uint32_t count, uint32_t depth)
+    {
+        while (true)
+        {
+            Eigen::AlignedBox3f box;
+            Eigen::AlignedBox3f centroidBox;
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                box.extend (boxes[indices[i]]);
+                centroidBox.extend (centroids[indices[i]]);
+            }
+
+            BuildNode& node = tree[nodeIndex];
+            node.box = box;
+
+            if (count <= MaxLeafSize)
+            {
+                makeLeaf (node, first, count);
+                return;
+            }
+
+            uint32_t splitCount = 0;
+            if (!findSplit (box, centroidBox, first, count, &splitCount))
+            {
+                makeLeaf (node, first, count);
+                return;
+            }
+
+            // a lopsided SAH split that could push leaves past MaxBuildDepth is replaced by
+            // halving the range, which always fits because the parent's range did
+            const uint32_t largest = std::max (splitCount, count - splitCount);
+            if (depth + 1 + halvingLevels (largest, MaxLeafSize) > MaxBuildDepth)
+                splitCount = count / 2;
+
+            const uint32_t left = nextNode.fetch_add (2, std::memory_order_relaxed);
+            node.left = left;
+            node.right = left + 1;
+            node.count = 0;
+
+            const uint32_t rightFirst = first + splitCount;
+            const uint32_t rightCount = count - splitCount;
+
+            if (pool && rightCount >= ParallelThreshold)
+            {
+                started();
+                pool->detach_task ([this, right = left + 1, rightFirst, rightCount, depth]()
+                                   { build (right, rightFirst, rightCount, depth + 1); finished(); });
+            }
+            else
+                build (left + 1, rightFirst, rightCount, depth + 1);
+
+            // continue with the left child on this thread
+            nodeIndex = left;
+            count = splitCount;
+            ++depth;
+        }
+    }
+
+    void makeLeaf (BuildNode& node, uint32_t first, uint32_t count)
+    {
+        node.first = first;
+        node.count = count;
+    }
+
+    // partitions [first, first + count) and returns the size of the left half,
+    // false when a leaf is cheaper
+    bool findSplit (const Eigen::AlignedBox3f& box, const Eigen::AlignedBox3f& centroidBox,
+                    uint32_t first, uint32_t count, uint32_t* leftCount)
+    {
+        const Eigen::Vector3f extent = centroidBox.sizes();
+        uint32_t* begin = indices.data() + first;
+        uint32_t* end = begin + count;
+
+        int bestAxis = -1;
+        uint32_t bestBin = 0;
+        float bestCost = std::numeric_limits<float>::infinity();
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (extent[axis] <= 0.0f) continue;
+
+            Eigen::AlignedBox3f binBoxes[NumBins];
+            uint32_t binCounts[NumBins] = {};
+            const float scale = NumBins / extent[axis];
+            const float lo = centroidBox.min()[axis];
+
+            for (uint32_t* it = begin; it != end; ++it)
+            {
+                const uint32_t b = std::min (static_cast<uint32_t> ((centroids[*it][axis] - lo) * scale), NumBins - 1);
+                binBoxes[b].extend (boxes[*it]);
+                ++binCounts[b];
+            }
+
+            // sweep from the right, then evaluate every plane from the left
+            float rightArea[NumBins];
+            uint32_t rightCounts[NumBins];
+            Eigen::AlignedBox3f acc;
+            uint32_t accCount = 0;
+            for (uint32_t b = NumBins - 1; b > 0; --b)
+            {
+                acc.extend (binBoxes[b]);
+                accCount += binCounts[b];
+                rightArea[b] = halfArea (acc);
+                rightCounts[b] = accCount;
+            }
+
+            acc.setEmpty();
+            accCount = 0;
+            for (uint32_t b = 0; b < NumBins - 1; ++b)
+            {
+                acc.extend (binBoxes[b]);
+                accCount += binCounts[b];
+                if (accCount == 0 || rightCounts[b + 1] == 0) continue;
+
+                const float cost = halfArea (acc) * accCount + rightArea[b + 1] * rightCounts[b + 1];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = b;
+                }
+            }
+        }
+
+        if (bestAxis < 0)
+        {
+            // every centroid in the same spot, split the range in half if it is too big for one leaf
+            if (count <= MaxSahLeafSize) return false;
+            *leftCount = count / 2;
+            return true;
+        }
+
+        // traversal costs about as much as one triangle test
+        const float area = halfArea (box);
+        const float splitCost = 1.0f + (area > 0.0f ? bestCost / area : 0.0f);
+        if (splitCost >= static_cast<float> (count) && count <= MaxSahLeafSize)
+            return false;
+
+        const float scale = NumBins / extent[bestAxis];
+        const float lo = centroidBox.min()[bestAxis];
+        uint32_t* mid = std::partition (begin, end, [&] (uint32_t i)
+                                        { return std::min (static_cast<uint32_t> ((centroids[i][bestAxis] - lo) * scale), NumBins - 1) <= bestBin; });
+
+        *leftCount = static_cast<uint32_t> (mid - begin);
+        return *leftCount > 0 && *leftCount < count;
+    }
+};
+
+void Bvh4::clear()
+{
+    nodes.clear();
+    p0.clear();
+    e1.clear();
+    e2.clear();
+    triIDs.clear();
+    sceneBounds.setEmpty();
+}
+
+void Bvh4::build (const std::vector<Eigen::Vector3f>& v0,
+                  const std::vector<Eigen::Vector3f>& v1,
+                  const std::vector<Eigen::Vector3f>& v2,
+                  BS::thread_pool* pool)
+{
+    clear();
+
+    const uint32_t triCount = static_cast<uint32_t> (v0.size());
+    if (triCount == 0 || v1.size() != v0.size() || v2.size() != v0.size())
+        return;
+
+    std::vector<Eigen::AlignedBox3f> boxes (triCount);
+    std::vector<Eigen::Vector3f> centroids (triCount);
+    std::vector<uint32_t> indices (triCount);
+    for (uint32_t i = 0; i < triCount; ++i)
+    {
+        boxes[i] = Eigen::AlignedBox3f (v0[i]);
+        boxes[i].extend (v1[i]);
+        boxes[i].extend (v2[i]);
+        centroids[i] = boxes[i].center();
+        indices[i] = i;
+        sceneBounds.extend (boxes[i]);
+    }
+
+    // a binary tree over n leaves never needs more than 2n - 1 nodes
+    std::vector<BuildNode> tree (2 * static_cast<size_t> (triCount));
+    BuildContext ctx {boxes, centroids, indices, tree};
+
+    // already on a pool thread the build runs serially rather than wait on a pool from inside it
+    if (!BS::this_thread::get_pool())
+        ctx.pool = pool;
+
+    ctx.build (0, 0, triCount, 0);
+
+    // only this build's subtrees are waited for, the pool may be shared
+    ctx.wait();
+
+    nodes.reserve (ctx.nextNode.load() / 2 + 1);
+    collapse (tree, 0);
+
+    p0.resize (triCount);
+    e1.resize (triCount);
+    e2.resize (triCount);
+    triIDs = std::move (indices);
+    for (uint32_t i = 0; i < triCount; ++i)
+    {
+        const uint32_t id = triIDs[i];
+        p0[i] = v0[id];
+        e1[i] = v1[id] - v0[id];
+        e2[i] = v2[id] - v0[id];
+    }
+
+    LOG (DBUG) << "Bvh4 built over " << triCount << " triangles, " << nodes.size() << " nodes";
+}
+
+uint32_t Bvh4::collapse (const std::vector<BuildNode>& tree, uint32_t buildIndex)
+{
+    // open the largest inner child until there are four
+    uint32_t children[4];
+    uint32_t childCount = 0;
+
+    const BuildNode& root = tree[buildIndex];
+    if (root.isLeaf())
+    {
+        children[childCount++] = buildIndex;
+    }
+    else
+    {
+        children[childCount++] = root.left;
+        children[childCount++] = root.right;
+    }
+
+    while (childCount < 4)
+    {
+        int best = -1;
+        float bestArea = -1.0f;
+        for (uint32_t i = 0; i < childCount; ++i)
+        {
+            const BuildNode& c = tree[children[i]];
+            if (!c.isLeaf() && halfArea (c.box) > bestArea)
+            {
+                bestArea = halfArea (c.box);
+                best = static_cast<int> (i);
+            }
+        }
+        if (best < 0) break;
+
+        const BuildNode& opened = tree[children[best]];
+        children[best] = opened.left;
+        children[childCount++] = opened.right;
+    }
+
+    const uint32_t nodeIndex = static_cast<uint32_t> (nodes.size());
+    nodes.emplace_back();
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        Node& node = nodes[nodeIndex];
+        if (i >= childCount)
+        {
+            // inverted box, the slab test can still pass for infinite bounds so
+            // traversal also skips InvalidID children
+            const float inf = std::numeric_limits<float>::infinity();
+            node.minX[i] = node.minY[i] = node.minZ[i] = inf;
+            node.maxX[i] = node.maxY[i] = node.maxZ[i] = -inf;
+            node.child[i] = InvalidID;
+            node.count[i] = 0;
+            continue;
+        }
+
+        const BuildNode& c = tree[children[i]];
+        node.minX[i] = c.box.min().x();
+        node.minY[i] = c.box.min().y();
+        node.minZ[i] = c.box.min().z();
+        node.maxX[i] = c.box.max().x();
+        node.maxY[i] = c.box.max().y();
+        node.maxZ[i] = c.box.max().z();
+
+        if (c.isLeaf())
+        {
+            node.child[i] = c.first;
+            node.count[i] = c.count;
+        }
+        else
+        {
+            // recursion may grow 'nodes', so write through the index afterwards
+            const uint32_t childIndex = collapse (tree, children[i]);
+            nodes[nodeIndex].child[i] = childIndex;
+            nodes[nodeIndex].count[i] = 0;
+        }
+    }
+
+    return nodeIndex;
+}
+
+int Bvh4::intersectChildren (const Node& node, const Eigen::Vector3f& origin, const Eigen::Vector3f& invDir,
+                             float tMax, float tNear[4])
+{
+#if defined(BVH4_USE_SSE)
+    const __m128 ox = _mm_set1_ps (origin.x());
+    const __m128 oy = _mm_set1_ps (origin.y());
+    const __m128 oz = _mm_set1_ps (origin.z());
+    const __m128 ix = _mm_set1_ps (invDir.x());
+    const __m128 iy = _mm_set1_ps (invDir.y());
+    const __m128 iz = _mm_set1_ps (invDir.z());
+
+    const __m128 t0x = _mm_mul_ps (_mm_sub_ps (_mm_load_ps (node.minX), ox), ix);
+    const __m128 t1x = _mm_mul_ps (_mm_sub_ps (_mm_load_ps (node.maxX), ox), ix);
+    const __m128 t0y = _mm_mul_ps (_mm_sub_ps (_mm_load_ps (node.minY), oy), iy);
+    const __m128 t1y = _mm_mul_ps (_mm_sub_ps (_mm_load_ps (node.maxY), oy), iy);
+    const __m128 t0z = _mm_mul_ps (_mm_sub_ps (_mm_load_ps (node.minZ), oz), iz);
+    const __m128 t1z = _mm_mul_ps (_mm_sub_ps (_mm_load_ps (node.maxZ), oz), iz);
+
+    const __m128 enter = _mm_max_ps (_mm_max_ps (_mm_min_ps (t0x, t1x), _mm_min_ps (t0y, t1y)),
+                                     _mm_max_ps (_mm_min_ps (t0z, t1z), _mm_setzero_ps()));
+    const __m128 exit = _mm_min_ps (_mm_min_ps (_mm_max_ps (t0x, t1x), _mm_max_ps (t0y, t1y)),
+                                    _mm_min_ps (_mm_max_ps (t0z, t1z), _mm_set1_ps (tMax)));
+
+    _mm_storeu_ps (tNear, enter);
+    return _mm_movemask_ps (_mm_cmple_ps (enter, exit));
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        const float t0x = (node.minX[i] - origin.x()) * invDir.x();
+        const float t1x = (node.maxX[i] - origin.x()) * invDir.x();
+        const float t0y = (node.minY[i] - origin.y()) * invDir.y();
+        const float t1y = (node.maxY[i] - origin.y()) * invDir.y();
+        const float t0z = (node.minZ[i] - origin.z()) * invDir.z();
+        const float t1z = (node.maxZ[i] - origin.z()) * invDir.z();
+
+        const float enter = std::max (std::max (std::min (t0x, t1x), std::min (t0y, t1y)), std::max (std::min (t0z, t1z), 0.0f));
+        const float exit = std::min (std::min (std::max (t0x, t1x), std::max (t0y, t1y)), std::min (std::max (t0z, t1z), tMax));
+
+        tNear[i] = enter;
+        if (enter <= exit) mask |= 1 << i;
+    }
+    return mask;
+#endif
+}
+
+bool Bvh4::intersectTriangle (uint32_t index, const Eigen::Vector3f& origin, const Eigen::Vector3f& dir,
+                              float tMax, float* t, float* u, float* v) const
+{
+    // Moller-Trumbore, both faces
+    const Eigen::Vector3f& edge1 = e1[index];
+    const Eigen::Vector3f& edge2 = e2[index];
+    const Eigen::Vector3f pvec = dir.cross (edge2);
+    const float det = edge1.dot (pvec);
+    if (std::abs (det) < 1e-12f) return false;
+
+    const float invDet = 1.0f / det;
+    const Eigen::Vector3f tvec = origin - p0[index];
+    const float b1 = tvec.dot (pvec) * invDet;
+    if (b1 < 0.0f || b1 > 1.0f) return false;
+
+    const Eigen::Vector3f qvec = tvec.cross (edge1);
+    const float b2 = dir.dot (qvec) * invDet;
+    if (b2 < 0.0f || b1 + b2 > 1.0f) return false;
+
+    const float hitT = edge2.dot (qvec) * invDet;
+    if (hitT <= 0.0f || hitT >= tMax) return false;
+
+    *t = hitT;
+    *u = b1;
+    *v = b2;
+    return true;
+}
+
+namespace
+{
+    struct StackEntry
+    {
+        uint32_t child;
+        uint32_t count;
+        float tNear;
+    };
+} // namespace
+
+bool Bvh4::intersect (const Eigen::Vector3f& origin, const Eigen::Vector3f& dir, float tMax, Hit* hit) const
+{
+    if (nodes.empty()) return false;
+
+    const Eigen::Vector3f invDir = dir.cwiseInverse();
+    float closest = tMax;
+    uint32_t closestIndex = InvalidID;
+    float closestU = 0.0f;
+    float closestV = 0.0f;
+
+    StackEntry stack[StackSize];
+    uint32_t sp = 0;
+    stack[sp++] = {0, 0, 0.0f};
+
+    while (sp)
+    {
+        const StackEntry entry = stack[--sp];
+        if (entry.tNear > closest) continue;
+
+        if (entry.count)
+        {
+            for (uint32_t i = entry.child; i < entry.child + entry.count; ++i)
+            {
+                float t, u, v;
+                if (intersectTriangle (i, origin, dir, closest, &t, &u, &v))
+                {
+                    closest = t;
+                    closestIndex = i;
+                    closestU = u;
+                    closestV = v;
+                }
+            }
+            continue;
+        }
+
+        const Node& node = nodes[entry.child];
+        float tNear[4];
+        int mask = intersectChildren (node, origin, invDir, closest, tNear);
+        if (!mask) continue;
+
+        // push far to near so the nearest child pops first
+        StackEntry hits[4];
+        uint32_t hitCount = 0;
+        while (mask)
+        {
+            const int i = std::countr_zero (static_cast<unsigned> (mask));
+            mask &= mask - 1;
+            if (node.child[i] == InvalidID) continue;
+
+            StackEntry e {node.child[i], node.count[i], tNear[i]};
+            uint32_t j = hitCount++;
+            while (j > 0 && hits[j - 1].tNear < e.tNear)
+            {
+                hits[j] = hits[j - 1];
+                --j;
+            }
+            hits[j] = e;
+        }
+
+        // the build depth cap keeps this within the stack
+        debug_assert (sp + hitCount <= StackSize);
+        for (uint32_t i = 0; i < hitCount; ++i)
+            stack[sp++] = hits[i];
+    }
+
+    if (closestIndex == InvalidID) return false;
+
+    hit->t = closest;
+    hit->u = closestU;
+    hit->v = closestV;
+    hit->primID = triIDs[closestIndex];
+    return true;
+}
+
+bool Bvh4::occluded (const Eigen::Vector3f& origin, const Eigen::Vector3f& dir, float tMax) const
+{
+    if (nodes.empty()) return false;
+
+    const Eigen::Vector3f invDir = dir.cwiseInverse();
+
+    StackEntry stack[StackSize];
+    uint32_t sp = 0;
+    stack[sp++] = {0, 0, 0.0f};
+
+    while (sp)
+    {
+        const StackEntry entry = stack[--sp];
+
+        if (entry.count)
+        {
+            for (uint32_t i = entry.child; i < entry.child + entry.count; ++i)
+            {
+                float t, u, v;
+                if (intersectTriangle (i, origin, dir, tMax, &t, &u, &v))
+                    return true;
+            }
+            continue;
+        }
+
+        const Node& node = nodes[entry.child];
+        float tNear[4];
+        int mask = intersectChildren (node, origin, invDir, tMax, tNear);
+        while (mask)
+        {
+            const int i = std::countr_zero (static_cast<unsigned> (mask));
+            mask &= mask - 1;
+            if (node.child[i] == InvalidID) continue;
+
+            // the build depth cap keeps this within the stack
+            debug_assert (sp < StackSize);
+            stack[sp++] = {node.child[i], node.count[i], tNear[i]};
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+// Bvh4 is a four wide bounding volume hierarchy over world space triangles.
+//
+// Building:
+// - A binary tree is built top down with a binned SAH (16 bins per axis)
+// - Large subtrees are split across a thread pool, small ones finish on the thread that found them
+// - Leaves are never deeper than MaxBuildDepth, so traversal fits its fixed size stack, a
+//   split that would go deeper halves the range instead
+// - The binary tree is then collapsed so every node holds up to four children,
+//   always opening the child with the largest surface area first
+// - Triangles are reordered into leaf order and stored as a vertex plus two edges
+//
+// Traversal:
+// - The four child boxes of a node are tested against the ray at once, with SSE on x64
+//   and a scalar loop elsewhere
+// - Hit children are pushed far to near so the closest is visited first, stack
+//   entries whose entry distance is beyond the current hit are skipped
+// - intersect() finds the closest hit, occluded() stops at the first one
+
+class Bvh4
+{
+ public:
+    struct Hit
+    {
+        float t = std::numeric_limits<float>::infinity();
+        float u = 0.0f; // barycentric weight of vertex 1
+        float v = 0.0f; // barycentric weight of vertex 2
+        uint32_t primID = InvalidID;
+    };
+
+    static constexpr uint32_t InvalidID = std::numeric_limits<uint32_t>::max();
+
+    Bvh4() = default;
+    ~Bvh4() = default;
+
+    // one entry per triangle, primID in a Hit indexes these arrays
+    void build (const std::vector<Eigen::Vector3f>& v0,
+                const std::vector<Eigen::Vector3f>& v1,
+                const std::vector<Eigen::Vector3f>& v2,
+                BS::thread_pool* pool = nullptr);
+
+    void clear();
+    bool empty() const { return nodes.empty(); }
+
+    bool intersect (const Eigen::Vector3f& origin, const Eigen::Vector3f& dir, float tMax, Hit* hit) const;
+    bool occluded (const Eigen::Vector3f& origin, const Eigen::Vector3f& dir, float tMax) const;
+
+    size_t nodeCount() const { return nodes.size(); }
+    size_t triangleCount() const { return triIDs.size(); }
+    const Eigen::AlignedBox3f& bounds() const { return sceneBounds; }
+
+ private:
+    static constexpr uint32_t MaxLeafSize = 4;
+    static constexpr uint32_t StackSize = 128;
+
+    // a node pushes at most 4 entries after popping itself, so a path of d levels never holds
+    // more than 3 * d + 1 entries, the build keeps every leaf within this many levels
+    static constexpr uint32_t MaxBuildDepth = (StackSize - 1) / 3;
+
+    // child[i] is a node index when count[i] == 0, the first triangle of a leaf otherwise,
+    // empty slots have an inverted box and child InvalidID, traversal skips them
+    struct alignas (16) Node
+    {
+        float minX[4];
+        float minY[4];
+        float minZ[4];
+        float maxX[4];
+        float maxY[4];
+        float maxZ[4];
+        uint32_t child[4];
+        uint32_t count[4];
+    };
+
+    struct BuildNode
+    {
+        Eigen::AlignedBox3f box;
+        uint32_t left = 0;
+        uint32_t right = 0;
+        uint32_t first = 0;
+        uint32_t count = 0;
+        bool isLeaf() const { return count > 0; }
+    };
+
+    struct BuildContext;
+
+    std::vector<Node> nodes;
+    Eigen::AlignedBox3f sceneBounds;
+
+    // triangles in leaf order
+    std::vector<Eigen::Vector3f> p0;
+    std::vector<Eigen::Vector3f> e1;
+    std::vector<Eigen::Vector3f> e2;
+    std::vector<uint32_t> triIDs;
+
+    uint32_t collapse (const std::vector<BuildNode>& tree, uint32_t buildIndex);
+
+    // up to four hit flags and entry distances for one node
+    static int intersectChildren (const Node& node, const Eigen::Vector3f& origin, const Eigen::Vector3f& invDir,
+                                  float tMax, float tNear[4]);
+
+    bool intersectTriangle (uint32_t index, const Eigen::Vector3f& origin, const Eigen::Vector3f& dir,
+                            float tMax, float* t, float* u, float* v) const;
+
+}; // end class Bvh4
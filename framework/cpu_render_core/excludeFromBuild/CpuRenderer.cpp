@@ -0,0 +1,248 @@
+#include "CpuRenderer.h"
+
+using CpuShared::misWeight;
+using CpuShared::offsetRayOrigin;
+
+CpuRenderer::CpuRenderer (const Settings& settings)
+{
+    setSettings (settings);
+}
+
+CpuRenderer::~CpuRenderer()
+{
+    if (pool) pool->wait();
+}
+
+void CpuRenderer::setSettings (const Settings& newSettings)
+{
+    const uint32_t threads = newSettings.threadCount ? newSettings.threadCount : std::max (1u, std::thread::hardware_concurrency());
+    if (!pool || pool->get_thread_count() != threads)
+    {
+        if (pool) pool->wait();
+        pool = std::make_unique<BS::thread_pool> (threads);
+    }
+
+    settings = newSettings;
+    settings.tileSize = std::max (settings.tileSize, 1u);
+    settings.maxPathLength = std::max (settings.maxPathLength, 1u);
+    passCount = 0;
+}
+
+void CpuRenderer::setScene (CpuScenePtr newScene)
+{
+    scene = newScene;
+    if (scene) scene->commit (pool.get());
+    passCount = 0;
+}
+
+bool CpuRenderer::cameraChanged (const sabi::CameraHandle& camera)
+{
+    const Eigen::Vector2i resolution = camera->getSensor()->getPixelResolution();
+    const Eigen::Matrix4f pose = camera->getPose().matrix();
+    const float fov = camera->getVerticalFOVradians();
+
+    const bool changed = resolution.x() != static_cast<int> (width) || resolution.y() != static_cast<int> (height) ||
+                         pose != lastPose || fov != lastFov;
+
+    if (changed)
+    {
+        width = static_cast<uint32_t> (std::max (resolution.x(), 0));
+        height = static_cast<uint32_t> (std::max (resolution.y(), 0));
+        beauty.assign (static_cast<size_t> (width) * height * 4, 0.0f);
+        lastPose = pose;
+        lastFov = fov;
+    }
+    return changed;
+}
+
+uint32_t CpuRenderer::render (const sabi::CameraHandle& camera, uint32_t passes, const std::atomic<bool>* cancel)
+{
+    for (uint32_t i = 0; i < passes; ++i)
+    {
+        if (cancel && cancel->load (std::memory_order_relaxed)) break;
+        renderPass (camera);
+    }
+    return passCount;
+}
+
+uint32_t CpuRenderer::renderPass (const sabi::CameraHandle& camera)
+{
+    TRACE_SCOPE_CAT ("cpu", "CpuRenderer::renderPass");
+
+    if (!camera || !scene) return passCount;
+
+    if (cameraChanged (camera)) passCount = 0;
+    if (width == 0 || height == 0) return passCount;
+
+    const uint32_t tilesX = (width + settings.tileSize - 1) / settings.tileSize;
+    const uint32_t tilesY = (height + settings.tileSize - 1) / settings.tileSize;
+    const uint32_t tileCount = tilesX * tilesY;
+
+    // one task per tile so threads that finish early steal the remaining tiles
+    pool->detach_loop (0u, tileCount, [&] (uint32_t tile)
+                       { renderTile (camera, tile, tilesX); }, tileCount);
+    pool->wait();
+
+    ++passCount;
+
+    camera->getSensor()->updateImage (beauty.data(), Eigen::Vector2i (width, height), false, 1);
+
+    LOG_EVERY_MS (DBUG, 1000) << "CPU pass " << passCount << " at " << width << "x" << height;
+    return passCount;
+}
+
+void CpuRenderer::renderTile (const sabi::CameraHandle& camera, uint32_t tileIndex, uint32_t tilesX)
+{
+    const uint32_t x0 = (tileIndex % tilesX) * settings.tileSize;
+    const uint32_t y0 = (tileIndex / tilesX) * settings.tileSize;
+    const uint32_t x1 = std::min (x0 + settings.tileSize, width);
+    const uint32_t y1 = std::min (y0 + settings.tileSize, height);
+
+    // running average, the same update the device accumulation buffer uses
+    const float curWeight = 1.0f / static_cast<float> (passCount + 1);
+
+    for (uint32_t y = y0; y < y1; ++y)
+    {
+        for (uint32_t x = x0; x < x1; ++x)
+        {
+            const uint64_t pixel = static_cast<uint64_t> (y) * width + x;
+            CpuShared::Pcg32 rng (pixel * 0x9E3779B97F4A7C15ULL + passCount, pixel);
+
+            const float jitterU = rng.getFloat0cTo1o();
+            const float jitterV = rng.getFloat0cTo1o();
+            const wabi::Ray3f ray = camera->generateRay (x, y, jitterU, jitterV);
+
+            RGBf radiance = tracePath (ray.origin, ray.dir, rng);
+            if (!radiance.allFinite()) radiance = RGBf::Zero();
+
+            if (settings.maxRadiance > 0.0f)
+            {
+                const float lum = CpuShared::luminance (radiance);
+                if (lum > settings.maxRadiance) radiance *= settings.maxRadiance / lum;
+            }
+
+            float* out = &beauty[pixel * 4];
+            for (int c = 0; c < 3; ++c)
+                out[c] = (1.0f - curWeight) * out[c] + curWeight * radiance[c];
+            out[3] = 1.0f;
+        }
+    }
+}
+
+RGBf CpuRenderer::tracePath (Eigen::Vector3f origin, Eigen::Vector3f dir, CpuShared::Pcg32& rng) const
+{
+    RGBf contribution = RGBf::Zero();
+    RGBf alpha = RGBf::Ones();
+    float prevDirPDensity = 0.0f;
+    bool prevDelta = true; // camera rays see lights directly
+
+    for (uint32_t pathLength = 1;; ++pathLength)
+    {
+        CpuScene::SurfaceHit hit;
+        if (!scene->intersect (origin, dir, std::numeric_limits<float>::infinity(), &hit))
+        {
+            // implicit environment sampling, MIS weighted against next event estimation
+            const RGBf Le = scene->environmentRadiance (dir);
+            const float weight = prevDelta ? 1.0f : misWeight (prevDirPDensity, scene->environmentPDF (dir));
+            contribution += alpha * Le * weight;
+            break;
+        }
+
+        const HostDisneyPrincipled bsdf (scene->evaluateMaterial (hit.materialID, hit.uv));
+        const Eigen::Vector3f vOut = -dir;
+        const bool frontHit = vOut.dot (hit.geometricNormal) >= 0.0f;
+
+        // opaque surfaces shade both sides, glass needs the true orientation to know if it is entering
+        Eigen::Vector3f shadingNormal = hit.shadingNormal;
+        if (!bsdf.isDelta() && vOut.dot (shadingNormal) < 0.0f) shadingNormal = -shadingNormal;
+        const CpuShared::Frame frame (shadingNormal);
+        const Eigen::Vector3f vOutLocal = frame.toLocal (vOut);
+
+        // implicit light sampling, diffuse emitters radiate from the front face only
+        const RGBf& emittance = bsdf.evaluateEmission();
+        if (frontHit && (emittance > 0.0f).any())
+        {
+            float weight = 1.0f;
+            if (!prevDelta)
+            {
+                const float cosLight = vOut.dot (hit.geometricNormal);
+                const float lightPDensity = scene->meshLightPDF (hit.primID) * hit.t * hit.t / cosLight;
+                weight = misWeight (prevDirPDensity, lightPDensity);
+            }
+            contribution += alpha * emittance * (weight * CpuShared::InvPi);
+        }
+
+        if (pathLength >= settings.maxPathLength) break;
+
+        const Eigen::Vector3f offsetNormal = frontHit ? hit.geometricNormal : Eigen::Vector3f (-hit.geometricNormal);
+
+        // next event estimation
+        if (!bsdf.isDelta())
+        {
+            const float uSelect = rng.getFloat0cTo1o();
+            const float u0 = rng.getFloat0cTo1o();
+            const float u1 = rng.getFloat0cTo1o();
+
+            CpuScene::LightSample light;
+            if (scene->sampleLight (uSelect, u0, u1, &light))
+            {
+                Eigen::Vector3f toLight;
+                float dist;
+                float lightPDensity;
+                bool valid = true;
+                if (light.atInfinity)
+                {
+                    toLight = light.position;
+                    dist = std::numeric_limits<float>::infinity();
+                    lightPDensity = light.pdf;
+                }
+                else
+                {
+                    toLight = light.position - hit.position;
+                    const float dist2 = toLight.squaredNorm();
+                    dist = std::sqrt (dist2);
+                    toLight /= dist;
+                    const float cosLight = -toLight.dot (light.normal);
+                    valid = cosLight > 0.0f;
+                    lightPDensity = light.pdf * dist2 / std::max (cosLight, 1e-8f);
+                }
+
+                const Eigen::Vector3f vInLocal = frame.toLocal (toLight);
+                if (valid && vInLocal.z() > 0.0f)
+                {
+                    const RGBf fs = bsdf.evaluate (vOutLocal, vInLocal);
+                    if ((fs > 0.0f).any())
+                    {
+                        const Eigen::Vector3f shadowOrigin = offsetRayOrigin (hit.position, toLight.dot (hit.geometricNormal) >= 0.0f ? hit.geometricNormal : Eigen::Vector3f (-hit.geometricNormal));
+                        const float shadowMax = light.atInfinity ? dist : dist * 0.9999f;
+                        if (!scene->occluded (shadowOrigin, toLight, shadowMax))
+                        {
+                            const float weight = misWeight (lightPDensity, bsdf.evaluatePDF (vOutLocal, vInLocal));
+                            contribution += alpha * fs * light.radiance * (weight / lightPDensity);
+                        }
+                    }
+                }
+            }
+        }
+
+        // extend the path
+        HostDisneyPrincipled::Sample s;
+        if (!bsdf.sample (vOutLocal, rng.getFloat0cTo1o(), rng.getFloat0cTo1o(), &s))
+            break;
+
+        alpha *= s.weight;
+        prevDirPDensity = s.pdf;
+        prevDelta = s.delta;
+
+        dir = frame.fromLocal (s.wi).normalized();
+        origin = offsetRayOrigin (hit.position, dir.dot (offsetNormal) >= 0.0f ? offsetNormal : Eigen::Vector3f (-offsetNormal));
+
+        // Russian roulette against the path's initial importance of 1, as on the device
+        const float continueProb = std::min (CpuShared::luminance (alpha), 1.0f);
+        if (!(continueProb > 0.0f) || rng.getFloat0cTo1o() >= continueProb)
+            break;
+        alpha /= continueProb;
+    }
+
+    return contribution;
+}
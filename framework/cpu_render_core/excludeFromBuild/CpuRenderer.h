@@ -0,0 +1,80 @@
+#pragma once
+
+// CpuRenderer is a headless reference path tracer for the scenes dog_core renders on the GPU.
+//
+// - Unidirectional path tracing with next event estimation and MIS (power heuristic) over
+//   mesh lights and the environment, the same light selection and weights as the device kernels
+// - The image is split into square tiles rendered in parallel on a thread pool
+// - Every renderPass() adds one sample per pixel to a running average, the average is
+//   restarted whenever the camera pose, field of view or sensor resolution changes
+// - Results are written into the camera's CameraSensor like the GPU renderer's, so the
+//   existing display and save paths work unchanged
+//
+// Usage:
+//   CpuScenePtr scene = CpuScene::create();
+//   scene->addRenderable (node);
+//   scene->setEnvironment (hdrPath);
+//   CpuRendererPtr renderer = CpuRenderer::create();
+//   renderer->setScene (scene);      // commits the scene
+//   renderer->render (camera, 256);  // 256 progressive passes
+
+#include "CpuScene.h"
+
+using CpuRendererPtr = std::shared_ptr<class CpuRenderer>;
+
+struct CpuRenderSettings
+{
+    uint32_t maxPathLength = 8; // vertices after the camera
+    uint32_t tileSize = 32;
+    uint32_t threadCount = 0;   // 0 uses every core
+    float maxRadiance = 0.0f;   // clamps each sample's luminance, 0 disables
+};
+
+class CpuRenderer
+{
+ public:
+    using Settings = CpuRenderSettings;
+
+    static CpuRendererPtr create (const Settings& settings = Settings()) { return std::make_shared<CpuRenderer> (settings); }
+
+    explicit CpuRenderer (const Settings& settings = Settings());
+    ~CpuRenderer();
+
+    void setSettings (const Settings& newSettings);
+    const Settings& getSettings() const { return settings; }
+
+    // commits the scene and restarts accumulation
+    void setScene (CpuScenePtr newScene);
+    CpuScenePtr getScene() const { return scene; }
+
+    // one sample per pixel at the sensor's resolution, returns the number of accumulated passes
+    uint32_t renderPass (const sabi::CameraHandle& camera);
+
+    // 'passes' more samples per pixel, stops early when 'cancel' becomes true
+    uint32_t render (const sabi::CameraHandle& camera, uint32_t passes, const std::atomic<bool>* cancel = nullptr);
+
+    void resetAccumulation() { passCount = 0; }
+    uint32_t getPassCount() const { return passCount; }
+
+    // running average, RGBA floats top row first
+    const std::vector<float>& getPixels() const { return beauty; }
+    Eigen::Vector2i getResolution() const { return Eigen::Vector2i (width, height); }
+
+ private:
+    Settings settings;
+    CpuScenePtr scene = nullptr;
+    std::unique_ptr<BS::thread_pool> pool;
+
+    std::vector<float> beauty;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t passCount = 0;
+
+    // camera state the accumulation belongs to
+    Eigen::Matrix4f lastPose = Eigen::Matrix4f::Zero();
+    float lastFov = 0.0f;
+
+    bool cameraChanged (const sabi::CameraHandle& camera);
+    void renderTile (const sabi::CameraHandle& camera, uint32_t tileIndex, uint32_t tilesX);
+    RGBf tracePath (Eigen::Vector3f origin, Eigen::Vector3f dir, CpuShared::Pcg32& rng) const;
+};
@@ -0,0 +1,496 @@
+#include "CpuScene.h"
+
+using CpuShared::Pi;
+
+namespace
+{
+    float srgbToLinear (float c)
+    {
+        return c <= 0.04045f ? c / 12.92f : std::pow ((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    // RGBA float texels from any OIIO image, grey and grey-alpha images are expanded
+    bool readRGBA (const OIIO::ImageBuf& image, uint32_t* width, uint32_t* height, std::vector<float>& texels)
+    {
+        if (!image.initialized()) return false;
+
+        const OIIO::ImageSpec& spec = image.spec();
+        const int channels = spec.nchannels;
+        if (spec.width <= 0 || spec.height <= 0 || channels <= 0) return false;
+
+        std::vector<float> raw (static_cast<size_t> (spec.width) * spec.height * channels);
+        if (!image.get_pixels (OIIO::ROI (spec.x, spec.x + spec.width, spec.y, spec.y + spec.height, 0, 1, 0, channels),
+                               OIIO::TypeDesc::FLOAT, raw.data()))
+            return false;
+
+        const size_t count = static_cast<size_t> (spec.width) * spec.height;
+        texels.resize (count * 4);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float* src = &raw[i * channels];
+            float* dst = &texels[i * 4];
+            if (channels >= 3)
+            {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = channels >= 4 ? src[3] : 1.0f;
+            }
+            else
+            {
+                dst[0] = dst[1] = dst[2] = src[0];
+                dst[3] = channels == 2 ? src[1] : 1.0f;
+            }
+        }
+
+        *width = static_cast<uint32_t> (spec.width);
+        *height = static_cast<uint32_t> (spec.height);
+        return true;
+    }
+} // namespace
+
+Eigen::Vector4f CpuScene::Texture::sample (const Eigen::Vector2f& uv) const
+{
+    // bilinear with repeat wrapping, v runs down the image like glTF
+    const float x = (uv.x() - std::floor (uv.x())) * width - 0.5f;
+    const float y = (uv.y() - std::floor (uv.y())) * height - 0.5f;
+    const float fx = std::floor (x);
+    const float fy = std::floor (y);
+    const float wx = x - fx;
+    const float wy = y - fy;
+
+    auto wrap = [] (int i, uint32_t n)
+    { return static_cast<uint32_t> ((i % static_cast<int> (n) + static_cast<int> (n)) % static_cast<int> (n)); };
+
+    const uint32_t x0 = wrap (static_cast<int> (fx), width);
+    const uint32_t x1 = wrap (static_cast<int> (fx) + 1, width);
+    const uint32_t y0 = wrap (static_cast<int> (fy), height);
+    const uint32_t y1 = wrap (static_cast<int> (fy) + 1, height);
+
+    auto texel = [&] (uint32_t tx, uint32_t ty)
+    { return Eigen::Map<const Eigen::Vector4f> (&texels[(static_cast<size_t> (ty) * width + tx) * 4]); };
+
+    const Eigen::Vector4f top = texel (x0, y0) * (1.0f - wx) + texel (x1, y0) * wx;
+    const Eigen::Vector4f bottom = texel (x0, y1) * (1.0f - wx) + texel (x1, y1) * wx;
+    return top * (1.0f - wy) + bottom * wy;
+}
+
+void CpuScene::clear()
+{
+    positions.clear();
+    normals.clear();
+    uvs.clear();
+    triangles.clear();
+    materials.clear();
+    textures.clear();
+    textureLookup.clear();
+    bvh.clear();
+    lightTriangles.clear();
+    lightCDF.clear();
+    lightPickProb.clear();
+    lightPower = 0.0f;
+}
+
+int CpuScene::importTexture (const sabi::CgModelPtr& model, const std::optional<sabi::CgTextureInfo>& info, bool sRGB)
+{
+    if (!info || info->textureIndex >= model->cgTextures.size()) return -1;
+
+    const sabi::CgTexture& texture = model->cgTextures[info->textureIndex];
+    if (!texture.imageIndex || *texture.imageIndex >= model->cgImages.size()) return -1;
+
+    const auto key = std::make_pair (static_cast<const void*> (model.get()), *texture.imageIndex);
+    if (auto it = textureLookup.find (key); it != textureLookup.end()) return it->second;
+
+    const sabi::CgImage& image = model->cgImages[*texture.imageIndex];
+    const sabi::CgPixelsPtr pixels = image.pixels();
+    Texture decoded;
+    if (!pixels || !readRGBA (*pixels, &decoded.width, &decoded.height, decoded.texels))
+    {
+        LOG (WARNING) << "CpuScene could not read texture " << image.uri;
+        textureLookup[key] = -1;
+        return -1;
+    }
+
+    // 8 bit color textures are sRGB encoded, float images are already linear
+    if (sRGB && pixels->spec().format.basetype == OIIO::TypeDesc::UINT8)
+    {
+        for (size_t i = 0; i < decoded.texels.size(); i += 4)
+            for (size_t c = 0; c < 3; ++c)
+                decoded.texels[i + c] = srgbToLinear (decoded.texels[i + c]);
+    }
+
+    const int index = static_cast<int> (textures.size());
+    textures.push_back (std::move (decoded));
+    textureLookup[key] = index;
+    return index;
+}
+
+void CpuScene::addRenderable (const sabi::RenderableNode& node)
+{
+    if (!node) return;
+
+    sabi::CgModelPtr model = node->getModel();
+    if (!model)
+    {
+        sabi::RenderableNode source = node->getInstancedFrom();
+        if (source) model = source->getModel();
+    }
+    if (!model || model->V.cols() == 0) return;
+
+    const Eigen::Affine3f& xform = node->getSpaceTime().worldTransform;
+    const Eigen::Matrix3f normalXform = xform.linear().inverse().transpose();
+
+    const uint32_t base = static_cast<uint32_t> (positions.size());
+    const Eigen::Index vertexCount = model->V.cols();
+    const bool hasNormals = model->N.cols() == vertexCount && model->N.rows() == 3;
+    const bool hasUVs = model->UV0.cols() == vertexCount && model->UV0.rows() == 2;
+
+    positions.reserve (positions.size() + vertexCount);
+    normals.reserve (normals.size() + vertexCount);
+    uvs.reserve (uvs.size() + vertexCount);
+    for (Eigen::Index i = 0; i < vertexCount; ++i)
+    {
+        positions.push_back (xform * Eigen::Vector3f (model->V.col (i)));
+        normals.push_back (hasNormals ? Eigen::Vector3f ((normalXform * Eigen::Vector3f (model->N.col (i))).normalized())
+                                      : Eigen::Vector3f (Eigen::Vector3f::Zero()));
+        uvs.push_back (hasUVs ? Eigen::Vector2f (model->UV0.col (i)) : Eigen::Vector2f (Eigen::Vector2f::Zero()));
+    }
+
+    for (const sabi::CgModelSurface& surface : model->S)
+    {
+        const sabi::CgMaterial& cg = surface.cgMaterial;
+
+        Material material;
+        material.baseColor = cg.core.baseColor.array();
+        material.roughness = cg.core.roughness;
+        material.metallic = cg.metallic.metallic;
+        material.anisotropic = cg.metallic.anisotropic;
+        material.ior = cg.transparency.refractionIndex;
+        material.transparency = cg.transparency.transparency;
+        material.transmittance = 1.0f;
+        material.transmittanceDistance = cg.transparency.transmittanceDistance;
+        material.thinWalled = cg.transparency.thin;
+        material.emittance = cg.emission.luminous > 0.0f ? RGBf (cg.emission.luminousColor.array() * cg.emission.luminous) : RGBf (RGBf::Zero());
+        material.baseColorTexture = importTexture (model, cg.core.baseColorTexture, true);
+        material.roughnessTexture = importTexture (model, cg.core.roughnessTexture, false);
+        material.metallicTexture = importTexture (model, cg.metallic.metallicTexture, false);
+
+        const uint32_t materialID = static_cast<uint32_t> (materials.size());
+        materials.push_back (material);
+
+        for (Eigen::Index f = 0; f < surface.F.cols(); ++f)
+        {
+            if (static_cast<Eigen::Index> (surface.F.col (f).maxCoeff()) >= vertexCount) continue;
+
+            Triangle tri;
+            for (int k = 0; k < 3; ++k)
+                tri.v[k] = base + surface.F (k, f);
+
+            const Eigen::Vector3f& a = positions[tri.v[0]];
+            const Eigen::Vector3f& b = positions[tri.v[1]];
+            const Eigen::Vector3f& c = positions[tri.v[2]];
+            const Eigen::Vector3f cross = (b - a).cross (c - a);
+            const float length = cross.norm();
+            if (!(length > 0.0f) || !std::isfinite (length)) continue;
+
+            tri.normal = cross / length;
+            tri.area = 0.5f * length;
+            tri.materialID = materialID;
+
+            // flip the face normal to the side the vertex normals point to, emitters and
+            // ray offsets then agree with the modeled orientation even for mixed winding
+            if (hasNormals)
+            {
+                const Eigen::Vector3f average = normals[tri.v[0]] + normals[tri.v[1]] + normals[tri.v[2]];
+                if (average.dot (tri.normal) < 0.0f) tri.normal = -tri.normal;
+            }
+
+            triangles.push_back (tri);
+        }
+    }
+}
+
+void CpuScene::commit (BS::thread_pool* pool)
+{
+    std::vector<Eigen::Vector3f> v0 (triangles.size());
+    std::vector<Eigen::Vector3f> v1 (triangles.size());
+    std::vector<Eigen::Vector3f> v2 (triangles.size());
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        v0[i] = positions[triangles[i].v[0]];
+        v1[i] = positions[triangles[i].v[1]];
+        v2[i] = positions[triangles[i].v[2]];
+    }
+    bvh.build (v0, v1, v2, pool);
+
+    lightTriangles.clear();
+    lightCDF.clear();
+    lightPickProb.assign (triangles.size(), 0.0f);
+    lightPower = 0.0f;
+
+    std::vector<float> power;
+    for (uint32_t i = 0; i < triangles.size(); ++i)
+    {
+        const float emitted = CpuShared::luminance (materials[triangles[i].materialID].emittance);
+        if (emitted <= 0.0f) continue;
+
+        lightTriangles.push_back (i);
+        power.push_back (emitted * triangles[i].area);
+    }
+
+    if (!lightTriangles.empty())
+    {
+        double sum = 0.0;
+        lightCDF.resize (power.size() + 1);
+        for (size_t i = 0; i < power.size(); ++i)
+        {
+            lightCDF[i] = static_cast<float> (sum);
+            sum += power[i];
+        }
+        for (size_t i = 0; i < power.size(); ++i)
+        {
+            lightCDF[i] = static_cast<float> (lightCDF[i] / sum);
+            lightPickProb[lightTriangles[i]] = static_cast<float> (power[i] / sum);
+        }
+        lightCDF.back() = 1.0f;
+        lightPower = static_cast<float> (sum);
+    }
+
+    LOG (INFO) << "CpuScene: " << triangles.size() << " triangles, " << materials.size() << " materials, "
+               << textures.size() << " textures, " << lightTriangles.size() << " emissive triangles";
+}
+
+bool CpuScene::setEnvironment (const std::filesystem::path& hdrPath)
+{
+    OIIO::ImageBuf image (hdrPath.generic_string());
+    if (!image.read (0, 0, true, OIIO::TypeDesc::FLOAT))
+    {
+        LOG (WARNING) << "Could not read environment " << hdrPath.generic_string() << ": " << image.geterror();
+        return false;
+    }
+    return setEnvironment (image);
+}
+
+bool CpuScene::setEnvironment (const OIIO::ImageBuf& image)
+{
+    Texture map;
+    if (!readRGBA (image, &map.width, &map.height, map.texels))
+        return false;
+
+    envMap = std::move (map);
+    envImportance.build (envMap.texels.data(), envMap.width, envMap.height, 4);
+    envMode = EnvMode::Map;
+    return true;
+}
+
+void CpuScene::setEnvironmentColor (const RGBf& color)
+{
+    envColor = color;
+    envMap = Texture();
+    envImportance.clear();
+    envMode = (color > 0.0f).any() ? EnvMode::Constant : EnvMode::None;
+}
+
+void CpuScene::clearEnvironment()
+{
+    envMode = EnvMode::None;
+    envMap = Texture();
+    envImportance.clear();
+}
+
+bool CpuScene::intersect (const Eigen::Vector3f& origin, const Eigen::Vector3f& dir, float tMax, SurfaceHit* hit) const
+{
+    Bvh4::Hit h;
+    if (!bvh.intersect (origin, dir, tMax, &h)) return false;
+
+    const Triangle& tri = triangles[h.primID];
+    const float w = 1.0f - h.u - h.v;
+
+    hit->t = h.t;
+    hit->primID = h.primID;
+    hit->materialID = tri.materialID;
+    hit->position = w * positions[tri.v[0]] + h.u * positions[tri.v[1]] + h.v * positions[tri.v[2]];
+    hit->geometricNormal = tri.normal;
+    hit->uv = w * uvs[tri.v[0]] + h.u * uvs[tri.v[1]] + h.v * uvs[tri.v[2]];
+
+    const Eigen::Vector3f shading = w * normals[tri.v[0]] + h.u * normals[tri.v[1]] + h.v * normals[tri.v[2]];
+    const float length = shading.norm();
+    hit->shadingNormal = length > 1e-6f ? Eigen::Vector3f (shading / length) : tri.normal;
+
+    return true;
+}
+
+HostDisneyData CpuScene::evaluateMaterial (uint32_t materialID, const Eigen::Vector2f& uv) const
+{
+    const Material& m = materials[materialID];
+
+    HostDisneyData data;
+    data.baseColor = m.baseColor;
+    data.metallic = m.metallic;
+    data.roughness = m.roughness;
+    data.anisotropic = m.anisotropic;
+    data.ior = m.ior;
+    data.transparency = m.transparency;
+    data.transmittance = m.transmittance;
+    data.transmittanceDistance = m.transmittanceDistance;
+    data.thinWalled = m.thinWalled;
+    data.emittance = m.emittance;
+
+    // textures multiply the factors like glTF does
+    if (m.baseColorTexture >= 0)
+    {
+        const Eigen::Vector4f texel = textures[m.baseColorTexture].sample (uv);
+        data.baseColor *= RGBf (texel.x(), texel.y(), texel.z());
+    }
+    if (m.roughnessTexture >= 0)
+        data.roughness *= textures[m.roughnessTexture].sample (uv).y();
+    if (m.metallicTexture >= 0)
+        data.metallic *= textures[m.metallicTexture].sample (uv).z();
+
+    return data;
+}
+
+float CpuScene::environmentSelectProb() const
+{
+    if (!hasEnvironment()) return 0.0f;
+    return hasMeshLights() ? CpuShared::probToSampleEnvLight : 1.0f;
+}
+
+bool CpuScene::sampleLight (float uSelect, float u0, float u1, LightSample* sample) const
+{
+    const float envProb = environmentSelectProb();
+    if (envProb <= 0.0f && !hasMeshLights()) return false;
+
+    bool ok;
+    if (uSelect < envProb)
+    {
+        ok = sampleEnvironment (u0, u1, sample);
+        sample->pdf *= envProb;
+    }
+    else
+    {
+        const float uLight = envProb > 0.0f ? (uSelect - envProb) / (1.0f - envProb) : uSelect;
+        ok = sampleMeshLight (uLight, u0, u1, sample);
+        sample->pdf *= 1.0f - envProb;
+    }
+
+    return ok && sample->pdf > 0.0f;
+}
+
+bool CpuScene::sampleMeshLight (float uSelect, float u0, float u1, LightSample* sample) const
+{
+    if (lightTriangles.empty()) return false;
+
+    const auto it = std::upper_bound (lightCDF.begin(), lightCDF.end() - 1, uSelect);
+    const size_t index = std::min<size_t> (std::max<ptrdiff_t> (it - lightCDF.begin() - 1, 0), lightTriangles.size() - 1);
+    const uint32_t primID = lightTriangles[index];
+    const Triangle& tri = triangles[primID];
+
+    // uniform point on the triangle
+    const float su = std::sqrt (u0);
+    const float b0 = 1.0f - su;
+    const float b1 = su * (1.0f - u1);
+    const float b2 = su * u1;
+
+    sample->position = b0 * positions[tri.v[0]] + b1 * positions[tri.v[1]] + b2 * positions[tri.v[2]];
+    sample->normal = tri.normal;
+    sample->radiance = materials[tri.materialID].emittance * CpuShared::InvPi;
+    sample->pdf = lightPickProb[primID] / tri.area;
+    sample->atInfinity = false;
+    return true;
+}
+
+float CpuScene::meshLightPDF (uint32_t primID) const
+{
+    if (primID >= lightPickProb.size()) return 0.0f;
+    return (1.0f - environmentSelectProb()) * lightPickProb[primID] / triangles[primID].area;
+}
+
+RGBf CpuScene::envTexel (float u, float v) const
+{
+    const uint32_t x = std::min (static_cast<uint32_t> (u * envMap.width), envMap.width - 1);
+    const uint32_t y = std::min (static_cast<uint32_t> (v * envMap.height), envMap.height - 1);
+    const float* t = &envMap.texels[(static_cast<size_t> (y) * envMap.width + x) * 4];
+    return RGBf (t[0], t[1], t[2]);
+}
+
+RGBf CpuScene::environmentRadiance (const Eigen::Vector3f& dir) const
+{
+    switch (envMode)
+    {
+        case EnvMode::Constant:
+            return envColor * envIntensity;
+
+        case EnvMode::Map:
+        {
+            float phi, theta;
+            CpuShared::toPolarYUp (dir, &phi, &theta);
+            phi += envRotation;
+            phi -= std::floor (phi / (2.0f * Pi)) * 2.0f * Pi;
+            return envTexel (phi / (2.0f * Pi), theta / Pi) * envIntensity;
+        }
+
+        default:
+            return RGBf::Zero();
+    }
+}
+
+float CpuScene::environmentPDF (const Eigen::Vector3f& dir) const
+{
+    const float selectProb = environmentSelectProb();
+    switch (envMode)
+    {
+        case EnvMode::Constant:
+            return selectProb / (4.0f * Pi);
+
+        case EnvMode::Map:
+        {
+            float phi, theta;
+            CpuShared::toPolarYUp (dir, &phi, &theta);
+            const float sinTheta = std::sin (theta);
+            if (sinTheta <= 0.0f) return 0.0f;
+
+            phi += envRotation;
+            phi -= std::floor (phi / (2.0f * Pi)) * 2.0f * Pi;
+            const float uvPDF = envImportance.evaluatePDF (phi / (2.0f * Pi), theta / Pi);
+            return selectProb * uvPDF / (2.0f * Pi * Pi * sinTheta);
+        }
+
+        default:
+            return 0.0f;
+    }
+}
+
+bool CpuScene::sampleEnvironment (float u0, float u1, LightSample* sample) const
+{
+    sample->atInfinity = true;
+
+    if (envMode == EnvMode::Constant)
+    {
+        // uniform sphere
+        const float z = 1.0f - 2.0f * u0;
+        const float r = std::sqrt (std::max (0.0f, 1.0f - z * z));
+        const float phi = 2.0f * Pi * u1;
+        sample->position = Eigen::Vector3f (r * std::cos (phi), r * std::sin (phi), z);
+        sample->normal = -sample->position;
+        sample->radiance = envColor * envIntensity;
+        sample->pdf = 1.0f / (4.0f * Pi);
+        return true;
+    }
+
+    if (envMode != EnvMode::Map || envImportance.empty()) return false;
+
+    float d0, d1, uvPDF;
+    envImportance.sample (u0, u1, &d0, &d1, &uvPDF);
+
+    const float theta = d1 * Pi;
+    const float sinTheta = std::sin (theta);
+    if (sinTheta <= 0.0f || !(uvPDF > 0.0f)) return false;
+
+    const float phi = d0 * 2.0f * Pi - envRotation;
+    sample->position = CpuShared::fromPolarYUp (phi, theta);
+    sample->normal = -sample->position;
+    sample->radiance = envTexel (d0, d1) * envIntensity;
+    sample->pdf = uvPDF / (2.0f * Pi * Pi * sinTheta);
+    return true;
+}
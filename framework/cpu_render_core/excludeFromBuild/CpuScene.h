@@ -0,0 +1,164 @@
+#pragma once
+
+// CpuScene flattens RenderableNodes into world space triangles for the CPU path tracer.
+//
+// - Every surface of every CgModel is baked with its node's world transform, vertex
+//   normals and UV0 are kept when the model has them
+// - CgMaterials are reduced to the inputs HostDisneyPrincipled needs, base color and
+//   metallic/roughness textures are decoded once into linear float texels
+// - Triangles whose material has luminous > 0 become mesh lights, picked in proportion
+//   to area times emitted luminance
+// - The environment is an equirectangular map (or a constant color) importance sampled
+//   with the same EnvImportanceMap the GPU renderer builds
+//
+// Edits are not tracked, call clear(), add the nodes again and commit() after a change.
+
+#include "Bvh4.h"
+#include "HostPrincipledDisney.h"
+
+using CpuScenePtr = std::shared_ptr<class CpuScene>;
+
+class CpuScene
+{
+ public:
+    static CpuScenePtr create() { return std::make_shared<CpuScene>(); }
+
+    struct SurfaceHit
+    {
+        Eigen::Vector3f position;
+        Eigen::Vector3f geometricNormal; // oriented to agree with the vertex normals
+        Eigen::Vector3f shadingNormal;
+        Eigen::Vector2f uv;
+        uint32_t primID = Bvh4::InvalidID;
+        uint32_t materialID = 0;
+        float t = 0.0f;
+    };
+
+    struct LightSample
+    {
+        Eigen::Vector3f position; // direction when atInfinity
+        Eigen::Vector3f normal;
+        RGBf radiance = RGBf::Zero();
+        float pdf = 0.0f; // area density for mesh lights, solid angle density for the environment
+        bool atInfinity = false;
+    };
+
+    CpuScene() = default;
+    ~CpuScene() = default;
+
+    void clear();
+
+    // bakes the node's model, instances use the model they were instanced from
+    void addRenderable (const sabi::RenderableNode& node);
+
+    // builds the BVH and the light distribution, call once after adding nodes
+    void commit (BS::thread_pool* pool = nullptr);
+
+    // equirectangular HDR, false if the file can not be read
+    bool setEnvironment (const std::filesystem::path& hdrPath);
+    bool setEnvironment (const OIIO::ImageBuf& image);
+    void setEnvironmentColor (const RGBf& color);
+    void clearEnvironment();
+
+    // scale and rotation about +y in radians, the same knobs the GPU renderer exposes
+    void setEnvironmentIntensity (float intensity) { envIntensity = intensity; }
+    void setEnvironmentRotation (float radians) { envRotation = radians; }
+
+    bool intersect (const Eigen::Vector3f& origin, const Eigen::Vector3f& dir, float tMax, SurfaceHit* hit) const;
+    bool occluded (const Eigen::Vector3f& origin, const Eigen::Vector3f& dir, float tMax) const
+    {
+        return bvh.occluded (origin, dir, tMax);
+    }
+
+    HostDisneyData evaluateMaterial (uint32_t materialID, const Eigen::Vector2f& uv) const;
+
+    // lights
+    bool hasEnvironment() const { return envMode != EnvMode::None; }
+    bool hasMeshLights() const { return !lightCDF.empty(); }
+    float environmentSelectProb() const;
+
+    // picks a light type with 'uSelect' and samples it, pdf includes the selection probability
+    bool sampleLight (float uSelect, float u0, float u1, LightSample* sample) const;
+
+    // radiance seen along a ray that left the scene, and its light sampling density
+    RGBf environmentRadiance (const Eigen::Vector3f& dir) const;
+    float environmentPDF (const Eigen::Vector3f& dir) const;
+
+    // area density of hitting 'primID' through sampleLight()
+    float meshLightPDF (uint32_t primID) const;
+
+    size_t triangleCount() const { return triangles.size(); }
+    size_t meshLightCount() const { return lightTriangles.size(); }
+    const Eigen::AlignedBox3f& bounds() const { return bvh.bounds(); }
+
+ private:
+    struct Triangle
+    {
+        uint32_t v[3];
+        uint32_t materialID;
+        Eigen::Vector3f normal; // unit geometric normal
+        float area;
+    };
+
+    struct Texture
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<float> texels; // RGBA, linear
+
+        Eigen::Vector4f sample (const Eigen::Vector2f& uv) const;
+    };
+
+    struct Material
+    {
+        RGBf baseColor = RGBf::Constant (0.5f);
+        float metallic = 0.0f;
+        float roughness = 0.5f;
+        float anisotropic = 0.0f;
+        float ior = 1.5f;
+        float transparency = 0.0f;
+        float transmittance = 1.0f;
+        float transmittanceDistance = 1.0f;
+        bool thinWalled = false;
+        RGBf emittance = RGBf::Zero();
+        int baseColorTexture = -1;
+        int roughnessTexture = -1; // glTF metallic/roughness, roughness in G
+        int metallicTexture = -1;  // metallic in B
+    };
+
+    enum class EnvMode
+    {
+        None,
+        Constant,
+        Map
+    };
+
+    std::vector<Eigen::Vector3f> positions;
+    std::vector<Eigen::Vector3f> normals; // empty entries are zero, the face normal is used instead
+    std::vector<Eigen::Vector2f> uvs;
+    std::vector<Triangle> triangles;
+    std::vector<Material> materials;
+    std::vector<Texture> textures;
+    std::map<std::pair<const void*, size_t>, int> textureLookup;
+
+    Bvh4 bvh;
+
+    // mesh lights
+    std::vector<uint32_t> lightTriangles;
+    std::vector<float> lightCDF; // lightTriangles.size() + 1 entries
+    std::vector<float> lightPickProb; // per triangle, zero for non emitters
+    float lightPower = 0.0f;
+
+    // environment
+    EnvMode envMode = EnvMode::None;
+    RGBf envColor = RGBf::Zero();
+    Texture envMap;
+    EnvImportanceMap envImportance;
+    float envIntensity = 1.0f;
+    float envRotation = 0.0f;
+
+    int importTexture (const sabi::CgModelPtr& model, const std::optional<sabi::CgTextureInfo>& info, bool sRGB);
+    bool sampleMeshLight (float uSelect, float u0, float u1, LightSample* sample) const;
+    bool sampleEnvironment (float u0, float u1, LightSample* sample) const;
+    RGBf envTexel (float u, float v) const;
+};
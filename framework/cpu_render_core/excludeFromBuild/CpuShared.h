@@ -0,0 +1,104 @@
+#pragma once
+
+// Small host side types shared by the CPU path tracer.
+// Colors are Eigen arrays so component wise products read like the device RGB type,
+// directions are plain Vector3f.
+
+using RGBf = Eigen::Array3f;
+
+namespace CpuShared
+{
+    static constexpr float Pi = std::numbers::pi_v<float>;
+    static constexpr float InvPi = 1.0f / Pi;
+
+    // same split as DogShared::probToSampleEnvLight
+    static constexpr float probToSampleEnvLight = 0.25f;
+
+    inline float luminance (const RGBf& c) { return 0.2126729f * c.x() + 0.7151522f * c.y() + 0.0721750f * c.z(); }
+
+    inline float pow2 (float x) { return x * x; }
+
+    // power heuristic with beta 2, matches the device MIS weights
+    inline float misWeight (float pdfA, float pdfB)
+    {
+        const float a2 = pow2 (pdfA);
+        const float b2 = pow2 (pdfB);
+        return a2 + b2 > 0.0f ? a2 / (a2 + b2) : 0.0f;
+    }
+
+    // phi in the x-z plane, theta from +y, same convention as the device toPolarYUp
+    inline Eigen::Vector3f fromPolarYUp (float phi, float theta)
+    {
+        const float sinTheta = std::sin (theta);
+        return Eigen::Vector3f (-std::sin (phi) * sinTheta, std::cos (theta), std::cos (phi) * sinTheta);
+    }
+
+    inline void toPolarYUp (const Eigen::Vector3f& v, float* phi, float* theta)
+    {
+        *theta = std::acos (std::clamp (v.y(), -1.0f, 1.0f));
+        *phi = std::fmod (std::atan2 (-v.x(), v.z()) + 2.0f * Pi, 2.0f * Pi);
+    }
+
+    // Orthonormal shading frame, local z is the normal
+    struct Frame
+    {
+        Eigen::Vector3f t;
+        Eigen::Vector3f b;
+        Eigen::Vector3f n;
+
+        explicit Frame (const Eigen::Vector3f& normal) :
+            n (normal)
+        {
+            // Duff et al. 2017, branchless and continuous away from the pole
+            const float sign = std::copysign (1.0f, n.z());
+            const float a = -1.0f / (sign + n.z());
+            const float c = n.x() * n.y() * a;
+            t = Eigen::Vector3f (1.0f + sign * n.x() * n.x() * a, sign * c, -sign * n.x());
+            b = Eigen::Vector3f (c, sign + n.y() * n.y() * a, -n.y());
+        }
+
+        Eigen::Vector3f toLocal (const Eigen::Vector3f& v) const { return Eigen::Vector3f (v.dot (t), v.dot (b), v.dot (n)); }
+        Eigen::Vector3f fromLocal (const Eigen::Vector3f& v) const { return t * v.x() + b * v.y() + n * v.z(); }
+    };
+
+    // PCG32, the same generator the device path tracer keeps per pixel
+    class Pcg32
+    {
+     public:
+        Pcg32() = default;
+        Pcg32 (uint64_t seed, uint64_t stream) { setState (seed, stream); }
+
+        void setState (uint64_t seed, uint64_t stream)
+        {
+            state = 0u;
+            inc = (stream << 1u) | 1u;
+            next();
+            state += seed;
+            next();
+        }
+
+        uint32_t next()
+        {
+            const uint64_t old = state;
+            state = old * 6364136223846793005ULL + inc;
+            const uint32_t xorShifted = static_cast<uint32_t> (((old >> 18u) ^ old) >> 27u);
+            const uint32_t rot = static_cast<uint32_t> (old >> 59u);
+            return (xorShifted >> rot) | (xorShifted << ((~rot + 1u) & 31));
+        }
+
+        // [0, 1)
+        float getFloat0cTo1o() { return static_cast<float> (next() >> 8) * 0x1.0p-24f; }
+
+     private:
+        uint64_t state = 0x853c49e6748fea9bULL;
+        uint64_t inc = 0xda3e39cb94b95bdbULL;
+    };
+
+    // offsets a ray origin off the surface along the geometric normal, scale aware
+    inline Eigen::Vector3f offsetRayOrigin (const Eigen::Vector3f& p, const Eigen::Vector3f& n)
+    {
+        const float scale = 1e-4f * std::max (1.0f, p.cwiseAbs().maxCoeff());
+        return p + n * scale;
+    }
+
+} // namespace CpuShared
@@ -0,0 +1,427 @@
+#pragma once
+
+// Host port of dog_core's cuda/principledDisney.h and the mx_core.h helpers it uses.
+//
+// The lobes, Fresnel terms and glass handling follow the device code line for line so
+// a CPU render can be compared against the GPU one. Where the device code takes
+// shortcuts that only work inside its own kernels the port is made self consistent,
+// otherwise the reference would not converge:
+// - evaluate() and sample() use the same lobe for a given material, metals use the
+//   evaluateMetallic() BRDF for both next event estimation and BSDF sampling
+// - sample() returns f * cos / pdf, the device returns the BRDF value and lets the
+//   kernel skip the division
+// - the dielectric pdf is the mixture of the GGX VNDF and cosine lobes that sample()
+//   actually draws from
+// - glass is a delta BSDF, evaluate() and evaluatePDF() return zero for it and the
+//   renderer skips next event estimation on glass hits
+
+#include "CpuShared.h"
+
+namespace hostmx
+{
+    static constexpr float FLOAT_EPS = 1e-5f;
+
+    inline float square (float x) { return x * x; }
+    inline float pow5 (float x) { return x * x * x * x * x; }
+    inline float mix (float x, float y, float a) { return x + (y - x) * a; }
+    inline RGBf mix (const RGBf& x, const RGBf& y, float a) { return x + (y - x) * a; }
+
+    inline Eigen::Vector3f reflect (const Eigen::Vector3f& I, const Eigen::Vector3f& N) { return I - 2.0f * N.dot (I) * N; }
+
+    inline RGBf fresnelSchlick (float cosTheta, const RGBf& F0)
+    {
+        const float x5 = pow5 (std::clamp (1.0f - cosTheta, 0.0f, 1.0f));
+        return F0 + (RGBf::Ones() - F0) * x5;
+    }
+
+    inline float fresnelDielectric (float cosTheta, float ior)
+    {
+        const float c = cosTheta;
+        const float g2 = ior * ior + c * c - 1.0f;
+        if (g2 < 0.0f)
+            return 1.0f;
+
+        const float g = std::sqrt (g2);
+        return 0.5f * square ((g - c) / (g + c)) *
+               (1.0f + square (((g + c) * c - 1.0f) / ((g - c) * c + 1.0f)));
+    }
+
+    // Fresnel for the glass lobes, same as the device fresnel()
+    inline float fresnel (float etaEnter, float etaExit, float cosEnter)
+    {
+        const float sinExit = etaEnter / etaExit * std::sqrt (std::fmax (0.0f, 1.0f - cosEnter * cosEnter));
+        if (sinExit >= 1.0f)
+            return 1.0f;
+
+        const float cosExit = std::sqrt (std::fmax (0.0f, 1.0f - sinExit * sinExit));
+        const float Rparl = ((etaExit * cosEnter) - (etaEnter * cosExit)) / ((etaExit * cosEnter) + (etaEnter * cosExit));
+        const float Rperp = ((etaEnter * cosEnter) - (etaExit * cosExit)) / ((etaEnter * cosEnter) + (etaExit * cosExit));
+        return (Rparl * Rparl + Rperp * Rperp) / 2.0f;
+    }
+
+    inline void concentricSampleDisk (float u1, float u2, float* dx, float* dy)
+    {
+        const float sx = 2.0f * u1 - 1.0f;
+        const float sy = 2.0f * u2 - 1.0f;
+        if (sx == 0.0f && sy == 0.0f)
+        {
+            *dx = 0.0f;
+            *dy = 0.0f;
+            return;
+        }
+
+        float r, theta;
+        if (sx >= -sy)
+        {
+            if (sx > sy)
+            {
+                r = sx;
+                theta = sy / sx;
+            }
+            else
+            {
+                r = sy;
+                theta = 2.0f - sx / sy;
+            }
+        }
+        else
+        {
+            if (sx <= sy)
+            {
+                r = -sx;
+                theta = 4.0f + sy / sx;
+            }
+            else
+            {
+                r = -sy;
+                theta = 6.0f - sx / sy;
+            }
+        }
+
+        theta *= CpuShared::Pi / 4.0f;
+        *dx = r * std::cos (theta);
+        *dy = r * std::sin (theta);
+    }
+
+    inline Eigen::Vector3f cosineSampleHemisphere (float u1, float u2)
+    {
+        float x, y;
+        concentricSampleDisk (u1, u2, &x, &y);
+        return Eigen::Vector3f (x, y, std::sqrt (std::max (0.0f, 1.0f - x * x - y * y)));
+    }
+
+    inline Eigen::Vector2f roughnessAnisotropy (float roughness, float anisotropy)
+    {
+        const float roughnessSqr = std::clamp (roughness * roughness, FLOAT_EPS, 1.0f);
+        if (anisotropy > 0.0f)
+        {
+            const float aspect = std::sqrt (1.0f - std::clamp (anisotropy, 0.0f, 0.98f));
+            return Eigen::Vector2f (std::min (roughnessSqr / aspect, 1.0f), roughnessSqr * aspect);
+        }
+        return Eigen::Vector2f (roughnessSqr, roughnessSqr);
+    }
+
+    inline float ggxNDF (const Eigen::Vector3f& H, const Eigen::Vector2f& alpha)
+    {
+        const float denom = std::max (H.x() * H.x() / square (alpha.x()) + H.y() * H.y() / square (alpha.y()) + H.z() * H.z(), 1e-7f);
+        return 1.0f / (CpuShared::Pi * alpha.x() * alpha.y() * denom * denom);
+    }
+
+    inline float ggxSmithG1 (float cosTheta, float alpha)
+    {
+        const float cosTheta2 = square (cosTheta);
+        const float tanTheta2 = (1.0f - cosTheta2) / cosTheta2;
+        return 2.0f / (1.0f + std::sqrt (1.0f + square (alpha) * tanTheta2));
+    }
+
+    // anisotropic G1, the exact normalization of the VNDF that ggxImportanceSampleVNDF draws from
+    inline float ggxSmithG1 (const Eigen::Vector3f& V, const Eigen::Vector2f& alpha)
+    {
+        const float z2 = square (V.z());
+        if (z2 <= 0.0f) return 0.0f;
+        const float a2tan2 = (square (alpha.x() * V.x()) + square (alpha.y() * V.y())) / z2;
+        return 2.0f / (1.0f + std::sqrt (1.0f + a2tan2));
+    }
+
+    inline float ggxSmithG2 (float NdotL, float NdotV, float alpha)
+    {
+        const float alpha2 = square (alpha);
+        const float lambdaL = std::sqrt (alpha2 + (1.0f - alpha2) * square (NdotL));
+        const float lambdaV = std::sqrt (alpha2 + (1.0f - alpha2) * square (NdotV));
+        return 2.0f / (lambdaL / NdotL + lambdaV / NdotV);
+    }
+
+    inline float averageAlpha (const Eigen::Vector2f& alpha) { return std::sqrt (alpha.x() * alpha.y()); }
+
+    inline float iorToF0 (float ior) { return square ((ior - 1.0f) / (ior + 1.0f)); }
+
+    inline Eigen::Vector3f ggxImportanceSampleVNDF (const Eigen::Vector2f& Xi, const Eigen::Vector3f& V, const Eigen::Vector2f& alpha)
+    {
+        const Eigen::Vector3f Vh = Eigen::Vector3f (alpha.x() * V.x(), alpha.y() * V.y(), V.z()).normalized();
+
+        const float lensq = Vh.x() * Vh.x() + Vh.y() * Vh.y();
+        const Eigen::Vector3f T1 = lensq > 0.0f ? Eigen::Vector3f (Eigen::Vector3f (-Vh.y(), Vh.x(), 0.0f) / std::sqrt (lensq)) : Eigen::Vector3f::UnitX();
+        const Eigen::Vector3f T2 = Vh.cross (T1);
+
+        const float r = std::sqrt (Xi.x());
+        const float phi = 2.0f * CpuShared::Pi * Xi.y();
+        const float t1 = r * std::cos (phi);
+        float t2 = r * std::sin (phi);
+        const float s = 0.5f * (1.0f + Vh.z());
+        t2 = (1.0f - s) * std::sqrt (1.0f - t1 * t1) + s * t2;
+
+        const Eigen::Vector3f Nh = t1 * T1 + t2 * T2 + std::sqrt (std::max (0.0f, 1.0f - t1 * t1 - t2 * t2)) * Vh;
+        return Eigen::Vector3f (alpha.x() * Nh.x(), alpha.y() * Nh.y(), std::max (0.0f, Nh.z())).normalized();
+    }
+
+    inline RGBf ggxEnergyCompensation (float NdotV, float alpha, const RGBf& F0)
+    {
+        float Eavg = 0.0f;
+        if (alpha > 0.0f)
+        {
+            const float E = std::min (std::exp2 (-10.23f * NdotV * alpha) - std::exp2 (-10.23f * alpha), 1.0f);
+            Eavg = 1.0f - E;
+        }
+        return RGBf::Ones() + F0 * (1.0f / Eavg - 1.0f);
+    }
+
+} // namespace hostmx
+
+// Material inputs at a shading point, the host equivalent of the DisneyData texture reads
+struct HostDisneyData
+{
+    RGBf baseColor = RGBf::Constant (0.5f);
+    float metallic = 0.0f;
+    float roughness = 0.5f;
+    float anisotropic = 0.0f;
+    float ior = 1.5f;
+    float transparency = 0.0f;
+    float transmittance = 1.0f;
+    float transmittanceDistance = 1.0f;
+    bool thinWalled = false;
+    RGBf emittance = RGBf::Zero();
+};
+
+class HostDisneyPrincipled
+{
+ public:
+    struct Sample
+    {
+        Eigen::Vector3f wi = Eigen::Vector3f::Zero();
+        RGBf weight = RGBf::Zero(); // f * cos / pdf
+        float pdf = 0.0f;           // solid angle density, 0 for delta lobes
+        bool delta = false;
+    };
+
+    explicit HostDisneyPrincipled (const HostDisneyData& data) :
+        baseColor (data.baseColor),
+        metallic (data.metallic),
+        roughness (std::clamp (data.roughness, 0.001f, 1.0f)),
+        ior (data.ior),
+        transparency (data.transparency),
+        transmittance (data.transmittance),
+        transmittanceDistance (data.transmittanceDistance),
+        thinWalled (data.thinWalled),
+        emittance (data.emittance)
+    {
+        alpha = hostmx::roughnessAnisotropy (roughness, data.anisotropic);
+    }
+
+    // glass is sampled but never evaluated, see the note at the top
+    bool isDelta() const { return metallic <= 0.0f && transparency > 0.0f; }
+
+    // diffuse emitter, radiance = emittance / pi on the front face
+    const RGBf& evaluateEmission() const { return emittance; }
+
+    // f * cos for wo and wi in the local shading frame
+    RGBf evaluate (const Eigen::Vector3f& wo, const Eigen::Vector3f& wi) const
+    {
+        if (isDelta() || wo.z() <= 0.0f || wi.z() <= 0.0f)
+            return RGBf::Zero();
+
+        return metallic > 0.0f ? evaluateMetallic (wo, wi) : evaluateDielectric (wo, wi);
+    }
+
+    float evaluatePDF (const Eigen::Vector3f& wo, const Eigen::Vector3f& wi) const
+    {
+        if (isDelta() || wo.z() <= 0.0f || wi.z() <= 0.0f)
+            return 0.0f;
+
+        const float specular = specularPDF (wo, wi);
+        if (metallic > 0.0f)
+            return specular;
+
+        const float specularProb = hostmx::mix (0.5f, 1.0f, metallic);
+        return specularProb * specular + (1.0f - specularProb) * wi.z() * CpuShared::InvPi;
+    }
+
+    bool sample (const Eigen::Vector3f& wo, float u0, float u1, Sample* s) const
+    {
+        if (isDelta())
+            return sampleGlass (wo, u0, s);
+
+        if (wo.z() <= 0.0f)
+            return false;
+
+        if (metallic > 0.0f)
+        {
+            const Eigen::Vector3f H = hostmx::ggxImportanceSampleVNDF (Eigen::Vector2f (u0, u1), wo, alpha);
+            s->wi = hostmx::reflect (-wo, H);
+        }
+        else
+        {
+            const float specularProb = hostmx::mix (0.5f, 1.0f, metallic);
+            if (u0 < specularProb)
+            {
+                const Eigen::Vector3f H = hostmx::ggxImportanceSampleVNDF (Eigen::Vector2f (u0 / specularProb, u1), wo, alpha);
+                s->wi = hostmx::reflect (-wo, H);
+            }
+            else
+            {
+                s->wi = hostmx::cosineSampleHemisphere ((u0 - specularProb) / (1.0f - specularProb), u1);
+            }
+        }
+
+        if (s->wi.z() <= 0.0f)
+            return false;
+
+        s->pdf = evaluatePDF (wo, s->wi);
+        if (!(s->pdf > 0.0f) || !std::isfinite (s->pdf))
+            return false;
+
+        s->weight = evaluate (wo, s->wi) / s->pdf;
+        s->delta = false;
+        return s->weight.allFinite();
+    }
+
+ private:
+    RGBf baseColor;
+    float metallic;
+    float roughness;
+    float ior;
+    float transparency;
+    float transmittance;
+    float transmittanceDistance;
+    bool thinWalled;
+    RGBf emittance;
+    Eigen::Vector2f alpha;
+
+    // density of a GGX VNDF reflection, D * G1(V) / (4 NdotV)
+    float specularPDF (const Eigen::Vector3f& wo, const Eigen::Vector3f& wi) const
+    {
+        const Eigen::Vector3f H = (wo + wi).normalized();
+        return hostmx::ggxNDF (H, alpha) * hostmx::ggxSmithG1 (wo, alpha) / (4.0f * wo.z());
+    }
+
+    // DisneyPrincipled::evaluateMetallic, times cos
+    RGBf evaluateMetallic (const Eigen::Vector3f& wo, const Eigen::Vector3f& wi) const
+    {
+        const Eigen::Vector3f H = (wo + wi).normalized();
+        const RGBf& F0 = baseColor;
+
+        const float NdotV = wo.z();
+        const float NdotL = wi.z();
+        const float HdotV = std::max (H.dot (wo), 0.0f);
+
+        RGBf F = hostmx::fresnelSchlick (HdotV, F0);
+        const float edgeFalloff = std::pow (1.0f - HdotV, 5.0f);
+        F *= 1.0f + edgeFalloff * 0.5f;
+
+        const float avgAlpha = hostmx::averageAlpha (alpha);
+        const float D = hostmx::ggxNDF (H, alpha);
+        const float G = hostmx::ggxSmithG2 (NdotL, NdotV, avgAlpha);
+        const RGBf energyCompensation = hostmx::ggxEnergyCompensation (NdotV, avgAlpha, F0);
+
+        return (F * D * G / (4.0f * NdotV * NdotL)) * energyCompensation * NdotL;
+    }
+
+    // the opaque branch of DisneyPrincipled::evaluate, GGX specular over Burley diffuse
+    RGBf evaluateDielectric (const Eigen::Vector3f& wo, const Eigen::Vector3f& wi) const
+    {
+        const Eigen::Vector3f H = (wo + wi).normalized();
+        const float NdotL = wi.z();
+        const float NdotV = wo.z();
+        const float VdotH = std::max (wo.dot (H), 0.0f);
+        const float LdotH = std::max (wi.dot (H), 0.0f);
+
+        const RGBf F0 = RGBf::Constant (std::max (hostmx::iorToF0 (ior), 0.04f));
+        const RGBf F = hostmx::fresnelSchlick (VdotH, F0);
+
+        const float avgAlpha = hostmx::averageAlpha (alpha);
+        const float D = hostmx::ggxNDF (H, alpha);
+        const float G = hostmx::ggxSmithG2 (NdotL, NdotV, avgAlpha);
+        const RGBf Fr = F * D * G / (4.0f * NdotV * NdotL);
+
+        const RGBf diffuseAlbedo = baseColor * (1.0f - metallic);
+        const float FL = hostmx::pow5 (1.0f - NdotL);
+        const float FV = hostmx::pow5 (1.0f - NdotV);
+        const float FD90 = 0.5f + 2.0f * LdotH * LdotH * avgAlpha;
+        const float FD = hostmx::mix (1.0f, FD90, FL) * hostmx::mix (1.0f, FD90, FV);
+        const RGBf Fd = diffuseAlbedo * FD * (RGBf::Ones() - F) * CpuShared::InvPi;
+
+        return (Fd + Fr) * NdotL;
+    }
+
+    // the transparency branch of DisneyPrincipled::sampleThroughput, weights already divided by the lobe probability
+    bool sampleGlass (const Eigen::Vector3f& wo, float u0, Sample* s) const
+    {
+        const bool entering = wo.z() >= 0.0f;
+        const float eEnter = entering ? 1.0f : ior;
+        const float eExit = entering ? ior : 1.0f;
+        const Eigen::Vector3f dirV = entering ? wo : Eigen::Vector3f (-wo);
+        const float cosTheta = std::abs (dirV.z());
+
+        s->pdf = 0.0f;
+        s->delta = true;
+
+        if (cosTheta == 0.0f)
+            return false;
+
+        const float F1 = hostmx::fresnel (eEnter, eExit, cosTheta);
+        const Eigen::Vector3f mirrored (-wo.x(), -wo.y(), wo.z());
+
+        if (thinWalled)
+        {
+            const float recRelIOR = eEnter / eExit;
+            const float sinInternal2 = recRelIOR * recRelIOR * (1.0f - cosTheta * cosTheta);
+            const float cosInternal = std::sqrt (std::fmax (0.0f, 1.0f - sinInternal2));
+            const float F2 = hostmx::fresnel (eExit, eEnter, cosInternal);
+
+            const float T12 = (1.0f - F1) * (1.0f - F2);
+            const float R12 = F1 + T12 * F2;
+
+            if (u0 < R12)
+            {
+                s->wi = mirrored;
+                s->weight = RGBf::Ones();
+                return true;
+            }
+
+            s->wi = -wo;
+            s->weight = RGBf::Constant (T12 / (1.0f - R12) * transparency);
+            if (cosTheta < 0.2f)
+                s->weight *= cosTheta * 5.0f;
+            return true;
+        }
+
+        if (u0 < F1)
+        {
+            s->wi = mirrored;
+            s->weight = RGBf::Ones();
+            return true;
+        }
+
+        const float recRelIOR = eEnter / eExit;
+        const float sinExit2 = recRelIOR * recRelIOR * (1.0f - dirV.z() * dirV.z());
+        if (sinExit2 >= 1.0f)
+            return false;
+
+        const float cosExit = std::sqrt (std::fmax (0.0f, 1.0f - sinExit2));
+        const Eigen::Vector3f refracted (recRelIOR * -dirV.x(), recRelIOR * -dirV.y(), -cosExit);
+        s->wi = entering ? refracted : Eigen::Vector3f (-refracted);
+
+        // Beer's law per interface like the device code, the radiance squeeze cancels against the pdf
+        s->weight = transparency * (-baseColor * transmittanceDistance).exp();
+        return true;
+    }
+};
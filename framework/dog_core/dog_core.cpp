@@ -26,6 +26,7 @@
 #include "excludeFromBuild/tools/GPUManager.cpp"
 #include "excludeFromBuild/tools/GPUMemoryMonitor.cpp"
 #include "excludeFromBuild/tools/GPUTimerManager.cpp"
+#include "excludeFromBuild/tools/TextureBaker.cpp"
 
 // cuda compiler NVCC
 #include "excludeFromBuild/nvcc/CudaCompiler.cpp"
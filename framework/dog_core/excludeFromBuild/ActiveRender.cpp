@@ -20,6 +20,11 @@ ActiveRender::~ActiveRender()
         stateThread.join();
 }
 
+sabi::SceneChangeJournalPtr ActiveRender::getSceneJournal()
+{
+    return impl->getSceneJournal();
+}
+
 // Start the state thread
 void ActiveRender::start()
 {
@@ -30,6 +35,7 @@ void ActiveRender::start()
 void ActiveRender::executeState()
 {
     LOG(DBUG) << "ActiveRender thread is starting up";
+    Tracer::setThreadName ("ActiveRender");
     
     state = &ActiveRender::waitingForMessages;
     
@@ -75,6 +81,24 @@ void ActiveRender::waitingForMessages()
                 state = &ActiveRender::addWeakNode; 
             })
 
+        .handle<QMS::addWeakNodeList>([&](QMS::addWeakNodeList const& msg)
+            {
+                weakNodes = msg.weakNodes;
+                state = &ActiveRender::addWeakNodeList; 
+            })
+
+        .handle<QMS::removeWeakNode>([&](QMS::removeWeakNode const& msg)
+            {
+                weakNode = msg.weakNode;
+                state = &ActiveRender::removeWeakNode; 
+            })
+
+        .handle<QMS::removeWeakNodeByID>([&](QMS::removeWeakNodeByID const& msg)
+            {
+                nodeID = msg.bodyID;
+                state = &ActiveRender::removeWeakNodeByID; 
+            })
+
         .handle<QMS::renderNextFrame>([&](QMS::renderNextFrame const& msg)
             { 
                 updateMotion = msg.updateMotion;
@@ -214,6 +238,78 @@ void ActiveRender::addWeakNode()
     state = &ActiveRender::waitingForMessages;
 }
 
+// State: addWeakNodeList
+void ActiveRender::addWeakNodeList()
+{
+    try
+    {
+        for (auto& node : weakNodes)
+        {
+            if (!node.expired())
+                impl->addRenderableNode(node);
+        }
+        weakNodes.clear();
+    }
+    catch (std::exception& e)
+    {
+        done();
+        LOG(WARNING) << e.what();
+        messengers.dreamer.send(QMS::onError(e.what() + std::string(" ActiveRender thread is shutting down")));
+    }
+    catch (...)
+    {
+        done();
+        LOG(WARNING) << "Caught unknown exception!";
+        messengers.dreamer.send(QMS::onError("Caught unknown exception!"));
+    }
+    state = &ActiveRender::waitingForMessages;
+}
+
+// State: removeWeakNode
+void ActiveRender::removeWeakNode()
+{
+    try
+    {
+        if (!weakNode.expired())
+            impl->removeRenderableNode(weakNode);
+    }
+    catch (std::exception& e)
+    {
+        done();
+        LOG(WARNING) << e.what();
+        messengers.dreamer.send(QMS::onError(e.what() + std::string(" ActiveRender thread is shutting down")));
+    }
+    catch (...)
+    {
+        done();
+        LOG(WARNING) << "Caught unknown exception!";
+        messengers.dreamer.send(QMS::onError("Caught unknown exception!"));
+    }
+    state = &ActiveRender::waitingForMessages;
+}
+
+// State: removeWeakNodeByID
+void ActiveRender::removeWeakNodeByID()
+{
+    try
+    {
+        impl->removeRenderableNodeByID(nodeID);
+    }
+    catch (std::exception& e)
+    {
+        done();
+        LOG(WARNING) << e.what();
+        messengers.dreamer.send(QMS::onError(e.what() + std::string(" ActiveRender thread is shutting down")));
+    }
+    catch (...)
+    {
+        done();
+        LOG(WARNING) << "Caught unknown exception!";
+        messengers.dreamer.send(QMS::onError("Caught unknown exception!"));
+    }
+    state = &ActiveRender::waitingForMessages;
+}
+
 // State: setEngine
 void ActiveRender::setEngine()
 {
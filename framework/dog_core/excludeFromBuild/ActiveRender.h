@@ -19,11 +19,15 @@ public:
     MsgSender getMessenger() { return incoming; }
     void done() { getMessenger().send (qms::clear_queue()); }
 
+    // lock free path for per frame edits like transforms that
+    // would otherwise flood the message queue
+    sabi::SceneChangeJournalPtr getSceneJournal();
+
 private:
     std::unique_ptr<Renderer> impl;
     
     // messaging
-    MsgReceiver incoming;
+    MsgReceiver incoming{"qms queue depth: Renderer"};
     
     // message arguments
     uint32_t frameNumber = 0;
@@ -35,6 +39,8 @@ private:
     ImageCacheHandlerPtr imageCache = nullptr;
     CameraHandle camera = nullptr;
     RenderableWeakRef weakNode;
+    WeakRenderableList weakNodes;
+    BodyID nodeID = INVALID_ID;
     std::string engineName;
     
     // state functions
@@ -46,6 +52,9 @@ private:
     void renderNextFrame();
     void addSkydomeHDR();
     void addWeakNode();
+    void addWeakNodeList();
+    void removeWeakNode();
+    void removeWeakNodeByID();
     void setEngine();
     
     // state thread function
@@ -118,12 +118,12 @@ void Renderer::initializeEngine (CameraHandle camera, ImageCacheHandlerPtr image
 {
     LOG (INFO) << "Renderer::initializeEngine - stub implementation";
 
-    std::filesystem::path resourceFolder = properties.renderProps->getVal<std::string> (RenderKey::ResourceFolder);
-    std::filesystem::path repoFolder = properties.renderProps->getVal<std::string> (RenderKey::RepoFolder);
+    std::filesystem::path resourceFolder = properties.getRender<RenderKey::ResourceFolder>();
+    std::filesystem::path repoFolder = properties.getRender<RenderKey::RepoFolder>();
 
     // Check build configuration for CUDA kernel compilation strategy
-    bool softwareReleaseMode = properties.renderProps->getVal<bool> (RenderKey::SoftwareReleaseMode);
-    bool embeddedPTX = properties.renderProps->getVal<bool> (RenderKey::UseEmbeddedPTX);
+    bool softwareReleaseMode = properties.getRender<RenderKey::SoftwareReleaseMode>();
+    bool embeddedPTX = properties.getRender<RenderKey::UseEmbeddedPTX>();
 
     // NB: Determine whether to compile CUDA kernels at runtime
     // Development workflow:
@@ -146,7 +146,7 @@ void Renderer::initializeEngine (CameraHandle camera, ImageCacheHandlerPtr image
         // Try to load from properties if available
         try
         {
-            std::string archList = properties.renderProps->getVal<std::string> (RenderKey::CudaTargetArchitectures);
+            std::string archList = properties.getRender<RenderKey::CudaTargetArchitectures>();
             if (!archList.empty())
             {
                 // Parse comma-separated list of architectures
@@ -227,7 +227,8 @@ void Renderer::finalize()
 
 void Renderer::render (const InputEvent& input, bool updateMotion, uint32_t frameNumber)
 {
-    LOG (DBUG) << "Renderer::render - frame " << frameNumber;
+    TRACE_SCOPE_CAT ("render", "Renderer::render");
+    LOG_EVERY_MS (DBUG, 1000) << "Renderer::render - frame " << frameNumber;
 
     if (!initialized_ || !renderContext_)
     {
@@ -236,7 +237,14 @@ void Renderer::render (const InputEvent& input, bool updateMotion, uint32_t fram
     }
 
     // Get current stream from the StreamChain (waits for previous frame if needed)
-    CUstream currentStream = renderContext_->getCurrentStream();
+    CUstream currentStream;
+    {
+        TRACE_SCOPE_CAT ("render", "waitForStream");
+        currentStream = renderContext_->getCurrentStream();
+    }
+
+    // Phase 0: Apply the scene edits recorded since the last frame
+    applySceneChanges();
 
     // Determine buffer index for double buffering
     uint32_t bufferIndex = frameNumber % 2;
@@ -250,7 +258,7 @@ void Renderer::render (const InputEvent& input, bool updateMotion, uint32_t fram
         accumulationFrame_ = 0;
         cameraChanged_ = false;
         restartAccumulation_ = false;
-        LOG (DBUG) << "  Restarting accumulation due to camera change";
+        LOG_EVERY_MS (DBUG, 1000) << "  Restarting accumulation due to camera change";
     }
     else if (accumulationFrame_ < maxAccumulationFrames_)
     {
@@ -265,7 +273,7 @@ void Renderer::render (const InputEvent& input, bool updateMotion, uint32_t fram
 
         // TODO: Update animated objects
         // TODO: Rebuild acceleration structures if needed
-        LOG (DBUG) << "  Updating motion for frame " << frameNumber;
+        LOG_EVERY_MS (DBUG, 1000) << "  Updating motion for frame " << frameNumber;
     }
 
     // Get handlers
@@ -283,6 +291,16 @@ void Renderer::render (const InputEvent& input, bool updateMotion, uint32_t fram
     frameParams.enableJittering = true;
     frameParams.resetFlowBuffer = (accumulationFrame_ == 0);
 
+    // One consistent snapshot of the UI settings for the whole frame
+    if (properties.renderState)
+    {
+        RenderStateStore::Snapshot settings = properties.renderState->read();
+        frameParams.envLightPowerCoeff = static_cast<float> (settings->enviroIntensity);
+        frameParams.envLightRotation = static_cast<float> (settings->enviroRotation * std::numbers::pi / 180.0);
+        frameParams.enableEnvLight = settings->renderEnviro && handlers->environment &&
+                                     handlers->environment->hasEnvironmentTexture();
+    }
+
     // Update parameters
     handlers->pipelineParameter->updatePerFrameParameters (frameParams);
     handlers->pipelineParameter->copyParametersToDevice (currentStream);
@@ -291,6 +309,7 @@ void Renderer::render (const InputEvent& input, bool updateMotion, uint32_t fram
     CUdeviceptr plpDevice = handlers->pipelineParameter->getCombinedParametersDevice();
 
     // Launch G-buffer pass
+    Tracer::begin ("launchPipelines", "render");
     handlers->pipeline->launchGBufferPipeline (currentStream, plpDevice,
                                                renderContext_->getRenderWidth(),
                                                renderContext_->getRenderHeight());
@@ -309,6 +328,7 @@ void Renderer::render (const InputEvent& input, bool updateMotion, uint32_t fram
         handlers->screenBuffer->getLinearAlbedoBuffer(),
         handlers->screenBuffer->getLinearNormalBuffer(),
         handlers->screenBuffer->getLinearFlowBuffer());
+    Tracer::end ("launchPipelines", "render");
 
     // Store camera for next frame
     previousCamera_ = currentCamera_;
@@ -369,69 +389,24 @@ void Renderer::addSkyDomeHDR (const std::filesystem::path& hdrPath)
 
 void Renderer::addRenderableNode (RenderableWeakRef& weakNode)
 {
-    LOG (DBUG) << "Renderer::addRenderableNode";
-
-    if (!initialized_ || !renderContext_)
-    {
-        LOG (WARNING) << "Renderer not initialized, cannot add node";
-        return;
-    }
-
-    // Get the handlers from render context
-    dog::Handlers* handlers = renderContext_->getHandlers();
-    if (!handlers || !handlers->scene)
-    {
-        LOG (WARNING) << "SceneHandler not available";
-        return;
-    }
-
-    // Try to lock the weak reference to check node info
-    if (RenderableNode node = weakNode.lock())
-    {
-        LOG (INFO) << "Adding RenderableNode: " << node->getName() << " (ID: " << node->getID() << ")";
-
-        // Check if node has valid geometry
-        CgModelPtr cgModel = node->getModel();
-        if (cgModel)
-        {
-            LOG (DBUG) << "  Vertices: " << cgModel->vertexCount() << ", Triangles: " << cgModel->triangleCount();
-        }
-        else
-        {
-            LOG (WARNING) << "  Node has no CgModel geometry";
-        }
-    }
-
-    // Add the node to the scene handler
-    bool success = handlers->scene->addRenderableNode (weakNode);
-
-    if (success)
-    {
-        LOG (INFO) << "Node successfully added to SceneHandler";
-        LOG (INFO) << "Scene now contains " << handlers->scene->getNodeCount() << " nodes";
-
-        // Rebuild acceleration structures if needed
-        if (handlers->scene->hasGeometry())
-        {
-            LOG (DBUG) << "Building acceleration structures...";
-            handlers->scene->buildAccelerationStructures();
-        }
-    }
-    else
-    {
-        LOG (WARNING) << "Failed to add node to SceneHandler";
-    }
+    sceneJournal_->recordAdd (weakNode);
 }
 
 void Renderer::removeRenderableNode (RenderableWeakRef& weakNode)
 {
-    LOG (DBUG) << "Renderer::removeRenderableNode";
+    sceneJournal_->recordRemove (weakNode);
+}
 
-    if (!initialized_ || !renderContext_)
-    {
-        LOG (WARNING) << "Renderer not initialized, cannot remove node";
+void Renderer::removeRenderableNodeByID (ItemID nodeID)
+{
+    sceneJournal_->recordRemove (nodeID);
+}
+
+void Renderer::applySceneChanges()
+{
+    TRACE_SCOPE_CAT ("render", "Renderer::applySceneChanges");
+    if (!sceneJournal_->hasPendingChanges())
         return;
-    }
 
     // Get the handlers from render context
     dog::Handlers* handlers = renderContext_->getHandlers();
@@ -441,74 +416,55 @@ void Renderer::removeRenderableNode (RenderableWeakRef& weakNode)
         return;
     }
 
-    // Try to lock the weak reference to check node info
-    if (RenderableNode node = weakNode.lock())
+    const sabi::SceneDelta& delta = sceneJournal_->consume();
+    if (delta.empty())
     {
-        LOG (INFO) << "Removing RenderableNode: " << node->getName() << " (ID: " << node->getID() << ")";
+        LOG (DBUG) << "Scene journal: " << delta.recordCount << " changes cancelled out";
+        return;
     }
 
-    // Remove the node from the scene handler
-    bool success = handlers->scene->removeRenderableNode (weakNode);
+    LOG (DBUG) << "Scene journal: " << delta.recordCount << " changes coalesced into "
+               << delta.removed.size() << " removals, " << delta.added.size() << " additions, "
+               << delta.transforms.size() << " transforms";
 
-    if (success)
+    // Removals first so a node that was removed and re-added gets replaced
+    for (ItemID nodeID : delta.removed)
     {
-        LOG (INFO) << "Node successfully removed from SceneHandler";
-        LOG (INFO) << "Scene now contains " << handlers->scene->getNodeCount() << " nodes";
-
-        // Rebuild acceleration structures if still have geometry
-        if (handlers->scene->hasGeometry())
+        if (!handlers->scene->removeRenderableNodeByID (nodeID))
         {
-            LOG (DBUG) << "Rebuilding acceleration structures...";
-            handlers->scene->buildAccelerationStructures();
+            LOG (DBUG) << "Node " << nodeID << " was not in SceneHandler";
         }
     }
-    else
-    {
-        LOG (DBUG) << "Node was not in SceneHandler";
-    }
-}
 
-void Renderer::removeRenderableNodeByID (ItemID nodeID)
-{
-    LOG (DBUG) << "Renderer::removeRenderableNodeByID: " << nodeID;
-
-    if (!initialized_ || !renderContext_)
+    for (const RenderableWeakRef& weakNode : delta.added)
     {
-        LOG (WARNING) << "Renderer not initialized, cannot remove node";
-        return;
-    }
+        if (RenderableNode node = weakNode.lock())
+        {
+            LOG (DBUG) << "Adding RenderableNode: " << node->getName() << " (ID: " << node->getID() << ")";
 
-    // Get the handlers from render context
-    dog::Handlers* handlers = renderContext_->getHandlers();
-    if (!handlers || !handlers->scene)
-    {
-        LOG (WARNING) << "SceneHandler not available";
-        return;
+            if (!handlers->scene->addRenderableNode (weakNode))
+            {
+                LOG (WARNING) << "Failed to add node " << node->getName() << " to SceneHandler";
+            }
+        }
     }
 
-    // Remove the node from the scene handler
-    bool success = handlers->scene->removeRenderableNodeByID (nodeID);
-
-    if (success)
-    {
-        LOG (INFO) << "Node " << nodeID << " successfully removed from SceneHandler";
-        LOG (INFO) << "Scene now contains " << handlers->scene->getNodeCount() << " nodes";
+    handlers->scene->updateNodeTransforms (delta.transforms);
 
-        // Rebuild acceleration structures if still have geometry
-        if (handlers->scene->hasGeometry())
-        {
-            LOG (DBUG) << "Rebuilding acceleration structures...";
-            handlers->scene->buildAccelerationStructures();
-        }
-    }
-    else
+    // One acceleration structure rebuild for everything that changed this frame
+    if (handlers->scene->needsRebuild())
     {
-        LOG (DBUG) << "Node " << nodeID << " was not in SceneHandler";
+        LOG (DBUG) << "Rebuilding acceleration structures for " << handlers->scene->getNodeCount() << " nodes";
+        handlers->scene->buildAccelerationStructures();
     }
+
+    // Moving, adding or removing anything invalidates the accumulated image
+    restartAccumulation_ = true;
 }
 
 void Renderer::updateCameraBody (const InputEvent& input)
 {
+    TRACE_SCOPE_CAT ("render", "Renderer::updateCameraBody");
     if (!renderContext_)
     {
         return;
@@ -591,6 +547,7 @@ void Renderer::updateCameraBody (const InputEvent& input)
 
 void Renderer::updateCameraSensor()
 {
+    TRACE_SCOPE_CAT ("render", "Renderer::updateCameraSensor");
     // Get camera from render context
     if (!renderContext_)
     {
@@ -621,18 +578,31 @@ void Renderer::updateCameraSensor()
 
     auto& linearBeautyBuffer = renderHandler_->getLinearBeautyBuffer();
 
-    // Copy device buffer to host
     int renderWidth = renderContext_->getRenderWidth();
     int renderHeight = renderContext_->getRenderHeight();
+    sabi::CameraSensor* sensor = camera->getSensor();
+
+    if (sensor->getPixelResolution() == Eigen::Vector2i (renderWidth, renderHeight))
+    {
+        // Download straight into the sensor's write buffer, no host side copy
+        float* pixels = sensor->acquireWritePixels();
+        if (pixels)
+        {
+            linearBeautyBuffer.read (reinterpret_cast<float4*> (pixels), renderWidth * renderHeight);
+            sensor->publishWritePixels();
+        }
+        return;
+    }
+
+    // Sizes differ (preview scale or a pending resize), let the sensor resample
     std::vector<float4> hostPixels (renderWidth * renderHeight);
     linearBeautyBuffer.read (hostPixels.data(), renderWidth * renderHeight);
 
-    // Update the camera sensor with the rendered image
-    bool previewMode = false; // Full quality display
-    uint32_t renderScale = 1; // No scaling
+    bool previewMode = true;
+    uint32_t renderScale = std::max (1, sensor->getPixelResolution().x() / renderWidth);
 
     Eigen::Vector2i renderSize (renderWidth, renderHeight);
-    bool success = camera->getSensor()->updateImage (hostPixels.data(), renderSize, previewMode, renderScale);
+    bool success = sensor->updateImage (hostPixels.data(), renderSize, previewMode, renderScale);
 
     if (!success)
     {
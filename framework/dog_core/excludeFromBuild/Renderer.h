@@ -29,11 +29,19 @@ public:
     void render(const InputEvent& input, bool updateMotion, uint32_t frameNumber = 0);
 
     void addSkyDomeHDR(const std::filesystem::path& hdrPath);
+
+    // Scene edits are recorded in the journal and applied once per frame in render()
     void addRenderableNode(RenderableWeakRef& weakNode);
     void removeRenderableNode(RenderableWeakRef& weakNode);
     void removeRenderableNodeByID(ItemID nodeID);
 
+    // Producers on other threads can record straight into the journal
+    sabi::SceneChangeJournalPtr getSceneJournal() { return sceneJournal_; }
+
 private:
+    // Drain the scene journal and apply the coalesced delta to the SceneHandler
+    void applySceneChanges();
+
     // Camera update methods
     void updateCameraBody(const InputEvent& input);
     void updateCameraSensor();
@@ -44,6 +52,9 @@ private:
     // Render Context
     RenderContextPtr renderContext_;
 
+    // Pending scene edits, consumed once per frame
+    sabi::SceneChangeJournalPtr sceneJournal_ = std::make_shared<sabi::SceneChangeJournal>();
+
     // Camera state tracking
     DogShared::PerspectiveCamera currentCamera_ = {};
     DogShared::PerspectiveCamera previousCamera_ = {};
@@ -331,6 +331,35 @@ void RegularConstantContinuousDistribution1DTemplate<RealType>::
     m_isInitialized = true;
 }
 
+template <typename RealType>
+void RegularConstantContinuousDistribution1DTemplate<RealType>::
+    initialize (
+        CUcontext cuContext, cudau::BufferType type,
+        const RealType* PDF, const RealType* CDF, RealType integral, uint32_t numValues)
+{
+#if defined(USE_WALKER_ALIAS_METHOD)
+    // the alias table still has to be built here, the PDF is proportional to the weights
+    (void)CDF;
+    initialize (cuContext, type, PDF, numValues);
+    m_integral = integral;
+#else
+    Assert (!m_isInitialized, "Already initialized!");
+    m_numValues = numValues;
+    m_integral = integral;
+
+    m_PDF.initialize (cuContext, type, m_numValues);
+    m_CDF.initialize (cuContext, type, m_numValues + 1);
+
+    std::memcpy (m_PDF.map(), PDF, sizeof (RealType) * m_numValues);
+    std::memcpy (m_CDF.map(), CDF, sizeof (RealType) * (m_numValues + 1));
+
+    m_CDF.unmap();
+    m_PDF.unmap();
+
+    m_isInitialized = true;
+#endif
+}
+
 template class RegularConstantContinuousDistribution1DTemplate<float>;
 
 template <typename RealType>
@@ -370,6 +399,40 @@ void RegularConstantContinuousDistribution2DTemplate<RealType>::
     m_isInitialized = true;
 }
 
+template <typename RealType>
+void RegularConstantContinuousDistribution2DTemplate<RealType>::
+    initialize (
+        CUcontext cuContext, cudau::BufferType type,
+        const RealType* PDFs, const RealType* CDFs, const RealType* integrals,
+        const RealType* topPDF, const RealType* topCDF, RealType topIntegral,
+        uint32_t numD1, uint32_t numD2)
+{
+    Assert (!m_isInitialized, "Already initialized!");
+    m_1DDists = new RegularConstantContinuousDistribution1DTemplate<RealType>[numD2];
+    m_raw1DDists.initialize (cuContext, type, static_cast<uint32_t> (numD2));
+
+    shared::RegularConstantContinuousDistribution1DTemplate<RealType>* rawDists = m_raw1DDists.map();
+
+    // EN: the host did all the CDF work, only upload here.
+    for (uint32_t i = 0; i < numD2; ++i)
+    {
+        RegularConstantContinuousDistribution1DTemplate<RealType>& dist = m_1DDists[i];
+        dist.initialize (cuContext, type,
+                         PDFs + static_cast<size_t> (i) * numD1,
+                         CDFs + static_cast<size_t> (i) * (numD1 + 1),
+                         integrals[i], numD1);
+        dist.getDeviceType (&rawDists[i]);
+    }
+
+    m_top1DDist.initialize (cuContext, type, topPDF, topCDF, topIntegral, numD2);
+
+    Assert (std::isfinite (m_top1DDist.getIntegral()), "invalid integral value.");
+
+    m_raw1DDists.unmap();
+
+    m_isInitialized = true;
+}
+
 template class RegularConstantContinuousDistribution2DTemplate<float>;
 
 void ProbabilityTexture::initialize (CUcontext cuContext, uint32_t numValues)
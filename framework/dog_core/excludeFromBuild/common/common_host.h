@@ -337,6 +337,10 @@ class RegularConstantContinuousDistribution1DTemplate
     void initialize (
         CUcontext cuContext, cudau::BufferType type,
         const RealType* values, uint32_t numValues);
+    // Uploads a PDF and CDF that were already normalized on the host
+    void initialize (
+        CUcontext cuContext, cudau::BufferType type,
+        const RealType* PDF, const RealType* CDF, RealType integral, uint32_t numValues);
     void finalize (CUcontext cuContext)
     {
         if (!m_isInitialized)
@@ -409,6 +413,13 @@ class RegularConstantContinuousDistribution2DTemplate
     void initialize (
         CUcontext cuContext, cudau::BufferType type,
         const RealType* values, uint32_t numD1, uint32_t numD2);
+    // Uploads conditional and marginal distributions that were already built on the host
+    // PDFs and CDFs hold numD2 rows of numD1 and numD1 + 1 entries
+    void initialize (
+        CUcontext cuContext, cudau::BufferType type,
+        const RealType* PDFs, const RealType* CDFs, const RealType* integrals,
+        const RealType* topPDF, const RealType* topCDF, RealType topIntegral,
+        uint32_t numD1, uint32_t numD2);
     void finalize (CUcontext cuContext)
     {
         if (!m_isInitialized)
@@ -43,23 +43,16 @@ void EnvironmentHandler::addSkyDomeImage(const OIIO::ImageBuf&& image)
     // don't delete ... owned by ImageBuf
     float* textureData = static_cast<float*>(rgba.localpixels());
 
-    float* const importanceData = new float[width * height];
-    for (int y = 0; y < height; ++y)
+    BS::thread_pool pool;
+
+    // negative texels would break filtering, clamp them before the upload
+    const size_t numFloats = static_cast<size_t>(width) * height * 4;
+    pool.detach_blocks(size_t(0), numFloats, [textureData](const size_t start, const size_t end)
     {
-        float theta = pi_v<float> * (y + 0.5f) / height;
-        float sinTheta = std::sin(theta);
-        for (int x = 0; x < width; ++x)
-        {
-            uint32_t idx = 4 * (y * width + x);
-            textureData[idx + 0] = std::max(textureData[idx + 0], 0.0f);
-            textureData[idx + 1] = std::max(textureData[idx + 1], 0.0f);
-            textureData[idx + 2] = std::max(textureData[idx + 2], 0.0f);
-            RGB value(textureData[idx + 0],
-                       textureData[idx + 1],
-                       textureData[idx + 2]);
-            importanceData[y * width + x] = sRGB_calcLuminance(value) * sinTheta;
-        }
-    }
+        for (size_t i = start; i < end; ++i)
+            textureData[i] = std::max(textureData[i], 0.0f);
+    });
+    pool.wait();
 
     envLightArray.initialize2D(
         ctx->getCudaContext(), cudau::ArrayElementType::Float32, 4,
@@ -68,10 +61,19 @@ void EnvironmentHandler::addSkyDomeImage(const OIIO::ImageBuf&& image)
 
     envLightArray.write(textureData, width * height * 4);
 
+    // luminance * sin(theta) marginal and conditional CDFs, built in parallel on the host
+    hostImportanceMap.build(textureData, width, height, 4, maxImportanceWidth, &pool);
+
     envLightImportanceMap.initialize(
-        ctx->getCudaContext(), cudau::BufferType::Device, importanceData, width, height);
+        ctx->getCudaContext(), cudau::BufferType::Device,
+        hostImportanceMap.rowPDFs().data(), hostImportanceMap.rowCDFs().data(),
+        hostImportanceMap.rowIntegrals().data(),
+        hostImportanceMap.rowMarginalPDF().data(), hostImportanceMap.rowMarginalCDF().data(),
+        hostImportanceMap.integral(),
+        hostImportanceMap.width(), hostImportanceMap.height());
 
-    delete[] importanceData;
+    if (hostImportanceMap.reductionFactor() > 1)
+        LOG(DBUG) << "Environment importance map reduced to " << hostImportanceMap.width() << "x" << hostImportanceMap.height();
 
     envLightTexture = sampler_float.createTextureObject(envLightArray);
     
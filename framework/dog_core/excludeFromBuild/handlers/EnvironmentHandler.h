@@ -5,6 +5,7 @@
 // Handles texture creation, mipmap generation, and probability distribution for environment sampling.
 
 #include "../common/common_host.h"
+#include "../tools/EnvImportanceMap.h"
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 
@@ -37,6 +38,13 @@ public:
     // Used to efficiently sample the environment based on light contribution
     RegularConstantContinuousDistribution2D& getImportanceMap() { return envLightImportanceMap; }
 
+    // Host copy of the same distribution, for CPU side sampling and tests
+    const EnvImportanceMap& getHostImportanceMap() const { return hostImportanceMap; }
+
+    // Maps wider than this are importance sampled on a coarser grid, 0 keeps full resolution
+    // Takes effect on the next addSkyDomeImage()
+    void setMaxImportanceWidth (uint32_t width) { maxImportanceWidth = width; }
+
     // Check if environment texture is loaded
     bool hasEnvironmentTexture() const { return envLightTexture != 0; }
 
@@ -54,4 +62,8 @@ private:
     // Used to sample directions based on light contribution for efficient rendering
     RegularConstantContinuousDistribution2D envLightImportanceMap;
 
+    // CPU built marginal and conditional distributions uploaded into envLightImportanceMap
+    EnvImportanceMap hostImportanceMap;
+    uint32_t maxImportanceWidth = 8192;
+
 }; // end class EnvironmentHandler
\ No newline at end of file
@@ -493,6 +493,66 @@ bool SceneHandler::removeRenderableNodeByID(ItemID nodeID)
     return true;
 }
 
+size_t SceneHandler::updateNodeTransforms(const std::vector<sabi::SceneTransformChange>& changes)
+{
+    if (!initialized_)
+    {
+        LOG(WARNING) << "SceneHandler not initialized";
+        return 0;
+    }
+
+    if (changes.empty())
+        return 0;
+
+    size_t updated = 0;
+
+    // Map once for the whole batch instead of once per node
+    inst_data_buffer_[0].map();
+    shared::InstanceData* instDataHost = inst_data_buffer_[0].getMappedPointer();
+
+    for (const auto& change : changes)
+    {
+        auto it = node_resources_.find(change.nodeID);
+        if (it == node_resources_.end())
+            continue;
+
+        NodeResources& nodeRes = it->second;
+
+        // Convert Eigen matrix to OptiX format (row-major float[12])
+        const Eigen::Matrix4f& worldTransform = change.worldTransform.matrix();
+        float transform[12];
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int col = 0; col < 4; ++col)
+            {
+                transform[row * 4 + col] = worldTransform(row, col);
+            }
+        }
+
+        nodeRes.optix_instance.setTransform(transform);
+
+        shared::InstanceData& instData = instDataHost[nodeRes.instance_slot];
+        instData.transform = Matrix4x4(
+            Vector4D(transform[0], transform[1], transform[2], transform[3]),
+            Vector4D(transform[4], transform[5], transform[6], transform[7]),
+            Vector4D(transform[8], transform[9], transform[10], transform[11]),
+            Vector4D(0, 0, 0, 1));
+        instData.curToPrevTransform = instData.transform;  // No motion blur yet
+        instData.normalMatrix = instData.transform.getUpperLeftMatrix().invert().transpose();
+
+        ++updated;
+    }
+
+    inst_data_buffer_[0].unmap();
+
+    if (updated)
+        ias_needs_rebuild_ = true;
+
+    LOG(DBUG) << "Updated transforms for " << updated << " of " << changes.size() << " nodes";
+
+    return updated;
+}
+
 // Note: computeGeometryHash and createGeometryGroup methods have been moved to ModelHandler
 
 bool SceneHandler::createNodeInstance(NodeResources& nodeRes, const GeometryGroupResources& geomGroup)
@@ -554,6 +614,7 @@ bool SceneHandler::createNodeInstance(NodeResources& nodeRes, const GeometryGrou
         optixu::Instance instance = optixScene.createInstance();
         instance.setChild(geomGroup.gas);
         instance.setTransform(transform);
+        nodeRes.optix_instance = instance;
         
         // Add to IAS
         ias_.addChild(instance);
@@ -122,6 +122,14 @@ public:
     bool removeRenderableNode(RenderableWeakRef node);
     bool removeRenderableNodeByID(ItemID nodeID);
     size_t getNodeCount() const { return node_resources_.size(); }
+
+    // Apply a frame's worth of coalesced transform changes
+    // Maps the instance data buffer once for the whole batch
+    // Returns the number of nodes that were updated
+    size_t updateNodeTransforms(const std::vector<sabi::SceneTransformChange>& changes);
+
+    // True when instances were added, removed or moved since the last IAS build
+    bool needsRebuild() const { return ias_needs_rebuild_; }
     
 
 private:
@@ -141,6 +149,7 @@ private:
         
         // OptiX resources
         optixu::GeometryInstance optix_geom_inst;
+        optixu::Instance optix_instance;             // Kept so transforms can be updated in place
         uint32_t optix_instance_index = UINT32_MAX;  // Index in IAS instance buffer
     };
     
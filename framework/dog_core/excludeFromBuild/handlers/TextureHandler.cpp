@@ -84,8 +84,57 @@ bool TextureHandler::loadTexture (const std::filesystem::path& filePath,
     bool success = true;
     TextureCacheValue cacheValue = {};
 
-    // Load image using OIIO
-    OIIO::ImageBuf image = ctx->getImageCache()->getCachedImage (filePath.generic_string(), false);
+    // Stores cacheValue and hands the texture back to the caller
+    auto storeInCache = [&]()
+    {
+        s_textureCache[cacheKey] = std::move (cacheValue);
+        const TextureCacheValue& cached = s_textureCache.at (cacheKey);
+        *texture = &cached.texture;
+        *needsDegamma = cached.needsDegamma;
+        if (isHDR)
+            *isHDR = cached.isHDR;
+    };
+
+    const bool isPacked = texKind.format == TextureKind::Format::OcclusionRoughnessMetallic ||
+                          texKind.format == TextureKind::Format::RoughnessMetallic;
+
+    // Authored DDS files are already block compressed, upload them as they are.
+    // Packed channel maps still need their channel pulled out, so those are
+    // decoded and baked like any other source
+    const bool isDDS = filePath.extension() == ".dds" || filePath.extension() == ".DDS";
+    if (isDDS && !isPacked)
+    {
+        if (!loadDDS (filePath, cacheValue)) return false;
+
+        storeInCache();
+        return true;
+    }
+
+    // Colour and packed channel textures are baked to block compressed DDS once,
+    // after that the source image is never decoded again. The bake itself runs in
+    // the background, see below
+    std::filesystem::path bakedPath;
+    TextureBakerPtr textureBaker = bakingEnabled && (requestedInput == "Color" || isPacked) ? getBaker() : nullptr;
+    if (textureBaker)
+    {
+        bakedPath = textureBaker->cachePath (filePath, requestedInput);
+
+        std::error_code ec;
+        if (!bakedPath.empty() && std::filesystem::is_regular_file (bakedPath, ec) && loadDDS (bakedPath, cacheValue))
+        {
+            // same convention as the uncompressed 8 bit path
+            cacheValue.needsDegamma = true;
+            storeInCache();
+            return true;
+        }
+    }
+
+    // Pinned pixels are shared with anyone else reading the same file
+    // and the view wraps them, so nothing is copied before the upload
+    PinnedImagePtr pinned = ctx->getImageCache()->getPinnedImage (filePath.generic_string());
+    if (!pinned) return false;
+
+    OIIO::ImageBuf image = pinned->view();
     OIIO::ImageSpec spec = image.spec();
 
     if (spec.format != OIIO::TypeDesc::UINT8) return false;
@@ -94,10 +143,14 @@ bool TextureHandler::loadTexture (const std::filesystem::path& filePath,
     bool mightHaveAlpha = (spec.nchannels == 4 && requestedInput == "Color");
 
     OIIO::ImageBuf processedImage;
+    const OIIO::ImageBuf* uploadImage = &image;
+
     // Handle packed formats where we need to extract specific channels
-    if (texKind.format == TextureKind::Format::OcclusionRoughnessMetallic ||
-        texKind.format == TextureKind::Format::RoughnessMetallic)
+    if (isPacked)
     {
+        // Nothing gets uploaded unless the channel extraction succeeds
+        uploadImage = &processedImage;
+
         // Find the channel we need to extract
         std::string channelOutput;
         for (const auto& channel : texKind.channels)
@@ -140,23 +193,21 @@ bool TextureHandler::loadTexture (const std::filesystem::path& filePath,
         std::string channelnames[] = {"R", "G", "B", "A"};
         processedImage = OIIO::ImageBufAlgo::channels (image, 4, channelorder,
                                                        channelvalues, channelnames);
+        uploadImage = &processedImage;
         spec = processedImage.spec();
         mightHaveAlpha = false; // We created an all-opaque alpha channel
     }
-    else
-    {
-        processedImage = image;
-        // Keep the original 4-channel image which might have alpha
-    }
+    // else keep the original 4-channel image which might have alpha
+    // and upload straight from the pinned pixels
 
     const uint8_t* const linearImageData =
-        static_cast<uint8_t*> (processedImage.localpixels());
+        static_cast<const uint8_t*> (uploadImage->localpixels());
 
     // NOW we can analyze the alpha channel if needed
     bool hasNonTrivialAlpha = false;
     if (mightHaveAlpha && linearImageData)
     {
-        hasNonTrivialAlpha = analyzeAlphaChannel (processedImage);
+        hasNonTrivialAlpha = analyzeAlphaChannel (*uploadImage);
        // LOG (DBUG) << "Texture " << filePath.filename().string()
             //       << (hasNonTrivialAlpha ? " has non-trivial alpha" : " has trivial alpha");
     }
@@ -165,6 +216,7 @@ bool TextureHandler::loadTexture (const std::filesystem::path& filePath,
     if (linearImageData)
     {
         int channelCount = spec.nchannels; // Will be 1 for extracted channels, 4 for regular textures
+
         cacheValue.texture.initialize2D (
             ctx->getCudaContext(), cudau::ArrayElementType::UInt8, channelCount,
             cudau::ArraySurface::Disable,
@@ -173,6 +225,31 @@ bool TextureHandler::loadTexture (const std::filesystem::path& filePath,
         cacheValue.texture.write<uint8_t> (linearImageData,
                                            spec.width * spec.height * channelCount);
 
+        // Compressing a large texture takes far longer than a frame, so the first load
+        // uploads the pixels above and the bake runs in the background. The next load
+        // of this texture finds the DDS in the cache
+        if (textureBaker && !bakedPath.empty() && TextureBaker::canCompress (spec.width, spec.height))
+        {
+            // opaque colour fits in BC1, colour with alpha needs BC7
+            TextureBaker::Options options;
+            options.format = channelCount == 1 ? TextureBaker::Format::BC4
+                                               : (hasNonTrivialAlpha ? TextureBaker::Format::BC7 : TextureBaker::Format::BC1);
+            options.sRGB = channelCount != 1;
+
+            // the bake outlives this call, hand it something that keeps the pixels alive
+            std::shared_ptr<const void> owner = pinned;
+            const uint8_t* pixels = linearImageData;
+            if (uploadImage == &processedImage)
+            {
+                auto processed = std::make_shared<OIIO::ImageBuf> (std::move (processedImage));
+                pixels = static_cast<const uint8_t*> (processed->localpixels());
+                owner = processed;
+            }
+
+            textureBaker->bakeInBackground (std::move (owner), pixels, spec.width, spec.height,
+                                            channelCount, options, bakedPath);
+        }
+
         cacheValue.needsDegamma = true;
         cacheValue.isHDR = false;
 
@@ -186,15 +263,62 @@ bool TextureHandler::loadTexture (const std::filesystem::path& filePath,
 
     // Cache and return
     if (success)
+        storeInCache();
+
+    return success;
+}
+
+TextureBakerPtr TextureHandler::getBaker()
+{
+    if (!baker)
     {
-        s_textureCache[cacheKey] = std::move (cacheValue);
-        *texture = &s_textureCache.at (cacheKey).texture;
-        *needsDegamma = s_textureCache.at (cacheKey).needsDegamma;
-        if (isHDR)
-            *isHDR = s_textureCache.at (cacheKey).isHDR;
+        std::filesystem::path resourcePath = ctx->getResourcePath();
+        std::filesystem::path cacheFolder = resourcePath.empty()
+                                                ? std::filesystem::temp_directory_path() / "cook" / "textures"
+                                                : resourcePath / "cache" / "textures";
+        baker = TextureBaker::create (cacheFolder);
     }
+    return baker;
+}
 
-    return success;
+void TextureHandler::uploadBlockCompressed (int32_t width, int32_t height, dds::Format format,
+                                            const uint8_t* const* mips, const size_t* sizes, int32_t mipCount,
+                                            TextureCacheValue& value)
+{
+    cudau::ArrayElementType elemType;
+    translate (format, &elemType, &value.needsDegamma, &value.isHDR);
+
+    value.texture.initialize2D (
+        ctx->getCudaContext(), elemType, 1,
+        cudau::ArraySurface::Disable,
+        cudau::ArrayTextureGather::Disable,
+        width, height, mipCount);
+    for (int32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        value.texture.write<uint8_t> (mips[mipLevel], static_cast<uint32_t> (sizes[mipLevel]), mipLevel);
+
+    // only the formats with a full alpha channel can carry meaningful alpha
+    value.hasAlpha = format == dds::Format::BC2_UNorm || format == dds::Format::BC2_UNorm_sRGB ||
+                     format == dds::Format::BC3_UNorm || format == dds::Format::BC3_UNorm_sRGB ||
+                     format == dds::Format::BC7_UNorm || format == dds::Format::BC7_UNorm_sRGB;
+}
+
+bool TextureHandler::loadDDS (const std::filesystem::path& ddsPath, TextureCacheValue& value)
+{
+    int32_t width, height, mipCount;
+    dds::Format ddsFormat;
+    size_t* sizes;
+    uint8_t** imageData = dds::load (
+        ddsPath.string().c_str(), &width, &height, &mipCount, &sizes, &ddsFormat);
+    if (!imageData)
+    {
+        LOG (WARNING) << "Failed to load DDS texture " << ddsPath.generic_string();
+        return false;
+    }
+
+    uploadBlockCompressed (width, height, ddsFormat, imageData, sizes, mipCount, value);
+    dds::free (imageData, sizes);
+
+    return true;
 }
 
 bool TextureHandler::textureHasAlpha (const cudau::Array* texture) const
@@ -19,6 +19,13 @@
 // - Provides gamma correction handling
 // - Manages different pixel formats (8-bit, 32-bit float)
 //
+// Block Compression:
+// - Colour and packed channel textures are baked once by TextureBaker into
+//   mip mapped BC1/BC7/BC4 DDS files and reloaded from that cache afterwards
+// - The bake runs in the background, the first load uploads uncompressed pixels
+// - .dds sources are uploaded directly without decoding, except packed channel
+//   maps which are decoded so the requested channel can be extracted
+//
 // Memory Optimization:
 // - Uses shared pointers for automatic resource management
 // - Implements texture reuse through caching
@@ -70,6 +77,7 @@
 #pragma once
 
 #include "../RenderContext.h"
+#include "../tools/TextureBaker.h"
 
 using TextureHandlerPtr = std::shared_ptr<class TextureHandler>;
 
@@ -125,12 +133,23 @@ class TextureHandler
 
     bool textureHasAlpha (const cudau::Array* texture) const;
 
+    // Block compressed baking is on by default, turn it off to upload
+    // uncompressed 8 bit textures as before
+    void setBakingEnabled (bool enabled) { bakingEnabled = enabled; }
+    bool isBakingEnabled() const { return bakingEnabled; }
+
  private:
     RenderContextPtr ctx = nullptr;
     std::vector<std::shared_ptr<cudau::Array>> textures;
 
+    TextureBakerPtr baker = nullptr;
+    bool bakingEnabled = true;
+
     bool analyzeAlphaChannel (const OIIO::ImageBuf& image);
 
+    // created on first use so the resource path has been set by then
+    TextureBakerPtr getBaker();
+
     // Key structure for file-based texture cache
     // Combines filepath and CUDA context to uniquely identify a texture
     struct TextureCacheKey
@@ -210,6 +229,14 @@ class TextureHandler
         bool hasAlpha = false;          // Flag to indicate meaningful alpha data
     };
 
+    // Uploads a block compressed mip chain into value.texture
+    void uploadBlockCompressed (int32_t width, int32_t height, dds::Format format,
+                                const uint8_t* const* mips, const size_t* sizes, int32_t mipCount,
+                                TextureCacheValue& value);
+
+    // Reads a DDS file, baked or authored, into value
+    bool loadDDS (const std::filesystem::path& ddsPath, TextureCacheValue& value);
+
     // Cache mappings for different texture types
     std::map<TextureCacheKey, TextureCacheValue> s_textureCache;                  // File-based textures
     std::map<ImmTextureCacheKey<float>, TextureCacheValue> s_Fx1ImmTextureCache;  // Grayscale immediate
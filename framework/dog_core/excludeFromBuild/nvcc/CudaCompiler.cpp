@@ -2,59 +2,6 @@
 #include "CudaCompiler.h"
 #include <reproc++/run.hpp>
 
-bool CudaCompiler::hasFolderChanged (const std::string& folderPath, const std::string& jsonFilePath, const std::string& buildMode)
-{
-    nlohmann::json jsonFile;
-    std::ifstream inFile (jsonFilePath);
-
-    if (inFile.is_open())
-    {
-        inFile >> jsonFile;
-        inFile.close();
-    }
-    else
-    {
-        jsonFile = nlohmann::json::object();
-    }
-
-    bool changed = false;
-
-    // Check if build mode has changed
-    if (jsonFile.find ("buildMode") == jsonFile.end() || jsonFile["buildMode"] != buildMode)
-    {
-        changed = true;
-        jsonFile["buildMode"] = buildMode;
-    }
-
-    for (const auto& entry : std::filesystem::directory_iterator (folderPath))
-    {
-        auto path = entry.path();
-
-        // Only consider *.cu files
-        if (path.extension() == ".cu")
-        {
-            auto pathStr = path.string();
-            auto lastWriteTime = std::filesystem::last_write_time (path);
-            auto timeStr = lastWriteTime.time_since_epoch().count();
-
-            if (jsonFile.find (pathStr) == jsonFile.end() || jsonFile[pathStr] != timeStr)
-            {
-                changed = true;
-                jsonFile[pathStr] = timeStr;
-            }
-        }
-    }
-
-    std::ofstream outFile (jsonFilePath);
-    if (outFile.is_open())
-    {
-        outFile << jsonFile.dump (4);
-        outFile.close();
-    }
-
-    return changed;
-}
-
 void CudaCompiler::compile (const std::filesystem::path& resourceFolder,
                             const std::filesystem::path& repoFolder,
                             const std::vector<std::string>& targetArchitectures)
@@ -80,10 +27,6 @@ void CudaCompiler::compile (const std::filesystem::path& resourceFolder,
     std::filesystem::path cudaFolder = repoFolder / "framework" / "dog_core" / "excludeFromBuild" / "cuda";
     verifyPath (cudaFolder);
 
-    // Nothing to do if the cu files or build mode haven't been changed
-    std::string jsonPath = baseOutputFolder.string() + "/file_times.json";
-    if (!hasFolderChanged (cudaFolder.string(), jsonPath, buildMode)) return;
-
     std::filesystem::path shockerUtilFolder = repoFolder / "thirdparty/optiXUtil/src";
     verifyPath (shockerUtilFolder);
 
@@ -116,17 +59,52 @@ void CudaCompiler::compileForArchitecture (const std::filesystem::path& cudaFold
                                            const std::string& buildMode,
                                            const std::filesystem::path& shockerUtilFolder)
 {
-    // Path to nvcc exe
-    std::string exe = "C:/Program Files/NVIDIA GPU Computing Toolkit/CUDA/v12.9/bin/nvcc.exe";
+    std::vector<KernelBuildCache::Job> jobs = createJobs (cudaFolder, outputFolder, architecture, buildMode, shockerUtilFolder);
+
+    // headers in the repo are hashed with the kernels that include them, the SDK headers are
+    // not, a different SDK shows up as different include paths on the command line
+    KernelBuildCache cache;
+    cache.setIncludeFolders ({shockerUtilFolder});
+    cache.load (outputFolder / "build_cache.json");
+
+    const uint32_t timeoutMs = options.timeoutMs;
+    auto launch = [timeoutMs] (const KernelBuildCache::Job& job)
+    {
+        LOG (DBUG) << "Compiling " << job.source.filename().string() << " -> " << job.output.filename().string();
+
+        reproc::options procOptions;
+        procOptions.redirect.parent = true;
+        if (timeoutMs)
+            procOptions.deadline = reproc::milliseconds (timeoutMs);
+
+        auto [status, errCode] = reproc::run (job.args, procOptions);
+        if (errCode)
+        {
+            LOG (WARNING) << "Error compiling " << job.source.filename().string() << ": " << errCode.message();
+            return -1;
+        }
+        return status;
+    };
 
+    const KernelBuildCache::RunStats stats = cache.run (jobs, launch, options.maxJobs);
+
+    LOG (INFO) << architecture << ": " << stats.built << " kernels built, " << stats.upToDate << " up to date, "
+               << stats.failed << " failed";
+}
+
+std::vector<KernelBuildCache::Job> CudaCompiler::createJobs (const std::filesystem::path& cudaFolder,
+                                                             const std::filesystem::path& outputFolder,
+                                                             const std::string& architecture,
+                                                             const std::string& buildMode,
+                                                             const std::filesystem::path& shockerUtilFolder) const
+{
     std::string ext = ".cu";
     std::vector<std::filesystem::path> cuFiles = FileServices::findFilesWithExtension (cudaFolder, ext);
 
+    std::vector<KernelBuildCache::Job> jobs;
     for (const auto& f : cuFiles)
     {
         std::string fileName = f.filename().string();
-
-        LOG (DBUG) << "Compiling " << fileName << " for " << architecture;
         bool ptx = false;
 
         // copy_buffers.cu has to be ptx
@@ -149,16 +127,22 @@ void CudaCompiler::compileForArchitecture (const std::filesystem::path& cudaFold
         if (fileName.rfind ("optix_pathtracing_", 0) == 0)
             ptx = true;
 
+        if (fileName.rfind ("compute_light_probs", 0) == 0)
+            ptx = true;
 
+        KernelBuildCache::Job job;
+        job.source = f;
 
-         if (fileName.rfind ("compute_light_probs", 0) == 0)
-             ptx = true;
+        // Output to architecture-specific folder
+        job.output = ptx
+                         ? (outputFolder / f.stem()).string() + ".ptx"
+                         : (outputFolder / f.stem()).string() + ".optixir";
 
         // nvcc args
-        std::vector<std::string> args;
+        std::vector<std::string>& args = job.args;
 
         // Path to nvcc exe
-        args.push_back (exe);
+        args.push_back (options.compiler.string());
         args.push_back (f.string());
 
         if (ptx)
@@ -177,9 +161,11 @@ void CudaCompiler::compileForArchitecture (const std::filesystem::path& cudaFold
         args.push_back ("--machine");
         args.push_back ("64");
 
+#ifdef _WIN32
         // Suppress warning 4819 and enable __cplusplus macro
         args.push_back ("-Xcompiler");
         args.push_back ("/wd 4819 /Zc:__cplusplus");
+#endif
 
         // Set GPU architecture - now using the parameter
         args.push_back ("--gpu-architecture");
@@ -195,50 +181,32 @@ void CudaCompiler::compileForArchitecture (const std::filesystem::path& cudaFold
                 args.push_back ("-G");
         }
 
-        args.push_back ("-ccbin");
-
-        // if desktop
-        args.push_back ("C:/Program Files/Microsoft Visual Studio/2022/Community/VC/Tools/MSVC/14.42.34433/bin/Hostx64/x64/");
-        // if laptop
-        // args.push_back ("C:/Program Files/Microsoft Visual Studio/2022/Community/VC/Tools/MSVC/14.39.33519/bin/Hostx64/x64/");
-
-        // OptiX 9 headers
-        args.push_back ("--include-path");
-        args.push_back ("C:/ProgramData/NVIDIA Corporation/OptiX SDK 9.0.0/include");
+        if (!options.hostCompilerFolder.empty())
+        {
+            args.push_back ("-ccbin");
+            args.push_back (options.hostCompilerFolder.generic_string());
+        }
 
-        // cuda 12.9 headers
-        args.push_back ("--include-path");
-        args.push_back ("C:/Program Files/NVIDIA GPU Computing Toolkit/CUDA/v12.9/include");
+        // OptiX and CUDA headers
+        for (const auto& folder : options.includeFolders)
+        {
+            args.push_back ("--include-path");
+            args.push_back (folder.generic_string());
+        }
 
         // OptixUtil
         args.push_back ("--include-path");
         args.push_back (shockerUtilFolder.generic_string());
 
         args.push_back ("--output-file");
+        args.push_back (job.output.string());
 
-        // Output to architecture-specific folder
-        std::string outPath = ptx
-                                  ? (outputFolder / f.stem()).string() + ".ptx"
-                                  : (outputFolder / f.stem()).string() + ".optixir";
-
-        LOG (DBUG) << "Output: " << outPath;
-        args.push_back (outPath);
-
-        int status = -1;
-        std::error_code errCode;
-
-        reproc::options options;
-        options.redirect.parent = true;
-        options.deadline = reproc::milliseconds (5000);
-
-        std::tie (status, errCode) = reproc::run (args, options);
-
-        if (errCode.value() != 0)
-        {
-            LOG (WARNING) << "Error compiling for " << architecture << ": " << errCode.message();
-        }
+        jobs.push_back (std::move (job));
     }
+
+    return jobs;
 }
+
 void CudaCompiler::verifyPath (const std::filesystem::path& path)
 {
     if (!std::filesystem::exists (path))
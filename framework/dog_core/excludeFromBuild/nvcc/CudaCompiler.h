@@ -1,21 +1,69 @@
 #pragma once
 
 #include "../../dog_core.h"
+#include "KernelBuildCache.h"
+
+// Where the compiler and its headers live, the defaults match the Windows dev machines.
+// On other systems the compiler is found on the PATH, or any stand in can be given.
+struct CudaCompilerOptions
+{
+    std::filesystem::path compiler = defaultCompiler();
+    std::filesystem::path hostCompilerFolder = defaultHostCompilerFolder(); // -ccbin, empty to leave it to nvcc
+    std::vector<std::filesystem::path> includeFolders = defaultIncludeFolders();
+    uint32_t maxJobs = 0;      // compiler processes at once, 0 uses every core
+    uint32_t timeoutMs = 5000; // per file, 0 waits forever
+
+    static std::filesystem::path defaultCompiler()
+    {
+#ifdef _WIN32
+        return "C:/Program Files/NVIDIA GPU Computing Toolkit/CUDA/v12.9/bin/nvcc.exe";
+#else
+        return "nvcc";
+#endif
+    }
+
+    static std::filesystem::path defaultHostCompilerFolder()
+    {
+#ifdef _WIN32
+        // if laptop: C:/Program Files/Microsoft Visual Studio/2022/Community/VC/Tools/MSVC/14.39.33519/bin/Hostx64/x64/
+        return "C:/Program Files/Microsoft Visual Studio/2022/Community/VC/Tools/MSVC/14.42.34433/bin/Hostx64/x64/";
+#else
+        return {};
+#endif
+    }
+
+    static std::vector<std::filesystem::path> defaultIncludeFolders()
+    {
+#ifdef _WIN32
+        return {"C:/ProgramData/NVIDIA Corporation/OptiX SDK 9.0.0/include",
+                "C:/Program Files/NVIDIA GPU Computing Toolkit/CUDA/v12.9/include"};
+#else
+        return {};
+#endif
+    }
+};
 
 class CudaCompiler
 {
  public:
-    CudaCompiler() = default;
+    explicit CudaCompiler (const CudaCompilerOptions& options = CudaCompilerOptions()) :
+        options (options)
+    {
+    }
     ~CudaCompiler() = default;
 
+    void setOptions (const CudaCompilerOptions& newOptions) { options = newOptions; }
+    const CudaCompilerOptions& getOptions() const { return options; }
+
     // Modified to accept a vector of target architectures
     void compile (const std::filesystem::path& resourceFolder,
                   const std::filesystem::path& repoFolder,
                   const std::vector<std::string>& targetArchitectures = {"sm_75", "sm_80", "sm_86", "sm_90"});
 
  private:
+    CudaCompilerOptions options;
+
     void verifyPath (const std::filesystem::path& path);
-    bool hasFolderChanged (const std::string& folderPath, const std::string& jsonFilePath, const std::string& buildMode);
 
     // Helper to run compilation for a specific architecture
     void compileForArchitecture (const std::filesystem::path& cudaFolder,
@@ -23,4 +71,11 @@ class CudaCompiler
                                  const std::string& architecture,
                                  const std::string& buildMode,
                                  const std::filesystem::path& shockerUtilFolder);
-};
\ No newline at end of file
+
+    // one compiler job per .cu file, the command line is part of the cache key
+    std::vector<KernelBuildCache::Job> createJobs (const std::filesystem::path& cudaFolder,
+                                                   const std::filesystem::path& outputFolder,
+                                                   const std::string& architecture,
+                                                   const std::string& buildMode,
+                                                   const std::filesystem::path& shockerUtilFolder) const;
+};
@@ -0,0 +1,289 @@
+#pragma once
+
+// KernelBuildCache decides which kernel translation units need compiling and runs them in parallel.
+//
+// Keys:
+// - Each job is keyed by its output file and a 64 bit FNV-1a hash of the translation unit,
+//   every file it includes transitively and the full compiler command line
+// - Includes are found by scanning #include lines, quoted includes resolve against the
+//   including file's folder first, then the include folders, angle includes only against
+//   the include folders; anything unresolved (CUDA, OptiX, the STL) is treated as a
+//   system header and left out of the hash
+// - File hashes and include lists are remembered for the length of a run(), so a header
+//   shared by every kernel is read once
+//
+// Building:
+// - run() launches the stale jobs on a thread pool with at most 'maxJobs' in flight,
+//   a job is recorded as built only when the launcher reports success and the output exists
+// - The launcher is supplied by the caller, CudaCompiler runs the configured compiler
+//   through reproc and the unit tests use a stand in
+//
+// Header only and free of CUDA so unit tests can use it directly.
+
+#include <map>
+#include <optional>
+
+class KernelBuildCache
+{
+ public:
+    struct Job
+    {
+        std::filesystem::path source;
+        std::filesystem::path output;
+        std::vector<std::string> args; // full command line, part of the key
+    };
+
+    // returns the compiler's exit status, 0 is success
+    using Launcher = std::function<int (const Job&)>;
+
+    struct RunStats
+    {
+        uint32_t upToDate = 0;
+        uint32_t built = 0;
+        uint32_t failed = 0;
+    };
+
+    KernelBuildCache() = default;
+    ~KernelBuildCache() = default;
+
+    // a missing or unreadable cache file starts an empty cache
+    void load (const std::filesystem::path& cacheFile)
+    {
+        cachePath = cacheFile;
+        entries.clear();
+
+        std::ifstream in (cacheFile);
+        if (!in) return;
+
+        try
+        {
+            json cache = json::parse (in);
+            if (cache.value ("version", 0u) != CacheVersion) return;
+            for (const auto& [output, hash] : cache["entries"].items())
+                entries[output] = hash.get<std::string>();
+        }
+        catch (const std::exception& e)
+        {
+            LOG (WARNING) << "Ignoring kernel build cache " << cacheFile.generic_string() << ": " << e.what();
+            entries.clear();
+        }
+    }
+
+    bool save() const
+    {
+        json cache;
+        cache["version"] = CacheVersion;
+        cache["entries"] = json::object();
+        for (const auto& [output, hash] : entries)
+            cache["entries"][output] = hash;
+
+        std::ofstream out (cachePath);
+        if (!out) return false;
+        out << cache.dump (4);
+        return static_cast<bool> (out);
+    }
+
+    void setIncludeFolders (const std::vector<std::filesystem::path>& folders) { includeFolders = folders; }
+
+    // hex hash of the job's source, its transitive includes and its command line
+    std::string jobHash (const Job& job)
+    {
+        std::vector<std::filesystem::path> files;
+        std::set<std::filesystem::path> visited;
+        collectDependencies (job.source, visited, files);
+
+        // the source comes first, the order of its includes must not matter
+        std::sort (files.begin() + 1, files.end());
+
+        uint64_t hash = fnv1a64 (nullptr, 0); // the offset basis
+        for (const auto& f : files)
+        {
+            const std::string path = f.generic_string();
+            const std::string contents = fileHash (f);
+            hash = fnv1a64 (path.data(), path.size(), hash);
+            hash = fnv1a64 (contents.data(), contents.size(), hash);
+        }
+        for (const auto& arg : job.args)
+        {
+            hash = fnv1a64 (arg.data(), arg.size(), hash);
+            hash = fnv1a64 ("\0", 1, hash); // keeps {"ab","c"} apart from {"a","bc"}
+        }
+
+        std::ostringstream hex;
+        hex << std::hex << std::setw (16) << std::setfill ('0') << hash;
+        return hex.str();
+    }
+
+    bool isUpToDate (const Job& job, const std::string& hash) const
+    {
+        auto it = entries.find (job.output.generic_string());
+        return it != entries.end() && it->second == hash && std::filesystem::exists (job.output);
+    }
+
+    // builds every stale job, saves the cache when anything was built
+    RunStats run (const std::vector<Job>& jobs, const Launcher& launch, uint32_t maxJobs = 0)
+    {
+        RunStats stats;
+
+        {
+            std::lock_guard<std::mutex> lock (memoMutex);
+            contentHashes.clear();
+            includeLists.clear();
+        }
+
+        std::vector<size_t> stale;
+        std::vector<std::string> hashes (jobs.size());
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            hashes[i] = jobHash (jobs[i]);
+            if (isUpToDate (jobs[i], hashes[i]))
+                ++stats.upToDate;
+            else
+                stale.push_back (i);
+        }
+
+        if (stale.empty()) return stats;
+
+        if (maxJobs == 0) maxJobs = std::max (1u, std::thread::hardware_concurrency());
+        maxJobs = std::min<uint32_t> (maxJobs, static_cast<uint32_t> (stale.size()));
+
+        std::vector<int> status (stale.size(), -1);
+        {
+            BS::thread_pool pool (maxJobs);
+            for (size_t s = 0; s < stale.size(); ++s)
+            {
+                pool.detach_task ([&, s]()
+                                  {
+                                      try
+                                      {
+                                          status[s] = launch (jobs[stale[s]]);
+                                      }
+                                      catch (const std::exception& e)
+                                      {
+                                          LOG (WARNING) << "Kernel job for " << jobs[stale[s]].source.filename().string() << " threw: " << e.what();
+                                      } });
+            }
+            pool.wait();
+        }
+
+        for (size_t s = 0; s < stale.size(); ++s)
+        {
+            const Job& job = jobs[stale[s]];
+            const std::string key = job.output.generic_string();
+            if (status[s] == 0 && std::filesystem::exists (job.output))
+            {
+                entries[key] = hashes[stale[s]];
+                ++stats.built;
+            }
+            else
+            {
+                // forget it so the next run retries even if an old output is still lying around
+                entries.erase (key);
+                ++stats.failed;
+                LOG (WARNING) << "Failed to build " << job.source.filename().string() << " (status " << status[s] << ")";
+            }
+        }
+
+        save();
+        return stats;
+    }
+
+    // resolved includes of 'file', in the order they appear
+    std::vector<std::filesystem::path> scanIncludes (const std::filesystem::path& file)
+    {
+        std::lock_guard<std::mutex> lock (memoMutex);
+        return scanIncludesLocked (file);
+    }
+
+ private:
+    static constexpr uint32_t CacheVersion = 1;
+
+    std::filesystem::path cachePath;
+    std::map<std::string, std::string> entries; // output -> hash
+    std::vector<std::filesystem::path> includeFolders;
+
+    std::mutex memoMutex;
+    std::map<std::filesystem::path, std::string> contentHashes;
+    std::map<std::filesystem::path, std::vector<std::filesystem::path>> includeLists;
+
+    static std::string readFile (const std::filesystem::path& file)
+    {
+        std::ifstream in (file, std::ios::binary);
+        return std::string (std::istreambuf_iterator<char> (in), std::istreambuf_iterator<char>());
+    }
+
+    std::string fileHash (const std::filesystem::path& file)
+    {
+        std::lock_guard<std::mutex> lock (memoMutex);
+        auto it = contentHashes.find (file);
+        if (it != contentHashes.end()) return it->second;
+
+        const std::string contents = readFile (file);
+        const uint64_t hash = fnv1a64 (contents.data(), contents.size());
+        return contentHashes[file] = std::to_string (hash);
+    }
+
+    void collectDependencies (const std::filesystem::path& file, std::set<std::filesystem::path>& visited, std::vector<std::filesystem::path>& files)
+    {
+        const std::filesystem::path canonical = std::filesystem::weakly_canonical (file);
+        if (!visited.insert (canonical).second) return;
+        files.push_back (canonical);
+
+        for (const auto& include : scanIncludes (canonical))
+            collectDependencies (include, visited, files);
+    }
+
+    std::vector<std::filesystem::path> scanIncludesLocked (const std::filesystem::path& file)
+    {
+        auto it = includeLists.find (file);
+        if (it != includeLists.end()) return it->second;
+
+        std::vector<std::filesystem::path> includes;
+        std::istringstream in (readFile (file));
+        std::string line;
+        while (std::getline (in, line))
+        {
+            // skip a UTF-8 byte order mark and leading whitespace
+            size_t pos = line.rfind ("\xEF\xBB\xBF", 0) == 0 ? 3 : 0;
+            pos = line.find_first_not_of (" \t", pos);
+            if (pos == std::string::npos || line[pos] != '#') continue;
+
+            pos = line.find_first_not_of (" \t", pos + 1);
+            if (pos == std::string::npos || line.compare (pos, 7, "include") != 0) continue;
+
+            pos = line.find_first_not_of (" \t", pos + 7);
+            if (pos == std::string::npos) continue;
+
+            const char open = line[pos];
+            const char close = open == '"' ? '"' : (open == '<' ? '>' : 0);
+            if (!close) continue;
+
+            const size_t end = line.find (close, pos + 1);
+            if (end == std::string::npos) continue;
+
+            const std::string name = line.substr (pos + 1, end - pos - 1);
+            if (auto resolved = resolveInclude (name, file.parent_path(), open == '"'))
+                includes.push_back (*resolved);
+        }
+
+        return includeLists[file] = includes;
+    }
+
+    std::optional<std::filesystem::path> resolveInclude (const std::string& name, const std::filesystem::path& fromFolder, bool quoted) const
+    {
+        std::error_code ec;
+        if (quoted)
+        {
+            std::filesystem::path candidate = fromFolder / name;
+            if (std::filesystem::is_regular_file (candidate, ec))
+                return std::filesystem::weakly_canonical (candidate);
+        }
+        for (const auto& folder : includeFolders)
+        {
+            std::filesystem::path candidate = folder / name;
+            if (std::filesystem::is_regular_file (candidate, ec))
+                return std::filesystem::weakly_canonical (candidate);
+        }
+        return std::nullopt;
+    }
+};
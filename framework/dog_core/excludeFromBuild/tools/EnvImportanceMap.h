@@ -0,0 +1,240 @@
+#pragma once
+
+// EnvImportanceMap builds the 2D piecewise constant distribution used to importance
+// sample the environment light, entirely on the CPU.
+//
+// Building:
+// - Each texel of the equirectangular map is weighted by luminance * sin(theta)
+// - Rows (the conditional distributions) are built in parallel on a thread pool,
+//   the marginal distribution over rows is built once all rows are done
+// - Prefix sums are accumulated in double so 16K wide rows stay accurate
+// - Rows that are completely black get a uniform distribution instead of NaNs,
+//   the marginal never picks them so they cost nothing
+//
+// Reduced maps:
+// - Very large maps can be reduced by a power of two before the CDFs are built
+// - Each coarse cell holds the mean weight of the texels it covers, which keeps
+//   the integral and the relative importance of every region intact
+//
+// Sampling:
+// - The layout matches the CDF variant of RegularConstantContinuousDistribution2D
+// - sample() and evaluatePDF() mirror the device code so results can be checked headless
+//
+// Header only and free of CUDA so unit tests can use it directly.
+
+class EnvImportanceMap
+{
+ public:
+    EnvImportanceMap() = default;
+    ~EnvImportanceMap() = default;
+
+    // texels: width x height texels of 'channels' floats, RGB first, negative values count as zero
+    // maxWidth: 0 keeps full resolution, otherwise the grid is halved until it is no wider than maxWidth
+    // pool: optional, a temporary pool is used when none is given, called from a pool thread
+    // the rows are built on that thread
+    void build (const float* texels, uint32_t width, uint32_t height, uint32_t channels = 4,
+                uint32_t maxWidth = 0, BS::thread_pool* pool = nullptr)
+    {
+        clear();
+        if (!texels || width == 0 || height == 0 || channels < 3) return;
+
+        reduction = 1;
+        while (maxWidth && (width + reduction - 1) / reduction > maxWidth)
+            reduction *= 2;
+
+        numD1 = (width + reduction - 1) / reduction;
+        numD2 = (height + reduction - 1) / reduction;
+
+        cellWeights.resize (static_cast<size_t> (numD1) * numD2);
+        conditionalPDF.resize (static_cast<size_t> (numD1) * numD2);
+        conditionalCDF.resize (static_cast<size_t> (numD1 + 1) * numD2);
+        rowIntegral.resize (numD2);
+
+        auto buildRows = [&] (const uint32_t start, const uint32_t end)
+        {
+            std::vector<double> cellSums (numD1);
+            for (uint32_t row = start; row < end; ++row)
+            {
+                std::fill (cellSums.begin(), cellSums.end(), 0.0);
+
+                const uint32_t yBegin = row * reduction;
+                const uint32_t yEnd = std::min (yBegin + reduction, height);
+                for (uint32_t y = yBegin; y < yEnd; ++y)
+                {
+                    const float sinTheta = std::sin (std::numbers::pi_v<float> * (y + 0.5f) / height);
+                    const float* src = texels + static_cast<size_t> (y) * width * channels;
+                    for (uint32_t x = 0; x < width; ++x)
+                    {
+                        const float* t = src + static_cast<size_t> (x) * channels;
+                        const float lum = 0.2126729f * std::max (t[0], 0.0f) +
+                                          0.7151522f * std::max (t[1], 0.0f) +
+                                          0.0721750f * std::max (t[2], 0.0f);
+                        cellSums[x / reduction] += lum * sinTheta;
+                    }
+                }
+
+                float* weights = &cellWeights[static_cast<size_t> (row) * numD1];
+                for (uint32_t cx = 0; cx < numD1; ++cx)
+                {
+                    const uint32_t xBegin = cx * reduction;
+                    const uint32_t xEnd = std::min (xBegin + reduction, width);
+                    const double count = static_cast<double> (xEnd - xBegin) * (yEnd - yBegin);
+                    weights[cx] = static_cast<float> (cellSums[cx] / count);
+                }
+
+                rowIntegral[row] = build1D (weights, numD1,
+                                            &conditionalPDF[static_cast<size_t> (row) * numD1],
+                                            &conditionalCDF[static_cast<size_t> (row) * (numD1 + 1)]);
+            }
+        };
+
+        if (BS::this_thread::get_pool())
+        {
+            // already on a pool thread, waiting on a pool from here could deadlock
+            buildRows (0u, numD2);
+        }
+        else if (pool)
+        {
+            // the pool may be shared, wait for these rows only
+            pool->submit_blocks (0u, numD2, buildRows).wait();
+        }
+        else
+        {
+            BS::thread_pool localPool;
+            localPool.detach_blocks (0u, numD2, buildRows);
+            localPool.wait();
+        }
+
+        marginalPDF.resize (numD2);
+        marginalCDF.resize (numD2 + 1);
+        marginalIntegral = build1D (rowIntegral.data(), numD2, marginalPDF.data(), marginalCDF.data());
+    }
+
+    void clear()
+    {
+        numD1 = numD2 = 0;
+        reduction = 1;
+        marginalIntegral = 0.0f;
+        cellWeights.clear();
+        conditionalPDF.clear();
+        conditionalCDF.clear();
+        rowIntegral.clear();
+        marginalPDF.clear();
+        marginalCDF.clear();
+    }
+
+    bool empty() const { return numD1 == 0; }
+
+    // grid dimensions, after any reduction
+    uint32_t width() const { return numD1; }
+    uint32_t height() const { return numD2; }
+
+    // source texels per grid cell along each axis
+    uint32_t reductionFactor() const { return reduction; }
+
+    // mean weight over the whole map
+    float integral() const { return marginalIntegral; }
+
+    // row major importance weights, width() entries per row
+    const std::vector<float>& weights() const { return cellWeights; }
+
+    // conditional distribution of a row, width() PDF and width() + 1 CDF entries
+    const float* rowPDF (uint32_t row) const { return &conditionalPDF[static_cast<size_t> (row) * numD1]; }
+    const float* rowCDF (uint32_t row) const { return &conditionalCDF[static_cast<size_t> (row) * (numD1 + 1)]; }
+
+    // packed conditionals, height() rows back to back
+    const std::vector<float>& rowPDFs() const { return conditionalPDF; }
+    const std::vector<float>& rowCDFs() const { return conditionalCDF; }
+    const std::vector<float>& rowIntegrals() const { return rowIntegral; }
+
+    // distribution over rows, height() PDF and height() + 1 CDF entries
+    const std::vector<float>& rowMarginalPDF() const { return marginalPDF; }
+    const std::vector<float>& rowMarginalCDF() const { return marginalCDF; }
+
+    // d0 is horizontal and d1 vertical, both in [0, 1)
+    void sample (float u0, float u1, float* d0, float* d1, float* probDensity) const
+    {
+        float topPDF;
+        *d1 = sample1D (marginalPDF.data(), marginalCDF.data(), numD2, u1, &topPDF);
+        const uint32_t row = std::min (static_cast<uint32_t> (*d1 * numD2), numD2 - 1);
+        *d0 = sample1D (rowPDF (row), rowCDF (row), numD1, u0, probDensity);
+        *probDensity *= topPDF;
+    }
+
+    float evaluatePDF (float d0, float d1) const
+    {
+        const uint32_t row = std::min (static_cast<uint32_t> (d1 * numD2), numD2 - 1);
+        const uint32_t col = std::min (static_cast<uint32_t> (d0 * numD1), numD1 - 1);
+        return marginalPDF[row] * rowPDF (row)[col];
+    }
+
+ private:
+    uint32_t numD1 = 0;
+    uint32_t numD2 = 0;
+    uint32_t reduction = 1;
+    float marginalIntegral = 0.0f;
+
+    std::vector<float> cellWeights;
+    std::vector<float> conditionalPDF;
+    std::vector<float> conditionalCDF;
+    std::vector<float> rowIntegral;
+    std::vector<float> marginalPDF;
+    std::vector<float> marginalCDF;
+
+    // same normalization as RegularConstantContinuousDistribution1D, returns the integral
+    static float build1D (const float* values, uint32_t n, float* PDF, float* CDF)
+    {
+        double sum = 0.0;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            CDF[i] = static_cast<float> (sum);
+            sum += values[i];
+        }
+
+        const double integral = sum / n;
+        if (!(integral > 0.0) || !std::isfinite (integral))
+        {
+            // nothing to importance sample, fall back to uniform
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                PDF[i] = 1.0f;
+                CDF[i] = static_cast<float> (i) / n;
+            }
+            CDF[n] = 1.0f;
+            return 0.0f;
+        }
+
+        const double invSum = 1.0 / sum;
+        const float invIntegral = static_cast<float> (1.0 / integral);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            PDF[i] = values[i] * invIntegral;
+            CDF[i] = static_cast<float> (CDF[i] * invSum);
+        }
+        CDF[n] = 1.0f;
+
+        return static_cast<float> (integral);
+    }
+
+    // mirrors shared::RegularConstantContinuousDistribution1D::sample
+    static float sample1D (const float* PDF, const float* CDF, uint32_t n, float u, float* probDensity)
+    {
+        uint32_t step = 1;
+        while (step < n)
+            step <<= 1;
+
+        uint32_t idx = 0;
+        for (uint32_t d = step >> 1; d >= 1; d >>= 1)
+        {
+            if (idx + d >= n)
+                continue;
+            if (CDF[idx + d] <= u)
+                idx += d;
+        }
+
+        const float t = (u - CDF[idx]) / (CDF[idx + 1] - CDF[idx]);
+        *probDensity = PDF[idx];
+        return (idx + t) / n;
+    }
+
+}; // end class EnvImportanceMap
@@ -10,10 +10,10 @@ GPUManager::GPUManager (const PropertyService& properties) :
     // Try to load the selected GPU index from properties
     try
     {
-        selectedGPUIndex = properties.renderProps->getVal<int> (RenderKey::SelectedGPUIndex);
+        selectedGPUIndex = properties.getRender<RenderKey::SelectedGPUIndex>();
 
         // Check if fake GPUs should be used (for testing)
-        useFakeGPUs = properties.renderProps->getVal<bool> (RenderKey::UseFakeGPUs);
+        useFakeGPUs = properties.getRender<RenderKey::UseFakeGPUs>();
 
         // Validate the index is in range
         if (selectedGPUIndex < 0 || selectedGPUIndex >= static_cast<int> (gpuInfo.size()))
@@ -40,7 +40,7 @@ GPUManager::GPUManager (const PropertyService& properties) :
     // Try to load the selected GPU index from properties
     try
     {
-        selectedGPUIndex = properties.renderProps->getVal<int> (RenderKey::SelectedGPUIndex);
+        selectedGPUIndex = properties.getRender<RenderKey::SelectedGPUIndex>();
 
         // Validate the index is in range
         if (selectedGPUIndex < 0 || selectedGPUIndex >= static_cast<int> (gpuInfo.size()))
@@ -74,7 +74,7 @@ bool GPUManager::initialize()
     // Always read the current setting when initializing
     try
     {
-        useFakeGPUs = properties.renderProps->getVal<bool> (RenderKey::UseFakeGPUs);
+        useFakeGPUs = properties.getRender<RenderKey::UseFakeGPUs>();
         LOG (DBUG) << "Initializing GPU manager with useFakeGPUs = " << (useFakeGPUs ? "true" : "false");
     }
     catch (...)
@@ -206,7 +206,7 @@ bool GPUManager::initialize()
     // Try to load the selected GPU index from properties
     try
     {
-        selectedGPUIndex = properties.renderProps->getVal<int> (RenderKey::SelectedGPUIndex);
+        selectedGPUIndex = properties.getRender<RenderKey::SelectedGPUIndex>();
 
         // Validate the index is in range
         if (selectedGPUIndex < 0 || selectedGPUIndex >= static_cast<int> (gpuInfo.size()))
@@ -227,7 +227,7 @@ bool GPUManager::initialize()
     // Update properties with current GPU count
     try
     {
-        properties.renderProps->setValue (RenderKey::GPUCount, static_cast<int> (gpuInfo.size()));
+        properties.setRender<RenderKey::GPUCount> (static_cast<int> (gpuInfo.size()));
     }
     catch (...)
     {
@@ -237,13 +237,13 @@ bool GPUManager::initialize()
     // Add fake GPUs for testing if enabled
     if (useFakeGPUs)
     {
-        int fakeCount = properties.renderProps->getVal<int> (RenderKey::FakeGPUCount);
+        int fakeCount = properties.getRender<RenderKey::FakeGPUCount>();
         if (fakeCount > 0)
         {
             generateFakeGPUs (fakeCount);
 
             // Update properties with new GPU count including fake ones
-            properties.renderProps->setValue (RenderKey::GPUCount, static_cast<int> (gpuInfo.size()));
+            properties.setRender<RenderKey::GPUCount> (static_cast<int> (gpuInfo.size()));
 
             LOG (DBUG) << "Added " << fakeCount << " fake GPUs for testing. Total GPUs: " << gpuInfo.size();
         }
@@ -692,7 +692,7 @@ void GPUManager::updateProperties()
 {
     try
     {
-        properties.renderProps->setValue (RenderKey::SelectedGPUIndex, selectedGPUIndex);
+        properties.setRender<RenderKey::SelectedGPUIndex> (selectedGPUIndex);
     }
     catch (...)
     {
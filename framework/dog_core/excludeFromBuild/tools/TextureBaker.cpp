@@ -0,0 +1,789 @@
+#include "TextureBaker.h"
+
+namespace
+{
+    // bump whenever the encoders or file layout change so stale bakes are ignored
+    constexpr uint32_t TEXTURE_BAKER_VERSION = 1;
+
+    constexpr float KAISER_ALPHA = 4.0f;
+
+    // 8 bit sRGB to linear, exact for every input value
+    const std::array<float, 256>& srgbToLinearTable()
+    {
+        static const std::array<float, 256> table = []
+        {
+            std::array<float, 256> t{};
+            for (int i = 0; i < 256; ++i)
+            {
+                float c = i / 255.0f;
+                t[i] = c <= 0.04045f ? c / 12.92f : std::pow ((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    uint8_t linearToSrgb8 (float v)
+    {
+        v = std::clamp (v, 0.0f, 1.0f);
+        float c = v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow (v, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t> (c * 255.0f + 0.5f);
+    }
+
+    uint8_t unorm8 (float v)
+    {
+        return static_cast<uint8_t> (std::clamp (v, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    // zeroth order modified Bessel function of the first kind
+    float besselI0 (float x)
+    {
+        float sum = 1.0f;
+        float term = 1.0f;
+        const float halfSq = 0.25f * x * x;
+        for (int k = 1; k < 32 && term > 1e-7f * sum; ++k)
+        {
+            term *= halfSq / static_cast<float> (k * k);
+            sum += term;
+        }
+        return sum;
+    }
+
+    // 8 tap 2:1 downsampling kernel, a Kaiser windowed sinc in destination pixel units
+    const std::array<float, 8>& kaiserTaps()
+    {
+        static const std::array<float, 8> taps = []
+        {
+            std::array<float, 8> t{};
+            const float radius = 2.0f;
+            float sum = 0.0f;
+            for (int i = 0; i < 8; ++i)
+            {
+                // source pixel centres sit at -3.5 .. 3.5 from the destination centre
+                const float x = (i - 3.5f) * 0.5f;
+                const float px = std::numbers::pi_v<float> * x;
+                const float sinc = std::abs (x) < 1e-6f ? 1.0f : std::sin (px) / px;
+                const float r = x / radius;
+                const float window = besselI0 (KAISER_ALPHA * std::sqrt (std::max (0.0f, 1.0f - r * r))) / besselI0 (KAISER_ALPHA);
+                t[i] = sinc * window;
+                sum += t[i];
+            }
+            for (float& w : t)
+                w /= sum;
+            return t;
+        }();
+        return taps;
+    }
+
+    using BlockRGBA = std::array<std::array<float, 4>, 16>;
+
+    void loadBlock (const std::vector<uint8_t>& rgba8, int width, int bx, int by, BlockRGBA& block)
+    {
+        for (int y = 0; y < 4; ++y)
+        {
+            const uint8_t* row = &rgba8[((by * 4 + y) * width + bx * 4) * 4];
+            for (int x = 0; x < 4; ++x)
+                for (int c = 0; c < 4; ++c)
+                    block[y * 4 + x][c] = row[x * 4 + c];
+        }
+    }
+
+    // dominant axis of the block's colour distribution by power iteration
+    // only the first N channels are considered
+    template <int N>
+    void principalAxis (const BlockRGBA& block, std::array<float, 4>& mean, std::array<float, 4>& axis)
+    {
+        mean = {0, 0, 0, 0};
+        for (const auto& p : block)
+            for (int c = 0; c < N; ++c)
+                mean[c] += p[c];
+        for (int c = 0; c < N; ++c)
+            mean[c] /= 16.0f;
+
+        float cov[N][N] = {};
+        std::array<float, 4> lo = {255, 255, 255, 255};
+        std::array<float, 4> hi = {0, 0, 0, 0};
+        for (const auto& p : block)
+        {
+            float d[N];
+            for (int c = 0; c < N; ++c)
+            {
+                d[c] = p[c] - mean[c];
+                lo[c] = std::min (lo[c], p[c]);
+                hi[c] = std::max (hi[c], p[c]);
+            }
+            for (int i = 0; i < N; ++i)
+                for (int j = 0; j < N; ++j)
+                    cov[i][j] += d[i] * d[j];
+        }
+
+        // start along the bounding box diagonal, it is never orthogonal to the answer in practice
+        axis = {0, 0, 0, 0};
+        for (int c = 0; c < N; ++c)
+            axis[c] = hi[c] - lo[c];
+
+        for (int iter = 0; iter < 8; ++iter)
+        {
+            std::array<float, 4> next = {0, 0, 0, 0};
+            for (int i = 0; i < N; ++i)
+                for (int j = 0; j < N; ++j)
+                    next[i] += cov[i][j] * axis[j];
+
+            float len = 0.0f;
+            for (int c = 0; c < N; ++c)
+                len += next[c] * next[c];
+            if (len < 1e-12f) break;
+
+            len = 1.0f / std::sqrt (len);
+            for (int c = 0; c < N; ++c)
+                axis[c] = next[c] * len;
+        }
+
+        float len = 0.0f;
+        for (int c = 0; c < N; ++c)
+            len += axis[c] * axis[c];
+        if (len > 1e-12f)
+        {
+            len = 1.0f / std::sqrt (len);
+            for (int c = 0; c < N; ++c)
+                axis[c] *= len;
+        }
+    }
+
+    // ---- BC1 ----
+
+    uint16_t packRGB565 (const std::array<float, 4>& c)
+    {
+        const int r = static_cast<int> (std::clamp (c[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+        const int g = static_cast<int> (std::clamp (c[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+        const int b = static_cast<int> (std::clamp (c[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+        return static_cast<uint16_t> ((r << 11) | (g << 5) | b);
+    }
+
+    std::array<float, 4> unpackRGB565 (uint16_t v)
+    {
+        const int r = (v >> 11) & 31;
+        const int g = (v >> 5) & 63;
+        const int b = v & 31;
+        return {static_cast<float> ((r << 3) | (r >> 2)),
+                static_cast<float> ((g << 2) | (g >> 4)),
+                static_cast<float> ((b << 3) | (b >> 2)),
+                255.0f};
+    }
+
+    void encodeBC1 (const BlockRGBA& block, uint8_t* out)
+    {
+        std::array<float, 4> mean, axis;
+        principalAxis<3> (block, mean, axis);
+
+        float tMin = std::numeric_limits<float>::max(), tMax = -std::numeric_limits<float>::max();
+        for (const auto& p : block)
+        {
+            const float t = (p[0] - mean[0]) * axis[0] + (p[1] - mean[1]) * axis[1] + (p[2] - mean[2]) * axis[2];
+            tMin = std::min (tMin, t);
+            tMax = std::max (tMax, t);
+        }
+
+        // pull the endpoints in slightly, the interpolated colours cover the extremes better
+        const float inset = (tMax - tMin) / 16.0f;
+        tMin += inset;
+        tMax -= inset;
+
+        std::array<float, 4> e0, e1;
+        for (int c = 0; c < 3; ++c)
+        {
+            e0[c] = mean[c] + axis[c] * tMax;
+            e1[c] = mean[c] + axis[c] * tMin;
+        }
+
+        uint16_t c0 = packRGB565 (e0);
+        uint16_t c1 = packRGB565 (e1);
+        if (c0 < c1) std::swap (c0, c1);
+
+        uint32_t indices = 0;
+        if (c0 != c1)
+        {
+            // c0 > c1 selects the 4 colour mode
+            std::array<std::array<float, 4>, 4> palette;
+            palette[0] = unpackRGB565 (c0);
+            palette[1] = unpackRGB565 (c1);
+            for (int c = 0; c < 3; ++c)
+            {
+                palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+                palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+            }
+
+            for (int i = 0; i < 16; ++i)
+            {
+                int best = 0;
+                float bestErr = std::numeric_limits<float>::max();
+                for (int k = 0; k < 4; ++k)
+                {
+                    float err = 0.0f;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const float d = block[i][c] - palette[k][c];
+                        err += d * d;
+                    }
+                    if (err < bestErr)
+                    {
+                        bestErr = err;
+                        best = k;
+                    }
+                }
+                indices |= static_cast<uint32_t> (best) << (2 * i);
+            }
+        }
+
+        out[0] = c0 & 0xff;
+        out[1] = c0 >> 8;
+        out[2] = c1 & 0xff;
+        out[3] = c1 >> 8;
+        for (int i = 0; i < 4; ++i)
+            out[4 + i] = (indices >> (8 * i)) & 0xff;
+    }
+
+    // ---- BC4 / BC5 ----
+
+    void encodeBC4 (const BlockRGBA& block, int channel, uint8_t* out)
+    {
+        float lo = 255.0f, hi = 0.0f;
+        for (const auto& p : block)
+        {
+            lo = std::min (lo, p[channel]);
+            hi = std::max (hi, p[channel]);
+        }
+
+        const uint8_t c0 = static_cast<uint8_t> (hi);
+        const uint8_t c1 = static_cast<uint8_t> (lo);
+        out[0] = c0;
+        out[1] = c1;
+
+        uint64_t indices = 0;
+        if (c0 > c1)
+        {
+            // c0 > c1 selects the 8 value mode, palette[k] for k >= 2 is ((8 - k) * c0 + (k - 1) * c1) / 7
+            const float scale = 7.0f / static_cast<float> (c0 - c1);
+            for (int i = 0; i < 16; ++i)
+            {
+                const int w = static_cast<int> ((block[i][channel] - c1) * scale + 0.5f);
+                const int index = w >= 7 ? 0 : (w <= 0 ? 1 : 8 - w);
+                indices |= static_cast<uint64_t> (index) << (3 * i);
+            }
+        }
+
+        for (int i = 0; i < 6; ++i)
+            out[2 + i] = (indices >> (8 * i)) & 0xff;
+    }
+
+    // ---- BC7 mode 6: one subset, RGBA 7.7.7.7 endpoints with a p-bit each, 4 bit indices ----
+
+    constexpr int BC7_WEIGHTS4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    struct BitWriter
+    {
+        uint8_t* out;
+        int bit = 0;
+
+        void write (uint32_t value, int count)
+        {
+            for (int i = 0; i < count; ++i, ++bit)
+                if ((value >> i) & 1) out[bit >> 3] |= static_cast<uint8_t> (1u << (bit & 7));
+        }
+    };
+
+    // 7 bit endpoint plus shared p-bit, whichever p-bit lands closer
+    void quantizeEndpointBC7 (const std::array<float, 4>& e, std::array<int, 4>& q, int& pbit, std::array<float, 4>& recon)
+    {
+        float bestErr = std::numeric_limits<float>::max();
+        for (int p = 0; p < 2; ++p)
+        {
+            std::array<int, 4> qp;
+            std::array<float, 4> rp;
+            float err = 0.0f;
+            for (int c = 0; c < 4; ++c)
+            {
+                qp[c] = std::clamp (static_cast<int> ((e[c] - p) * 0.5f + 0.5f), 0, 127);
+                rp[c] = static_cast<float> ((qp[c] << 1) | p);
+                const float d = rp[c] - e[c];
+                err += d * d;
+            }
+            if (err < bestErr)
+            {
+                bestErr = err;
+                q = qp;
+                pbit = p;
+                recon = rp;
+            }
+        }
+    }
+
+    float assignIndicesBC7 (const BlockRGBA& block, const std::array<float, 4>& r0, const std::array<float, 4>& r1, std::array<int, 16>& indices)
+    {
+        std::array<std::array<float, 4>, 16> palette;
+        for (int k = 0; k < 16; ++k)
+            for (int c = 0; c < 4; ++c)
+            {
+                const int v = ((64 - BC7_WEIGHTS4[k]) * static_cast<int> (r0[c]) + BC7_WEIGHTS4[k] * static_cast<int> (r1[c]) + 32) >> 6;
+                palette[k][c] = static_cast<float> (v);
+            }
+
+        float total = 0.0f;
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0;
+            float bestErr = std::numeric_limits<float>::max();
+            for (int k = 0; k < 16; ++k)
+            {
+                float err = 0.0f;
+                for (int c = 0; c < 4; ++c)
+                {
+                    const float d = block[i][c] - palette[k][c];
+                    err += d * d;
+                }
+                if (err < bestErr)
+                {
+                    bestErr = err;
+                    best = k;
+                }
+            }
+            indices[i] = best;
+            total += bestErr;
+        }
+        return total;
+    }
+
+    void encodeBC7 (const BlockRGBA& block, uint8_t* out)
+    {
+        std::array<float, 4> mean, axis;
+        principalAxis<4> (block, mean, axis);
+
+        float tMin = std::numeric_limits<float>::max(), tMax = -std::numeric_limits<float>::max();
+        for (const auto& p : block)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < 4; ++c)
+                t += (p[c] - mean[c]) * axis[c];
+            tMin = std::min (tMin, t);
+            tMax = std::max (tMax, t);
+        }
+
+        std::array<float, 4> e0, e1;
+        for (int c = 0; c < 4; ++c)
+        {
+            e0[c] = mean[c] + axis[c] * tMin;
+            e1[c] = mean[c] + axis[c] * tMax;
+        }
+
+        std::array<int, 4> q0, q1;
+        std::array<float, 4> r0, r1;
+        int p0 = 0, p1 = 0;
+        std::array<int, 16> indices;
+
+        quantizeEndpointBC7 (e0, q0, p0, r0);
+        quantizeEndpointBC7 (e1, q1, p1, r1);
+        float err = assignIndicesBC7 (block, r0, r1, indices);
+
+        // one least squares pass, solve for the endpoints that best fit the chosen indices
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            std::array<float, 4> ax = {0, 0, 0, 0}, bx = {0, 0, 0, 0};
+            for (int i = 0; i < 16; ++i)
+            {
+                const float w = BC7_WEIGHTS4[indices[i]] / 64.0f;
+                const float a = 1.0f - w;
+                aa += a * a;
+                ab += a * w;
+                bb += w * w;
+                for (int c = 0; c < 4; ++c)
+                {
+                    ax[c] += a * block[i][c];
+                    bx[c] += w * block[i][c];
+                }
+            }
+
+            const float det = aa * bb - ab * ab;
+            if (std::abs (det) > 1e-6f)
+            {
+                std::array<float, 4> l0, l1;
+                for (int c = 0; c < 4; ++c)
+                {
+                    l0[c] = std::clamp ((bb * ax[c] - ab * bx[c]) / det, 0.0f, 255.0f);
+                    l1[c] = std::clamp ((aa * bx[c] - ab * ax[c]) / det, 0.0f, 255.0f);
+                }
+
+                std::array<int, 4> lq0, lq1;
+                std::array<float, 4> lr0, lr1;
+                int lp0 = 0, lp1 = 0;
+                std::array<int, 16> lIndices;
+                quantizeEndpointBC7 (l0, lq0, lp0, lr0);
+                quantizeEndpointBC7 (l1, lq1, lp1, lr1);
+                const float lErr = assignIndicesBC7 (block, lr0, lr1, lIndices);
+                if (lErr < err)
+                {
+                    q0 = lq0;
+                    q1 = lq1;
+                    p0 = lp0;
+                    p1 = lp1;
+                    indices = lIndices;
+                }
+            }
+        }
+
+        // the anchor index only stores 3 bits, its top bit must be clear
+        if (indices[0] & 8)
+        {
+            std::swap (q0, q1);
+            std::swap (p0, p1);
+            for (int& i : indices)
+                i = 15 - i;
+        }
+
+        std::memset (out, 0, 16);
+        BitWriter bits{out};
+        bits.write (1u << 6, 7); // mode 6
+        for (int c = 0; c < 4; ++c)
+        {
+            bits.write (q0[c], 7);
+            bits.write (q1[c], 7);
+        }
+        bits.write (p0, 1);
+        bits.write (p1, 1);
+        bits.write (indices[0], 3);
+        for (int i = 1; i < 16; ++i)
+            bits.write (indices[i], 4);
+    }
+
+    dds::Format toDDSFormat (TextureBaker::Format format, bool sRGB)
+    {
+        switch (format)
+        {
+            case TextureBaker::Format::BC1:
+                return sRGB ? dds::Format::BC1_UNorm_sRGB : dds::Format::BC1_UNorm;
+            case TextureBaker::Format::BC4:
+                return dds::Format::BC4_UNorm;
+            case TextureBaker::Format::BC5:
+                return dds::Format::BC5_UNorm;
+            case TextureBaker::Format::BC7:
+            default:
+                return sRGB ? dds::Format::BC7_UNorm_sRGB : dds::Format::BC7_UNorm;
+        }
+    }
+} // namespace
+
+TextureBaker::TextureBaker (const std::filesystem::path& cacheFolder) :
+    cacheFolder (cacheFolder)
+{
+    LOG (DBUG) << _FN_;
+
+    std::error_code ec;
+    std::filesystem::create_directories (cacheFolder, ec);
+    if (ec)
+        LOG (WARNING) << "Could not create texture cache folder " << cacheFolder.generic_string() << ": " << ec.message();
+}
+
+std::filesystem::path TextureBaker::cachePath (const std::filesystem::path& sourcePath, const std::string& profile) const
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    if (!hashFileStamp (sourcePath, hash)) return {};
+
+    hash = fnv1a64 (profile.data(), profile.size(), hash);
+    hash = fnv1a64 (&TEXTURE_BAKER_VERSION, sizeof (TEXTURE_BAKER_VERSION), hash);
+
+    char name[17];
+    std::snprintf (name, sizeof (name), "%016llx", static_cast<unsigned long long> (hash));
+
+    return cacheFolder / std::string (name, 2) / (std::string (name) + ".dds");
+}
+
+TextureBaker::BakedTexture TextureBaker::bake (const uint8_t* pixels, int width, int height, int nchannels, const Options& options)
+{
+    BakedTexture baked;
+    if (!pixels || nchannels < 1 || nchannels > 4 || !canCompress (width, height))
+        return baked;
+
+    std::lock_guard<std::mutex> lock (bakeMutex);
+
+    baked.width = width;
+    baked.height = height;
+    baked.format = toDDSFormat (options.format, options.sRGB);
+
+    // level 0 is compressed straight from the source values
+    std::vector<uint8_t> rgba8 (static_cast<size_t> (width) * height * 4);
+    pool.detach_blocks (0, height,
+                        [&] (const int start, const int end)
+                        {
+                            for (int y = start; y < end; ++y)
+                            {
+                                for (int x = 0; x < width; ++x)
+                                {
+                                    const size_t i = static_cast<size_t> (y) * width + x;
+                                    for (int c = 0; c < 4; ++c)
+                                        rgba8[i * 4 + c] = c < nchannels ? pixels[i * nchannels + c] : (c == 3 ? 255 : 0);
+                                }
+                            }
+                        });
+    pool.wait();
+
+    compress (rgba8, width, height, options.format, baked.mips.emplace_back());
+
+    if (!options.generateMips || !canCompress (width / 2, height / 2))
+        return baked;
+
+    // the rest of the chain is filtered in float
+    const auto& toLinear = srgbToLinearTable();
+    Level level;
+    level.width = width;
+    level.height = height;
+    level.rgba.resize (rgba8.size());
+    pool.detach_blocks (size_t (0), rgba8.size() / 4,
+                        [&] (const size_t start, const size_t end)
+                        {
+                            for (size_t i = start; i < end; ++i)
+                            {
+                                for (int c = 0; c < 4; ++c)
+                                {
+                                    const uint8_t v = rgba8[i * 4 + c];
+                                    level.rgba[i * 4 + c] = (options.sRGB && c < 3) ? toLinear[v] : v / 255.0f;
+                                }
+                            }
+                        });
+    pool.wait();
+
+    while (canCompress (level.width / 2, level.height / 2))
+    {
+        level = downsample (level, options.mipFilter);
+        quantize (level, options.sRGB, rgba8);
+        compress (rgba8, level.width, level.height, options.format, baked.mips.emplace_back());
+    }
+
+    return baked;
+}
+
+TextureBaker::Level TextureBaker::downsample (const Level& src, MipFilter filter)
+{
+    Level dst;
+    dst.width = src.width / 2;
+    dst.height = src.height / 2;
+    dst.rgba.resize (static_cast<size_t> (dst.width) * dst.height * 4);
+
+    if (filter == MipFilter::Box)
+    {
+        pool.detach_blocks (0, dst.height,
+                            [&] (const int start, const int end)
+                            {
+                                for (int y = start; y < end; ++y)
+                                {
+                                    const float* r0 = &src.rgba[static_cast<size_t> (2 * y) * src.width * 4];
+                                    const float* r1 = r0 + static_cast<size_t> (src.width) * 4;
+                                    float* d = &dst.rgba[static_cast<size_t> (y) * dst.width * 4];
+                                    for (int x = 0; x < dst.width; ++x)
+                                        for (int c = 0; c < 4; ++c)
+                                            d[x * 4 + c] = 0.25f * (r0[x * 8 + c] + r0[x * 8 + 4 + c] + r1[x * 8 + c] + r1[x * 8 + 4 + c]);
+                                }
+                            });
+        pool.wait();
+        return dst;
+    }
+
+    // separable Kaiser, horizontal into tmp then vertical into dst, edges clamp
+    const auto& taps = kaiserTaps();
+    std::vector<float> tmp (static_cast<size_t> (dst.width) * src.height * 4);
+
+    pool.detach_blocks (0, src.height,
+                        [&] (const int start, const int end)
+                        {
+                            for (int y = start; y < end; ++y)
+                            {
+                                const float* s = &src.rgba[static_cast<size_t> (y) * src.width * 4];
+                                float* d = &tmp[static_cast<size_t> (y) * dst.width * 4];
+                                for (int x = 0; x < dst.width; ++x)
+                                {
+                                    float acc[4] = {0, 0, 0, 0};
+                                    for (int t = 0; t < 8; ++t)
+                                    {
+                                        const int sx = std::clamp (2 * x - 3 + t, 0, src.width - 1);
+                                        for (int c = 0; c < 4; ++c)
+                                            acc[c] += taps[t] * s[sx * 4 + c];
+                                    }
+                                    for (int c = 0; c < 4; ++c)
+                                        d[x * 4 + c] = acc[c];
+                                }
+                            }
+                        });
+    pool.wait();
+
+    pool.detach_blocks (0, dst.height,
+                        [&] (const int start, const int end)
+                        {
+                            const size_t stride = static_cast<size_t> (dst.width) * 4;
+                            for (int y = start; y < end; ++y)
+                            {
+                                float* d = &dst.rgba[y * stride];
+                                for (int t = 0; t < 8; ++t)
+                                {
+                                    const int sy = std::clamp (2 * y - 3 + t, 0, src.height - 1);
+                                    const float* s = &tmp[sy * stride];
+                                    for (size_t i = 0; i < stride; ++i)
+                                        d[i] += taps[t] * s[i];
+                                }
+
+                                // the negative lobes can ring below zero
+                                for (size_t i = 0; i < stride; ++i)
+                                    d[i] = std::max (d[i], 0.0f);
+                            }
+                        });
+    pool.wait();
+
+    return dst;
+}
+
+void TextureBaker::quantize (const Level& level, bool sRGB, std::vector<uint8_t>& rgba8)
+{
+    rgba8.resize (level.rgba.size());
+    pool.detach_blocks (size_t (0), level.rgba.size() / 4,
+                        [&] (const size_t start, const size_t end)
+                        {
+                            for (size_t i = start; i < end; ++i)
+                            {
+                                for (int c = 0; c < 4; ++c)
+                                {
+                                    const float v = level.rgba[i * 4 + c];
+                                    rgba8[i * 4 + c] = (sRGB && c < 3) ? linearToSrgb8 (v) : unorm8 (v);
+                                }
+                            }
+                        });
+    pool.wait();
+}
+
+void TextureBaker::compress (const std::vector<uint8_t>& rgba8, int width, int height, Format format, std::vector<uint8_t>& blocks)
+{
+    const int blocksX = width / 4;
+    const int blocksY = height / 4;
+    const size_t blockBytes = (format == Format::BC1 || format == Format::BC4) ? 8 : 16;
+    blocks.resize (static_cast<size_t> (blocksX) * blocksY * blockBytes);
+
+    pool.detach_blocks (0, blocksY,
+                        [&] (const int start, const int end)
+                        {
+                            BlockRGBA block;
+                            for (int by = start; by < end; ++by)
+                            {
+                                for (int bx = 0; bx < blocksX; ++bx)
+                                {
+                                    loadBlock (rgba8, width, bx, by, block);
+                                    uint8_t* out = &blocks[(static_cast<size_t> (by) * blocksX + bx) * blockBytes];
+                                    switch (format)
+                                    {
+                                        case Format::BC1:
+                                            encodeBC1 (block, out);
+                                            break;
+                                        case Format::BC4:
+                                            encodeBC4 (block, 0, out);
+                                            break;
+                                        case Format::BC5:
+                                            encodeBC4 (block, 0, out);
+                                            encodeBC4 (block, 1, out + 8);
+                                            break;
+                                        case Format::BC7:
+                                            encodeBC7 (block, out);
+                                            break;
+                                    }
+                                }
+                            }
+                        });
+    pool.wait();
+}
+
+bool TextureBaker::writeDDS (const BakedTexture& baked, const std::filesystem::path& ddsPath) const
+{
+    if (!baked.valid() || ddsPath.empty()) return false;
+
+    // DDS_HEADER preceded by the magic, then DDS_HEADER_DXT10
+    uint32_t header[32] = {};
+    header[0] = 0x20534444;                            // "DDS "
+    header[1] = 124;                                   // header size
+    header[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x80000;    // caps, height, width, pixel format, linear size
+    header[3] = static_cast<uint32_t> (baked.height);
+    header[4] = static_cast<uint32_t> (baked.width);
+    header[5] = static_cast<uint32_t> (baked.mips[0].size());
+    header[7] = static_cast<uint32_t> (baked.mipCount());
+    header[19] = 32;                                   // pixel format size
+    header[20] = 0x4;                                  // fourCC
+    header[21] = 0x30315844;                           // "DX10"
+    header[27] = 0x1000;                               // texture
+    if (baked.mipCount() > 1)
+    {
+        header[2] |= 0x20000;                          // mip map count
+        header[27] |= 0x8 | 0x400000;                  // complex, mip map
+    }
+
+    const uint32_t dx10[5] = {
+        static_cast<uint32_t> (baked.format),
+        3, // texture 2D
+        0,
+        1, // array size
+        0};
+
+    std::error_code ec;
+    std::filesystem::create_directories (ddsPath.parent_path(), ec);
+
+    std::ostringstream tmpName;
+    tmpName << ddsPath.stem().generic_string() << "." << std::this_thread::get_id() << ".tmp";
+    const std::filesystem::path tmp = ddsPath.parent_path() / tmpName.str();
+
+    {
+        std::ofstream ofs (tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open())
+        {
+            LOG (WARNING) << "Could not write baked texture " << tmp.generic_string();
+            return false;
+        }
+
+        ofs.write (reinterpret_cast<const char*> (header), sizeof (header));
+        ofs.write (reinterpret_cast<const char*> (dx10), sizeof (dx10));
+        for (const auto& mip : baked.mips)
+            ofs.write (reinterpret_cast<const char*> (mip.data()), static_cast<std::streamsize> (mip.size()));
+
+        if (!ofs.good())
+        {
+            ofs.close();
+            std::filesystem::remove (tmp, ec);
+            LOG (WARNING) << "Failed writing baked texture " << tmp.generic_string();
+            return false;
+        }
+    }
+
+    std::filesystem::rename (tmp, ddsPath, ec);
+    if (ec)
+    {
+        std::filesystem::remove (tmp, ec);
+        return std::filesystem::exists (ddsPath, ec);
+    }
+
+    return true;
+}
+
+void TextureBaker::bakeInBackground (std::shared_ptr<const void> owner, const uint8_t* pixels, int width, int height,
+                                     int nchannels, const Options& options, const std::filesystem::path& ddsPath)
+{
+    if (!pixels || ddsPath.empty() || !canCompress (width, height)) return;
+
+    {
+        std::lock_guard<std::mutex> lock (queuedMutex);
+        if (!queuedPaths.insert (ddsPath.generic_string()).second) return;
+    }
+
+    bakeQueue.detach_task (
+        [this, owner = std::move (owner), pixels, width, height, nchannels, options, ddsPath]
+        {
+            BakedTexture baked = bake (pixels, width, height, nchannels, options);
+            if (baked.valid() && writeDDS (baked, ddsPath))
+                LOG (DBUG) << "Baked " << ddsPath.filename().generic_string() << " with " << baked.mipCount() << " mips";
+            else
+                LOG (WARNING) << "Failed to bake " << ddsPath.generic_string();
+
+            std::lock_guard<std::mutex> lock (queuedMutex);
+            queuedPaths.erase (ddsPath.generic_string());
+        });
+}
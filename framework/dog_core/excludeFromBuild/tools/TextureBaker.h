@@ -0,0 +1,126 @@
+#pragma once
+
+// TextureBaker turns 8 bit source textures into GPU ready block compressed DDS files.
+//
+// Baking:
+// - Builds a full mip chain on the CPU with either a box or a Kaiser windowed sinc filter
+// - Colour data is filtered in linear space and re-encoded to sRGB per level
+// - Compresses every level to BC1, BC4, BC5 or BC7 (mode 6)
+// - Block rows are spread over a thread pool, the inner loops are plain float
+//   arithmetic over fixed size arrays so the compiler can vectorize them
+//
+// Caching:
+// - Baked textures are written as DX10 DDS files readable by dds::load()
+// - Cache entries are keyed on the source path, size, modification time and a
+//   profile string chosen by the caller, so edited sources are rebaked automatically
+// - bakeInBackground() bakes and writes the cache entry off the calling thread
+//
+// Block compressed formats need dimensions that are a multiple of 4, use
+// canCompress() before baking. The mip chain stops at the first level that
+// would break that rule.
+
+#include "../common/dds_loader.h"
+
+using TextureBakerPtr = std::shared_ptr<class TextureBaker>;
+
+class TextureBaker
+{
+ public:
+    enum class Format
+    {
+        BC1, // RGB, 4 bits per pixel
+        BC4, // single channel, 4 bits per pixel
+        BC5, // two channels, 8 bits per pixel, for tangent space normals
+        BC7  // RGBA, 8 bits per pixel
+    };
+
+    enum class MipFilter
+    {
+        Box,
+        Kaiser
+    };
+
+    struct Options
+    {
+        Format format = Format::BC7;
+        MipFilter mipFilter = MipFilter::Kaiser;
+        bool sRGB = true; // filter in linear space and tag the DDS as sRGB
+        bool generateMips = true;
+    };
+
+    // Compressed result, one tightly packed block buffer per mip level
+    struct BakedTexture
+    {
+        int32_t width = 0;
+        int32_t height = 0;
+        dds::Format format = dds::Format::BC7_UNorm;
+        std::vector<std::vector<uint8_t>> mips;
+
+        bool valid() const { return !mips.empty(); }
+        int32_t mipCount() const { return static_cast<int32_t> (mips.size()); }
+    };
+
+ public:
+    static TextureBakerPtr create (const std::filesystem::path& cacheFolder)
+    {
+        return std::make_shared<TextureBaker> (cacheFolder);
+    }
+
+    TextureBaker (const std::filesystem::path& cacheFolder);
+    ~TextureBaker() = default;
+
+    TextureBaker (const TextureBaker&) = delete;
+    TextureBaker& operator= (const TextureBaker&) = delete;
+
+    static bool canCompress (int width, int height)
+    {
+        return width >= 4 && height >= 4 && (width % 4) == 0 && (height % 4) == 0;
+    }
+
+    // Location of the cached DDS for this source and profile
+    // Returns an empty path if the source can't be found
+    std::filesystem::path cachePath (const std::filesystem::path& sourcePath, const std::string& profile) const;
+
+    // Compresses tightly packed 8 bit pixels with 1 to 4 channels
+    // Missing channels read as 0, missing alpha reads as opaque
+    BakedTexture bake (const uint8_t* pixels, int width, int height, int nchannels, const Options& options);
+
+    // Writes a DX10 DDS, via a temp file so readers never see a partial file
+    bool writeDDS (const BakedTexture& baked, const std::filesystem::path& ddsPath) const;
+
+    // Queues bake() and writeDDS() on a background thread and returns right away.
+    // owner keeps pixels alive until the bake is done. A path that is already
+    // queued is skipped
+    void bakeInBackground (std::shared_ptr<const void> owner, const uint8_t* pixels, int width, int height,
+                           int nchannels, const Options& options, const std::filesystem::path& ddsPath);
+
+    // Blocks until every queued bake has been written
+    void waitForBakes() { bakeQueue.wait(); }
+
+    const std::filesystem::path& getCacheFolder() const { return cacheFolder; }
+
+ private:
+    std::filesystem::path cacheFolder;
+    BS::thread_pool pool;
+    std::mutex bakeMutex; // bake() waits on the whole pool, one bake at a time
+
+    std::mutex queuedMutex;
+    std::unordered_set<std::string> queuedPaths;
+
+    // one thread, bakes go through one at a time anyway. Declared last so queued
+    // bakes finish before the pool and the members they use go away
+    BS::thread_pool bakeQueue{1};
+
+    // RGBA float working image for one mip level
+    struct Level
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<float> rgba;
+    };
+
+    Level downsample (const Level& src, MipFilter filter);
+    void quantize (const Level& level, bool sRGB, std::vector<uint8_t>& rgba8);
+    void compress (const std::vector<uint8_t>& rgba8, int width, int height, Format format, std::vector<uint8_t>& blocks);
+
+}; // end class TextureBaker
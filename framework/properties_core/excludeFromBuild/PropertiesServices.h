@@ -14,9 +14,11 @@ class PropertyService
     void init()
     {
         renderProps = std::make_shared<RenderProperties>();
+        renderPropsMutex = std::make_shared<std::mutex>();
+        renderState = std::make_shared<RenderStateStore>();
 
         // Initialize other property containers as needed
-        // ioProps = std::make_shared<IOProperties>();
+        ioProps = std::make_shared<IOProperties>();
         // worldProps = std::make_shared<WorldProperties>();
         paintProps = std::make_shared<PaintProperties>();
         physicsProps = std::make_shared<PhysicsProperties>();
@@ -28,6 +30,8 @@ class PropertyService
     // Reset all properties to their default values
     void resetProperties()
     {
+        if (renderState) renderState->reset();
+
         initRenderProperties();
         initPathProperties();
         initEnvironmentProperties();
@@ -36,8 +40,8 @@ class PropertyService
         initMaterialProperties();
         initPaintProperties(); 
         initPhysicsProperties();
+        initIOProperties();
         /*   Initialize other property categories when implementing them
-           initIOProperties();
            initWorldProperties();
            initPaintProperties();
            initFlexProperties();*/
@@ -69,6 +73,9 @@ class PropertyService
         renderProps->addDefault (RenderKey::UseFakeGPUs, DEFAULT_USE_FAKE_GPUS);
         renderProps->addDefault (RenderKey::FakeGPUCount, DEFAULT_FAKE_GPU_COUNT);
         renderProps->addDefault (RenderKey::RenderBuffer, DEFAULT_RENDER_BUFFER);
+        renderProps->addDefault (RenderKey::MaxRadiance, DEFAULT_MAX_RADIANCE);
+        renderProps->addDefault (RenderKey::AreaLightPower, DEFAULT_AREA_LIGHT_POWER);
+        renderProps->addDefault (RenderKey::EnableAreaLights, DEFAULT_ENABLE_AREA_LIGHTS);
     }
 
     // Initialize path-related properties
@@ -194,25 +201,53 @@ class PropertyService
         physicsProps->addDefault (PhysicsKeys::ImpulseSpeed, sabi::DEFAULT_IMPULSE_SPEED);
     }
 
-    // Check if a path property is set (non-empty)
-    bool isPathSet (RenderKey key) const
+    // Initialize IO-related properties
+    void initIOProperties()
     {
-        try
-        {
-            return !renderProps->getValOr<std::string> (key, "").empty();
-        }
-        catch (...)
+        ioProps->addDefault (IOKey::SceneIconCount, DEFAULT_ICON_COUNT);
+        ioProps->addDefault (IOKey::ModelIconCount, DEFAULT_ICON_COUNT);
+        ioProps->addDefault (IOKey::EnviroIconCount, DEFAULT_ICON_COUNT);
+        ioProps->addDefault (IOKey::TextureIconCount, DEFAULT_ICON_COUNT);
+    }
+
+    // Typed write of a render property
+    // Publishes a new renderState snapshot for the render thread and keeps renderProps in step,
+    // the value is converted to the member type so both stores always agree on it
+    template <RenderKey KEY, typename VALUE>
+    void setRender (VALUE&& value) const
+    {
+        using Type = RenderStateStore::FieldType<KEY>;
+        Type typed = static_cast<Type> (std::forward<VALUE> (value));
         {
-            return false;
+            std::lock_guard<std::mutex> lock (*renderPropsMutex);
+            renderProps->setValue (KEY, typed);
         }
+        renderState->set<KEY> (std::move (typed));
+    }
+
+    // Typed read of a single render property, use renderState->read() when several must agree
+    template <RenderKey KEY>
+    RenderStateStore::FieldType<KEY> getRender() const
+    {
+        return renderState->get<KEY>();
+    }
+
+    // Check if a path property is set (non-empty)
+    template <RenderKey KEY>
+    bool isPathSet() const
+    {
+        static_assert (std::is_same_v<RenderStateStore::FieldType<KEY>, std::string>, "not a path property");
+        return !renderState->get<KEY>().empty();
     }
 
     // Ensure a path exists by creating directories if needed
-    bool ensurePathExists (RenderKey key)
+    template <RenderKey KEY>
+    bool ensurePathExists() const
     {
+        static_assert (std::is_same_v<RenderStateStore::FieldType<KEY>, std::string>, "not a path property");
         try
         {
-            std::string path = renderProps->getValOr<std::string> (key, "");
+            const std::string path = renderState->get<KEY>();
             if (path.empty()) return false;
 
             fs::path dirPath (path);
@@ -230,10 +265,18 @@ class PropertyService
     }
 
     // Property containers - only RenderProps implemented as requested
+    // Legacy untyped store, kept in step by setRender() for code that still reads it by key.
+    // It is not thread safe, anything that can run off the UI thread reads renderState instead
     std::shared_ptr<RenderProperties> renderProps = nullptr;
+    // Serializes setRender() writes into renderProps, shared like renderProps so every copy
+    // of the service takes the same lock
+    std::shared_ptr<std::mutex> renderPropsMutex = nullptr;
+
+    // Snapshot published typed copy of the render properties, safe to read from any thread
+    RenderStateRef renderState = nullptr;
 
     // Placeholders for other property containers
-    // std::shared_ptr<IOProperties> ioProps = nullptr;
+    std::shared_ptr<IOProperties> ioProps = nullptr;
     // std::shared_ptr<WorldProperties> worldProps = nullptr;
      std::shared_ptr<PaintProperties> paintProps = nullptr;
      std::shared_ptr<PhysicsProperties> physicsProps = nullptr;
@@ -0,0 +1,156 @@
+#pragma once
+
+// Typed, snapshot published mirror of the RenderKey properties.
+// The render thread takes one snapshot per frame with renderState->read() and reads members
+// directly, the UI publishes changes through PropertyService::setRender().
+// Every member starts at the same default as the matching RenderProperties entry.
+
+struct RenderState
+{
+    // render settings
+    bool showPerformanceGraph = true;
+    double renderTime = DEFAULT_RENDER_TIME;
+    uint32_t renderPasses = DEFAULT_RENDER_PASSES;
+    RenderMode renderMode = DEFAULT_RENDER_MODE;
+    RenderPlaybackMode renderPlaybackType = DEFAULT_RENDER_PLAYBACK_MODE;
+    bool autoRender = DEFAULT_AUTO_RENDER;
+    uint32_t bounceLimit = DEFAULT_BOUNCE_LIMIT;
+    bool saveRender = DEFAULT_SAVE_RENDER;
+    bool softwareReleaseMode = DEFAULT_SOFTWARE_RELEASE_MODE;
+    bool useEmbeddedPTX = DEFAULT_USE_EMBEDDED_PTX;
+    PreviewScaleFactor renderScale = DEFAULT_RENDER_SCALE;
+    Eigen::Vector2i renderSize = DEFAULT_RENDER_SIZE;
+    double renderDownsampledSize = DEFAULT_RENDER_DOWNSAMPLED_PERCENT;
+    bool resizeOnGPU = DEFAULT_RESIZE_ON_GPU;
+    bool screengrab = DEFAULT_DO_SCREEN_GRAB;
+    ImageFileFormat screengrabFormat = DEFAULT_SCREENGRAB_FORMAT;
+    bool useTimestampedSubfolders = DEFAULT_USE_TIMESTAMPED_SUBFOLDERS;
+    bool renderingAnimation = DEFAULT_RENDERING_ANIMATION;
+    RenderBuffer renderBuffer = DEFAULT_RENDER_BUFFER;
+    float maxRadiance = DEFAULT_MAX_RADIANCE;
+
+    // GPU selection
+    std::string cudaTargetArchitectures = DEFAULT_CUDA_GPU_ARCHITECTURES;
+    int selectedGPUIndex = DEFAULT_SELECTED_GPU_INDEX;
+    bool useFakeGPUs = DEFAULT_USE_FAKE_GPUS;
+    int fakeGPUCount = DEFAULT_FAKE_GPU_COUNT;
+    int gpuCount = 0;
+
+    // paths
+    std::string resourceFolder = UNSET_PATH;
+    std::string commonFolder = UNSET_PATH;
+    std::string contentFolder = UNSET_PATH;
+    std::string repoFolder = UNSET_PATH;
+    std::string externalContentFolder = UNSET_PATH;
+    std::string rootFolder = UNSET_PATH;
+    std::string ptxFolder = UNSET_PATH;
+    std::string framegrabFolder = UNSET_PATH;
+    std::string textureFolder = UNSET_PATH;
+    std::string gltfModelFolder = UNSET_PATH;
+    std::string renderRootFolder = UNSET_PATH;
+    std::string renderCurrentSubfolder = UNSET_PATH;
+    std::string screengrabFolder = UNSET_PATH;
+    std::string playbackLoadFolder = UNSET_PATH;
+    std::string hdrImagePath = UNSET_PATH;
+
+    // environment
+    double enviroRotation = DEFAULT_ENVIRO_ROTATION;
+    double enviroIntensity = DEFAULT_ENVIRO_INTENSITY_PERCENT;
+    bool renderEnviro = DEFAULT_RENDER_ENVIRO;
+    Eigen::Vector3d backgroundColor = DEFAULT_BACKGROUND_COLOR;
+    EnviroRotDir enviroRotationDirection = DEFAULT_ENVIRO_ROTATE_DIR;
+    double enviroRotationSpeed = DEFAULT_ENVIRO_ROTATE_SPEED;
+
+    // area lights
+    float areaLightPower = DEFAULT_AREA_LIGHT_POWER;
+    bool enableAreaLights = DEFAULT_ENABLE_AREA_LIGHTS;
+
+    // playback
+    bool loopPlayback = DEFAULT_LOOP_PLAYBACK;
+    PlaybackDirection playbackDirection = DEFAULT_PLAYBACK_DIR;
+    uint32_t playbackRate = DEFAULT_PLAYBACK_FPS;
+    uint32_t renderStartFrame = DEFAULT_RENDER_START_FRAME;
+    uint32_t renderEndFrame = DEFAULT_RENDER_END_FRAME;
+
+    // camera
+    double aperture = DEFAULT_APERTURE;
+    double focalLength = DEFAULT_FOCAL_DIST;
+    Eigen::Affine3f cameraPose = Eigen::Affine3f::Identity();
+
+    // materials
+    bool makeGlassScene = DEFAULT_GLASS_SCENE;
+    double glassAbsorption = DEFAULT_GLASS_ABSORPTION;
+    double glassIOR = DEFAULT_GLASS_IOR;
+    GlassKind glassType = DEFAULT_GLASS_KIND;
+};
+
+PROPERTY_FIELD (RenderState, RenderKey::ShowPerformanceGraph, showPerformanceGraph)
+PROPERTY_FIELD (RenderState, RenderKey::RenderTime, renderTime)
+PROPERTY_FIELD (RenderState, RenderKey::RenderPasses, renderPasses)
+PROPERTY_FIELD (RenderState, RenderKey::RenderMode, renderMode)
+PROPERTY_FIELD (RenderState, RenderKey::RenderPlaybackType, renderPlaybackType)
+PROPERTY_FIELD (RenderState, RenderKey::AutoRender, autoRender)
+PROPERTY_FIELD (RenderState, RenderKey::BounceLimit, bounceLimit)
+PROPERTY_FIELD (RenderState, RenderKey::SaveRender, saveRender)
+PROPERTY_FIELD (RenderState, RenderKey::SoftwareReleaseMode, softwareReleaseMode)
+PROPERTY_FIELD (RenderState, RenderKey::UseEmbeddedPTX, useEmbeddedPTX)
+PROPERTY_FIELD (RenderState, RenderKey::RenderScale, renderScale)
+PROPERTY_FIELD (RenderState, RenderKey::RenderSize, renderSize)
+PROPERTY_FIELD (RenderState, RenderKey::RenderDownsampledSize, renderDownsampledSize)
+PROPERTY_FIELD (RenderState, RenderKey::ResizeOnGPU, resizeOnGPU)
+PROPERTY_FIELD (RenderState, RenderKey::Screengrab, screengrab)
+PROPERTY_FIELD (RenderState, RenderKey::ScreengrabFormat, screengrabFormat)
+PROPERTY_FIELD (RenderState, RenderKey::UseTimestampedSubfolders, useTimestampedSubfolders)
+PROPERTY_FIELD (RenderState, RenderKey::RenderingAnimation, renderingAnimation)
+PROPERTY_FIELD (RenderState, RenderKey::RenderBuffer, renderBuffer)
+PROPERTY_FIELD (RenderState, RenderKey::MaxRadiance, maxRadiance)
+
+PROPERTY_FIELD (RenderState, RenderKey::CudaTargetArchitectures, cudaTargetArchitectures)
+PROPERTY_FIELD (RenderState, RenderKey::SelectedGPUIndex, selectedGPUIndex)
+PROPERTY_FIELD (RenderState, RenderKey::UseFakeGPUs, useFakeGPUs)
+PROPERTY_FIELD (RenderState, RenderKey::FakeGPUCount, fakeGPUCount)
+PROPERTY_FIELD (RenderState, RenderKey::GPUCount, gpuCount)
+
+PROPERTY_FIELD (RenderState, RenderKey::ResourceFolder, resourceFolder)
+PROPERTY_FIELD (RenderState, RenderKey::CommonFolder, commonFolder)
+PROPERTY_FIELD (RenderState, RenderKey::ContentFolder, contentFolder)
+PROPERTY_FIELD (RenderState, RenderKey::RepoFolder, repoFolder)
+PROPERTY_FIELD (RenderState, RenderKey::ExternalContentFolder, externalContentFolder)
+PROPERTY_FIELD (RenderState, RenderKey::RootFolder, rootFolder)
+PROPERTY_FIELD (RenderState, RenderKey::PtxFolder, ptxFolder)
+PROPERTY_FIELD (RenderState, RenderKey::FramegrabFolder, framegrabFolder)
+PROPERTY_FIELD (RenderState, RenderKey::TextureFolder, textureFolder)
+PROPERTY_FIELD (RenderState, RenderKey::GltfModelFolder, gltfModelFolder)
+PROPERTY_FIELD (RenderState, RenderKey::RenderRootFolder, renderRootFolder)
+PROPERTY_FIELD (RenderState, RenderKey::RenderCurrentSubfolder, renderCurrentSubfolder)
+PROPERTY_FIELD (RenderState, RenderKey::ScreengrabFolder, screengrabFolder)
+PROPERTY_FIELD (RenderState, RenderKey::PlaybackLoadFolder, playbackLoadFolder)
+PROPERTY_FIELD (RenderState, RenderKey::HDRImagePath, hdrImagePath)
+
+PROPERTY_FIELD (RenderState, RenderKey::EnviroRotation, enviroRotation)
+PROPERTY_FIELD (RenderState, RenderKey::EnviroIntensity, enviroIntensity)
+PROPERTY_FIELD (RenderState, RenderKey::RenderEnviro, renderEnviro)
+PROPERTY_FIELD (RenderState, RenderKey::BackgroundColor, backgroundColor)
+PROPERTY_FIELD (RenderState, RenderKey::EnviroRotationDirection, enviroRotationDirection)
+PROPERTY_FIELD (RenderState, RenderKey::EnviroRotationSpeed, enviroRotationSpeed)
+
+PROPERTY_FIELD (RenderState, RenderKey::AreaLightPower, areaLightPower)
+PROPERTY_FIELD (RenderState, RenderKey::EnableAreaLights, enableAreaLights)
+
+PROPERTY_FIELD (RenderState, RenderKey::LoopPlayback, loopPlayback)
+PROPERTY_FIELD (RenderState, RenderKey::PlaybackDirection, playbackDirection)
+PROPERTY_FIELD (RenderState, RenderKey::PlaybackRate, playbackRate)
+PROPERTY_FIELD (RenderState, RenderKey::RenderStartFrame, renderStartFrame)
+PROPERTY_FIELD (RenderState, RenderKey::RenderEndFrame, renderEndFrame)
+
+PROPERTY_FIELD (RenderState, RenderKey::Aperture, aperture)
+PROPERTY_FIELD (RenderState, RenderKey::FocalLength, focalLength)
+PROPERTY_FIELD (RenderState, RenderKey::CameraPose, cameraPose)
+
+PROPERTY_FIELD (RenderState, RenderKey::MakeGlassScene, makeGlassScene)
+PROPERTY_FIELD (RenderState, RenderKey::GlassAbsorption, glassAbsorption)
+PROPERTY_FIELD (RenderState, RenderKey::GlassIOR, glassIOR)
+PROPERTY_FIELD (RenderState, RenderKey::GlassType, glassType)
+
+using RenderStateStore = PropertySnapshots<RenderState>;
+using RenderStateRef = std::shared_ptr<RenderStateStore>;
@@ -4,6 +4,7 @@
 
 // keep properties out of any namespace for now
 #include "excludeFromBuild/RenderProps.h"
+#include "excludeFromBuild/RenderState.h"
 #include "excludeFromBuild/IOProps.h"
 #include "excludeFromBuild/WorldProps.h"
 #include "excludeFromBuild/PaintProps.h"
@@ -8,6 +8,14 @@ namespace qms
         queue q;
 
     public:
+        receiver() = default;
+
+        // names the queue's depth counter in the trace, see qms::queue
+        explicit receiver (const char* depthCounter) :
+            q (depthCounter)
+        {
+        }
+
         operator sender()
         {
             return sender(&q);
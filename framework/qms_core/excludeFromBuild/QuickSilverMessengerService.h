@@ -2,7 +2,7 @@
 
 // quicksilver messenger service
 #include "QmsData.h"
-#include "QmsQueue.h"
+#include "qmsqueue.h"
 #include "QmsSender.h"
 #include "QmsDispatcherT.h"
 #include "QmsDispatcher.h"
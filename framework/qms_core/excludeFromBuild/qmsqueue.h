@@ -35,7 +35,17 @@ namespace qms
         QmsID lastID = QmsID::Invalid;
         QmsID lastRealID = QmsID::Invalid;
 
+        // trace counter for this queue's depth, must be a string literal since the
+        // tracer keeps the pointer, queues sharing a name share one counter track
+        const char* depthCounter = "qms queue depth";
+
      public:
+        queue() = default;
+        explicit queue (const char* depthCounter) :
+            depthCounter (depthCounter)
+        {
+        }
+
         template <typename T>
         void push (T const& msg)
         {
@@ -81,11 +91,14 @@ namespace qms
             lastRealID = msg.realID;
             lastID = msg.id;
 
+            TRACE_COUNTER (depthCounter, q.size());
+
             c.notify_all();
         }
 
         std::shared_ptr<message_base> wait_and_pop()
         {
+            TRACE_SCOPE_CAT ("qms", "qms::waitForMessage");
             std::unique_lock<std::mutex> lk (m);
             c.wait (lk, [&]
                     { return !q.empty(); });
@@ -96,6 +109,7 @@ namespace qms
 
         std::shared_ptr<message_base> wait_and_pop_back()
         {
+            TRACE_SCOPE_CAT ("qms", "qms::waitForMessage");
             std::unique_lock<std::mutex> lk (m);
             c.wait (lk, [&]
                     { return !q.empty(); });
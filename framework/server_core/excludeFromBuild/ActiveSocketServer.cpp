@@ -23,6 +23,7 @@ void ActiveSocketServer::start()
 void ActiveSocketServer::messageLoop()
 {
     LOG (DBUG) << "ActiveSocketServer thread is starting up";
+    Tracer::setThreadName ("ActiveSocketServer");
     shutdown = false;
 
     while (!shutdown)
@@ -23,7 +23,7 @@ class ActiveSocketServer
     std::unique_ptr<SocketServerImpl> impl;
 
     // Messaging
-    MsgReceiver incoming;
+    MsgReceiver incoming{"qms queue depth: SocketServer"};
     MessageService messengers;
 
     // Thread management
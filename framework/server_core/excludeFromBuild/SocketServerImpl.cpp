@@ -214,6 +214,8 @@ bool SocketServerImpl::checkClientData (SocketHandle clientSocket, bool& disconn
 
 void SocketServerImpl::processClientData (SocketHandle clientSocket, const std::string& data)
 {
+    TRACE_SCOPE_CAT ("socket", "SocketServerImpl::processClientData");
+
     // Get or create client data
     auto& clientData = clientDataMap[clientSocket];
 
@@ -232,7 +234,7 @@ void SocketServerImpl::processClientData (SocketHandle clientSocket, const std::
 
         // Add to lock-free queue
         moodyMessages.enqueue (message);
-        LOG (DBUG) << "Added to moody queue: " << message;
+        LOG_EVERY_MS (DBUG, 250) << "Added to moody queue: " << message;
 
         // Handle special commands with immediate response
         if (message == "ping")
@@ -0,0 +1,182 @@
+#pragma once
+
+// LogFilter sits on top of g3log and keeps logging out of the hot paths.
+//
+// Compile time filtering:
+// - LOG statements below MACE_LOG_MIN_LEVEL are discarded by the compiler, the message is
+//   never formatted and the g3log level check never runs
+// - Levels are matched by name (DBUG 100, INFO 300, TESTING 301, WARNING 500, CRITICAL 501,
+//   FATAL 1000), a level passed in a variable is always compiled and filtered at runtime
+// - Release builds set MACE_LOG_MIN_LEVEL=300 in premake, so LOG (DBUG) costs nothing there
+//
+// Per site variants, each call site keeps its own state:
+//   LOG_ONCE (WARNING) << "only the first time";
+//   LOG_EVERY_N (DBUG, 100) << "every 100th call";
+//   LOG_EVERY_MS (DBUG, 1000) << "at most once a second";
+// The rate limited variants prefix the message with the number of calls dropped since the
+// last one that got through.
+//
+// Aggregate counters log one summary line when they go out of scope:
+//   LOG_TALLY (degenerate, WARNING, "degenerate triangles skipped");
+//   for (...) if (bad) degenerate.add();
+// prints "512 degenerate triangles skipped", nothing at all if the count is zero.
+
+#ifndef MACE_LOG_MIN_LEVEL
+#define MACE_LOG_MIN_LEVEL 0
+#endif
+
+namespace mace_log
+{
+    // value of a g3log level given its name, unknown names are never compiled out
+    constexpr int levelValue (std::string_view name)
+    {
+        if (name == "DBUG" || name == "DEBUG") return 100;
+        if (name == "INFO") return 300;
+        if (name == "TESTING") return 301;
+        if (name == "WARNING") return 500;
+        if (name == "CRITICAL") return 501;
+        if (name == "FATAL") return 1000;
+        return std::numeric_limits<int>::max();
+    }
+
+    constexpr bool isCompiled (std::string_view name) { return levelValue (name) >= MACE_LOG_MIN_LEVEL; }
+
+    class Once
+    {
+     public:
+        bool allow() { return !done.exchange (true, std::memory_order_relaxed); }
+
+     private:
+        std::atomic<bool> done = false;
+    };
+
+    class EveryN
+    {
+     public:
+        bool allow (uint64_t n, uint64_t& suppressed)
+        {
+            const uint64_t call = calls.fetch_add (1, std::memory_order_relaxed);
+            if (n > 1 && call % n) return false;
+            suppressed = call ? std::max<uint64_t> (n, 1) - 1 : 0;
+            return true;
+        }
+
+     private:
+        std::atomic<uint64_t> calls = 0;
+    };
+
+    class RateLimit
+    {
+     public:
+        bool allow (int64_t intervalMs, uint64_t& suppressed)
+        {
+            const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds> (
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count();
+
+            int64_t previous = last.load (std::memory_order_relaxed);
+            if (previous != NEVER && now - previous < intervalMs)
+            {
+                dropped.fetch_add (1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // another thread got there first
+            if (!last.compare_exchange_strong (previous, now, std::memory_order_relaxed))
+            {
+                dropped.fetch_add (1, std::memory_order_relaxed);
+                return false;
+            }
+
+            suppressed = dropped.exchange (0, std::memory_order_relaxed);
+            return true;
+        }
+
+     private:
+        static constexpr int64_t NEVER = std::numeric_limits<int64_t>::min();
+        std::atomic<int64_t> last = NEVER;
+        std::atomic<uint64_t> dropped = 0;
+    };
+
+    struct Suppressed
+    {
+        uint64_t count = 0;
+    };
+
+    inline std::ostream& operator<< (std::ostream& out, const Suppressed& s)
+    {
+        if (s.count) out << "(+" << s.count << " suppressed) ";
+        return out;
+    }
+
+    // Counts events and logs the total once, from the site that declared it
+    class Tally
+    {
+     public:
+        Tally (const LEVELS& level, const char* message, const char* file, int line, const char* function) :
+            level (level),
+            message (message),
+            file (file),
+            line (line),
+            function (function)
+        {
+        }
+
+        ~Tally()
+        {
+            const uint64_t total = count.load (std::memory_order_relaxed);
+            if (total && g3::logLevel (level))
+                LogCapture (file, line, function, level).stream() << total << " " << message;
+        }
+
+        Tally (const Tally&) = delete;
+        Tally& operator= (const Tally&) = delete;
+
+        void add (uint64_t n = 1) { count.fetch_add (n, std::memory_order_relaxed); }
+        uint64_t total() const { return count.load (std::memory_order_relaxed); }
+
+     private:
+        const LEVELS& level;
+        const char* message;
+        const char* file;
+        int line;
+        const char* function;
+        std::atomic<uint64_t> count = 0;
+    };
+
+} // namespace mace_log
+
+// one static T per expansion, each lambda is a distinct type
+#define MACE_LOG_SITE(T) ([]() -> T& { static T site; return site; }())
+
+#undef LOG
+#define LOG(level)                                   \
+    if constexpr (!mace_log::isCompiled (#level)) {} \
+    else if (!g3::logLevel (level)) {}               \
+    else INTERNAL_LOG_MESSAGE (level).stream()
+
+#undef LOG_IF
+#define LOG_IF(level, boolean_expression)                                  \
+    if constexpr (!mace_log::isCompiled (#level)) {}                       \
+    else if (!g3::logLevel (level) || false == (boolean_expression)) {}    \
+    else INTERNAL_LOG_MESSAGE (level).stream()
+
+#define LOG_ONCE(level)                                                    \
+    if constexpr (!mace_log::isCompiled (#level)) {}                       \
+    else if (!g3::logLevel (level) || !MACE_LOG_SITE (mace_log::Once).allow()) {} \
+    else INTERNAL_LOG_MESSAGE (level).stream()
+
+#define LOG_EVERY_N(level, n)                                                                   \
+    if constexpr (!mace_log::isCompiled (#level)) {}                                            \
+    else if (uint64_t logSuppressed_ = 0;                                                       \
+             !g3::logLevel (level) || !MACE_LOG_SITE (mace_log::EveryN).allow (n, logSuppressed_)) {} \
+    else INTERNAL_LOG_MESSAGE (level).stream() << mace_log::Suppressed {logSuppressed_}
+
+#define LOG_EVERY_MS(level, ms)                                                                    \
+    if constexpr (!mace_log::isCompiled (#level)) {}                                               \
+    else if (uint64_t logSuppressed_ = 0;                                                          \
+             !g3::logLevel (level) || !MACE_LOG_SITE (mace_log::RateLimit).allow (ms, logSuppressed_)) {} \
+    else INTERNAL_LOG_MESSAGE (level).stream() << mace_log::Suppressed {logSuppressed_}
+
+#define LOG_TALLY(name, level, message) \
+    mace_log::Tally name (level, message, __FILE__, __LINE__, static_cast<const char*> (G3LOG_PRETTY_FUNCTION))
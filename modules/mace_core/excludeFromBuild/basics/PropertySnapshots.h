@@ -0,0 +1,97 @@
+#pragma once
+
+// PropertySnapshots holds a flat, typed settings struct and publishes immutable copies of it.
+//
+// Compared to AnyValue:
+// - Each key maps to a struct member at compile time through PropertyField, so a read is a
+//   plain member access with no hashing and no any_cast, and a wrong type fails to compile
+// - Writers copy the current snapshot, edit the copy and publish it atomically (RCU style),
+//   so a reader on another thread always sees a complete, consistent set of values
+// - A reader takes one snapshot per frame with read() and keeps using it, later writes
+//   never change a snapshot that is already out
+//
+// Writers are serialized with a mutex, they are rare compared to reads.
+//
+// Mapping keys to members:
+//   struct RenderState { double exposure = 0.0; };
+//   PROPERTY_FIELD (RenderState, RenderKey::Exposure, exposure)
+//
+//   store.set<RenderKey::Exposure> (1.5);
+//   double e = store.read()->exposure;
+
+// Specialized once per key with PROPERTY_FIELD
+template <class STATE, auto KEY>
+struct PropertyField;
+
+#define PROPERTY_FIELD(STATE, KEY, MEMBER)                                  \
+    template <>                                                             \
+    struct PropertyField<STATE, KEY>                                        \
+    {                                                                       \
+        using Type = decltype (STATE::MEMBER);                              \
+        static constexpr Type STATE::* member = &STATE::MEMBER;             \
+    };
+
+template <class STATE>
+class PropertySnapshots
+{
+ public:
+    using Snapshot = std::shared_ptr<const STATE>;
+
+    template <auto KEY>
+    using FieldType = typename PropertyField<STATE, KEY>::Type;
+
+    PropertySnapshots() :
+        current (std::make_shared<const STATE>())
+    {
+    }
+    ~PropertySnapshots() = default;
+
+    PropertySnapshots (const PropertySnapshots&) = delete;
+    PropertySnapshots& operator= (const PropertySnapshots&) = delete;
+
+    // Current snapshot, safe to hold on to for as long as needed
+    Snapshot read() const { return current.load (std::memory_order_acquire); }
+
+    // Increases every time a new snapshot is published
+    uint64_t version() const { return publishedVersion.load (std::memory_order_acquire); }
+
+    // Single value from the current snapshot, use read() when several values must agree
+    template <auto KEY>
+    FieldType<KEY> get() const
+    {
+        return read().get()->*PropertyField<STATE, KEY>::member;
+    }
+
+    template <auto KEY, typename VALUE>
+    void set (VALUE&& value)
+    {
+        update ([&] (STATE& state)
+                { state.*PropertyField<STATE, KEY>::member = static_cast<FieldType<KEY>> (std::forward<VALUE> (value)); });
+    }
+
+    // Applies several edits and publishes them as one snapshot
+    template <typename EDIT>
+    void update (EDIT&& edit)
+    {
+        std::lock_guard<std::mutex> lock (writeMutex);
+
+        auto next = std::make_shared<STATE> (*current.load (std::memory_order_relaxed));
+        edit (*next);
+
+        current.store (std::move (next), std::memory_order_release);
+        publishedVersion.fetch_add (1, std::memory_order_release);
+    }
+
+    // Back to a default constructed state
+    void reset()
+    {
+        update ([] (STATE& state)
+                { state = STATE(); });
+    }
+
+ private:
+    std::atomic<std::shared_ptr<const STATE>> current;
+    std::atomic<uint64_t> publishedVersion = 0;
+    std::mutex writeMutex;
+
+}; // end class PropertySnapshots
@@ -0,0 +1,246 @@
+#pragma once
+
+// Tracer records begin, end, counter and instant events for hot paths and writes them
+// out as Chrome trace JSON (chrome://tracing or https://ui.perfetto.dev).
+//
+// Recording:
+// - Always compiled in, a disabled tracer costs one relaxed atomic load per trace point
+// - Every thread writes into its own fixed size ring, no locks and no allocation after the
+//   thread's first event, the oldest events are overwritten when a ring wraps
+// - Timestamps are steady_clock nanoseconds since the tracer started
+// - Event and category names must be string literals or otherwise outlive the tracer
+//
+// Exporting:
+// - writeChromeTrace() dumps the last N seconds from every thread seen so far
+// - The dump does not stop recording, events written while it runs may be skipped
+//
+// Usage:
+//   Tracer::setThreadName ("Renderer");
+//   Tracer::enable (true);
+//   {
+//       TRACE_SCOPE ("Renderer::render");
+//       TRACE_COUNTER ("queue depth", q.size());
+//   }
+//   Tracer::writeChromeTrace (Tracer::defaultTracePath (resourceFolder), 10.0);
+
+class Tracer
+{
+ public:
+    enum class Phase : char
+    {
+        Begin = 'B',
+        End = 'E',
+        Counter = 'C',
+        Instant = 'i'
+    };
+
+    struct Event
+    {
+        const char* name = nullptr;
+        const char* category = nullptr;
+        int64_t value = 0;
+        uint64_t timestamp = 0;
+        Phase phase = Phase::Instant;
+    };
+
+    // events kept per thread, must be a power of two
+    static constexpr size_t RING_SIZE = 1 << 16;
+
+    static void enable (bool on) { active.store (on, std::memory_order_relaxed); }
+    static bool isEnabled() { return active.load (std::memory_order_relaxed); }
+
+    static uint64_t now()
+    {
+        return static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (
+                                          std::chrono::steady_clock::now() - epoch)
+                                          .count());
+    }
+
+    static void begin (const char* name, const char* category = "app") { record (Phase::Begin, name, category, 0); }
+    static void end (const char* name, const char* category = "app") { record (Phase::End, name, category, 0); }
+    static void counter (const char* name, int64_t value, const char* category = "app") { record (Phase::Counter, name, category, value); }
+    static void instant (const char* name, const char* category = "app") { record (Phase::Instant, name, category, 0); }
+
+    // Shown as the thread's name in the trace viewer
+    static void setThreadName (const std::string& name)
+    {
+        ThreadRing& ring = localRing();
+        std::lock_guard<std::mutex> lock (registryMutex());
+        ring.name = name;
+    }
+
+    // <folder>/traces/trace_<month>_<day>_<year>_<hour>_<min>_<sec><am|pm>.json,
+    // the underscore after "trace" is the first character of createTimestampString()
+    static std::filesystem::path defaultTracePath (const std::filesystem::path& folder)
+    {
+        return folder / "traces" / ("trace" + createTimestampString() + ".json");
+    }
+
+    // Writes every event newer than 'seconds' ago, 0 writes everything still in the rings
+    static bool writeChromeTrace (const std::filesystem::path& path, double seconds = 0.0)
+    {
+        std::error_code ec;
+        if (path.has_parent_path())
+            std::filesystem::create_directories (path.parent_path(), ec);
+
+        std::ofstream out (path, std::ios::binary);
+        if (!out)
+        {
+            LOG (WARNING) << "Could not open trace file " << path.generic_string();
+            return false;
+        }
+
+        const uint64_t cutoff = seconds > 0.0 ? now() - std::min (now(), static_cast<uint64_t> (seconds * 1e9)) : 0;
+
+        std::vector<std::shared_ptr<ThreadRing>> rings;
+        {
+            std::lock_guard<std::mutex> lock (registryMutex());
+            rings = registry();
+        }
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        size_t written = 0;
+
+        for (const auto& ring : rings)
+        {
+            std::string threadName;
+            {
+                std::lock_guard<std::mutex> lock (registryMutex());
+                threadName = ring->name.empty() ? "thread " + std::to_string (ring->tid) : ring->name;
+            }
+
+            if (!first) out << ",\n";
+            first = false;
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->tid
+                << ",\"args\":{\"name\":\"" << escape (threadName) << "\"}}";
+
+            // once a ring has wrapped the writer may be overwriting its oldest slots right now,
+            // leave a margin so torn events are never read
+            const uint64_t head = ring->head.load (std::memory_order_acquire);
+            const uint64_t margin = RING_SIZE / 8;
+            const uint64_t start = head > RING_SIZE - margin ? head - (RING_SIZE - margin) : 0;
+
+            for (uint64_t i = start; i < head; ++i)
+            {
+                const Event e = ring->events[i & (RING_SIZE - 1)];
+                if (e.timestamp < cutoff || !e.name) continue;
+
+                out << ",\n{\"name\":\"" << escape (e.name) << "\",\"cat\":\"" << escape (e.category ? e.category : "app")
+                    << "\",\"ph\":\"" << static_cast<char> (e.phase) << "\",\"ts\":" << std::fixed << std::setprecision (3)
+                    << e.timestamp / 1000.0 << ",\"pid\":1,\"tid\":" << ring->tid;
+
+                if (e.phase == Phase::Counter)
+                    out << ",\"args\":{\"value\":" << e.value << "}";
+                else if (e.phase == Phase::Instant)
+                    out << ",\"s\":\"t\"";
+
+                out << "}";
+                ++written;
+            }
+        }
+
+        out << "\n]}\n";
+
+        LOG (INFO) << "Wrote " << written << " trace events to " << path.generic_string();
+        return static_cast<bool> (out);
+    }
+
+ private:
+    struct ThreadRing
+    {
+        std::unique_ptr<Event[]> events = std::make_unique<Event[]> (RING_SIZE);
+        std::atomic<uint64_t> head = 0;
+        uint32_t tid = 0;
+        std::string name;
+    };
+
+    inline static std::atomic<bool> active = false;
+    inline static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    static std::mutex& registryMutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    // rings outlive their threads so a dump still shows threads that have finished
+    static std::vector<std::shared_ptr<ThreadRing>>& registry()
+    {
+        static std::vector<std::shared_ptr<ThreadRing>> rings;
+        return rings;
+    }
+
+    static ThreadRing& localRing()
+    {
+        thread_local std::shared_ptr<ThreadRing> ring = []
+        {
+            auto r = std::make_shared<ThreadRing>();
+            std::lock_guard<std::mutex> lock (registryMutex());
+            r->tid = static_cast<uint32_t> (registry().size() + 1);
+            registry().push_back (r);
+            return r;
+        }();
+        return *ring;
+    }
+
+    static void record (Phase phase, const char* name, const char* category, int64_t value)
+    {
+        if (!isEnabled()) return;
+
+        ThreadRing& ring = localRing();
+        const uint64_t h = ring.head.load (std::memory_order_relaxed);
+        Event& e = ring.events[h & (RING_SIZE - 1)];
+        e.name = name;
+        e.category = category;
+        e.value = value;
+        e.timestamp = now();
+        e.phase = phase;
+        ring.head.store (h + 1, std::memory_order_release);
+    }
+
+    static std::string escape (const char* s)
+    {
+        std::string out;
+        for (; *s; ++s)
+        {
+            if (*s == '"' || *s == '\\') out += '\\';
+            if (static_cast<unsigned char> (*s) >= 0x20) out += *s;
+        }
+        return out;
+    }
+    static std::string escape (const std::string& s) { return escape (s.c_str()); }
+
+}; // end class Tracer
+
+// Begin on construction, end on destruction, nothing at all if tracing was off at construction
+class TraceScope
+{
+ public:
+    explicit TraceScope (const char* name, const char* category = "app") :
+        name (Tracer::isEnabled() ? name : nullptr),
+        category (category)
+    {
+        if (this->name) Tracer::begin (this->name, category);
+    }
+
+    ~TraceScope()
+    {
+        if (name) Tracer::end (name, category);
+    }
+
+    TraceScope (const TraceScope&) = delete;
+    TraceScope& operator= (const TraceScope&) = delete;
+
+ private:
+    const char* name;
+    const char* category;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER (a, b)
+
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT (traceScope_, __LINE__) (name)
+#define TRACE_SCOPE_CAT(category, name) TraceScope TRACE_CONCAT (traceScope_, __LINE__) (name, category)
+#define TRACE_COUNTER(name, value) Tracer::counter (name, static_cast<int64_t> (value))
+#define TRACE_INSTANT(name) Tracer::instant (name)
@@ -585,6 +585,39 @@ inline std::vector<char> readBinaryFile (const std::filesystem::path& filepath)
     return std::move (ret);
 }
 
+// FNV-1a, stable across runs and platforms unlike std::hash
+inline uint64_t fnv1a64 (const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull)
+{
+    const auto* bytes = static_cast<const uint8_t*> (data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// Hashes a file's path, size and modification time into hash.
+// A cheap stand-in for hashing the contents when keying on-disk caches.
+// Returns false if the file can't be queried
+inline bool hashFileStamp (const std::filesystem::path& filePath, uint64_t& hash)
+{
+    std::error_code ec;
+    const uintmax_t fileSize = std::filesystem::file_size (filePath, ec);
+    if (ec) return false;
+
+    const auto modified = std::filesystem::last_write_time (filePath, ec);
+    if (ec) return false;
+
+    const std::string key = filePath.generic_string();
+    const int64_t ticks = modified.time_since_epoch().count();
+
+    hash = fnv1a64 (key.data(), key.size(), hash);
+    hash = fnv1a64 (&fileSize, sizeof (fileSize), hash);
+    hash = fnv1a64 (&ticks, sizeof (ticks), hash);
+    return true;
+}
+
 struct FileServices
 {
     static void copyFiles (const std::string& searchFolder, const std::string& destFolder, const std::string& extension, bool recursive = true)
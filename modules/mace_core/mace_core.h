@@ -9,11 +9,14 @@
 #include <set>
 #include <vector>
 #include <sstream>
+#include <iomanip>
 #include <random>
 #include <chrono>
 #include <thread>
 #include <ctime>
 #include <string>
+#include <string_view>
+#include <atomic>
 #include <iostream>
 #include <stdexcept>
 #include <assert.h>
@@ -67,6 +70,9 @@ using Observer = Nano::Observer<>;
 #include <g3log/g3log.hpp>
 #include <g3log/logworker.hpp>
 
+// compile time level filtering and rate limited LOG variants, replaces g3log's LOG
+#include "excludeFromBuild/basics/LogFilter.h"
+
 // moody camel lock free queue
 #include <concurrent/concurrentqueue.h>
 
@@ -113,6 +119,8 @@ typedef int SocketHandle;
 // some useful tools and defines outside mace namespace
 #include "excludeFromBuild/basics/Defaults.h"
 #include "excludeFromBuild/basics/Util.h"
+#include "excludeFromBuild/basics/PropertySnapshots.h"
+#include "excludeFromBuild/basics/Tracer.h"
 
 namespace mace
 {
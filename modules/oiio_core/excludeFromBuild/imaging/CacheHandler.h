@@ -4,6 +4,88 @@ using namespace OIIO;
 
 using ImageCacheHandlerPtr = std::shared_ptr<class ImageCacheHandler>;
 
+// A fully decoded image shared between all readers.
+// Treat it as read only, it may be in use on several threads at once.
+struct PinnedImage
+{
+    ImageSpec spec;
+    std::vector<std::byte> pixels;
+
+    const std::byte* data() const { return pixels.data(); }
+    size_t sizeInBytes() const { return pixels.size(); }
+
+    // wraps the pinned memory without copying, the view must not outlive this PinnedImage
+    ImageBuf view() const { return ImageBuf (spec, const_cast<std::byte*> (pixels.data())); }
+};
+using PinnedImagePtr = std::shared_ptr<const PinnedImage>;
+
+// Read only view of a single ImageCache tile.
+// Move only, releases the tile back to the cache when destroyed.
+class TileView
+{
+ public:
+    TileView() = default;
+    TileView (ImageCache* cache, ImageCache::Tile* tile, const void* data, TypeDesc format, ROI roi) :
+        cache (cache),
+        tile (tile),
+        pixels (data),
+        format (format),
+        roi (roi)
+    {
+    }
+    ~TileView() { release(); }
+
+    TileView (const TileView&) = delete;
+    TileView& operator= (const TileView&) = delete;
+
+    TileView (TileView&& other) noexcept { *this = std::move (other); }
+    TileView& operator= (TileView&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            cache = std::exchange (other.cache, nullptr);
+            tile = std::exchange (other.tile, nullptr);
+            pixels = std::exchange (other.pixels, nullptr);
+            format = other.format;
+            roi = other.roi;
+        }
+        return *this;
+    }
+
+    bool valid() const { return pixels != nullptr; }
+    explicit operator bool() const { return valid(); }
+
+    const void* data() const { return pixels; }
+    TypeDesc pixelFormat() const { return format; }
+    const ROI& region() const { return roi; }
+
+    // tiles are stored contiguously, all channels of the tile interleaved
+    size_t pixelStride() const { return format.size() * roi.nchannels(); }
+    size_t scanlineStride() const { return pixelStride() * roi.width(); }
+
+    const void* pixel (int x, int y) const
+    {
+        return static_cast<const std::byte*> (pixels) +
+               (y - roi.ybegin) * scanlineStride() + (x - roi.xbegin) * pixelStride();
+    }
+
+ private:
+    ImageCache* cache = nullptr;
+    ImageCache::Tile* tile = nullptr;
+    const void* pixels = nullptr;
+    TypeDesc format;
+    ROI roi;
+
+    void release()
+    {
+        if (cache && tile) cache->release_tile (tile);
+        cache = nullptr;
+        tile = nullptr;
+        pixels = nullptr;
+    }
+};
+
 class ImageCacheHandler
 {
  public:
@@ -32,6 +114,9 @@ class ImageCacheHandler
     void clear()
     {
         imageCache->invalidate_all();
+
+        std::lock_guard<std::mutex> lock (pinnedMutex);
+        pinnedImages.clear();
     }
 
     void info()
@@ -59,51 +144,118 @@ class ImageCacheHandler
         return getCachedImage (*it);
     }
 
+    // Returns an ImageBuf that owns its pixels so it can outlive the call
+    // and be used from any thread. Prefer getPinnedImage() or getTile()
+    // when the pixels are only read, they avoid the copy entirely.
     ImageBuf getCachedImage (const std::string& imagePath, bool fitToScreen = true)
     {
-        pixels.clear();
-        floatPixels.clear();
-
-        ustring filename (imagePath);
         ImageSpec spec;
-        imageCache->get_imagespec (filename, spec);
+        if (!getPixelSpec (imagePath, spec)) return ImageBuf();
 
-        if (spec.format == OIIO::TypeDesc::UINT8)
+        if (fitToScreen && spec.format == OIIO::TypeDesc::UINT8)
         {
-            pixels.resize (spec.width * spec.height * spec.nchannels * sizeof (uint8_t));
-            imageCache->get_pixels (filename, 0, 0, 0, spec.width, 0, spec.height,
-                                    0, 1, spec.format, pixels.data());
+            PinnedImagePtr pinned = getPinnedImage (imagePath);
+            if (!pinned) return ImageBuf();
 
-            if (fitToScreen)
-            {
-                ImageBuf image (spec, pixels.data());
-                // const OIIO::ImageSpec& spec = image.spec();
-                int w = spec.width;
-                int h = spec.height;
-                int nChan = spec.nchannels;
+            float aspectRatio = (float)spec.width / (float)spec.height;
+            float resizedWidth = DEFAULT_DESKTOP_WINDOW_WIDTH;
+            float resizedHeight = resizedWidth / aspectRatio;
 
-                float aspectRatio = (float)spec.width / (float)spec.height;
-                float resizedWidth = DEFAULT_DESKTOP_WINDOW_WIDTH;
-                float resizedHeight = resizedWidth / aspectRatio;
+            // resize reads straight from the pinned buffer and allocates the result once
+            OIIO::ROI roi (0, (int)resizedWidth, 0, (int)resizedHeight, 0, 1, /*chans:*/ 0, spec.nchannels);
+            return OIIO::ImageBufAlgo::resize (pinned->view(), "", 0, roi);
+        }
 
-                OIIO::ROI roi (0, (int)resizedWidth, 0, (int)resizedHeight, 0, 1, /*chans:*/ 0, spec.nchannels);
-                OIIO::ImageBuf img = OIIO::ImageBufAlgo::resize (image, "", 0, roi);
+        // every pixel is written below, skip the zero fill
+        ImageBuf image (spec, OIIO::InitializePixels::No);
 
-                return OIIO::ImageBufAlgo::resize (image, "", 0, roi);
-            }
-            else
-                return ImageBuf (spec, pixels.data());
+        // someone already holds the decoded pixels, copying them beats decoding again
+        if (PinnedImagePtr pinned = findPinnedImage (imagePath))
+        {
+            std::memcpy (image.localpixels(), pinned->data(), pinned->sizeInBytes());
+            return image;
         }
-        else if (spec.format == OIIO::TypeDesc::FLOAT)
+
+        // otherwise decode once, straight into the returned buffer
+        if (!imageCache->get_pixels (ustring (imagePath), 0, 0, 0, spec.width, 0, spec.height,
+                                     0, 1, spec.format, image.localpixels()))
         {
-            floatPixels.resize (spec.width * spec.height * spec.nchannels * sizeof (float));
-            imageCache->get_pixels (filename, 0, 0, 0, spec.width, 0, spec.height,
-                                    0, 1, spec.format, floatPixels.data());
+            LOG (WARNING) << "Failed to read pixels from " << imagePath << " " << imageCache->geterror();
+            return ImageBuf();
+        }
+        return image;
+    }
+
+    // Decodes the whole image once and hands out a shared, read only buffer.
+    // Concurrent callers asking for the same image get the same buffer and
+    // the memory is released when the last reference goes away.
+    PinnedImagePtr getPinnedImage (const std::string& imagePath)
+    {
+        if (PinnedImagePtr pinned = findPinnedImage (imagePath))
+            return pinned;
+
+        // read outside the lock, ImageCache::get_pixels is thread safe
+        ustring filename (imagePath);
+        ImageSpec spec;
+        if (!getPixelSpec (imagePath, spec)) return nullptr;
+
+        auto pinned = std::make_shared<PinnedImage>();
+        pinned->spec = spec;
+        pinned->pixels.resize (spec.image_bytes());
+
+        if (!imageCache->get_pixels (filename, 0, 0, 0, spec.width, 0, spec.height,
+                                     0, 1, spec.format, pinned->pixels.data()))
+        {
+            LOG (WARNING) << "Failed to read pixels from " << imagePath << " " << imageCache->geterror();
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock (pinnedMutex);
+
+        // another thread may have won the race, share its buffer
+        auto& slot = pinnedImages[imagePath];
+        if (PinnedImagePtr existing = slot.lock())
+            return existing;
 
-            return ImageBuf (spec, floatPixels.data());
+        slot = pinned;
+
+        // forget images nobody holds on to anymore
+        if (pinnedImages.size() > maxPinnedEntries)
+        {
+            for (auto it = pinnedImages.begin(); it != pinnedImages.end();)
+                it = it->second.expired() ? pinnedImages.erase (it) : std::next (it);
         }
 
-        return ImageBuf();
+        return pinned;
+    }
+
+    // Tile access straight out of the ImageCache, no copy is made.
+    // The tile stays pinned in the cache until the TileView is destroyed.
+    TileView getTile (const std::string& imagePath, int x, int y, int miplevel = 0)
+    {
+        ustring filename (imagePath);
+        ImageCache::Tile* tile = imageCache->get_tile (filename, 0, miplevel, x, y, 0);
+        if (!tile) return TileView();
+
+        TypeDesc format;
+        const void* data = imageCache->tile_pixels (tile, format);
+        ROI roi = imageCache->tile_roi (tile);
+        return TileView (imageCache, tile, data, format, roi);
+    }
+
+    // Streams a band of scanlines into caller owned memory.
+    // dst must hold (yend - ybegin) * width * nchannels * format.size() bytes.
+    bool readScanlines (const std::string& imagePath, int ybegin, int yend, TypeDesc format, void* dst)
+    {
+        ustring filename (imagePath);
+        ImageSpec spec;
+        if (!imageCache->get_imagespec (filename, spec)) return false;
+
+        ybegin = std::clamp (ybegin, 0, spec.height);
+        yend = std::clamp (yend, ybegin, spec.height);
+
+        return imageCache->get_pixels (filename, 0, 0, 0, spec.width, ybegin, yend,
+                                       0, 1, format, dst);
     }
 
     void addImage (const std::string& imagePath)
@@ -185,8 +337,30 @@ class ImageCacheHandler
     uint32_t imageIndex = 0;
     OIIO::thread_pool* threadPool = nullptr;
 
-    // pixels must persist until reaching opengl renderer
-    // FIXME
-    std::vector<uint8_t> pixels;
-    std::vector<float> floatPixels;
+    // fully decoded images that are still referenced by someone
+    static constexpr size_t maxPinnedEntries = 256;
+    std::mutex pinnedMutex;
+    std::unordered_map<std::string, std::weak_ptr<PinnedImage>> pinnedImages;
+
+    // the decoded image if someone still holds it, never decodes
+    PinnedImagePtr findPinnedImage (const std::string& imagePath)
+    {
+        std::lock_guard<std::mutex> lock (pinnedMutex);
+        auto it = pinnedImages.find (imagePath);
+        return it != pinnedImages.end() ? it->second.lock() : nullptr;
+    }
+
+    // spec of the pixels as handed out, anything but UINT8 is read as FLOAT
+    bool getPixelSpec (const std::string& imagePath, ImageSpec& spec)
+    {
+        if (!imageCache->get_imagespec (ustring (imagePath), spec))
+        {
+            LOG (WARNING) << "No image spec for " << imagePath << " " << imageCache->geterror();
+            return false;
+        }
+
+        if (spec.format != OIIO::TypeDesc::UINT8 && spec.format != OIIO::TypeDesc::FLOAT)
+            spec.format = OIIO::TypeDesc::FLOAT;
+        return true;
+    }
 };
\ No newline at end of file
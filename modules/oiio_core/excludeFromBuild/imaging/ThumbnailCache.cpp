@@ -0,0 +1,186 @@
+
+namespace
+{
+    // bump whenever the stored layout changes so old entries are ignored
+    constexpr uint32_t THUMBNAIL_CACHE_VERSION = 1;
+} // namespace
+
+ThumbnailCache::ThumbnailCache (const std::filesystem::path& cacheFolder, int maxSize) :
+    cacheFolder (cacheFolder),
+    maxSize (std::max (maxSize, 1))
+{
+    std::error_code ec;
+    std::filesystem::create_directories (cacheFolder, ec);
+    if (ec)
+        LOG (WARNING) << "Could not create thumbnail cache folder " << cacheFolder.generic_string() << ": " << ec.message();
+}
+
+std::filesystem::path ThumbnailCache::entryPath (const std::filesystem::path& sourcePath) const
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    if (!hashFileStamp (sourcePath, hash)) return {};
+
+    hash = fnv1a64 (&maxSize, sizeof (maxSize), hash);
+    hash = fnv1a64 (&THUMBNAIL_CACHE_VERSION, sizeof (THUMBNAIL_CACHE_VERSION), hash);
+
+    char name[17];
+    std::snprintf (name, sizeof (name), "%016llx", static_cast<unsigned long long> (hash));
+
+    // fan out on the first byte so no single folder holds thousands of files
+    return cacheFolder / std::string (name, 2) / (std::string (name) + ".png");
+}
+
+bool ThumbnailCache::contains (const std::filesystem::path& sourcePath) const
+{
+    std::filesystem::path entry = entryPath (sourcePath);
+    std::error_code ec;
+    return !entry.empty() && std::filesystem::is_regular_file (entry, ec);
+}
+
+ImageBuf ThumbnailCache::fetch (const std::filesystem::path& sourcePath, bool* cacheHit)
+{
+    if (cacheHit) *cacheHit = false;
+
+    std::filesystem::path entry = entryPath (sourcePath);
+    if (entry.empty())
+    {
+        LOG (WARNING) << "Thumbnail source does not exist: " << sourcePath.generic_string();
+        return ImageBuf();
+    }
+
+    std::error_code ec;
+    if (std::filesystem::is_regular_file (entry, ec))
+    {
+        ImageBuf thumb = readEntry (entry);
+        if (thumb.initialized())
+        {
+            if (cacheHit) *cacheHit = true;
+            return thumb;
+        }
+
+        // corrupt or truncated entry, rebuild it below
+        std::filesystem::remove (entry, ec);
+    }
+
+    ImageBuf thumb = buildThumbnail (sourcePath);
+    if (thumb.initialized())
+        writeEntry (thumb, entry);
+
+    return thumb;
+}
+
+void ThumbnailCache::purge()
+{
+    std::error_code ec;
+    std::filesystem::remove_all (cacheFolder, ec);
+    std::filesystem::create_directories (cacheFolder, ec);
+    if (ec)
+        LOG (WARNING) << "Failed to purge thumbnail cache: " << ec.message();
+}
+
+ImageBuf ThumbnailCache::readEntry (const std::filesystem::path& entry) const
+{
+    ImageBuf thumb (entry.generic_string());
+
+    // force the read now so the file handle is released before we return
+    if (!thumb.read (0, 0, true, TypeDesc::UINT8) || thumb.spec().nchannels != 4)
+    {
+        LOG (WARNING) << "Discarding bad thumbnail cache entry " << entry.generic_string() << " " << thumb.geterror();
+        return ImageBuf();
+    }
+
+    return thumb;
+}
+
+ImageBuf ThumbnailCache::buildThumbnail (const std::filesystem::path& sourcePath) const
+{
+    ImageBuf source (sourcePath.generic_string());
+    if (!source.read (0, 0, true))
+    {
+        LOG (CRITICAL) << source.geterror();
+        return ImageBuf();
+    }
+
+    ImageBuf sized = source;
+    const ImageSpec& spec = source.spec();
+    if (spec.width > maxSize || spec.height > maxSize)
+    {
+        // fit inside maxSize keeping the aspect ratio
+        const float scale = static_cast<float> (maxSize) / static_cast<float> (std::max (spec.width, spec.height));
+        const int w = std::max (1, static_cast<int> (std::lround (spec.width * scale)));
+        const int h = std::max (1, static_cast<int> (std::lround (spec.height * scale)));
+
+        sized = ImageBufAlgo::resize (source, "", 0.0f, ROI (0, w, 0, h, 0, 1, 0, spec.nchannels));
+        if (sized.has_error())
+        {
+            LOG (CRITICAL) << sized.geterror();
+            return ImageBuf();
+        }
+    }
+
+    // expand to RGBA, grey images replicate their first channel
+    ImageBuf rgba;
+    const int nChan = sized.spec().nchannels;
+    if (nChan == 4)
+    {
+        rgba = std::move (sized);
+    }
+    else
+    {
+        int channelorder[4] = {0, 1, 2, -1};
+        if (nChan < 3)
+        {
+            channelorder[1] = channelorder[2] = 0;
+            if (nChan == 2) channelorder[3] = 1;
+        }
+        else if (nChan > 4)
+        {
+            channelorder[3] = 3;
+        }
+
+        float channelvalues[] = {0 /*ignore*/, 0 /*ignore*/, 0 /*ignore*/, 1.0f};
+        std::string channelnames[] = {"R", "G", "B", "A"};
+        rgba = ImageBufAlgo::channels (sized, 4, channelorder, channelvalues, channelnames);
+        if (rgba.has_error())
+        {
+            LOG (CRITICAL) << rgba.geterror();
+            return ImageBuf();
+        }
+    }
+
+    ImageBuf thumb;
+    if (!thumb.copy (rgba, TypeDesc::UINT8))
+    {
+        LOG (CRITICAL) << thumb.geterror();
+        return ImageBuf();
+    }
+
+    return thumb;
+}
+
+void ThumbnailCache::writeEntry (const ImageBuf& thumb, const std::filesystem::path& entry) const
+{
+    std::error_code ec;
+    std::filesystem::create_directories (entry.parent_path(), ec);
+
+    // several threads may build the same entry, each writes its own temp file
+    std::ostringstream tmpName;
+    tmpName << entry.stem().generic_string() << "." << std::this_thread::get_id() << ".tmp.png";
+    std::filesystem::path tmp = entry.parent_path() / tmpName.str();
+
+    ImageBuf out = thumb;
+    out.specmod().attribute ("png:compressionLevel", 6);
+    if (!out.write (tmp.generic_string(), TypeDesc::UINT8, "png"))
+    {
+        LOG (WARNING) << "Failed to write thumbnail cache entry: " << out.geterror();
+        std::filesystem::remove (tmp, ec);
+        return;
+    }
+
+    std::filesystem::rename (tmp, entry, ec);
+    if (ec)
+    {
+        // another thread got there first, its entry is just as good
+        std::filesystem::remove (tmp, ec);
+    }
+}
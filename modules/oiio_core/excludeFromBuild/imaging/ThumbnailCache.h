@@ -0,0 +1,52 @@
+#pragma once
+
+using ThumbnailCachePtr = std::shared_ptr<class ThumbnailCache>;
+
+// Persistent on-disk cache of browser thumbnails.
+//
+// Every source image is stored once, already downsized to fit maxSize and
+// converted to 8 bit RGBA, as a compressed PNG under the cache folder.
+// Entries are keyed on the source path, file size and modification time so an
+// edited source simply misses and is rebuilt, stale entries are never read.
+//
+// fetch() is safe to call from any number of threads. Entries are written to a
+// temporary file and renamed into place so a reader never sees a partial file.
+class ThumbnailCache
+{
+ public:
+    static constexpr int DEFAULT_MAX_SIZE = 256;
+
+    static ThumbnailCachePtr create (const std::filesystem::path& cacheFolder, int maxSize = DEFAULT_MAX_SIZE)
+    {
+        return std::make_shared<ThumbnailCache> (cacheFolder, maxSize);
+    }
+
+ public:
+    ThumbnailCache (const std::filesystem::path& cacheFolder, int maxSize = DEFAULT_MAX_SIZE);
+    ~ThumbnailCache() = default;
+
+    // returns a display ready RGBA uint8 thumbnail, built from the source on a miss
+    // the result is empty if the source can't be read
+    ImageBuf fetch (const std::filesystem::path& sourcePath, bool* cacheHit = nullptr);
+
+    // cheap check that does not touch pixels, used to schedule hits ahead of misses
+    bool contains (const std::filesystem::path& sourcePath) const;
+
+    // content addressed location of the cache entry, empty if the source doesn't exist
+    std::filesystem::path entryPath (const std::filesystem::path& sourcePath) const;
+
+    const std::filesystem::path& getCacheFolder() const { return cacheFolder; }
+    int getMaxSize() const { return maxSize; }
+
+    // delete every entry, the next fetch rebuilds from source
+    void purge();
+
+ private:
+    std::filesystem::path cacheFolder;
+    int maxSize = DEFAULT_MAX_SIZE;
+
+    ImageBuf readEntry (const std::filesystem::path& entry) const;
+    ImageBuf buildThumbnail (const std::filesystem::path& sourcePath) const;
+    void writeEntry (const ImageBuf& thumb, const std::filesystem::path& entry) const;
+
+}; // end class ThumbnailCache
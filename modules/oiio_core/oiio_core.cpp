@@ -3,4 +3,5 @@
 #include "oiio_core.h"
 
 
-#include "excludeFromBuild/imaging/CacheHandler.cpp"
\ No newline at end of file
+#include "excludeFromBuild/imaging/CacheHandler.cpp"
+#include "excludeFromBuild/imaging/ThumbnailCache.cpp"
\ No newline at end of file
@@ -11,3 +11,4 @@
 
 #include "excludeFromBuild/imaging/OIIOHelpers.h"
 #include "excludeFromBuild/imaging/CacheHandler.h"
+#include "excludeFromBuild/imaging/ThumbnailCache.h"
@@ -0,0 +1,541 @@
+#pragma once
+
+// AnimationEvaluator samples the keyframed AnimationChannels of many nodes at once
+// and writes the result straight into each node's SpaceTime::worldTransform.
+//
+// Channels hold glTF node local TRS. A node with a parent gets the parent's world
+// transform applied on top, and nodes are composed parents first so an animated
+// parent moves its animated children in the same frame. The parent is looked up once,
+// reparenting an animated node needs clear() and addNode() again.
+//
+// Layout:
+// - Channels are grouped by path (translation, rotation, scale). Each group keeps its
+//   keys as structure of arrays, one contiguous array per component, so a frame
+//   touches only the keys it blends
+// - Every channel remembers the key it used last. Forward playback advances that
+//   cursor by a step or two, a jump backwards or far ahead falls back to a binary search
+// - Rotation keys are flipped into the same hemisphere as their predecessor when the
+//   evaluator is built, so blending never has to check the sign per frame
+//
+// Evaluating a frame:
+// - Channels are split into blocks over the thread pool, each block finds its keys,
+//   gathers them and then blends the whole block with Eigen array expressions so the
+//   lerp, nlerp and slerp math runs across channels in SIMD lanes
+// - Nodes are then composed as parent * translation * rotation * scale one hierarchy
+//   level at a time, a path without a channel keeps the node's start pose, and the
+//   previous world transform is kept for motion blur
+//
+// Only linear interpolation is evaluated, AnimationChannel does not carry the glTF
+// interpolation mode. Morph target weights are ignored.
+//
+// Usage:
+//   auto evaluator = AnimationEvaluator::create();
+//   for (auto& node : animatedNodes)
+//       evaluator->addNode (node);
+//   evaluator->evaluate (seconds, &pool, journal.get());
+
+using AnimationEvaluatorPtr = std::shared_ptr<class AnimationEvaluator>;
+
+class AnimationEvaluator
+{
+ public:
+    enum class RotationBlend
+    {
+        Nlerp, // cheapest, close to slerp for densely sampled keys
+        Slerp  // constant angular velocity between keys
+    };
+
+    static AnimationEvaluatorPtr create() { return std::make_shared<AnimationEvaluator>(); }
+
+    AnimationEvaluator() = default;
+    ~AnimationEvaluator() = default;
+
+    // channels come from the node's SpaceTime::animation
+    void addNode (sabi::RenderableNode node)
+    {
+        if (!node) return;
+        addNode (node, node->getSpaceTime().animation);
+    }
+
+    // rest pose is the node's start transform, relative to its parent's, at the time
+    // evaluate() first runs after this call
+    void addNode (sabi::RenderableNode node, const std::vector<AnimationChannel>& channels)
+    {
+        if (!node || channels.empty()) return;
+        pending.push_back ({node, channels});
+        dirty = true;
+    }
+
+    void clear()
+    {
+        pending.clear();
+        nodes.clear();
+        levelEnd.clear();
+        for (auto& group : groups)
+            group.clear();
+        startTime = endTime = 0.0f;
+        dirty = false;
+    }
+
+    void setRotationBlend (RotationBlend blend) { rotationBlend = blend; }
+    void setLooping (bool loop) { looping = loop; }
+
+    // the evaluator runs on the calling thread below this many channels
+    void setParallelThreshold (uint32_t channels) { parallelThreshold = channels; }
+
+    // samples every channel at 'time' seconds, wrapping into [start, end] when looping
+    // pool: optional, without one the frame is evaluated on the calling thread
+    // journal: optional, every updated node is recorded as a transform change
+    void evaluate (float time, BS::thread_pool* pool = nullptr, sabi::SceneChangeJournal* journal = nullptr)
+    {
+        if (dirty) build();
+        if (nodes.empty()) return;
+
+        const float t = wrapTime (time);
+
+        for (auto& group : groups)
+        {
+            const uint32_t count = group.channelCount();
+            if (count == 0) continue;
+
+            const bool rotation = &group == &groups[RotationGroup];
+            auto sampleBlock = [&, t, rotation] (const uint32_t start, const uint32_t end)
+            {
+                group.locate (t, start, end);
+                if (!rotation)
+                    group.blendLinear (start, end);
+                else if (rotationBlend == RotationBlend::Slerp)
+                    group.blendSlerp (start, end);
+                else
+                    group.blendNlerp (start, end);
+            };
+
+            runBlocks (count, pool, sampleBlock);
+        }
+
+        // parents before children, each level can see the one above it finished
+        uint32_t levelBegin = 0;
+        for (const uint32_t end : levelEnd)
+        {
+            auto composeBlock = [&, levelBegin] (const uint32_t start, const uint32_t stop)
+            {
+                for (uint32_t i = levelBegin + start; i < levelBegin + stop; ++i)
+                    compose (nodes[i], journal);
+            };
+
+            runBlocks (end - levelBegin, pool, composeBlock);
+            levelBegin = end;
+        }
+    }
+
+    size_t nodeCount() const { return dirty ? nodes.size() + pending.size() : nodes.size(); }
+    size_t channelCount() const
+    {
+        size_t count = 0;
+        for (const auto& group : groups)
+            count += group.channelCount();
+        return count;
+    }
+
+    float getStartTime() const { return startTime; }
+    float getEndTime() const { return endTime; }
+    float getDuration() const { return endTime - startTime; }
+
+ private:
+    static constexpr int TranslationGroup = 0;
+    static constexpr int RotationGroup = 1;
+    static constexpr int ScaleGroup = 2;
+    static constexpr int NoChannel = -1;
+
+    // linear cursor steps before giving up and bisecting
+    static constexpr uint32_t MaxCursorSteps = 4;
+
+    // above this cosine slerp and nlerp are indistinguishable, and slerp loses precision
+    static constexpr float SlerpThreshold = 0.9995f;
+
+    struct PendingNode
+    {
+        sabi::RenderableWeakRef node;
+        std::vector<AnimationChannel> channels;
+    };
+
+    struct AnimatedNode
+    {
+        sabi::RenderableWeakRef node;
+        sabi::RenderableWeakRef parent;
+        uint32_t depth = 0; // number of ancestors
+        Eigen::Vector3f restTranslation = Eigen::Vector3f::Zero();
+        Eigen::Quaternionf restRotation = Eigen::Quaternionf::Identity();
+        Eigen::Vector3f restScale = Eigen::Vector3f::Ones();
+        int channel[3] = {NoChannel, NoChannel, NoChannel}; // per group
+    };
+
+    // One path's channels, keys and per frame results, all as structure of arrays.
+    // w is only used by rotation.
+    struct ChannelGroup
+    {
+        // keys, every channel's keys are contiguous and sorted by time
+        std::vector<float> keyTime;
+        std::vector<float> keyX, keyY, keyZ, keyW;
+
+        // channels
+        std::vector<uint32_t> keyBegin;
+        std::vector<uint32_t> keyCount;
+        std::vector<uint32_t> cursor; // last key used, relative to keyBegin
+
+        // per frame, the bracketing keys gathered by locate() and the blended result
+        std::vector<float> alpha;
+        std::vector<float> x0, y0, z0, w0;
+        std::vector<float> x1, y1, z1, w1;
+        std::vector<float> outX, outY, outZ, outW;
+
+        uint32_t channelCount() const { return static_cast<uint32_t> (keyBegin.size()); }
+
+        void clear()
+        {
+            for (auto* v : {&keyTime, &keyX, &keyY, &keyZ, &keyW, &alpha,
+                            &x0, &y0, &z0, &w0, &x1, &y1, &z1, &w1, &outX, &outY, &outZ, &outW})
+                v->clear();
+            keyBegin.clear();
+            keyCount.clear();
+            cursor.clear();
+        }
+
+        void allocateFrame()
+        {
+            const size_t n = keyBegin.size();
+            for (auto* v : {&alpha, &x0, &y0, &z0, &w0, &x1, &y1, &z1, &w1, &outX, &outY, &outZ, &outW})
+                v->assign (n, 0.0f);
+        }
+
+        // finds the keys around 't' for each channel and gathers them
+        void locate (float t, uint32_t start, uint32_t end)
+        {
+            for (uint32_t c = start; c < end; ++c)
+            {
+                const uint32_t begin = keyBegin[c];
+                const uint32_t count = keyCount[c];
+                const float* times = keyTime.data() + begin;
+
+                uint32_t k = cursor[c];
+                uint32_t next = k;
+                float a = 0.0f;
+
+                if (count == 1 || t <= times[0])
+                {
+                    k = next = 0;
+                }
+                else if (t >= times[count - 1])
+                {
+                    k = next = count - 1;
+                }
+                else
+                {
+                    if (times[k] > t)
+                    {
+                        // went backwards, a loop wrap or a scrub
+                        k = findKey (times, count, t);
+                    }
+                    else
+                    {
+                        uint32_t steps = 0;
+                        while (times[k + 1] <= t && ++steps <= MaxCursorSteps)
+                            ++k;
+                        if (times[k + 1] <= t)
+                            k = findKey (times, count, t);
+                    }
+
+                    next = k + 1;
+                    const float span = times[next] - times[k];
+                    a = span > 0.0f ? (t - times[k]) / span : 0.0f;
+                }
+
+                cursor[c] = k;
+                alpha[c] = a;
+
+                const uint32_t i0 = begin + k;
+                const uint32_t i1 = begin + next;
+                x0[c] = keyX[i0], y0[c] = keyY[i0], z0[c] = keyZ[i0], w0[c] = keyW[i0];
+                x1[c] = keyX[i1], y1[c] = keyY[i1], z1[c] = keyZ[i1], w1[c] = keyW[i1];
+            }
+        }
+
+        // last key with time <= t, t is strictly inside the channel's range
+        static uint32_t findKey (const float* times, uint32_t count, float t)
+        {
+            return static_cast<uint32_t> (std::upper_bound (times, times + count, t) - times) - 1;
+        }
+
+        using Lanes = Eigen::Map<Eigen::ArrayXf>;
+
+        Lanes lanes (std::vector<float>& v, uint32_t start, uint32_t end)
+        {
+            return Lanes (v.data() + start, end - start);
+        }
+
+        void blendLinear (uint32_t start, uint32_t end)
+        {
+            auto a = lanes (alpha, start, end);
+            lanes (outX, start, end) = lanes (x0, start, end) + a * (lanes (x1, start, end) - lanes (x0, start, end));
+            lanes (outY, start, end) = lanes (y0, start, end) + a * (lanes (y1, start, end) - lanes (y0, start, end));
+            lanes (outZ, start, end) = lanes (z0, start, end) + a * (lanes (z1, start, end) - lanes (z0, start, end));
+        }
+
+        void blendNlerp (uint32_t start, uint32_t end)
+        {
+            auto a = lanes (alpha, start, end);
+            blendWeighted (start, end, 1.0f - a, a);
+        }
+
+        void blendSlerp (uint32_t start, uint32_t end)
+        {
+            auto a = lanes (alpha, start, end);
+
+            // keys share a hemisphere so the cosine is never negative
+            const Eigen::ArrayXf cosTheta = (lanes (x0, start, end) * lanes (x1, start, end) +
+                                             lanes (y0, start, end) * lanes (y1, start, end) +
+                                             lanes (z0, start, end) * lanes (z1, start, end) +
+                                             lanes (w0, start, end) * lanes (w1, start, end))
+                                                .min (1.0f);
+
+            const Eigen::ArrayXf theta = cosTheta.acos();
+            const Eigen::ArrayXf invSin = theta.sin().max (1e-6f).inverse();
+            const auto linear = cosTheta > SlerpThreshold;
+
+            const Eigen::ArrayXf s0 = linear.select (1.0f - a, ((1.0f - a) * theta).sin() * invSin);
+            const Eigen::ArrayXf s1 = linear.select (a, (a * theta).sin() * invSin);
+
+            blendWeighted (start, end, s0, s1);
+        }
+
+        // q = s0 * q0 + s1 * q1, normalized
+        template <typename Weights0, typename Weights1>
+        void blendWeighted (uint32_t start, uint32_t end, const Weights0& s0, const Weights1& s1)
+        {
+            auto x = lanes (outX, start, end);
+            auto y = lanes (outY, start, end);
+            auto z = lanes (outZ, start, end);
+            auto w = lanes (outW, start, end);
+
+            x = s0 * lanes (x0, start, end) + s1 * lanes (x1, start, end);
+            y = s0 * lanes (y0, start, end) + s1 * lanes (y1, start, end);
+            z = s0 * lanes (z0, start, end) + s1 * lanes (z1, start, end);
+            w = s0 * lanes (w0, start, end) + s1 * lanes (w1, start, end);
+
+            const Eigen::ArrayXf invLength = (x.square() + y.square() + z.square() + w.square()).max (1e-12f).rsqrt();
+            x *= invLength;
+            y *= invLength;
+            z *= invLength;
+            w *= invLength;
+        }
+    };
+
+    std::vector<PendingNode> pending;
+    std::vector<AnimatedNode> nodes; // sorted by depth
+    std::vector<uint32_t> levelEnd;  // one past the last node of each depth
+    ChannelGroup groups[3];
+
+    RotationBlend rotationBlend = RotationBlend::Nlerp;
+    bool looping = true;
+    bool dirty = false;
+    uint32_t parallelThreshold = 256;
+
+    float startTime = 0.0f;
+    float endTime = 0.0f;
+
+    static int groupIndex (fastgltf::AnimationPath path)
+    {
+        switch (path)
+        {
+            case fastgltf::AnimationPath::Translation:
+                return TranslationGroup;
+            case fastgltf::AnimationPath::Rotation:
+                return RotationGroup;
+            case fastgltf::AnimationPath::Scale:
+                return ScaleGroup;
+            default:
+                return NoChannel;
+        }
+    }
+
+    // flattens every pending node's channels into the key arrays
+    void build()
+    {
+        dirty = false;
+
+        for (auto& p : pending)
+        {
+            sabi::RenderableNode node = p.node.lock();
+            if (!node) continue;
+
+            AnimatedNode animated;
+            animated.node = node;
+            animated.parent = node->getParent();
+            for (sabi::RenderableNode p = node->getParent(); p; p = p->getParent())
+                ++animated.depth;
+
+            // rest pose in the parent's space, used for any path the node has no channel for
+            Eigen::Affine3f rest = node->getSpaceTime().startTransform;
+            if (sabi::RenderableNode parent = animated.parent.lock())
+                rest = parent->getSpaceTime().startTransform.inverse() * rest;
+            Eigen::Matrix3f rotation, scaling;
+            rest.computeRotationScaling (&rotation, &scaling);
+            animated.restTranslation = rest.translation();
+            animated.restRotation = Eigen::Quaternionf (rotation).normalized();
+            animated.restScale = scaling.diagonal();
+
+            for (const auto& channel : p.channels)
+            {
+                const int g = groupIndex (channel.path);
+                if (g == NoChannel || channel.keyFrames.empty())
+                {
+                    if (g == NoChannel)
+                        LOG (DBUG) << "Skipping unsupported animation path on " << channel.targetNode;
+                    continue;
+                }
+
+                // a later channel for the same path replaces an earlier one
+                animated.channel[g] = static_cast<int> (addChannel (groups[g], g, channel));
+            }
+
+            if (animated.channel[TranslationGroup] != NoChannel ||
+                animated.channel[RotationGroup] != NoChannel ||
+                animated.channel[ScaleGroup] != NoChannel)
+            {
+                nodes.push_back (std::move (animated));
+            }
+        }
+        pending.clear();
+
+        std::stable_sort (nodes.begin(), nodes.end(), [] (const AnimatedNode& a, const AnimatedNode& b)
+                          { return a.depth < b.depth; });
+        levelEnd.clear();
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+        {
+            if (i + 1 == nodes.size() || nodes[i + 1].depth != nodes[i].depth)
+                levelEnd.push_back (i + 1);
+        }
+
+        bool first = true;
+        for (auto& group : groups)
+        {
+            group.allocateFrame();
+            for (uint32_t c = 0; c < group.channelCount(); ++c)
+            {
+                const float begin = group.keyTime[group.keyBegin[c]];
+                const float end = group.keyTime[group.keyBegin[c] + group.keyCount[c] - 1];
+                startTime = first ? begin : std::min (startTime, begin);
+                endTime = first ? end : std::max (endTime, end);
+                first = false;
+            }
+        }
+    }
+
+    static uint32_t addChannel (ChannelGroup& group, int g, const AnimationChannel& channel)
+    {
+        std::vector<KeyFrame> keys = channel.keyFrames;
+        if (!std::is_sorted (keys.begin(), keys.end(), [] (const KeyFrame& a, const KeyFrame& b)
+                             { return a.time < b.time; }))
+        {
+            std::stable_sort (keys.begin(), keys.end(), [] (const KeyFrame& a, const KeyFrame& b)
+                              { return a.time < b.time; });
+        }
+
+        const uint32_t index = group.channelCount();
+        group.keyBegin.push_back (static_cast<uint32_t> (group.keyTime.size()));
+        group.keyCount.push_back (static_cast<uint32_t> (keys.size()));
+        group.cursor.push_back (0);
+
+        Eigen::Vector4f previous = Eigen::Vector4f::Zero();
+        for (size_t k = 0; k < keys.size(); ++k)
+        {
+            Eigen::Vector4f value;
+            if (g == RotationGroup)
+            {
+                value = keys[k].rotation.normalized().coeffs(); // x, y, z, w
+                if (k > 0 && value.dot (previous) < 0.0f)
+                    value = -value;
+                previous = value;
+            }
+            else
+            {
+                const Eigen::Vector3f& v = g == TranslationGroup ? keys[k].translation : keys[k].scale;
+                value = Eigen::Vector4f (v.x(), v.y(), v.z(), 0.0f);
+            }
+
+            group.keyTime.push_back (keys[k].time);
+            group.keyX.push_back (value.x());
+            group.keyY.push_back (value.y());
+            group.keyZ.push_back (value.z());
+            group.keyW.push_back (value.w());
+        }
+
+        return index;
+    }
+
+    float wrapTime (float time) const
+    {
+        const float duration = endTime - startTime;
+        if (!looping || duration <= 0.0f) return time;
+
+        float t = std::fmod (time - startTime, duration);
+        if (t < 0.0f) t += duration;
+
+        // land exactly on the last key instead of wrapping back to the first
+        if (t == 0.0f && time > startTime) return endTime;
+        return startTime + t;
+    }
+
+    template <typename Block>
+    void runBlocks (uint32_t count, BS::thread_pool* pool, Block&& block)
+    {
+        // already on a pool thread, waiting on a pool from here could deadlock
+        if (!pool || channelCount() < parallelThreshold || BS::this_thread::get_pool())
+        {
+            block (0u, count);
+            return;
+        }
+
+        // the pool may be shared, wait for these blocks only
+        pool->submit_blocks (0u, count, block).wait();
+    }
+
+    void compose (const AnimatedNode& animated, sabi::SceneChangeJournal* journal)
+    {
+        sabi::RenderableNode node = animated.node.lock();
+        if (!node) return;
+
+        Eigen::Vector3f translation = animated.restTranslation;
+        Eigen::Quaternionf rotation = animated.restRotation;
+        Eigen::Vector3f scale = animated.restScale;
+
+        if (int c = animated.channel[TranslationGroup]; c != NoChannel)
+        {
+            const auto& g = groups[TranslationGroup];
+            translation = Eigen::Vector3f (g.outX[c], g.outY[c], g.outZ[c]);
+        }
+        if (int c = animated.channel[RotationGroup]; c != NoChannel)
+        {
+            const auto& g = groups[RotationGroup];
+            rotation = Eigen::Quaternionf (g.outW[c], g.outX[c], g.outY[c], g.outZ[c]);
+        }
+        if (int c = animated.channel[ScaleGroup]; c != NoChannel)
+        {
+            const auto& g = groups[ScaleGroup];
+            scale = Eigen::Vector3f (g.outX[c], g.outY[c], g.outZ[c]);
+        }
+
+        SpaceTime& st = node->getSpaceTime();
+        st.previousWorldTransform = st.worldTransform;
+
+        // the channels are local to the parent
+        sabi::RenderableNode parent = animated.parent.lock();
+        st.worldTransform = parent ? parent->getSpaceTime().worldTransform : Eigen::Affine3f::Identity();
+        st.worldTransform.translate (translation);
+        st.worldTransform.rotate (rotation);
+        st.worldTransform.scale (scale);
+
+        if (journal)
+            journal->recordTransform (node, st.worldTransform);
+    }
+};
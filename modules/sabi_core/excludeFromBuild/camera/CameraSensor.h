@@ -8,15 +8,19 @@
 // 1. Double buffering: The class maintains two sets of image buffers (HDR) to allow
 //    simultaneous reading and writing operations.
 // 2. Thread safety: Uses atomic operations and memory ordering to ensure safe concurrent access.
-// 3.
+// 3. No per frame allocations: both buffers are sized by setPixelResolution() and written in place.
 // 4. Flexible resolution: Allows dynamic changes to sensor resolution.
-// 5. Performance optimization: Uses OIIO (OpenImageIO) for efficient image processing.
+// 5. Performance optimization: Matching renders are a single copy (or none, via acquireWritePixels()),
+//    scaled preview renders are bilinear upsampled straight into the write buffer.
 //
 // Double buffering implementation:
 // - Two image buffers are maintained: images[0] and images[1]
 // - currentReadBuffer atomic variable indicates which buffer is currently safe for reading.
 // - updateImage() writes to the non-reading buffer, then atomically switches the currentReadBuffer.
 // - getHDRImage() always read from the current read buffer.
+// - takeHDRImage() hands the newest published buffer to a reader by swapping it with one the
+//   reader owns, so a slow reader like the display pipeline never copies or holds the sensor's
+//   buffers. The swap and the publish share a small lock, neither ever waits on pixel work.
 //
 // This approach allows the rendering thread to update the image data while the front-end thread
 // can safely read the most recent complete image, preventing data races and ensuring consistency.
@@ -58,8 +62,12 @@ class CameraSensor
         height.store (h, std::memory_order_release);
 
         // Only swap buffers if both new ones are valid
-        images[0].swap (newBuffers[0]);
-        images[1].swap (newBuffers[1]);
+        {
+            std::lock_guard<std::mutex> lock (handoffMutex);
+            images[0].swap (newBuffers[0]);
+            images[1].swap (newBuffers[1]);
+            freshImage = false;
+        }
 
         aspect = static_cast<float> (w) / static_cast<float> (h);
         invPixelResolution = Eigen::Vector2f (1.0f / static_cast<float> (w),
@@ -111,124 +119,86 @@ class CameraSensor
             return false;
         }
 
-        /*  LOG (DBUG) << "UpdateImage: viewport=" << viewportWidth << "x" << viewportHeight
-                     << " render=" << renderWidth << "x" << renderHeight
-                     << " preview=" << (previewMode ? "true" : "false")
-                     << " scale=" << renderScale;*/
-
-        if (previewMode && renderScale > 1)
+        // The write buffer was allocated by setPixelResolution, nothing is allocated per frame
+        float* dst = static_cast<float*> (images[writeBuffer].localpixels());
+        if (!dst || images[writeBuffer].spec().width != static_cast<int> (viewportWidth) ||
+            images[writeBuffer].spec().height != static_cast<int> (viewportHeight))
         {
-            // Create temp buffer at viewport dimensions
-            OIIO::ImageSpec spec (viewportWidth, viewportHeight, 4, OIIO::TypeDesc::FLOAT);
-            OIIO::ImageBuf tempBuf (spec);
-
-            // Create source buffer at render dimensions
-            OIIO::ImageSpec srcSpec (renderWidth, renderHeight, 4, OIIO::TypeDesc::FLOAT);
-            OIIO::ImageBuf srcBuf (srcSpec);
-
-            // Validate source buffer creation
-            if (!srcBuf.initialized())
-            {
-                LOG (WARNING) << "Failed to initialize source buffer";
-                return false;
-            }
-
-            // Copy rendered pixels to source buffer
-            void* srcPixels = srcBuf.localpixels();
-            if (!srcPixels)
-            {
-                LOG (WARNING) << "Failed to get source buffer pixels";
-                return false;
-            }
-
-            const size_t srcByteSize = renderWidth * renderHeight * 4 * sizeof (float);
-            std::memcpy (srcPixels, renderedPixels, srcByteSize);
+            LOG (WARNING) << "Write buffer does not match the viewport";
+            return false;
+        }
 
-            // Resize from render dimensions to viewport dimensions
-            if (!OIIO::ImageBufAlgo::resize (tempBuf, srcBuf))
-            {
-                LOG (WARNING) << "Resize failed: " << tempBuf.geterror();
-                return false;
-            }
+        const float* src = static_cast<const float*> (renderedPixels);
 
-            // Initialize write buffer at viewport dimensions
-            images[writeBuffer].reset (spec, OIIO::InitializePixels::Yes);
-            if (!images[writeBuffer].initialized())
+        if (renderWidth == viewportWidth && renderHeight == viewportHeight)
+        {
+            // Dimensions match, one straight copy into the write buffer
+            const size_t rowFloats = static_cast<size_t> (viewportWidth) * 4;
+            if (flipVertical)
             {
-                LOG (WARNING) << "Failed to initialize write buffer";
-                return false;
+                for (uint32_t y = 0; y < viewportHeight; ++y)
+                    std::memcpy (dst + y * rowFloats, src + (viewportHeight - 1 - y) * rowFloats, rowFloats * sizeof (float));
             }
-
-            // Copy resized result
-            if (!OIIO::ImageBufAlgo::copy (images[writeBuffer], tempBuf))
+            else
             {
-                LOG (WARNING) << "Failed to copy to write buffer";
-                return false;
+                std::memcpy (dst, src, rowFloats * viewportHeight * sizeof (float));
             }
         }
         else
         {
-            // Create buffers - source at render dimensions, destination at viewport dimensions
-            OIIO::ImageSpec srcSpec (renderWidth, renderHeight, 4, OIIO::TypeDesc::FLOAT);
-            OIIO::ImageBuf srcBuf (srcSpec);
+            // Preview renders at 1/renderScale are upsampled, a render that lags behind a
+            // viewport resize is resampled the same way until the next frame catches up
+            if (!(previewMode && renderScale > 1))
+                LOG (DBUG) << "Resampling " << renderWidth << "x" << renderHeight << " render to "
+                           << viewportWidth << "x" << viewportHeight;
 
-            void* srcPixels = srcBuf.localpixels();
-            if (!srcPixels)
-            {
-                LOG (WARNING) << "Failed to get source buffer pixels";
-                return false;
-            }
-
-            const size_t srcByteSize = renderWidth * renderHeight * 4 * sizeof (float);
-            std::memcpy (srcPixels, renderedPixels, srcByteSize);
+            resampleBilinear (src, renderWidth, renderHeight, dst, viewportWidth, viewportHeight, flipVertical);
+        }
 
-            // If dimensions don't match, resize
-            if (renderWidth != viewportWidth || renderHeight != viewportHeight)
-            {
-                OIIO::ImageSpec destSpec (viewportWidth, viewportHeight, 4, OIIO::TypeDesc::FLOAT);
-                OIIO::ImageBuf destBuf (destSpec);
+        publish (writeBuffer);
+        return true;
+    }
 
-                if (!OIIO::ImageBufAlgo::resize (destBuf, srcBuf))
-                {
-                    LOG (WARNING) << "Failed to resize rendered image: " << destBuf.geterror();
-                    return false;
-                }
+    // Zero copy handoff for renderers that can write straight into host memory, for example
+    // a device to host download of the beauty buffer:
+    //   float* pixels = sensor->acquireWritePixels();
+    //   buffer.read (pixels, w * h);
+    //   sensor->publishWritePixels();
+    // Returns nullptr if the buffers are not allocated. The pointer is valid until the next
+    // publishWritePixels() or setPixelResolution() call and holds viewport width x height RGBA floats.
+    float* acquireWritePixels()
+    {
+        const int writeBuffer = 1 - currentReadBuffer.load (std::memory_order_acquire);
+        return static_cast<float*> (images[writeBuffer].localpixels());
+    }
 
-                images[writeBuffer].reset (destSpec, OIIO::InitializePixels::Yes);
-                if (!OIIO::ImageBufAlgo::copy (images[writeBuffer], destBuf))
-                {
-                    LOG (WARNING) << "Failed to copy resized image";
-                    return false;
-                }
-            }
-            else
-            {
-                // Dimensions match, direct copy
-                images[writeBuffer].reset (srcSpec, OIIO::InitializePixels::Yes);
-                if (!OIIO::ImageBufAlgo::copy (images[writeBuffer], srcBuf))
-                {
-                    LOG (WARNING) << "Failed to copy to write buffer";
-                    return false;
-                }
-            }
-        }
+    void publishWritePixels()
+    {
+        publish (1 - currentReadBuffer.load (std::memory_order_acquire));
+    }
 
-        if (flipVertical)
-        {
-            // Flip the result vertically
-            OIIO::ImageBuf flipped;
-            if (!OIIO::ImageBufAlgo::flip (flipped, images[writeBuffer]))
-            {
-                LOG (WARNING) << "Failed to flip buffer: " << flipped.geterror();
-                return false;
-            }
-            images[writeBuffer].copy (flipped);
-        }
-        
+    // Swaps the newest published image into 'image' without copying any pixels, the sensor
+    // keeps the buffer 'image' held as its read buffer until the next publish.
+    // 'image' must already be float RGBA at the sensor's resolution. Returns false, leaving
+    // 'image' untouched, if nothing was published since the last take or the specs differ.
+    // getHDRImage() shows the returned buffer's old contents until the next publish
+    bool takeHDRImage (OIIO::ImageBuf& image)
+    {
+        std::lock_guard<std::mutex> lock (handoffMutex);
+        if (!freshImage) return false;
+
+        OIIO::ImageBuf& readImage = images[currentReadBuffer.load (std::memory_order_acquire)];
+        const OIIO::ImageSpec& have = image.spec();
+        const OIIO::ImageSpec& want = readImage.spec();
+        if (!image.localpixels() || have.width != want.width || have.height != want.height ||
+            have.nchannels != want.nchannels || have.format != want.format)
+            return false;
 
-        currentReadBuffer.store (writeBuffer, std::memory_order_release);
+        readImage.swap (image);
+        freshImage = false;
         return true;
     }
+
 #if 0
     bool updateImage (const void* renderedPixels, Vector2i renderSize, bool previewMode, uint32_t renderScale)
     {
@@ -343,6 +313,84 @@ class CameraSensor
     }
 
  private:
+    // Bilinear resample of tightly packed RGBA floats, pixel centres aligned like OIIO's resize
+    // Column taps are cached between frames and rows are spread over a small pool, the
+    // per pixel work is a fixed 4 channel blend the compiler vectorizes
+    void resampleBilinear (const float* src, uint32_t srcW, uint32_t srcH, float* dst, uint32_t dstW, uint32_t dstH, bool flipVertical)
+    {
+        if (columnTaps.size() != dstW || tapSrcWidth != srcW)
+        {
+            columnTaps.resize (dstW);
+            const float scale = static_cast<float> (srcW) / static_cast<float> (dstW);
+            for (uint32_t x = 0; x < dstW; ++x)
+            {
+                const float sx = std::clamp ((x + 0.5f) * scale - 0.5f, 0.0f, static_cast<float> (srcW - 1));
+                ColumnTap& tap = columnTaps[x];
+                tap.x0 = static_cast<uint32_t> (sx);
+                tap.x1 = std::min (tap.x0 + 1, srcW - 1);
+                tap.weight = sx - static_cast<float> (tap.x0);
+            }
+            tapSrcWidth = srcW;
+        }
+
+        const float scaleY = static_cast<float> (srcH) / static_cast<float> (dstH);
+        const ColumnTap* taps = columnTaps.data();
+
+        auto resampleRows = [=] (const uint32_t start, const uint32_t end)
+        {
+            for (uint32_t y = start; y < end; ++y)
+            {
+                const float sy = std::clamp ((y + 0.5f) * scaleY - 0.5f, 0.0f, static_cast<float> (srcH - 1));
+                const uint32_t y0 = static_cast<uint32_t> (sy);
+                const uint32_t y1 = std::min (y0 + 1, srcH - 1);
+                const float wy = sy - static_cast<float> (y0);
+
+                const float* row0 = src + static_cast<size_t> (y0) * srcW * 4;
+                const float* row1 = src + static_cast<size_t> (y1) * srcW * 4;
+                const uint32_t dstY = flipVertical ? dstH - 1 - y : y;
+                float* out = dst + static_cast<size_t> (dstY) * dstW * 4;
+
+                for (uint32_t x = 0; x < dstW; ++x)
+                {
+                    const ColumnTap& tap = taps[x];
+                    const float* a = row0 + tap.x0 * 4;
+                    const float* b = row0 + tap.x1 * 4;
+                    const float* c = row1 + tap.x0 * 4;
+                    const float* d = row1 + tap.x1 * 4;
+                    float* o = out + x * 4;
+                    for (int ch = 0; ch < 4; ++ch)
+                    {
+                        const float top = a[ch] + (b[ch] - a[ch]) * tap.weight;
+                        const float bottom = c[ch] + (d[ch] - c[ch]) * tap.weight;
+                        o[ch] = top + (bottom - top) * wy;
+                    }
+                }
+            }
+        };
+
+        if (!resamplePool)
+            resamplePool = std::make_unique<BS::thread_pool> (std::max (1u, std::thread::hardware_concurrency() / 2));
+
+        resamplePool->detach_blocks (0u, dstH, resampleRows);
+        resamplePool->wait();
+    }
+
+    // the writer only ever touches the buffer that is not the read buffer, so making the
+    // publish and the take exclusive is enough to keep a take away from the pixels being written
+    void publish (int writeBuffer)
+    {
+        std::lock_guard<std::mutex> lock (handoffMutex);
+        currentReadBuffer.store (writeBuffer, std::memory_order_release);
+        freshImage = true;
+    }
+
+    struct ColumnTap
+    {
+        uint32_t x0;
+        uint32_t x1;
+        float weight;
+    };
+
     float aspect;
     Eigen::Vector2f invPixelResolution;
     Eigen::Vector2f sensorSize = Eigen::Vector2f (0.036f, 0.024f);
@@ -351,4 +399,13 @@ class CameraSensor
     std::atomic<int> currentReadBuffer;
     std::atomic<uint32_t> width;
     std::atomic<uint32_t> height;
+
+    // guards the read buffer index against takeHDRImage()
+    std::mutex handoffMutex;
+    bool freshImage = false; // published since the last takeHDRImage()
+
+    // only touched by the thread calling updateImage()
+    std::vector<ColumnTap> columnTaps;
+    uint32_t tapSrcWidth = 0;
+    std::unique_ptr<BS::thread_pool> resamplePool;
 };
\ No newline at end of file
@@ -0,0 +1,218 @@
+
+CgImageSourcePtr CgImageSource::fromEncoded (std::vector<unsigned char> bytes)
+{
+    CgImageSourcePtr source (new CgImageSource());
+    source->encoded_ = std::move (bytes);
+    return source;
+}
+
+CgImageSourcePtr CgImageSource::fromFile (const fs::path& path)
+{
+    CgImageSourcePtr source (new CgImageSource());
+    source->path_ = path;
+    return source;
+}
+
+CgImageSource::~CgImageSource()
+{
+    CgImageCache::get().erase (this);
+}
+
+const OIIO::ImageSpec& CgImageSource::spec() const
+{
+    std::call_once (specOnce_, [this]
+                    { readSpec(); });
+    return spec_;
+}
+
+CgPixelsPtr CgImageSource::pixels() const
+{
+    CgImageCache& cache = CgImageCache::get();
+    if (CgPixelsPtr cached = cache.find (this)) return cached;
+    if (failed_) return nullptr;
+
+    // other threads asking for the same source wait here and share the result
+    std::lock_guard<std::mutex> lock (loadMutex_);
+    if (CgPixelsPtr cached = cache.find (this)) return cached;
+
+    CgPixelsPtr decoded = decode();
+    if (!decoded)
+    {
+        failed_ = true;
+        return nullptr;
+    }
+
+    cache.insert (this, decoded);
+    return decoded;
+}
+
+void CgImageSource::release() const
+{
+    CgImageCache::get().erase (this);
+}
+
+bool CgImageSource::isResident() const
+{
+    return CgImageCache::get().contains (this);
+}
+
+void CgImageSource::readSpec() const
+{
+    if (encoded_.size())
+    {
+        int w = 0, h = 0, c = 0;
+        if (stbi_info_from_memory (encoded_.data(), static_cast<int> (encoded_.size()), &w, &h, &c))
+            spec_ = OIIO::ImageSpec (w, h, c, OIIO::TypeDesc::UINT8);
+        return;
+    }
+
+    auto input = OIIO::ImageInput::open (path_.string());
+    if (!input)
+    {
+        LOG (WARNING) << "Could not open image " << path_.string() << ": " << OIIO::geterror();
+        return;
+    }
+    spec_ = input->spec();
+    input->close();
+}
+
+CgPixelsPtr CgImageSource::decode() const
+{
+    TRACE_SCOPE_CAT ("io", "CgImageSource::decode");
+
+    if (encoded_.size())
+    {
+        int w, h, c;
+        unsigned char* decodedData = stbi_load_from_memory (encoded_.data(), static_cast<int> (encoded_.size()),
+                                                            &w, &h, &c, 0);
+        if (!decodedData)
+        {
+            LOG (WARNING) << "Failed to decode embedded image: " << stbi_failure_reason();
+            return nullptr;
+        }
+
+        OIIO::ImageSpec spec (w, h, c, OIIO::TypeDesc::UINT8);
+        auto image = std::make_shared<OIIO::ImageBuf> (spec, OIIO::InitializePixels::No);
+        image->set_pixels (OIIO::ROI::All(), OIIO::TypeDesc::UINT8, decodedData);
+        stbi_image_free (decodedData);
+        return image;
+    }
+
+    if (path_.empty()) return nullptr;
+
+    // force a local copy, the budget here replaces OIIO's own ImageCache
+    auto image = std::make_shared<OIIO::ImageBuf> (path_.string());
+    if (!image->read (0, 0, true))
+    {
+        LOG (WARNING) << "Failed to read image " << path_.string() << ": " << image->geterror();
+        return nullptr;
+    }
+    return image;
+}
+
+CgImageCache& CgImageCache::get()
+{
+    // never destroyed, sources owned by other statics may still erase themselves at exit
+    static CgImageCache* cache = new CgImageCache();
+    return *cache;
+}
+
+void CgImageCache::setBudget (size_t bytes)
+{
+    std::vector<CgPixelsPtr> dropped;
+    std::lock_guard<std::mutex> lock (mutex_);
+    budget_ = bytes;
+    evict (budget_, dropped);
+}
+
+size_t CgImageCache::getBudget() const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return budget_;
+}
+
+size_t CgImageCache::getResidentBytes() const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return residentBytes_;
+}
+
+size_t CgImageCache::getResidentCount() const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return entries_.size();
+}
+
+void CgImageCache::trim (size_t bytes)
+{
+    std::vector<CgPixelsPtr> dropped;
+    std::lock_guard<std::mutex> lock (mutex_);
+    evict (bytes, dropped);
+}
+
+CgPixelsPtr CgImageCache::find (const CgImageSource* source)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = entries_.find (source);
+    if (it == entries_.end()) return nullptr;
+
+    recent_.splice (recent_.begin(), recent_, it->second);
+    return it->second->pixels;
+}
+
+void CgImageCache::insert (const CgImageSource* source, CgPixelsPtr pixels)
+{
+    std::vector<CgPixelsPtr> dropped;
+    std::lock_guard<std::mutex> lock (mutex_);
+
+    auto it = entries_.find (source);
+    if (it != entries_.end())
+    {
+        residentBytes_ -= it->second->bytes;
+        dropped.push_back (std::move (it->second->pixels));
+        recent_.erase (it->second);
+    }
+
+    const size_t bytes = pixels->spec().image_bytes();
+    recent_.push_front ({source, std::move (pixels), bytes});
+    entries_[source] = recent_.begin();
+    residentBytes_ += bytes;
+
+    // an image larger than the whole budget stays until the next one comes in
+    evict (budget_, dropped, source);
+}
+
+void CgImageCache::erase (const CgImageSource* source)
+{
+    CgPixelsPtr dropped;
+    std::lock_guard<std::mutex> lock (mutex_);
+
+    auto it = entries_.find (source);
+    if (it == entries_.end()) return;
+
+    residentBytes_ -= it->second->bytes;
+    dropped = std::move (it->second->pixels);
+    recent_.erase (it->second);
+    entries_.erase (it);
+}
+
+bool CgImageCache::contains (const CgImageSource* source) const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return entries_.count (source) > 0;
+}
+
+void CgImageCache::evict (size_t bytes, std::vector<CgPixelsPtr>& dropped, const CgImageSource* keep)
+{
+    auto it = recent_.end();
+    while (residentBytes_ > bytes && it != recent_.begin())
+    {
+        --it;
+        if (it->source == keep) continue;
+
+        residentBytes_ -= it->bytes;
+        dropped.push_back (std::move (it->pixels));
+        entries_.erase (it->source);
+        it = recent_.erase (it);
+    }
+}
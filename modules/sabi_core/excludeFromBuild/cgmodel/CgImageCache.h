@@ -0,0 +1,111 @@
+#pragma once
+
+// CgImageSource and CgImageCache: CgImage pixels decoded on first use, within a memory budget
+//
+// A CgImage only holds a CgImageSource, which knows where its pixels come from and reads
+// their spec without decoding them: either the encoded bytes of an embedded image, a
+// fraction of the decoded size, or the path of an image file. The first pixels() call
+// decodes them into the process wide CgImageCache. When the decoded total goes over the
+// budget the least recently used images are dropped and decoded again if asked for later.
+//
+// Dropping an image never pulls pixels out from under a reader, the ImageBuf handed out
+// stays alive until its last reader lets go of it.
+//
+// Usage:
+//   CgImageCache::get().setBudget (size_t (512) << 20);
+//   CgPixelsPtr pixels = model->cgImages[i].pixels();
+//   CgImageCache::get().trim (0); // memory pressure, drop everything not being read
+
+using CgImageSourcePtr = std::shared_ptr<class CgImageSource>;
+using CgPixelsPtr = std::shared_ptr<const OIIO::ImageBuf>;
+
+class CgImageSource
+{
+ public:
+    // Encoded PNG, JPEG, ... bytes, the spec comes from the header
+    static CgImageSourcePtr fromEncoded (std::vector<unsigned char> bytes);
+
+    // Image file, not opened until the spec or the pixels are needed
+    static CgImageSourcePtr fromFile (const fs::path& path);
+
+    ~CgImageSource();
+
+    CgImageSource (const CgImageSource&) = delete;
+    CgImageSource& operator= (const CgImageSource&) = delete;
+
+    // Size, channels and format, width and height are 0 when the source can't be read
+    const OIIO::ImageSpec& spec() const;
+
+    // Decoded pixels, loaded on the first call and again after the cache dropped them
+    // Returns null when the source can't be decoded. Safe to call from several threads,
+    // each source is only decoded once at a time
+    CgPixelsPtr pixels() const;
+
+    // Drops the decoded pixels until the next pixels() call
+    void release() const;
+
+    bool isResident() const;
+    bool isEmbedded() const { return !encoded_.empty(); }
+    const fs::path& getPath() const { return path_; }
+    size_t getEncodedSize() const { return encoded_.size(); }
+
+ private:
+    CgImageSource() = default;
+
+    std::vector<unsigned char> encoded_;
+    fs::path path_;
+
+    mutable OIIO::ImageSpec spec_;
+    mutable std::once_flag specOnce_;
+    mutable std::mutex loadMutex_;
+    mutable std::atomic<bool> failed_ = false;
+
+    void readSpec() const;
+    CgPixelsPtr decode() const;
+};
+
+class CgImageCache
+{
+ public:
+    static constexpr size_t DefaultBudget = size_t (2) << 30;
+
+    // The cache every CgImageSource decodes into
+    static CgImageCache& get();
+
+    // Drops the least recently used images right away if they no longer fit
+    void setBudget (size_t bytes);
+    size_t getBudget() const;
+
+    size_t getResidentBytes() const;
+    size_t getResidentCount() const;
+
+    // Drops the least recently used images until at most 'bytes' stay resident
+    void trim (size_t bytes);
+    void clear() { trim (0); }
+
+ private:
+    friend class CgImageSource;
+
+    CgImageCache() = default;
+
+    struct Entry
+    {
+        const CgImageSource* source = nullptr;
+        CgPixelsPtr pixels;
+        size_t bytes = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::list<Entry> recent_; // most recently used first
+    std::unordered_map<const CgImageSource*, std::list<Entry>::iterator> entries_;
+    size_t budget_ = DefaultBudget;
+    size_t residentBytes_ = 0;
+
+    CgPixelsPtr find (const CgImageSource* source);
+    void insert (const CgImageSource* source, CgPixelsPtr pixels);
+    void erase (const CgImageSource* source);
+    bool contains (const CgImageSource* source) const;
+
+    // caller holds mutex_, the dropped pixels are freed by the caller after unlocking
+    void evict (size_t bytes, std::vector<CgPixelsPtr>& dropped, const CgImageSource* keep = nullptr);
+};
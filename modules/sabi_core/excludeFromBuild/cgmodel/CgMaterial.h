@@ -83,11 +83,20 @@ struct CgImage
     std::string uri;
     std::string mimeType;
 
-    // For embedded/loaded images
-    OIIO::ImageBuf extractedImage;
+    // Where the pixels come from, nothing is decoded until pixels() is called
+    CgImageSourcePtr source;
 
     std::size_t index = 0;
     std::string name;
+
+    // Decoded pixels, null when there is no source or it can't be read
+    CgPixelsPtr pixels() const { return source ? source->pixels() : nullptr; }
+
+    // Drops the decoded pixels until the next pixels() call
+    void releasePixels() const
+    {
+        if (source) source->release();
+    }
 };
 
 // Using our own enum types to avoid dependency on fastgltf
@@ -45,6 +45,33 @@ struct CgModel
         return triCount;
     }
 
+    // Decodes every image now instead of on first use, one task per image
+    // pool: optional, a temporary pool is used when none is given
+    void loadImages (BS::thread_pool* pool = nullptr) const
+    {
+        auto loadRange = [this] (size_t start, size_t end)
+        {
+            for (size_t i = start; i < end; ++i)
+                cgImages[i].pixels();
+        };
+
+        if (cgImages.size() < 2 || BS::this_thread::get_pool())
+        {
+            loadRange (0, cgImages.size());
+        }
+        else if (pool)
+        {
+            // the pool may be shared, wait for these images only
+            pool->submit_blocks (size_t (0), cgImages.size(), loadRange, cgImages.size()).wait();
+        }
+        else
+        {
+            BS::thread_pool localPool (static_cast<BS::concurrency_t> (std::min<size_t> (cgImages.size(), std::thread::hardware_concurrency())));
+            localPool.detach_blocks (size_t (0), cgImages.size(), loadRange, cgImages.size());
+            localPool.wait();
+        }
+    }
+
     void reset()
     {
         V.resize (3, 0);
@@ -75,6 +102,7 @@ struct CgModel
      float computeSurfaceArea() const
     {
         float totalArea = 0.0f;
+        LOG_TALLY (degenerate, WARNING, "degenerate triangles skipped");
 
         for (const auto& surface : S)
         {
@@ -95,8 +123,8 @@ struct CgModel
                 // Check for degenerate triangles
                 if (std::isnan (area) || std::isinf (area) || area <= std::numeric_limits<float>::epsilon())
                 {
-                    // Skip degenerate triangles and log a warning
-                    LOG (CRITICAL) << "Warning: Degenerate triangle found. Skipping...";
+                    // Skip degenerate triangles, counted and logged once on return
+                    degenerate.add();
                     continue;
                 }
 
@@ -23,6 +23,7 @@ struct CgModelSurface
     float computeSurfaceArea (const MatrixXf& V) const
     {
         float area = 0.0f;
+        LOG_TALLY (degenerate, WARNING, "degenerate triangles skipped in surface");
 
         for (int i = 0; i < F.cols(); ++i)
         {
@@ -39,8 +40,8 @@ struct CgModelSurface
             // Check for degenerate triangles
             if (std::isnan (triArea) || std::isinf (triArea) || triArea <= std::numeric_limits<float>::epsilon())
             {
-                // Skip degenerate triangles and log a warning
-                LOG (CRITICAL) << "Warning: Degenerate triangle found in surface. Skipping...";
+                // Skip degenerate triangles, counted and logged once on return
+                degenerate.add();
                 continue;
             }
 
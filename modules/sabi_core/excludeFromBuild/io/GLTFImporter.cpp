@@ -1,5 +1,4 @@
 
-#include <stb_image/stb_image.h>
 
 using fastgltf::Asset;
 using fastgltf::Expected;
@@ -13,8 +12,10 @@ using sabi::Material;
 using Eigen::Vector3f;
 
 
-std::pair<CgModelPtr, std::vector<Animation>> GLTFImporter::importModel (const std::string& filePath)
+std::pair<CgModelPtr, std::vector<Animation>> GLTFImporter::importModel (const std::string& filePath,
+                                                                         BS::thread_pool* pool)
 {
+    TRACE_SCOPE_CAT ("io", "GLTFImporter::importModel");
     try
     {
         if (!fs::exists (filePath) || !fs::is_regular_file (filePath))
@@ -24,18 +25,43 @@ std::pair<CgModelPtr, std::vector<Animation>> GLTFImporter::importModel (const s
 
         auto asset = loadGLTF (filePath);
 
-        processScenes (asset);
-        if (models.size() == 0) return {nullptr, {}};
+        // image URIs are relative to the glTF file
+        const fs::path contentDirectory = fs::path (filePath).parent_path();
+        collectImages (asset, contentDirectory);
 
-        CgModelPtr cgModel = models.size() > 1 ? forgeIntoOne (models) : models[0];
-        if (!cgModel) return {nullptr, {}};
+        // images decode on the pool while the geometry is imported on this thread,
+        // already on a pool thread they are left for first use instead of nesting pools
+        BS::multi_future<void> decoding;
+        if (pool && assetImages.size() && !BS::this_thread::get_pool())
+            decoding = decodeImages (*pool);
+
+        CgModelPtr cgModel;
+        try
+        {
+            processScenes (asset);
+            if (models.size()) cgModel = models.size() > 1 ? forgeIntoOne (models) : models[0];
+        }
+        catch (...)
+        {
+            // the decode tasks still read assetImages
+            decoding.wait();
+            throw;
+        }
+        decoding.wait();
+
+        if (!cgModel)
+        {
+            assetImages.clear();
+            return {nullptr, {}};
+        }
+
+        cgModel->contentDirectory = contentDirectory;
 
         importImages (asset, *cgModel);
         importTextures (asset, *cgModel);
         importSamplers (asset, *cgModel);
 
         // CgMaterial support
-        importCgImages (asset, *cgModel);
         importCgTextures (asset, *cgModel);
         importCgSamplers (asset, *cgModel);
 
@@ -55,6 +81,7 @@ std::pair<CgModelPtr, std::vector<Animation>> GLTFImporter::importModel (const s
 // Asset loading and parsing implementation
 fastgltf::Asset GLTFImporter::loadGLTF (const std::string& filePath)
 {
+    TRACE_SCOPE_CAT ("io", "GLTFImporter::loadGLTF");
     Expected<fastgltf::GltfDataBuffer> data = GltfDataBuffer::FromPath (filePath);
     Expected<Asset> asset (fastgltf::Error::None);
 
@@ -123,6 +150,7 @@ fastgltf::Asset GLTFImporter::loadGLTF (const std::string& filePath)
 // Scene graph processing implementation
 void GLTFImporter::processScenes (const fastgltf::Asset& asset)
 {
+    TRACE_SCOPE_CAT ("io", "GLTFImporter::processScenes");
     if (asset.scenes.empty())
     {
         LOG (CRITICAL) << "No scenes found in the glTF file";
@@ -689,68 +717,50 @@ void GLTFImporter::importPackedTextures (const fastgltf::Asset& asset,
     }
 }
 
-void GLTFImporter::importImages (const fastgltf::Asset& asset, CgModel& model)
+void GLTFImporter::collectImages (const fastgltf::Asset& asset, const fs::path& contentDirectory)
 {
-    model.images.reserve (asset.images.size());
+    assetImages.assign (asset.images.size(), {});
 
-    size_t index = 0;
-    for (const auto& gltfImage : asset.images)
+    for (size_t index = 0; index < asset.images.size(); ++index)
     {
-        sabi::Image sabiImage;
-        sabiImage.name = gltfImage.name;
-        sabiImage.index = index;
-
-        // Temporary storage for extracted image data
-        std::vector<unsigned char> extractedImageBytes;
-        std::uint32_t width, height, channels;
-        std::string imageId;
-
-        // Extract image data from GLTF source
-        extractImageData (asset, sabiImage, gltfImage, index++,
-                          extractedImageBytes, width, height, channels, imageId);
-
-        // If we successfully extracted image data, store it in an ImageBuf
-        if (extractedImageBytes.size())
-        {
-            OIIO::ImageSpec spec (width, height, channels, OIIO::TypeDesc::UINT8);
-            OIIO::ImageBuf imageBuf (spec, extractedImageBytes.data());
-            sabiImage.extractedImage = imageBuf;
-        }
-
-        model.images.push_back (std::move (sabiImage));
+        sabi::CgImage& cgImage = assetImages[index];
+        cgImage.name = asset.images[index].name;
+        cgImage.index = index;
+        cgImage.source = importImageSource (asset, asset.images[index], contentDirectory,
+                                            cgImage.uri, cgImage.mimeType);
     }
 }
 
-void GLTFImporter::importCgImages (const fastgltf::Asset& asset, sabi::CgModel& model)
+BS::multi_future<void> GLTFImporter::decodeImages (BS::thread_pool& pool)
 {
-    model.cgImages.reserve (asset.images.size());
-
-    size_t index = 0;
-    for (const auto& gltfImage : asset.images)
-    {
-        sabi::CgImage cgImage;
-        cgImage.name = gltfImage.name;
-        cgImage.index = index;
+    // the pixels land in CgImageCache, keyed by the same sources the model gets
+    return pool.submit_blocks (size_t (0), assetImages.size(), [this] (size_t start, size_t end)
+                               {
+        for (size_t i = start; i < end; ++i)
+            assetImages[i].pixels(); },
+                               assetImages.size());
+}
 
-        // Temporary storage for extracted image data
-        std::vector<unsigned char> extractedImageBytes;
-        std::uint32_t width, height, channels;
-        std::string imageId;
+void GLTFImporter::importImages (const fastgltf::Asset& asset, CgModel& model)
+{
+    model.images.reserve (assetImages.size());
+    model.cgImages.reserve (assetImages.size());
 
-        // Extract image data from GLTF source
-        extractImageData (asset, cgImage, gltfImage, index++,
-                          extractedImageBytes, width, height, channels, imageId);
+    for (size_t index = 0; index < assetImages.size(); ++index)
+    {
+        sabi::CgImage& cgImage = assetImages[index];
 
-        // If we successfully extracted image data, store it in an ImageBuf
-        if (extractedImageBytes.size())
-        {
-            OIIO::ImageSpec spec (width, height, channels, OIIO::TypeDesc::UINT8);
-            OIIO::ImageBuf imageBuf (spec, extractedImageBytes.data());
-            cgImage.extractedImage = imageBuf;
-        }
+        sabi::Image sabiImage;
+        sabiImage.name = cgImage.name;
+        sabiImage.index = static_cast<uint32_t> (index);
+        sabiImage.uri = cgImage.uri;
+        sabiImage.mimeType = cgImage.mimeType;
+        sabiImage.source = cgImage.source;
 
+        model.images.push_back (std::move (sabiImage));
         model.cgImages.push_back (std::move (cgImage));
     }
+    assetImages.clear();
 }
 
 void GLTFImporter::importTextures (const fastgltf::Asset& asset, CgModel& model)
@@ -848,17 +858,14 @@ void GLTFImporter::importCgSamplers (const fastgltf::Asset& asset, CgModel& mode
     LOG (DBUG) << "Imported " << model.cgSamplers.size() << " CG samplers";
 }
 
-void GLTFImporter::extractImageData (const fastgltf::Asset& asset, sabi::Image& sabiImage,
-                                     const fastgltf::Image& image, size_t imageIndex,
-                                     std::vector<unsigned char>& imageBytes, std::uint32_t& width,
-                                     std::uint32_t& height, std::uint32_t& channels,
-                                     std::string& imageIdentifier)
+sabi::CgImageSourcePtr GLTFImporter::importImageSource (const fastgltf::Asset& asset, const fastgltf::Image& image,
+                                                      const fs::path& contentDirectory, std::string& uri,
+                                                      std::string& mimeType)
 {
-    imageIdentifier = getImageIdentifier (asset, imageIndex);
-    imageBytes.clear();
-    width = height = channels = 0;
+    std::vector<unsigned char> imageBytes;
+    sabi::CgImageSourcePtr imageSource;
 
-    // Handle different image source types
+    // Handle different image source types, only the encoded bytes or the path are kept
     std::visit ([&] (const auto& source)
                 {
         using T = std::decay_t<decltype(source)>;
@@ -866,6 +873,7 @@ void GLTFImporter::extractImageData (const fastgltf::Asset& asset, sabi::Image&
         if constexpr (std::is_same_v<T, fastgltf::sources::BufferView>) {
             const auto& bufferView = asset.bufferViews[source.bufferViewIndex];
             const auto& buffer = asset.buffers[bufferView.bufferIndex];
+            mimeType = fastgltf::getMimeTypeString(source.mimeType);
 
             std::visit([&](const auto& bufferSource) {
                 using BufferT = std::decay_t<decltype(bufferSource)>;
@@ -882,102 +890,23 @@ void GLTFImporter::extractImageData (const fastgltf::Asset& asset, sabi::Image&
             }, buffer.data);
         }
         else if constexpr (std::is_same_v<T, fastgltf::sources::URI>) {
-            sabiImage.uri = source.uri.string();
-            sabiImage.mimeType = fastgltf::getMimeTypeString(source.mimeType);
-            LOG(DBUG) << "Stored image URI: " << sabiImage.uri;
+            uri = source.uri.string();
+            mimeType = fastgltf::getMimeTypeString(source.mimeType);
+            imageSource = sabi::CgImageSource::fromFile(contentDirectory / source.uri.fspath());
+            LOG(DBUG) << "Stored image URI: " << uri;
         }
         else if constexpr (std::is_same_v<T, fastgltf::sources::Vector> || 
                           std::is_same_v<T, fastgltf::sources::Array>) {
-            sabiImage.mimeType = fastgltf::getMimeTypeString(source.mimeType);
+            mimeType = fastgltf::getMimeTypeString(source.mimeType);
             auto start = reinterpret_cast<const unsigned char*>(source.bytes.data());
             imageBytes.assign(start, start + source.bytes.size());
         } },
                 image.data);
 
-    // Process image data if available
     if (!imageBytes.empty())
-    {
-        int w, h, c;
-        unsigned char* decodedData = stbi_load_from_memory (
-            imageBytes.data(),
-            static_cast<int> (imageBytes.size()),
-            &w, &h, &c, 0);
-
-        if (decodedData)
-        {
-            width = static_cast<std::uint32_t> (w);
-            height = static_cast<std::uint32_t> (h);
-            channels = static_cast<std::uint32_t> (c);
-            imageBytes.assign (decodedData, decodedData + (width * height * channels));
-            stbi_image_free (decodedData);
-        }
-    }
-}
-
-void GLTFImporter::extractImageData (const fastgltf::Asset& asset, sabi::CgImage& sabiImage,
-                                     const fastgltf::Image& image, size_t imageIndex,
-                                     std::vector<unsigned char>& imageBytes, std::uint32_t& width,
-                                     std::uint32_t& height, std::uint32_t& channels,
-                                     std::string& imageIdentifier)
-{
-    // This implementation is identical to the above but operates on CgImage
-    // Reuse the same implementation pattern but with CgImage specific features
-    imageIdentifier = getImageIdentifier (asset, imageIndex);
-    imageBytes.clear();
-    width = height = channels = 0;
+        imageSource = sabi::CgImageSource::fromEncoded (std::move (imageBytes));
 
-    std::visit ([&] (const auto& source)
-                {
-        using T = std::decay_t<decltype(source)>;
-        
-        if constexpr (std::is_same_v<T, fastgltf::sources::BufferView>) {
-            // Same as above implementation
-            const auto& bufferView = asset.bufferViews[source.bufferViewIndex];
-            const auto& buffer = asset.buffers[bufferView.bufferIndex];
-
-            std::visit([&](const auto& bufferSource) {
-                using BufferT = std::decay_t<decltype(bufferSource)>;
-                if constexpr (std::is_same_v<BufferT, fastgltf::sources::Array>) {
-                    if (bufferView.byteOffset + bufferView.byteLength <= bufferSource.bytes.size()) {
-                        imageBytes.resize(bufferView.byteLength);
-                        std::transform(
-                            bufferSource.bytes.begin() + bufferView.byteOffset,
-                            bufferSource.bytes.begin() + bufferView.byteOffset + bufferView.byteLength,
-                            imageBytes.begin(),
-                            [](std::byte b) { return static_cast<unsigned char>(b); });
-                    }
-                }
-            }, buffer.data);
-        }
-        else if constexpr (std::is_same_v<T, fastgltf::sources::URI>) {
-            sabiImage.uri = source.uri.string();
-            sabiImage.mimeType = fastgltf::getMimeTypeString(source.mimeType);
-        }
-        else if constexpr (std::is_same_v<T, fastgltf::sources::Vector> || 
-                          std::is_same_v<T, fastgltf::sources::Array>) {
-            sabiImage.mimeType = fastgltf::getMimeTypeString(source.mimeType);
-            auto start = reinterpret_cast<const unsigned char*>(source.bytes.data());
-            imageBytes.assign(start, start + source.bytes.size());
-        } },
-                image.data);
-
-    if (!imageBytes.empty())
-    {
-        int w, h, c;
-        unsigned char* decodedData = stbi_load_from_memory (
-            imageBytes.data(),
-            static_cast<int> (imageBytes.size()),
-            &w, &h, &c, 0);
-
-        if (decodedData)
-        {
-            width = static_cast<std::uint32_t> (w);
-            height = static_cast<std::uint32_t> (h);
-            channels = static_cast<std::uint32_t> (c);
-            imageBytes.assign (decodedData, decodedData + (width * height * channels));
-            stbi_image_free (decodedData);
-        }
-    }
+    return imageSource;
 }
 
 std::string GLTFImporter::mimeTypeToString (fastgltf::MimeType mimeType)
@@ -10,6 +10,8 @@
 // - Handles node hierarchies and transforms
 // - Supports animations
 // - Can combine multiple meshes into a single model
+// - Keeps embedded images encoded, their pixels are decoded on first use (see CgImageCache),
+//   or concurrently with the geometry import when given a thread pool
 //
 // Example usage:
 //   GLTFImporter importer;
@@ -29,13 +31,17 @@ class GLTFImporter
     // Primary entry point for importing a glTF file
     // Returns a pair containing the model and its animations
     // Throws std::runtime_error if import fails
-    std::pair<CgModelPtr, std::vector<Animation>> importModel (const std::string& filePath);
+    // pool: optional, every image is decoded on it while the geometry is imported,
+    // without one the images stay encoded until first use
+    std::pair<CgModelPtr, std::vector<Animation>> importModel (const std::string& filePath,
+                                                               BS::thread_pool* pool = nullptr);
 
  private:
     // Internal state
     CgModelList models;                        // Imported models
     GltfAnimationExporter animationExporter;   // Animation export handler
     std::unordered_set<std::string> usedNames; // Name uniqueness tracking
+    std::vector<sabi::CgImage> assetImages;    // Indexed like asset.images, made before the geometry
 
     // Asset loading
     // Parses glTF/GLB file into fastgltf::Asset
@@ -91,8 +97,8 @@ class GLTFImporter
                                sabi::CgMaterial::PackedTextureProperties& packedTextures);
 
     // Texture import
+    // Fills the legacy and Cg image tables from assetImages, both share each image source
     void importImages (const fastgltf::Asset& asset, CgModel& model);
-    void importCgImages (const fastgltf::Asset& asset, sabi::CgModel& model);
     void importTextures (const fastgltf::Asset& asset, CgModel& model);
     void importCgTextures (const fastgltf::Asset& asset, sabi::CgModel& model);
     void importSamplers (const fastgltf::Asset& asset, CgModel& model);
@@ -102,16 +108,15 @@ class GLTFImporter
     sabi::CgTextureInfo importCgTextureInfo (const fastgltf::Asset& asset,
                                              const fastgltf::TextureInfo& textureInfo);
     // Image data handling
-    void extractImageData (const fastgltf::Asset& asset, sabi::Image& sabiImage,
-                           const fastgltf::Image& image, size_t imageIndex,
-                           std::vector<unsigned char>& imageBytes, std::uint32_t& width,
-                           std::uint32_t& height, std::uint32_t& channels,
-                           std::string& imageIdentifier);
-    void extractImageData (const fastgltf::Asset& asset, sabi::CgImage& sabiImage,
-                           const fastgltf::Image& image, size_t imageIndex,
-                           std::vector<unsigned char>& imageBytes, std::uint32_t& width,
-                           std::uint32_t& height, std::uint32_t& channels,
-                           std::string& imageIdentifier);
+    // Fills assetImages, nothing is decoded
+    void collectImages (const fastgltf::Asset& asset, const fs::path& contentDirectory);
+    // Starts decoding every image in assetImages, one task per image
+    // Wait on the result before assetImages changes
+    BS::multi_future<void> decodeImages (BS::thread_pool& pool);
+    // Encoded bytes of an embedded or buffer view image, or the file of a URI image
+    sabi::CgImageSourcePtr importImageSource (const fastgltf::Asset& asset, const fastgltf::Image& image,
+                                              const fs::path& contentDirectory, std::string& uri,
+                                              std::string& mimeType);
 
     // Helper functions
     std::string mimeTypeToString (fastgltf::MimeType mimeType);
@@ -253,8 +253,8 @@ namespace
         int bufferViewIndex = INVALID_INDEX; // Index to a bufferView (for embedded image data)
         std::string mimeType;                // MIME type of the image
         // std::vector<uint8_t> data;           // Raw image data
-        OIIO::ImageBuf extractedImage; // could be from BufferView in GLB or embedded
-        uint32_t index = 0;            // index into the models vector of images
+        CgImageSourcePtr source; // pixels from a BufferView in GLB, embedded or a file, shared with the CgImage
+        uint32_t index = 0;      // index into the models vector of images
     };
 
     struct Texture
@@ -0,0 +1,127 @@
+#pragma once
+
+// LWO3ChunkIndex: One pass index of the elements in an LWO3 tree
+//
+// LWO3Navigator::findElementsById walks the whole tree on every query, so pulling
+// each chunk type out of each layer was quadratic in the size of the file. The index
+// is built once per file and answers the same questions with a hash lookup:
+// - every element with a given ID, at any depth, in file order
+// - the chunks of each layer, that is the LAYR chunk and the sibling chunks that
+//   follow it up to the next LAYR, by layer number and chunk ID
+//
+// Chunks that come before the first LAYR (TAGS, CLIP...) belong to the whole file
+// and are only found through find().
+//
+// The index points into the tree, keep the root form alive while using it.
+
+using LWO3ChunkIndexPtr = std::shared_ptr<const class LWO3ChunkIndex>;
+
+class LWO3ChunkIndex
+{
+ public:
+    static LWO3ChunkIndexPtr create (const LWO3Form* root)
+    {
+        auto index = std::make_shared<LWO3ChunkIndex>();
+        if (root) index->addForm (root);
+        return index;
+    }
+
+    // Every element with 'id', in file order
+    const std::vector<const LWO3Element*>& find (uint32_t id) const
+    {
+        auto it = elements_.find (id);
+        return it != elements_.end() ? it->second : noElements_;
+    }
+
+    // First chunk with 'id' anywhere in the file, or nullptr
+    const LWO3Chunk* findFirstChunk (uint32_t id) const
+    {
+        for (const LWO3Element* element : find (id))
+        {
+            if (!element->isForm()) return static_cast<const LWO3Chunk*> (element);
+        }
+        return nullptr;
+    }
+
+    // Layer numbers from the LAYR chunks, in file order
+    const std::vector<uint16_t>& getLayerNumbers() const { return layerNumbers_; }
+
+    bool hasLayer (uint16_t layer) const { return layers_.count (layer) != 0; }
+
+    // Every chunk with 'id' that belongs to 'layer', in file order
+    const std::vector<const LWO3Chunk*>& findLayerChunks (uint16_t layer, uint32_t id) const
+    {
+        auto layerIt = layers_.find (layer);
+        if (layerIt == layers_.end()) return noChunks_;
+
+        auto it = layerIt->second.find (id);
+        return it != layerIt->second.end() ? it->second : noChunks_;
+    }
+
+    // First chunk with 'id' that belongs to 'layer', or nullptr
+    const LWO3Chunk* findLayerChunk (uint16_t layer, uint32_t id) const
+    {
+        const auto& chunks = findLayerChunks (layer, id);
+        return chunks.empty() ? nullptr : chunks.front();
+    }
+
+    size_t elementCount() const { return elementCount_; }
+
+ private:
+    using LayerChunks = std::unordered_map<uint32_t, std::vector<const LWO3Chunk*>>;
+
+    std::unordered_map<uint32_t, std::vector<const LWO3Element*>> elements_;
+    std::unordered_map<uint16_t, LayerChunks> layers_;
+    std::vector<uint16_t> layerNumbers_;
+    size_t elementCount_ = 0;
+
+    inline static const std::vector<const LWO3Element*> noElements_;
+    inline static const std::vector<const LWO3Chunk*> noChunks_;
+
+    void addForm (const LWO3Form* form)
+    {
+        // a LAYR claims the chunks after it within the same form
+        LayerChunks* layer = nullptr;
+
+        for (const auto& child : form->getChildren())
+        {
+            const LWO3Element* element = child.get();
+            elements_[element->getId()].push_back (element);
+            ++elementCount_;
+
+            if (element->isForm())
+            {
+                addForm (static_cast<const LWO3Form*> (element));
+                continue;
+            }
+
+            const auto* chunk = static_cast<const LWO3Chunk*> (element);
+            if (chunk->getId() == LWO::LAYR)
+                layer = beginLayer (chunk);
+
+            if (layer)
+                (*layer)[chunk->getId()].push_back (chunk);
+        }
+    }
+
+    LayerChunks* beginLayer (const LWO3Chunk* layr)
+    {
+        const auto data = layr->getData();
+        if (data.size() < 2)
+        {
+            LOG (WARNING) << "LAYR chunk at offset " << layr->getFileOffset() << " is too small";
+            return nullptr;
+        }
+
+        const uint16_t number = static_cast<uint16_t> ((data[0] << 8) | data[1]);
+        if (layers_.count (number))
+        {
+            // the first LAYR with a number wins, as it did before the index
+            LOG (WARNING) << "Ignoring duplicate LAYR " << number << " at offset " << layr->getFileOffset();
+            return nullptr;
+        }
+
+        layerNumbers_.push_back (number);
+        return &layers_[number];
+    }
+};
@@ -1,10 +1,16 @@
 
 
 LWO3Layer::LWO3Layer (std::shared_ptr<LWO3Form> root, size_t layerIndex) :
-    root_ (root), 
+    LWO3Layer (root, sabi::LWO3ChunkIndex::create (root.get()), layerIndex)
+{
+}
+
+LWO3Layer::LWO3Layer (std::shared_ptr<LWO3Form> root, LWO3ChunkIndexPtr chunkIndex, size_t layerIndex) :
+    root_ (root),
+    chunkIndex_ (chunkIndex),
     index_ (layerIndex)
 {
-    if (!root)
+    if (!root || !chunkIndex)
     {
         LOG (INFO) << "Null root form provided to LWO3Layer";
         return;
@@ -61,8 +67,8 @@ LWO3Layer::LWO3Layer (std::shared_ptr<LWO3Form> root, size_t layerIndex) :
         LOG (WARNING) << "Failed to process SURF forms for layer " << index_;
     }
 
-    // Process PTAG chunks after POLS and TAGS
-    if (const LWO3Chunk* ptagChunk = findChunk (sabi::LWO::PTAG))
+    // Process PTAG chunks after POLS and TAGS, there is one per tag type (SURF, PART, SMGP...)
+    for (const LWO3Chunk* ptagChunk : chunkIndex_->findLayerChunks (static_cast<uint16_t> (index_), sabi::LWO::PTAG))
     {
         if (!processPTagChunk (ptagChunk))
         {
@@ -70,12 +76,15 @@ LWO3Layer::LWO3Layer (std::shared_ptr<LWO3Form> root, size_t layerIndex) :
         }
     }
 
-    //  after other chunk processing
-    if (const LWO3Chunk* vmapChunk = findChunk (sabi::LWO::VMAP))
+    //  after other chunk processing, a layer has a VMAP per map and a VMAD per map with seams
+    for (const uint32_t mapId : {sabi::LWO::VMAP, sabi::LWO::VMAD})
     {
-        if (!processVMapChunk (vmapChunk))
+        for (const LWO3Chunk* vmapChunk : chunkIndex_->findLayerChunks (static_cast<uint16_t> (index_), mapId))
         {
-            LOG (WARNING) << "Failed to process VMAP chunk for layer " << index_;
+            if (!processVMapChunk (vmapChunk, mapId == sabi::LWO::VMAD))
+            {
+                LOG (WARNING) << "Failed to process vertex map chunk for layer " << index_;
+            }
         }
     }
 }
@@ -111,18 +120,16 @@ bool LWO3Layer::processBBoxChunk (const LWO3Chunk* chunk)
 
 bool LWO3Layer::processPolsChunk (const LWO3Chunk* chunk)
 {
-    BinaryReader reader (
-        const_cast<char*> (reinterpret_cast<const char*> (chunk->getData().data())),
-        static_cast<uint32_t> (chunk->getData().size()));
+    LWO3Decoder decoder (chunk->getData());
 
     // Read polygon type (FACE, PTCH, etc)
-    polygonType_ = mace::swap32 (reader.ReadUint32());
+    polygonType_ = decoder.u32();
 
     // Read polygons until we reach the end of the chunk
-    while (reader.Position() < reader.Length())
+    while (!decoder.atEnd())
     {
         // Read vertex count including flags
-        uint16_t vertCountAndFlags = mace::swap16 (reader.ReadUint16());
+        uint16_t vertCountAndFlags = decoder.u16();
 
         // Extract count and flags
         uint16_t flags = vertCountAndFlags & 0xFC00;     // High 6 bits
@@ -131,14 +138,14 @@ bool LWO3Layer::processPolsChunk (const LWO3Chunk* chunk)
         // Create new polygon
         LWPolygon poly;
         poly.flags = flags;
-        poly.indices.reserve (vertCount);
+        poly.indices.resize (vertCount);
 
-        // Read vertex indices
-        for (uint16_t i = 0; i < vertCount; i++)
+        // Read vertex indices, variable-length
+        decoder.vxIndices (poly.indices.data(), vertCount);
+        if (decoder.overrun())
         {
-            // Use readVX to handle variable-length indices
-            uint32_t index = mace::readVX (reader);
-            poly.indices.push_back (index);
+            LOG (WARNING) << "Truncated POLS chunk in layer " << index_;
+            break;
         }
 
         polygons_.push_back (std::move (poly));
@@ -146,39 +153,15 @@ bool LWO3Layer::processPolsChunk (const LWO3Chunk* chunk)
 
     return true;
 }
-const LWO3Chunk* LWO3Layer::findChunk (uint32_t chunkId, size_t startOffset)
+const LWO3Chunk* LWO3Layer::findChunk (uint32_t chunkId) const
 {
-    auto results = navigator_.findElementsById (root_.get(), chunkId);
-
-    for (const auto& result : results)
+    // tags are written once for the whole file, before the first layer
+    if (chunkId == sabi::LWO::TAGS)
     {
-        if (!result.element->isForm())
-        {
-            const auto* chunk = static_cast<const LWO3Chunk*> (result.element);
-
-            // For LAYR chunks, verify it's for our layer
-            if (chunkId == sabi::LWO::LAYR)
-            {
-                BinaryReader reader (
-                    const_cast<char*> (reinterpret_cast<const char*> (chunk->getData().data())),
-                    static_cast<uint32_t> (chunk->getData().size()));
-
-                uint16_t layerNumber = mace::swap16 (reader.ReadUint16());
-                if (layerNumber == index_)
-                {
-                    return chunk;
-                }
-            }
-            else
-            {
-                if (chunk->getFileOffset() >= startOffset)
-                {
-                    return chunk;
-                }
-            }
-        }
+        return chunkIndex_->findFirstChunk (chunkId);
     }
-    return nullptr;
+
+    return chunkIndex_->findLayerChunk (static_cast<uint16_t> (index_), chunkId);
 }
 
 bool LWO3Layer::processLayrChunk (const LWO3Chunk* chunk)
@@ -213,22 +196,13 @@ bool LWO3Layer::processLayrChunk (const LWO3Chunk* chunk)
 
 bool LWO3Layer::processPntsChunk (const LWO3Chunk* chunk)
 {
-    const auto& data = chunk->getData();
-    BinaryReader reader (
-        const_cast<char*> (reinterpret_cast<const char*> (data.data())),
-        static_cast<uint32_t> (data.size()));
+    LWO3Decoder decoder (chunk->getData());
 
-    // Each point is 12 bytes (3 x 4-byte floats)
-    size_t numPoints = data.size() / 12;
-    points_.reserve (numPoints);
-
-    for (size_t i = 0; i < numPoints; i++)
-    {
-        float x = mace::swapFloat (reader.ReadFloat());
-        float y = mace::swapFloat (reader.ReadFloat());
-        float z = mace::swapFloat (reader.ReadFloat());
-        points_.emplace_back (x, y, z);
-    }
+    // Each point is 12 bytes (3 x 4-byte floats), decoded in one bulk swap
+    size_t numPoints = decoder.size() / 12;
+    points_.resize (numPoints);
+    static_assert (sizeof (Vector3f) == 3 * sizeof (float));
+    decoder.floats (points_.data()->data(), numPoints * 3);
 
     return true;
 }
@@ -265,12 +239,10 @@ bool LWO3Layer::processTagsChunk (const LWO3Chunk* chunk)
 
 bool LWO3Layer::processPTagChunk (const LWO3Chunk* chunk)
 {
-    BinaryReader reader (
-        const_cast<char*> (reinterpret_cast<const char*> (chunk->getData().data())),
-        static_cast<uint32_t> (chunk->getData().size()));
+    LWO3Decoder decoder (chunk->getData());
 
     // Read tag type (SURF, PART, etc)
-    uint32_t tagType = mace::swap32 (reader.ReadUint32());
+    uint32_t tagType = decoder.u32();
 
     // Create or get vector of tag indices for this type
     auto& tagIndices = polyTags_[tagType];
@@ -282,13 +254,19 @@ bool LWO3Layer::processPTagChunk (const LWO3Chunk* chunk)
     }
 
     // Read polygon/tag pairs until end of chunk
-    while (reader.Position() < reader.Length())
+    while (!decoder.atEnd())
     {
         // Read polygon index using variable-length format
-        uint32_t polyIndex = mace::readVX (reader);
+        uint32_t polyIndex = decoder.vx();
 
         // Read tag index
-        uint16_t tagIndex = mace::swap16 (reader.ReadUint16());
+        uint16_t tagIndex = decoder.u16();
+
+        if (decoder.overrun())
+        {
+            LOG (WARNING) << "Truncated PTAG chunk in layer " << index_;
+            break;
+        }
 
         // Validate indices
         if (polyIndex >= polygons_.size())
@@ -310,25 +288,18 @@ bool LWO3Layer::processPTagChunk (const LWO3Chunk* chunk)
     return true;
 }
 
-bool LWO3Layer::processVMapChunk (const LWO3Chunk* chunk)
+bool LWO3Layer::processVMapChunk (const LWO3Chunk* chunk, bool discontinuous)
 {
-    BinaryReader reader (
-        const_cast<char*> (reinterpret_cast<const char*> (chunk->getData().data())),
-        static_cast<uint32_t> (chunk->getData().size()));
+    LWO3Decoder decoder (chunk->getData());
 
     // Read map type (TXUV, WGHT, etc)
-    uint32_t type = mace::swap32 (reader.ReadUint32());
+    uint32_t type = decoder.u32();
 
     // Read dimension
-    uint16_t dimension = mace::swap16 (reader.ReadUint16());
-
-    // Read name
-    std::string name = reader.ReadNullTerminatedString();
-
-    
-    // Skip any padding after name string to align to next vertex index
-    reader.Align (2);
+    uint16_t dimension = decoder.u16();
 
+    // Read name, padded to the next vertex index
+    std::string name = decoder.string();
 
     // Create new vertex map
     VertexMap vmap;
@@ -336,26 +307,55 @@ bool LWO3Layer::processVMapChunk (const LWO3Chunk* chunk)
     vmap.dimension = dimension;
     vmap.name = name;
 
-    // Read vertex/value pairs until end of chunk
-    while (reader.Position() < reader.Length())
+    // VMAP entries are a vertex and its values, VMAD entries add the polygon.
+    // Sized for the smallest entries, with 2 byte indices
+    const size_t valueBytes = size_t (dimension) * 4;
+    const size_t maxEntries = decoder.remaining() / ((discontinuous ? 4 : 2) + valueBytes);
+    vmap.vertexIndices.reserve (maxEntries);
+    vmap.values.resize (maxEntries * dimension);
+    if (discontinuous) vmap.polygonIndices.reserve (maxEntries);
+
+    // Indices are read as they come, the values are copied raw and swapped in bulk
+    size_t count = 0;
+    while (!decoder.atEnd() && count < maxEntries)
     {
-        // Read vertex index
-        uint32_t vertIndex = mace::readVX (reader);
-        vmap.vertexIndices.push_back (vertIndex);
+        uint32_t vertIndex = decoder.vx();
+        uint32_t polyIndex = discontinuous ? decoder.vx() : 0;
+        decoder.raw (vmap.values.data() + count * dimension, valueBytes);
+
+        if (decoder.overrun())
+        {
+            LOG (WARNING) << "Truncated vertex map " << name << " in layer " << index_;
+            break;
+        }
 
-        // Read dimension number of values
-        for (uint16_t i = 0; i < dimension; i++)
+        vmap.vertexIndices.push_back (vertIndex);
+        if (discontinuous)
         {
-            float value = mace::swapFloat (reader.ReadFloat());
-            // flip the V to match LW
-            // lost hours trying to track this
-            if (i == 1)
-               value = 1.0f - value;
-            vmap.values.push_back (value);
+            if (polyIndex >= polygons_.size())
+            {
+                LOG (WARNING) << "Invalid polygon index in VMAD " << name << ": " << polyIndex;
+            }
+            vmap.polygonIndices.push_back (polyIndex);
         }
+        ++count;
     }
 
-    vertexMaps_.push_back (std::move (vmap));
+    vmap.values.resize (count * dimension);
+    LWO3Decoder::swapFloats (vmap.values.data(), vmap.values.data(), vmap.values.size());
+
+    // flip the V to match LW
+    // lost hours trying to track this
+    if (type == sabi::LWO::TXUV && dimension >= 2)
+    {
+        for (size_t i = 1; i < vmap.values.size(); i += dimension)
+            vmap.values[i] = 1.0f - vmap.values[i];
+    }
+
+    if (discontinuous)
+        discontinuousMaps_.push_back (std::move (vmap));
+    else
+        vertexMaps_.push_back (std::move (vmap));
    
     return true;
 }
@@ -384,6 +384,29 @@ const VertexMap* LWO3Layer::getVertexMapByName (const std::string& name) const
     }
     return nullptr;
 }
+std::vector<const VertexMap*> LWO3Layer::getDiscontinuousMaps (uint32_t type) const
+{
+    std::vector<const VertexMap*> maps;
+    for (const auto& map : discontinuousMaps_)
+    {
+        if (map.type == type)
+        {
+            maps.push_back (&map);
+        }
+    }
+    return maps;
+}
+const VertexMap* LWO3Layer::getDiscontinuousMapByName (const std::string& name) const
+{
+    for (const auto& map : discontinuousMaps_)
+    {
+        if (map.name == name)
+        {
+            return &map;
+        }
+    }
+    return nullptr;
+}
 
 bool LWO3Layer::getVertexUV (uint32_t vertexIndex, float& u, float& v) const
 {
@@ -415,21 +438,21 @@ bool LWO3Layer::processSurfaceForms()
         return false;
     }
 
-    auto results = navigator_.findElementsById (root_.get(), sabi::LWO::SURF);
+    const auto& results = chunkIndex_->find (sabi::LWO::SURF);
     if (results.empty())
     {
         LOG (WARNING) << "No SURF forms found";
         return false;
     }
 
-    for (const auto& result : results)
+    for (const LWO3Element* element : results)
     {
-        if (!result.element->isForm())
+        if (!element->isForm())
         {
             continue;
         }
 
-        const auto* surfForm = static_cast<const LWO3Form*> (result.element);
+        const auto* surfForm = static_cast<const LWO3Form*> (element);
 
         std::string surfaceName;
         std::string parentName;
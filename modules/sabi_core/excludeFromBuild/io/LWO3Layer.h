@@ -12,7 +12,7 @@ using Eigen::Quaternionf;
 using Eigen::Vector3f;
 
 using sabi::BSDFInput;
-using sabi::LWO3Navigator;
+using sabi::LWO3ChunkIndexPtr;
 using sabi::LWO3NodeGraph;
 using sabi::LWO3Surface;
 using sabi::NodeConnection;
@@ -24,25 +24,34 @@ struct LWPolygon
     uint16_t flags = 0;            // High 6 bits from vertex count
 };
 
-// Structure to hold vertex map data
+// Structure to hold vertex map data, from a VMAP or a VMAD chunk
 struct VertexMap
 {
-    uint32_t type;                       // TXUV, WGHT, etc
-    uint16_t dimension;                  // Number of values per vertex
-    std::string name;                    // Map name
-    std::vector<uint32_t> vertexIndices; // Indices of mapped vertices
-    std::vector<float> values;           // Dimension * vertexIndices.size() values
+    uint32_t type;                        // TXUV, WGHT, etc
+    uint16_t dimension;                   // Number of values per vertex
+    std::string name;                     // Map name
+    std::vector<uint32_t> vertexIndices;  // Indices of mapped vertices
+    std::vector<uint32_t> polygonIndices; // VMAD only, the polygon each value applies to
+    std::vector<float> values;            // Dimension * vertexIndices.size() values
 };
 
 class LWO3Layer
 {
  public:
     // Constructs a layer from a LAYR chunk in the LWO3 form
+    // Builds a chunk index of its own, use the other constructor when reading several layers
     LWO3Layer (std::shared_ptr<LWO3Form> root, size_t layerIndex);
 
+    // Constructs a layer using an index shared by every layer of the file
+    LWO3Layer (std::shared_ptr<LWO3Form> root, LWO3ChunkIndexPtr chunkIndex, size_t layerIndex);
+
     // Gets the layer's index number
     size_t getIndex() const { return index_; }
 
+    // Gets the root form and the chunk index the layer was read from
+    std::shared_ptr<LWO3Form> getRoot() const { return root_; }
+    LWO3ChunkIndexPtr getChunkIndex() const { return chunkIndex_; }
+
     // Gets the layer's flags (bit 0 = visibility)
     uint16_t getFlags() const { return flags_; }
 
@@ -93,6 +102,13 @@ class LWO3Layer
         return -1;
     }
 
+    // Get the tag index of every polygon for a tag type, nullptr if the layer has no such tags
+    const std::vector<uint16_t>* getPolygonTagIndices (uint32_t tagType) const
+    {
+        auto it = polyTags_.find (tagType);
+        return it != polyTags_.end() ? &it->second : nullptr;
+    }
+
     // Get surface tag name for a polygon
     std::string getPolygonTag (uint32_t polyIndex, uint32_t tagType) const
     {
@@ -110,6 +126,13 @@ class LWO3Layer
     // Gets a vertex map by name
     const VertexMap* getVertexMapByName (const std::string& name) const;
 
+    // Gets all discontinuous (VMAD) vertex maps of a specific type
+    // Their values override the VMAP with the same name at the listed polygon corners
+    std::vector<const VertexMap*> getDiscontinuousMaps (uint32_t type) const;
+
+    // Gets a discontinuous vertex map by name
+    const VertexMap* getDiscontinuousMapByName (const std::string& name) const;
+
     // Gets UV coordinates for a vertex if they exist
     bool getVertexUV (uint32_t vertexIndex, float& u, float& v) const;
 
@@ -125,8 +148,8 @@ class LWO3Layer
     const LWO3Surface* getPolygonSurface (size_t polyIndex) const;
 
  private:
-    LWO3Navigator navigator_;
     std::shared_ptr<LWO3Form> root_;
+    LWO3ChunkIndexPtr chunkIndex_;
 
     size_t index_ = 0;
     uint16_t flags_ = 0;
@@ -149,6 +172,7 @@ class LWO3Layer
     AlignedBox3f bbox_; // Stores min/max corners of bounding box
 
     std::vector<VertexMap> vertexMaps_;
+    std::vector<VertexMap> discontinuousMaps_;
 
     std::vector<std::shared_ptr<LWO3Surface>> surfaces_;
 
@@ -159,9 +183,9 @@ class LWO3Layer
     bool processPolsChunk (const LWO3Chunk* chunk);
     bool processTagsChunk (const LWO3Chunk* chunk);
     bool processPTagChunk (const LWO3Chunk* chunk);
-    bool processVMapChunk (const LWO3Chunk* chunk);
+    bool processVMapChunk (const LWO3Chunk* chunk, bool discontinuous);
     bool processSurfaceForms();
 
-    // Helper to find specific chunk
-    const LWO3Chunk* findChunk (uint32_t chunkId, size_t startOffset = 0);
+    // Finds a chunk of this layer, TAGS is shared by the whole file
+    const LWO3Chunk* findChunk (uint32_t chunkId) const;
 };
\ No newline at end of file
@@ -1,27 +1,29 @@
 //#include "LWO3Navigator.h"
 //#include "LWO3MaterialManager.h"
 
-LWO3MaterialManager::LWO3MaterialManager (std::shared_ptr<LWO3Form> root)
+LWO3MaterialManager::LWO3MaterialManager (std::shared_ptr<LWO3Form> root) :
+    LWO3MaterialManager (root, LWO3ChunkIndex::create (root.get()))
 {
-    if (root)
+}
+
+LWO3MaterialManager::LWO3MaterialManager (std::shared_ptr<LWO3Form> root, LWO3ChunkIndexPtr chunkIndex)
+{
+    if (root && chunkIndex)
     {
-        extractMaterials (root);
+        extractMaterials (root, *chunkIndex);
     }
     else
     {
         LOG (WARNING) << "Null root form provided to LWO3MaterialManager";
     }
 }
-void LWO3MaterialManager::extractMaterials (std::shared_ptr<LWO3Form> root)
+void LWO3MaterialManager::extractMaterials (std::shared_ptr<LWO3Form> root, const LWO3ChunkIndex& chunkIndex)
 {
-    LWO3Navigator nav;
-    auto results = nav.findElementsById (root.get(), LWO::SURF);
-
-    for (const auto& result : results)
+    for (const LWO3Element* element : chunkIndex.find (LWO::SURF))
     {
-        if (!result.element->isForm()) continue;
+        if (!element->isForm()) continue;
 
-        const auto* surfForm = static_cast<const LWO3Form*> (result.element);
+        const auto* surfForm = static_cast<const LWO3Form*> (element);
 
         // Find surface name in ANON chunk
         for (const auto& child : surfForm->getChildren())
@@ -36,6 +38,7 @@ void LWO3MaterialManager::extractMaterials (std::shared_ptr<LWO3Form> root)
                 std::string surfaceName = reader.ReadNullTerminatedString();
                 if (!surfaceName.empty())
                 {
+                    materialsByName_.try_emplace (surfaceName, materials_.size());
                     materials_.push_back (std::make_shared<LWO3Material> (surfaceName, root, surfForm));
                 }
             }
@@ -45,8 +48,6 @@ void LWO3MaterialManager::extractMaterials (std::shared_ptr<LWO3Form> root)
 
 const LWO3Material* LWO3MaterialManager::getMaterial (const std::string& surfaceName) const
 {
-    auto it = std::find_if (materials_.begin(), materials_.end(),
-                            [&] (const auto& mat)
-                            { return mat->getName() == surfaceName; });
-    return it != materials_.end() ? it->get() : nullptr;
+    auto it = materialsByName_.find (surfaceName);
+    return it != materialsByName_.end() ? materials_[it->second].get() : nullptr;
 }
\ No newline at end of file
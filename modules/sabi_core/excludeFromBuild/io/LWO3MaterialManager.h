@@ -8,6 +8,9 @@ class LWO3MaterialManager
  public:
     explicit LWO3MaterialManager (std::shared_ptr<LWO3Form> root);
 
+    // Uses an existing chunk index instead of building one
+    LWO3MaterialManager (std::shared_ptr<LWO3Form> root, LWO3ChunkIndexPtr chunkIndex);
+
     // Get material by surface name
     const LWO3Material* getMaterial (const std::string& surfaceName) const;
 
@@ -19,5 +22,6 @@ class LWO3MaterialManager
 
  private:
     std::vector<std::shared_ptr<LWO3Material>> materials_;
-    void extractMaterials (std::shared_ptr<LWO3Form> root);
+    std::unordered_map<std::string, size_t> materialsByName_; // first material with the name
+    void extractMaterials (std::shared_ptr<LWO3Form> root, const LWO3ChunkIndex& chunkIndex);
 };
\ No newline at end of file
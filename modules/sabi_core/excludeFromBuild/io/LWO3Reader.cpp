@@ -1,10 +1,12 @@
 
 
 // Attempts to read and parse the LWO3 file at the given path
-bool LWO3Reader::read (const fs::path& filepath)
+bool LWO3Reader::read (const fs::path& filepath, BS::thread_pool* pool)
 {
+    TRACE_SCOPE_CAT ("io", "LWO3Reader::read");
     // Clear any existing data
     root_.reset();
+    chunkIndex_.reset();
     layers_.clear();
     errorMessage_.clear();
 
@@ -21,7 +23,7 @@ bool LWO3Reader::read (const fs::path& filepath)
         }
 
         // Parse layers from form structure
-        if (!parseLayers())
+        if (!parseLayers (pool))
         {
             return false;
         }
@@ -59,7 +61,7 @@ std::shared_ptr<LWO3Layer> LWO3Reader::getLayerByName (const std::string& name)
 }
 
 // Creates layer objects from the parsed form structure
-bool LWO3Reader::parseLayers()
+bool LWO3Reader::parseLayers (BS::thread_pool* pool)
 {
     if (!root_)
     {
@@ -67,67 +69,61 @@ bool LWO3Reader::parseLayers()
         return false;
     }
 
-    LWO3Navigator navigator;
-    auto results = navigator.findElementsById (root_.get(), sabi::LWO::LAYR);
+    // one pass over the tree, every layer looks its chunks up here
+    chunkIndex_ = LWO3ChunkIndex::create (root_.get());
 
-    if (results.empty())
+    std::vector<uint16_t> layerNumbers = chunkIndex_->getLayerNumbers();
+    if (layerNumbers.empty())
     {
         errorMessage_ = "No layers found in LWO3 file";
         return false;
     }
 
-    // Create layers in order of their indices
-    size_t maxLayerIndex = 0;
+    // Create layers in order of their indices, each one only reads its own chunks
+    std::sort (layerNumbers.begin(), layerNumbers.end());
+    layers_.resize (layerNumbers.size());
+    std::vector<std::string> failures (layerNumbers.size());
 
-    // First pass to find highest layer index
-    for (const auto& result : results)
+    auto parseRange = [&] (size_t start, size_t end)
     {
-        if (!result.element->isForm())
+        for (size_t i = start; i < end; ++i)
         {
-            const auto* chunk = static_cast<const LWO3Chunk*> (result.element);
-            BinaryReader reader (
-                const_cast<char*> (reinterpret_cast<const char*> (chunk->getData().data())),
-                static_cast<uint32_t> (chunk->getData().size()));
-
-            uint16_t layerIndex = mace::swap16 (reader.ReadUint16());
-            maxLayerIndex = std::max (maxLayerIndex, static_cast<size_t> (layerIndex));
-        }
-    }
-
-    // Resize layers vector to accommodate all indices
-    layers_.resize (maxLayerIndex + 1);
-
-    // Create layers
-    for (const auto& result : results)
-    {
-        if (!result.element->isForm())
-        {
-            const auto* chunk = static_cast<const LWO3Chunk*> (result.element);
-            BinaryReader reader (
-                const_cast<char*> (reinterpret_cast<const char*> (chunk->getData().data())),
-                static_cast<uint32_t> (chunk->getData().size()));
-
-            uint16_t layerIndex = mace::swap16 (reader.ReadUint16());
-
             try
             {
-                auto layer = std::make_shared<LWO3Layer> (root_, layerIndex);
-                layers_[layerIndex] = layer;
+                layers_[i] = std::make_shared<LWO3Layer> (root_, chunkIndex_, layerNumbers[i]);
             }
             catch (const std::exception& e)
             {
-                LOG (WARNING) << "Failed to create layer " << layerIndex << ": " << e.what();
-                return false;
+                failures[i] = e.what();
             }
         }
+    };
+
+    if (layerNumbers.size() == 1 || BS::this_thread::get_pool())
+    {
+        parseRange (0, layerNumbers.size());
+    }
+    else if (pool)
+    {
+        // the pool may be shared, wait for these layers only
+        pool->submit_blocks (size_t (0), layerNumbers.size(), parseRange, layerNumbers.size()).wait();
+    }
+    else
+    {
+        BS::thread_pool localPool (static_cast<BS::concurrency_t> (std::min<size_t> (layerNumbers.size(), std::thread::hardware_concurrency())));
+        localPool.detach_blocks (size_t (0), layerNumbers.size(), parseRange, layerNumbers.size());
+        localPool.wait();
     }
 
-    // Remove any null layers from gaps in indices
-    layers_.erase (
-        std::remove_if (layers_.begin(), layers_.end(),
-                        [] (const auto& layer)
-                        { return layer == nullptr; }),
-        layers_.end());
+    for (size_t i = 0; i < layerNumbers.size(); ++i)
+    {
+        if (!layers_[i])
+        {
+            LOG (WARNING) << "Failed to create layer " << layerNumbers[i] << ": " << failures[i];
+            layers_.clear();
+            return false;
+        }
+    }
 
     return !layers_.empty();
 }
\ No newline at end of file
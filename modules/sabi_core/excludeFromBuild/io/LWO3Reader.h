@@ -9,7 +9,8 @@ class LWO3Reader
 {
  public:
     // Reads and parses an LWO3 file at the given path
-    bool read (const fs::path& filepath);
+    // Layers are parsed concurrently on 'pool', or on a temporary pool when the file has several
+    bool read (const fs::path& filepath, BS::thread_pool* pool = nullptr);
 
     // Returns all layers in the LWO3 file
     const std::vector<std::shared_ptr<LWO3Layer>>& getLayers() const { return layers_; }
@@ -23,14 +24,18 @@ class LWO3Reader
     // Returns true if file was successfully loaded and parsed
     bool isValid() const { return !layers_.empty() && root_ != nullptr; }
 
+    // Returns the chunk index shared by the layers, nullptr until a file is read
+    LWO3ChunkIndexPtr getChunkIndex() const { return chunkIndex_; }
+
     // Returns last error message if any operation failed
     const std::string& getError() const { return errorMessage_; }
 
  private:
     // Creates layer objects from the parsed form structure
-    bool parseLayers();
+    bool parseLayers (BS::thread_pool* pool);
 
     std::shared_ptr<LWO3Form> root_;
+    LWO3ChunkIndexPtr chunkIndex_;
     std::vector<std::shared_ptr<LWO3Layer>> layers_;
     std::string errorMessage_;
 };
\ No newline at end of file
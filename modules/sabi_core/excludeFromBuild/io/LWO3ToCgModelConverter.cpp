@@ -6,6 +6,109 @@ LWO3ToCgModelConverter::LWO3ToCgModelConverter (ConversionFlags flags) :
 }
 
 CgModelPtr LWO3ToCgModelConverter::convert (const LWO3Layer* layer)
+{
+    TRACE_SCOPE_CAT ("io", "LWO3ToCgModelConverter::convert");
+
+    auto model = convertGeometry (layer);
+    if (!model)
+    {
+        return nullptr;
+    }
+
+    // Convert materials (which includes images and textures)
+    if ((flags_ & ConversionFlags::Materials) == ConversionFlags::Materials)
+    {
+        LWO3MaterialManager materials (layer->getRoot(), layer->getChunkIndex());
+
+        if (!convertMaterials (materials, model))
+        {
+            LOG (WARNING) << "Failed to convert materials: " << errorMsg_;
+            return nullptr;
+        }
+    }
+
+    return model;
+}
+
+CgModelPtr LWO3ToCgModelConverter::convert (const std::vector<std::shared_ptr<LWO3Layer>>& layers, BS::thread_pool* pool)
+{
+    TRACE_SCOPE_CAT ("io", "LWO3ToCgModelConverter::convertLayers");
+    if (layers.empty())
+    {
+        errorMsg_ = "No layers provided";
+        return nullptr;
+    }
+
+    if (layers.size() == 1)
+    {
+        return convert (layers.front().get());
+    }
+
+    // every layer gets a converter of its own, they share nothing while running
+    std::vector<CgModelPtr> parts (layers.size());
+    std::vector<std::string> errors (layers.size());
+
+    auto convertRange = [&] (size_t start, size_t end)
+    {
+        for (size_t i = start; i < end; ++i)
+        {
+            LWO3ToCgModelConverter worker (flags_);
+            worker.setContentDirectory (contentDir_);
+            parts[i] = worker.convertGeometry (layers[i].get());
+            errors[i] = worker.getError();
+        }
+    };
+
+    // already on a pool thread, e.g. a batch job, waiting on a pool from here could deadlock
+    if (BS::this_thread::get_pool())
+    {
+        convertRange (0, layers.size());
+    }
+    else if (pool)
+    {
+        // the pool may be shared, wait for these layers only
+        pool->submit_blocks (size_t (0), layers.size(), convertRange, layers.size()).wait();
+    }
+    else
+    {
+        BS::thread_pool localPool (static_cast<BS::concurrency_t> (std::min<size_t> (layers.size(), std::thread::hardware_concurrency())));
+        localPool.detach_blocks (size_t (0), layers.size(), convertRange, layers.size());
+        localPool.wait();
+    }
+
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        if (!parts[i])
+        {
+            LOG (WARNING) << "Skipping layer " << (layers[i] ? layers[i]->getIndex() : i) << ": " << errors[i];
+        }
+    }
+
+    auto model = mergeModels (parts);
+    if (!model)
+    {
+        errorMsg_ = "No layer could be converted";
+        return nullptr;
+    }
+
+    // the surfaces of every layer come from the same SURF forms
+    if ((flags_ & ConversionFlags::Materials) == ConversionFlags::Materials)
+    {
+        processedImages_.clear();
+        imageTextureMap_.clear();
+
+        LWO3MaterialManager materials (layers.front()->getRoot(), layers.front()->getChunkIndex());
+        if (!convertMaterials (materials, model))
+        {
+            LOG (WARNING) << "Failed to convert materials: " << errorMsg_;
+            return nullptr;
+        }
+    }
+
+    return model;
+}
+
+CgModelPtr LWO3ToCgModelConverter::convertGeometry (const LWO3Layer* layer)
 {
     if (!validateLayer (layer))
     {
@@ -17,10 +120,9 @@ CgModelPtr LWO3ToCgModelConverter::convert (const LWO3Layer* layer)
 
     // Clear tracking state at start of conversion
     processedImages_.clear();
-    processedSurfaces_.clear();
     imageTextureMap_.clear();
 
-    // Convert geometry
+    // Convert geometry, UVs go before triangles since seams add vertices
     if ((flags_ & ConversionFlags::StandardGeometry) != ConversionFlags::None)
     {
         if (!convertVertices (layer, model))
@@ -29,38 +131,97 @@ CgModelPtr LWO3ToCgModelConverter::convert (const LWO3Layer* layer)
             return nullptr;
         }
 
-        if (!convertTriangles (layer, model))
+        if ((flags_ & ConversionFlags::UVs) == ConversionFlags::UVs && !convertUVs (layer, model))
         {
-            LOG (WARNING) << "Failed to convert triangles: " << errorMsg_;
+            LOG (WARNING) << "Failed to convert UVs: " << errorMsg_;
             return nullptr;
         }
 
-        if (!convertUVs (layer, model))
+        if (!convertTriangles (layer, model))
         {
-            LOG (WARNING) << "Failed to convert UVs: " << errorMsg_;
+            LOG (WARNING) << "Failed to convert triangles: " << errorMsg_;
             return nullptr;
         }
     }
 
-    // Convert materials (which includes images and textures)
-    if ((flags_ & ConversionFlags::Materials) == ConversionFlags::Materials)
+    return model;
+}
+
+CgModelPtr LWO3ToCgModelConverter::mergeModels (const std::vector<CgModelPtr>& parts) const
+{
+    // sizes first so every matrix is allocated once
+    Eigen::Index vertexCount = 0;
+    bool hasUV0 = false;
+    bool hasUV1 = false;
+
+    std::unordered_map<std::string, size_t> surfaceByName;
+    std::vector<const CgModelSurface*> firstSurface;
+    std::vector<Eigen::Index> surfaceColumns;
+
+    for (const auto& part : parts)
     {
-        // Get initial image count for allocation
-        auto imageNodes = layer->getSurfaces()[0]->getNodeGraph()->getImageNodes();
-        model->images.reserve (imageNodes.size());
-        model->textures.reserve (imageNodes.size());
+        if (!part) continue;
+
+        vertexCount += part->V.cols();
+        hasUV0 |= part->UV0.cols() > 0;
+        hasUV1 |= part->UV1.cols() > 0;
 
-        if (!convertImages (layer, model))
+        for (const auto& surface : part->S)
         {
-            LOG (WARNING) << "Failed to convert images: " << errorMsg_;
-            return nullptr;
+            auto [it, inserted] = surfaceByName.try_emplace (surface.name, firstSurface.size());
+            if (inserted)
+            {
+                firstSurface.push_back (&surface);
+                surfaceColumns.push_back (0);
+            }
+            surfaceColumns[it->second] += surface.F.cols();
         }
+    }
+
+    if (firstSurface.empty())
+    {
+        return nullptr;
+    }
 
-        if (!convertMaterials (layer, model))
+    auto model = CgModel::create();
+    model->contentDirectory = contentDir_;
+    model->V.resize (3, vertexCount);
+    if (hasUV0) model->UV0 = MatrixXf::Zero (2, vertexCount);
+    if (hasUV1) model->UV1 = MatrixXf::Zero (2, vertexCount);
+
+    // surfaces in order of first appearance, named like the first layer that has them
+    model->S.resize (firstSurface.size());
+    for (size_t i = 0; i < firstSurface.size(); ++i)
+    {
+        model->S[i].name = firstSurface[i]->name;
+        model->S[i].material = firstSurface[i]->material;
+        model->S[i].cgMaterial = firstSurface[i]->cgMaterial;
+        model->S[i].F.resize (3, surfaceColumns[i]);
+    }
+
+    std::vector<Eigen::Index> surfaceFill (firstSurface.size(), 0);
+    Eigen::Index base = 0;
+    model->triCount = 0;
+
+    for (const auto& part : parts)
+    {
+        if (!part) continue;
+
+        const Eigen::Index count = part->V.cols();
+        model->V.middleCols (base, count) = part->V;
+        if (part->UV0.cols() == count && hasUV0) model->UV0.middleCols (base, count) = part->UV0;
+        if (part->UV1.cols() == count && hasUV1) model->UV1.middleCols (base, count) = part->UV1;
+
+        for (const auto& surface : part->S)
         {
-            LOG (WARNING) << "Failed to convert materials: " << errorMsg_;
-            return nullptr;
+            const size_t slot = surfaceByName[surface.name];
+            const Eigen::Index columns = surface.F.cols();
+            model->S[slot].F.middleCols (surfaceFill[slot], columns) = surface.F.array() + static_cast<uint32_t> (base);
+            surfaceFill[slot] += columns;
         }
+
+        model->triCount += part->triCount;
+        base += count;
     }
 
     return model;
@@ -94,13 +255,17 @@ bool LWO3ToCgModelConverter::validateLayer (const LWO3Layer* layer)
         return false;
     }
 
-    // Verify all polygons are triangles
+    // Every corner must reference a point
+    const size_t pointCount = layer->getPoints().size();
     for (const auto& poly : layer->getPolygons())
     {
-        if (poly.indices.size() != 3)
+        for (uint32_t index : poly.indices)
         {
-            errorMsg_ = "Non-triangle polygon found";
-            return false;
+            if (index >= pointCount)
+            {
+                errorMsg_ = "Polygon references a missing point";
+                return false;
+            }
         }
     }
 
@@ -110,6 +275,23 @@ bool LWO3ToCgModelConverter::validateLayer (const LWO3Layer* layer)
 bool LWO3ToCgModelConverter::convertVertices (const LWO3Layer* layer, CgModelPtr model)
 {
     const auto& points = layer->getPoints();
+    const auto& polygons = layer->getPolygons();
+
+    points_ = points;
+
+    // Flatten the polygon corners so UV seams can repoint them
+    cornerStart_.resize (polygons.size() + 1);
+    cornerStart_[0] = 0;
+    for (size_t i = 0; i < polygons.size(); ++i)
+    {
+        cornerStart_[i + 1] = cornerStart_[i] + static_cast<uint32_t> (polygons[i].indices.size());
+    }
+
+    corners_.resize (cornerStart_.back());
+    for (size_t i = 0; i < polygons.size(); ++i)
+    {
+        std::copy (polygons[i].indices.begin(), polygons[i].indices.end(), corners_.begin() + cornerStart_[i]);
+    }
 
     // Resize vertex matrix
     model->V.resize (3, points.size());
@@ -126,294 +308,489 @@ bool LWO3ToCgModelConverter::convertVertices (const LWO3Layer* layer, CgModelPtr
 bool LWO3ToCgModelConverter::convertTriangles (const LWO3Layer* layer, CgModelPtr model)
 {
     const auto& polygons = layer->getPolygons();
+    const auto& tags = layer->getTags();
+    const std::vector<uint16_t>* surfaceTags = layer->getPolygonTagIndices (sabi::LWO::SURF);
 
-    // Create a single surface for all triangles initially
-    CgModelSurface surface;
-    surface.F.resize (3, polygons.size());
+    // One bucket per tag, polygons without a valid SURF tag go to the first one
+    const size_t bucketCount = std::max<size_t> (tags.size(), 1);
+    auto bucketOf = [&] (size_t i) -> size_t
+    {
+        if (!surfaceTags || i >= surfaceTags->size()) return 0;
+        const size_t tag = (*surfaceTags)[i];
+        return tag < bucketCount ? tag : 0;
+    };
 
-    // Copy triangle indices
+    // Counting sort of the polygons by bucket, linear in the polygon count
+    std::vector<uint32_t> bucketStart (bucketCount + 1, 0);
     for (size_t i = 0; i < polygons.size(); ++i)
     {
-        const auto& poly = polygons[i];
-        surface.F.col (i) = Vector3u (
-            poly.indices[0],
-            poly.indices[1],
-            poly.indices[2]);
+        ++bucketStart[bucketOf (i) + 1];
     }
-
-    // Add surface to model
-    model->S.push_back (surface);
-    model->triCount = polygons.size();
-
-    return true;
-}
-
-bool LWO3ToCgModelConverter::convertUVs (const LWO3Layer* layer, CgModelPtr model)
-{
-
-    auto uvMaps = layer->getVertexMaps (sabi::LWO::TXUV);
-    if (uvMaps.empty())
+    for (size_t b = 0; b < bucketCount; ++b)
     {
-        errorMsg_ = "No UV maps found";
-        return false;
+        bucketStart[b + 1] += bucketStart[b];
     }
 
-    const VertexMap* primaryUVMap = uvMaps[0];
-    if (!primaryUVMap || primaryUVMap->dimension != 2)
+    std::vector<uint32_t> sorted (polygons.size());
+    std::vector<uint32_t> cursor (bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t i = 0; i < polygons.size(); ++i)
     {
-        errorMsg_ = "Invalid UV map dimension";
-        return false;
+        sorted[cursor[bucketOf (i)]++] = static_cast<uint32_t> (i);
     }
 
-    // Initialize UV matrix
-    model->UV0.resize (2, model->V.cols());
-    model->UV0.setZero();
+    // one pool shared by every surface of a large mesh, unless this layer already runs on a pool
+    std::unique_ptr<BS::thread_pool> pool;
+    if (polygons.size() >= PolygonTriangulator::ParallelThreshold && !BS::this_thread::get_pool())
+    {
+        pool = std::make_unique<BS::thread_pool>();
+    }
 
-    // Copy UV data - values are already properly parsed
-    for (size_t i = 0; i < primaryUVMap->vertexIndices.size(); ++i)
+    model->triCount = 0;
+    for (size_t b = 0; b < bucketCount; ++b)
     {
-        uint32_t vertIndex = primaryUVMap->vertexIndices[i];
-        if (vertIndex >= static_cast<uint32_t> (model->V.cols()))
+        const uint32_t* members = sorted.data() + bucketStart[b];
+        const size_t memberCount = bucketStart[b + 1] - bucketStart[b];
+        if (memberCount == 0)
         {
-            LOG (WARNING) << "UV vertex index out of bounds: " << vertIndex;
             continue;
         }
 
-        model->UV0.col (vertIndex) = Eigen::Vector2f (
-            primaryUVMap->values[i * 2],    // U coordinate
-            primaryUVMap->values[i * 2 + 1] // V coordinate
-        );
-    }
+        CgModelSurface surface;
 
-    // Handle UV1 similarly if present
-    if (uvMaps.size() > 1)
-    {
-        const VertexMap* secondaryUVMap = uvMaps[1];
-        if (secondaryUVMap && secondaryUVMap->dimension == 2)
+        // quads and n-gons are split, in parallel for large surfaces
+        surface.F = PolygonTriangulator::triangulate (points_, memberCount, [&] (size_t i)
+                                                      {
+                                                          const uint32_t p = members[i];
+                                                          return std::span<const uint32_t> (corners_.data() + cornerStart_[p],
+                                                                                            cornerStart_[p + 1] - cornerStart_[p]); },
+                                                      pool.get());
+        if (surface.F.cols() == 0)
         {
-            model->UV1.resize (2, model->V.cols());
-            model->UV1.setZero();
+            continue;
+        }
 
-            for (size_t i = 0; i < secondaryUVMap->vertexIndices.size(); ++i)
-            {
-                uint32_t vertIndex = secondaryUVMap->vertexIndices[i];
-                if (vertIndex >= static_cast<uint32_t> (model->V.cols()))
-                {
-                    continue;
-                }
+        surface.name = b < tags.size() ? tags[b] : layer->getName();
+        surface.material.name = surface.name;
+        surface.cgMaterial.name = surface.name;
 
-                model->UV1.col (vertIndex) = Eigen::Vector2f (
-                    secondaryUVMap->values[i * 2],
-                    secondaryUVMap->values[i * 2 + 1]);
-            }
-        }
+        model->triCount += surface.F.cols();
+        model->S.push_back (std::move (surface));
+    }
+
+    if (model->S.empty())
+    {
+        errorMsg_ = "Layer contains no polygons with 3 or more corners";
+        return false;
     }
 
     return true;
 }
 
-// Pre-allocate vectors to avoid reallocation:
-bool LWO3ToCgModelConverter::convertImages (const LWO3Layer* layer, CgModelPtr model)
+namespace
 {
-    auto imageNodes = layer->getSurfaces()[0]->getNodeGraph()->getImageNodes();
-    model->images.reserve (imageNodes.size());
-    model->textures.reserve (imageNodes.size());
-    processedImages_.reserve (imageNodes.size());
-
-    // Process each surface's node graph
-    for (const auto& surface : layer->getSurfaces())
+    // One UV set, per vertex values from its VMAP and per corner overrides from its VMAD
+    struct UVSource
     {
-        if (!surface || !surface->getNodeGraph())
-        {
-            continue;
-        }
+        static constexpr uint32_t NoPolygon = std::numeric_limits<uint32_t>::max();
 
-        const auto* nodeGraph = surface->getNodeGraph();
-        auto connectedImages = nodeGraph->getConnectedImageNodes();
+        std::vector<Eigen::Vector2f> perVertex;
+        std::unordered_map<uint64_t, Eigen::Vector2f> perCorner; // polygon << 32 | vertex
 
-        for (const auto& conn : connectedImages)
+        UVSource (const VertexMap* vmap, const VertexMap* vmad, size_t pointCount) :
+            perVertex (pointCount, Eigen::Vector2f::Zero())
         {
-            const auto& imageNode = conn.imageNode;
-            if (imageNode.imagePath.empty() || !imageNode.enabled)
+            if (vmap)
             {
-                continue;
-            }
-
-            // Add image if not already processed
-            if (processedImages_.find (imageNode.imagePath) == processedImages_.end())
-            {
-                Image image;
-                image.uri = imageNode.imagePath;
-
-                if (!contentDir_.empty())
+                for (size_t i = 0; i < vmap->vertexIndices.size(); ++i)
                 {
-                    fs::path fullPath = contentDir_ / image.uri;
-                    if (fs::exists (fullPath))
+                    const uint32_t v = vmap->vertexIndices[i];
+                    if (v >= pointCount)
                     {
-                        image.uri = fullPath.string();
+                        LOG (WARNING) << "UV vertex index out of bounds: " << v;
+                        continue;
                     }
+                    perVertex[v] = Eigen::Vector2f (vmap->values[i * 2], vmap->values[i * 2 + 1]);
                 }
+            }
 
-                model->images.push_back (image);
-                size_t imageIndex = model->images.size() - 1;
-                processedImages_[imageNode.imagePath] = imageIndex;
+            if (vmad)
+            {
+                perCorner.reserve (vmad->vertexIndices.size());
+                for (size_t i = 0; i < vmad->vertexIndices.size(); ++i)
+                {
+                    perCorner[key (vmad->polygonIndices[i], vmad->vertexIndices[i])] =
+                        Eigen::Vector2f (vmad->values[i * 2], vmad->values[i * 2 + 1]);
+                }
+            }
+        }
 
-                // Create corresponding texture
-                Texture texture;
-                texture.name = imageNode.nodeName;
-                texture.source = static_cast<int> (imageIndex);
-                model->textures.push_back (texture);
+        static uint64_t key (uint32_t polygon, uint32_t vertex)
+        {
+            return (uint64_t (polygon) << 32) | vertex;
+        }
 
-                // Store mapping between image path and texture index
-                imageTextureMap_[imageNode.imagePath] = model->textures.size() - 1;
+        Eigen::Vector2f lookup (uint32_t polygon, uint32_t vertex) const
+        {
+            if (!perCorner.empty() && polygon != NoPolygon)
+            {
+                auto it = perCorner.find (key (polygon, vertex));
+                if (it != perCorner.end()) return it->second;
             }
+            return perVertex[vertex];
         }
-    }
+    };
 
-    return true;
-}
-bool LWO3ToCgModelConverter::convertMaterials (const LWO3Layer* layer, CgModelPtr model)
-{
-    if (!model->S.empty())
-    { // Model must have a surface
-        for (const auto& surface : layer->getSurfaces())
+    // A source vertex with a particular set of UVs, compared bit for bit
+    struct SplitKey
+    {
+        uint32_t vertex;
+        std::array<uint32_t, 4> uv;
+
+        static std::array<uint32_t, 4> bits (const Eigen::Vector4f& uv)
+        {
+            return {std::bit_cast<uint32_t> (uv.x()), std::bit_cast<uint32_t> (uv.y()),
+                    std::bit_cast<uint32_t> (uv.z()), std::bit_cast<uint32_t> (uv.w())};
+        }
+
+        bool operator== (const SplitKey& other) const = default;
+    };
+
+    struct SplitKeyHash
+    {
+        size_t operator() (const SplitKey& key) const
         {
-            if (!surface || !surface->getNodeGraph())
+            uint64_t h = key.vertex;
+            for (uint32_t b : key.uv)
             {
-                continue;
+                h = (h ^ b) * 0x100000001b3ull;
+                h ^= h >> 29;
             }
+            return static_cast<size_t> (h);
+        }
+    };
+} // namespace
 
-            if (processedSurfaces_.find (surface->getName()) != processedSurfaces_.end())
+bool LWO3ToCgModelConverter::convertUVs (const LWO3Layer* layer, CgModelPtr model)
+{
+    const size_t pointCount = points_.size();
+
+    // UV sets by name in file order, a map can be VMAD only
+    std::vector<std::string> names;
+    auto addNames = [&] (const std::vector<const VertexMap*>& maps)
+    {
+        for (const VertexMap* map : maps)
+        {
+            if (map->dimension != 2)
             {
+                LOG (WARNING) << "Skipping UV map " << map->name << " with dimension " << map->dimension;
                 continue;
             }
-            processedSurfaces_.insert (surface->getName());
-
-            auto bsdfNodes = surface->getNodeGraph()->getPrincipledBSDFNodes();
-            if (bsdfNodes.empty())
+            if (std::find (names.begin(), names.end(), map->name) == names.end())
             {
-                LOG (WARNING) << "No BSDF nodes found for surface: " << surface->getName();
-                continue; // Skip this surface but continue processing others
+                names.push_back (map->name);
             }
+        }
+    };
+    addNames (layer->getVertexMaps (sabi::LWO::TXUV));
+    addNames (layer->getDiscontinuousMaps (sabi::LWO::TXUV));
 
-            Material material;
-            material.name = surface->getName();
-            const auto& bsdf = bsdfNodes[0];
-            material.pbrMetallicRoughness.baseColorFactor = {
-                bsdf.baseColor (0), bsdf.baseColor (1), bsdf.baseColor (2), 1.0f};
-            material.pbrMetallicRoughness.metallicFactor = bsdf.metallic;
-            material.pbrMetallicRoughness.roughnessFactor = bsdf.roughness;
+    if (names.empty())
+    {
+        LOG (DBUG) << "No UV maps found in layer " << layer->getName();
+        model->UV0 = MatrixXf::Zero (2, model->V.cols());
+        return true;
+    }
 
-            auto imageNodes = surface->getNodeGraph()->getConnectedImageNodes();
+    if (names.size() > 2)
+    {
+        LOG (DBUG) << "Using the first 2 of " << names.size() << " UV maps";
+        names.resize (2);
+    }
 
-            for (const auto& conn : imageNodes)
+    std::vector<UVSource> sources;
+    for (const auto& name : names)
+    {
+        sources.emplace_back (layer->getVertexMapByName (name), layer->getDiscontinuousMapByName (name), pointCount);
+    }
+
+    // UV0 in xy and UV1 in zw
+    auto cornerUV = [&] (uint32_t polygon, uint32_t vertex)
+    {
+        Eigen::Vector4f uv = Eigen::Vector4f::Zero();
+        uv.head<2>() = sources[0].lookup (polygon, vertex);
+        if (sources.size() > 1) uv.tail<2>() = sources[1].lookup (polygon, vertex);
+        return uv;
+    };
+
+    std::vector<Eigen::Vector4f> vertexUV (pointCount);
+    for (uint32_t v = 0; v < pointCount; ++v)
+    {
+        vertexUV[v] = cornerUV (UVSource::NoPolygon, v);
+    }
+
+    // Without VMADs every corner of a vertex shares its UVs
+    const bool hasSeams = std::any_of (sources.begin(), sources.end(), [] (const UVSource& source)
+                                       { return !source.perCorner.empty(); });
+    if (hasSeams)
+    {
+        // A vertex keeps the UVs of the first corner that uses it, other corners
+        // reuse it or the split vertex that already has their UVs
+        std::vector<uint8_t> claimed (pointCount, 0);
+        std::unordered_map<SplitKey, uint32_t, SplitKeyHash> splits;
+
+        for (uint32_t p = 0; p + 1 < cornerStart_.size(); ++p)
+        {
+            for (uint32_t c = cornerStart_[p]; c < cornerStart_[p + 1]; ++c)
             {
-                const auto& imageNode = conn.imageNode;
-                if (imageNode.imagePath.empty() || !imageNode.enabled)
+                const uint32_t v = corners_[c];
+                const Eigen::Vector4f uv = cornerUV (p, v);
+
+                if (!claimed[v])
                 {
+                    claimed[v] = 1;
+                    vertexUV[v] = uv;
                     continue;
                 }
 
-                // Use existing texture index from convertImages
-                auto it = imageTextureMap_.find (imageNode.imagePath);
-                if (it == imageTextureMap_.end())
+                const SplitKey key {v, SplitKey::bits (uv)};
+                if (key.uv == SplitKey::bits (vertexUV[v]))
                 {
-                    LOG (WARNING) << "Missing texture for image: " << imageNode.imagePath;
                     continue;
                 }
 
-                // Create texture info using existing texture index
-                TextureInfo texInfo;
-                texInfo.textureIndex = static_cast<int> (it->second);
-                texInfo.texCoord = 0;
-
-                if (conn.bsdfInputSocket == "Color")
+                auto [it, inserted] = splits.try_emplace (key, static_cast<uint32_t> (points_.size()));
+                if (inserted)
                 {
-                    material.pbrMetallicRoughness.baseColorTexture = texInfo;
+                    points_.push_back (points_[v]);
+                    vertexUV.push_back (uv);
                 }
-                // Handle other texture types...
+                corners_[c] = it->second;
             }
-            model->S[0].material = material;
         }
-        return true;
+
+        if (!splits.empty())
+        {
+            LOG (DBUG) << "Split " << splits.size() << " vertices at UV seams";
+
+            const Eigen::Index first = model->V.cols();
+            model->V.conservativeResize (3, points_.size());
+            for (size_t i = first; i < points_.size(); ++i)
+            {
+                model->V.col (i) = points_[i];
+            }
+        }
+    }
+
+    model->UV0.resize (2, vertexUV.size());
+    for (size_t i = 0; i < vertexUV.size(); ++i)
+    {
+        model->UV0.col (i) = vertexUV[i].head<2>();
+    }
+
+    if (sources.size() > 1)
+    {
+        model->UV1.resize (2, vertexUV.size());
+        for (size_t i = 0; i < vertexUV.size(); ++i)
+        {
+            model->UV1.col (i) = vertexUV[i].tail<2>();
+        }
     }
 
-    errorMsg_ = "No surfaces present in model";
-    return false;
+    return true;
 }
 
-#if 0
-bool LWO3ToCgModelConverter::convertMaterials (const LWO3Layer* layer, CgModelPtr model)
+namespace
 {
-    if ((flags_ & ConversionFlags::Materials) != ConversionFlags::Materials)
+    // Principled BSDF inputs that take a texture, and where it goes in the material
+    struct TextureSlot
     {
-        return true;
+        BSDFInput input;
+        std::optional<CgTextureInfo>* (*target) (CgMaterial&);
+    };
+
+    const TextureSlot textureSlots[] = {
+        {BSDFInput::Color, [] (CgMaterial& m) { return &m.core.baseColorTexture; }},
+        {BSDFInput::Roughness, [] (CgMaterial& m) { return &m.core.roughnessTexture; }},
+        {BSDFInput::Metallic, [] (CgMaterial& m) { return &m.metallic.metallicTexture; }},
+        {BSDFInput::Normal, [] (CgMaterial& m) { return &m.normalTexture; }},
+        {BSDFInput::Transparency, [] (CgMaterial& m) { return &m.transparency.transparencyTexture; }},
+        {BSDFInput::Translucency, [] (CgMaterial& m) { return &m.translucency.translucencyTexture; }},
+        {BSDFInput::Luminous, [] (CgMaterial& m) { return &m.emission.luminousTexture; }},
+        {BSDFInput::Clearcoat, [] (CgMaterial& m) { return &m.clearcoat.clearcoatTexture; }},
+    };
+
+    void applyBSDF (const PrincipledBSDFInfo& bsdf, CgMaterial& material)
+    {
+        material.core.baseColor = bsdf.baseColor;
+        material.core.roughness = bsdf.roughness;
+        material.core.specular = bsdf.specular;
+        material.core.specularTint = bsdf.specularTint;
+
+        material.metallic.metallic = bsdf.metallic;
+        material.metallic.anisotropic = bsdf.anisotropic;
+        material.metallic.anisotropicRotation = bsdf.anisotropicRotation;
+
+        material.sheen.sheenColorFactor = Eigen::Vector3f::Constant (bsdf.sheen);
+
+        material.translucency.translucency = bsdf.translucency;
+        material.translucency.flatness = bsdf.flatness;
+
+        material.subsurface.subsurface = bsdf.subsurface;
+        material.subsurface.subsurfaceColor = bsdf.subsurfaceColor;
+        material.subsurface.subsurfaceDistance = bsdf.subsurfaceDistance;
+        material.subsurface.asymmetry = bsdf.asymmetry;
+
+        material.emission.luminous = bsdf.luminous;
+        material.emission.luminousColor = bsdf.luminousColor;
+
+        material.clearcoat.clearcoat = bsdf.clearcoat;
+        material.clearcoat.clearcoatGloss = bsdf.clearcoatGloss;
+
+        material.transparency.thin = bsdf.thinWalled;
+        material.transparency.transparency = bsdf.transparency;
+        material.transparency.transmittance = bsdf.transmittance;
+        material.transparency.transmittanceDistance = bsdf.transmittanceDistance;
+        material.transparency.refractionIndex = bsdf.ior;
     }
 
-    for (const auto& surface : layer->getSurfaces())
+    // the legacy Standard material has no metallic input and uses glossiness
+    void applyStandard (const StandardNodeInfo& standard, CgMaterial& material)
     {
-        if (!surface || !surface->getNodeGraph())
-        {
-            continue;
-        }
+        material.core.baseColor = standard.color * standard.diffuse;
+        material.core.roughness = 1.0f - standard.glossiness;
+        material.core.specular = standard.specular;
+        material.metallic.metallic = standard.reflection;
 
-        if (processedSurfaces_.find (surface->getName()) != processedSurfaces_.end())
-        {
-            continue;
-        }
-        processedSurfaces_.insert (surface->getName());
+        material.translucency.translucency = standard.translucency;
+
+        material.emission.luminous = standard.luminosity;
+        material.emission.luminousColor = standard.color;
+
+        material.transparency.transparency = standard.transparency;
+        material.transparency.refractionIndex = standard.refractionIndex;
+
+        material.bumpHeight = standard.bumpHeight;
+    }
+} // namespace
+
+size_t LWO3ToCgModelConverter::addImage (const ImageNodeInfo& imageNode, CgModelPtr model)
+{
+    auto it = imageTextureMap_.find (imageNode.imagePath);
+    if (it != imageTextureMap_.end())
+    {
+        return it->second;
+    }
 
-        auto bsdfNodes = surface->getNodeGraph()->getPrincipledBSDFNodes();
-        if (bsdfNodes.empty())
+    std::string uri = imageNode.imagePath;
+    if (!contentDir_.empty())
+    {
+        fs::path fullPath = contentDir_ / uri;
+        if (fs::exists (fullPath))
         {
-            continue;
+            uri = fullPath.string();
         }
+    }
 
-        Material material;
-        material.name = surface->getName();
-
-        const auto& bsdf = bsdfNodes[0];
-        material.pbrMetallicRoughness.baseColorFactor = {
-            bsdf.baseColor (0), bsdf.baseColor (1), bsdf.baseColor (2), 1.0f};
-        material.pbrMetallicRoughness.metallicFactor = bsdf.metallic;
-        material.pbrMetallicRoughness.roughnessFactor = bsdf.roughness;
+    // legacy and Cg lists are kept in step so an index means the same in both
+    const size_t imageIndex = model->images.size();
+    processedImages_[imageNode.imagePath] = imageIndex;
+
+    // the file is only read when something asks for the pixels
+    const CgImageSourcePtr source = CgImageSource::fromFile (uri);
+
+    Image image;
+    image.uri = uri;
+    image.source = source;
+    model->images.push_back (image);
+
+    CgImage cgImage;
+    cgImage.uri = uri;
+    cgImage.index = imageIndex;
+    cgImage.name = imageNode.nodeName;
+    cgImage.source = source;
+    model->cgImages.push_back (std::move (cgImage));
+
+    Texture texture;
+    texture.name = imageNode.nodeName;
+    texture.source = static_cast<int> (imageIndex);
+    model->textures.push_back (texture);
+
+    CgTexture cgTexture;
+    cgTexture.imageIndex = imageIndex;
+    cgTexture.name = imageNode.nodeName;
+    model->cgTextures.push_back (std::move (cgTexture));
+
+    const size_t textureIndex = model->textures.size() - 1;
+    imageTextureMap_[imageNode.imagePath] = textureIndex;
+    return textureIndex;
+}
 
-        auto imageNodes = surface->getNodeGraph()->getConnectedImageNodes();
+bool LWO3ToCgModelConverter::convertMaterials (const LWO3MaterialManager& materials, CgModelPtr model)
+{
+    if (model->S.empty())
+    {
+        errorMsg_ = "No surfaces present in model";
+        return false;
+    }
 
-        for (const auto& conn : imageNodes)
+    for (auto& surface : model->S)
+    {
+        const LWO3Material* lwMaterial = materials.getMaterial (surface.name);
+        if (!lwMaterial)
         {
-            const auto& imageNode = conn.imageNode;
-            if (imageNode.imagePath.empty() || !imageNode.enabled)
-            {
-                continue;
-            }
+            LOG (WARNING) << "No SURF form found for surface: " << surface.name;
+            continue; // keeps the default material
+        }
 
-            // Use existing texture index from convertImages
-            auto it = imageTextureMap_.find (imageNode.imagePath);
-            if (it == imageTextureMap_.end())
-            {
-                LOG (WARNING) << "Missing texture for image: " << imageNode.imagePath;
-                continue;
-            }
+        CgMaterial& material = surface.cgMaterial;
+        material.name = surface.name;
+        surface.maxSmoothingAngle = lwMaterial->getMaxSmoothingAngle();
 
-            // Create texture info using existing texture index
-            TextureInfo texInfo;
-            texInfo.textureIndex = static_cast<int> (it->second);
-            texInfo.texCoord = 0;
+        if (lwMaterial->usesBSDFNodes())
+        {
+            applyBSDF (lwMaterial->getBSDFNodes().front(), material);
 
-            if (conn.bsdfInputSocket == "Color")
+            // images are added the first time a surface samples them
+            for (const auto& slot : textureSlots)
             {
-                material.pbrMetallicRoughness.baseColorTexture = texInfo;
+                auto imageNode = lwMaterial->getBSDFImageNode (slot.input);
+                if (!imageNode || !imageNode->enabled || imageNode->imagePath.empty())
+                {
+                    continue;
+                }
+
+                CgTextureInfo texInfo;
+                texInfo.textureIndex = addImage (*imageNode, model);
+                texInfo.texCoordIndex = 0;
+                *slot.target (material) = texInfo;
             }
-            // Handle other texture types...
         }
-        if (!model->S.empty() && !bsdfNodes.empty())
+        else if (lwMaterial->usesStandardNodes())
         {
-            model->S[0].material = material;
+            applyStandard (lwMaterial->getStandardNodes().front(), material);
+        }
+        else
+        {
+            LOG (WARNING) << "No BSDF or Standard nodes found for surface: " << surface.name;
+        }
+
+        // the legacy glTF style material mirrors the core properties
+        Material legacy;
+        legacy.name = surface.name;
+        legacy.pbrMetallicRoughness.baseColorFactor = {
+            material.core.baseColor (0), material.core.baseColor (1), material.core.baseColor (2), 1.0f};
+        legacy.pbrMetallicRoughness.metallicFactor = material.metallic.metallic;
+        legacy.pbrMetallicRoughness.roughnessFactor = material.core.roughness;
+
+        if (material.core.baseColorTexture)
+        {
+            TextureInfo texInfo;
+            texInfo.textureIndex = static_cast<int> (material.core.baseColorTexture->textureIndex);
+            texInfo.texCoord = 0;
+            legacy.pbrMetallicRoughness.baseColorTexture = texInfo;
         }
-       
+        surface.material = legacy;
     }
 
     return true;
 }
-#endif
\ No newline at end of file
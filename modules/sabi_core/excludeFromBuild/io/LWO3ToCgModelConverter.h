@@ -3,6 +3,14 @@
 // Converts LightWave Object (LWO3) layers to CgModel format with support for
 // geometry, materials, textures and other attributes. Implements a flexible
 // flag-based system for controlling which features are converted.
+//
+// Polygons are grouped by their PTAG SURF tag into one CgModelSurface per
+// LightWave surface, each named after its tag and carrying the CgMaterial
+// built from that surface's node graph.
+//
+// The first two TXUV maps become UV0 and UV1. Their VMAD entries override the
+// per vertex VMAP values at single polygon corners, and a vertex is split only
+// where a corner's UVs differ from the ones the vertex already carries.
 
 class LWO3ToCgModelConverter
 {
@@ -27,6 +35,15 @@ class LWO3ToCgModelConverter
     // Converts a single LWO3 layer to CgModel format
     CgModelPtr convert (const LWO3Layer* layer);
 
+    // Converts the layers of one file into a single CgModel
+    // Layers are converted concurrently and merged in the order given, so vertex
+    // and surface order don't depend on the thread count. Surfaces with the same
+    // tag in several layers become one surface. Layers that fail to convert are
+    // skipped with a warning
+    // pool: optional, a temporary pool is used when none is given. Called from a
+    // pool thread the layers are converted on that thread instead
+    CgModelPtr convert (const std::vector<std::shared_ptr<LWO3Layer>>& layers, BS::thread_pool* pool = nullptr);
+
     // Gets the currently enabled conversion flags
     ConversionFlags getFlags() const { return flags_; }
 
@@ -54,7 +71,17 @@ class LWO3ToCgModelConverter
 
     std::unordered_map<std::string, size_t> imageTextureMap_;
     std::unordered_map<std::string, size_t> processedImages_;
-    std::set<std::string> processedSurfaces_;
+
+    // Positions and polygon corners, which grow when UV seams split vertices
+    std::vector<Eigen::Vector3f> points_;
+    std::vector<uint32_t> corners_;
+    std::vector<uint32_t> cornerStart_; // first corner of each polygon, plus the end
+
+    // Validates and converts the geometry and UVs of one layer, no materials
+    CgModelPtr convertGeometry (const LWO3Layer* layer);
+
+    // Appends the layer models in order, offsetting indices and joining surfaces by name
+    CgModelPtr mergeModels (const std::vector<CgModelPtr>& parts) const;
 
     // Validates layer data before conversion
     bool validateLayer (const LWO3Layer* layer);
@@ -65,14 +92,14 @@ class LWO3ToCgModelConverter
     // Converts triangle indices to CgModel format
     bool convertTriangles (const LWO3Layer* layer, CgModelPtr model);
 
-    // Converts UV coordinates to CgModel format
+    // Converts UV coordinates to CgModel format, splitting vertices at UV seams
     bool convertUVs (const LWO3Layer* layer, CgModelPtr model);
 
-    // Converts images and textures to CgModel format
-    bool convertImages (const LWO3Layer* layer, CgModelPtr model);
+    // Fills each surface's material, images and textures from the LWO3 surface with the same name
+    bool convertMaterials (const LWO3MaterialManager& materials, CgModelPtr model);
 
-    // Converts material properties and node graphs to CgModel format
-    bool convertMaterials (const LWO3Layer* layer, CgModelPtr model);
+    // Adds the image and a texture for it once, returns the texture index
+    size_t addImage (const ImageNodeInfo& imageNode, CgModelPtr model);
 };
 
 // Enable bitwise operations on ConversionFlags
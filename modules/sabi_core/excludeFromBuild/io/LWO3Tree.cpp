@@ -2,22 +2,28 @@
 
 std::shared_ptr<LWO3Form> LWO3Tree::read (const fs::path& lwoPath)
 {
-    BinaryReader reader (lwoPath.string().c_str());
+    file_ = LWO3MappedFile::open (lwoPath);
+    if (!file_)
+    {
+        return nullptr;
+    }
+
+    // FORM, the file size and LWO3
+    if (file_->size() < 12)
+    {
+        LOG (WARNING) << "Invalid LWO3 file: too small for a header";
+        return nullptr;
+    }
 
     // Read the FORM identifier
-    uint32_t formId = reader.ReadUint32();
-    if (formId != mace::swap32 (LWO::FORM))
+    if (readU32 (0) != LWO::FORM)
     {
         LOG (WARNING) << "Invalid LWO3 file: FORM identifier not found";
         return nullptr;
     }
 
-    // Read the file size (we don't need to use this, but we need to skip it)
-    reader.Skip (4);
-
-    // Read the LWO3 identifier
-    uint32_t lwo3Id = reader.ReadUint32();
-    if (lwo3Id != mace::swap32 (LWO::LWO3))
+    // Read the LWO3 identifier, the file size is not needed
+    if (readU32 (8) != LWO::LWO3)
     {
         LOG (WARNING) << "Invalid LWO3 file: LWO3 identifier not found";
         return nullptr;
@@ -25,45 +31,84 @@ std::shared_ptr<LWO3Form> LWO3Tree::read (const fs::path& lwoPath)
 
     auto rootForm = std::make_shared<LWO3Form> (LWO::LWO3);
 
-    while (reader.Position() < reader.Length())
+    size_t position = 12;
+    while (position < file_->size())
     {
-        readElement (reader, rootForm.get());
+        if (!readElement (position, file_->size(), rootForm.get()))
+        {
+            break;
+        }
     }
 
+    // the chunks keep the mapping alive
+    file_.reset();
+
     return rootForm;
 }
 
+uint32_t LWO3Tree::readU32 (size_t position) const
+{
+    uint32_t value;
+    std::memcpy (&value, file_->data() + position, sizeof (value));
+    return mace::swap32 (value);
+}
+
 // Reads a chunk or form element at the current position and populates the parent
-void LWO3Tree::readElement (BinaryReader& reader, LWO3Form* parent)
+bool LWO3Tree::readElement (size_t& position, size_t end, LWO3Form* parent)
 {
-    size_t elementOffset = reader.Position();
-    uint32_t id = reader.ReadUint32();
-    uint32_t size = mace::swap32 (reader.ReadUint32());
+    size_t elementOffset = position;
+    if (end - position < 8)
+    {
+        LOG (WARNING) << "Truncated LWO3 element at offset " << elementOffset;
+        return false;
+    }
+
+    uint32_t id = readU32 (position);
+    uint32_t size = readU32 (position + 4);
+    position += 8;
+
+    if (size > end - position)
+    {
+        LOG (WARNING) << "LWO3 element at offset " << elementOffset << " runs past the end of its parent";
+        return false;
+    }
 
-    if (id == mace::swap32 (LWO::FORM))
+    if (id == LWO::FORM)
     {
-        uint32_t formType = reader.ReadUint32();
-        auto form = std::make_unique<LWO3Form> (mace::swap32 (formType), elementOffset);
+        if (size < 4)
+        {
+            LOG (WARNING) << "Invalid LWO3 FORM at offset " << elementOffset;
+            return false;
+        }
+
+        uint32_t formType = readU32 (position);
+        auto form = std::make_unique<LWO3Form> (formType, elementOffset);
 
-        size_t endPosition = reader.Position() + size - 4;
-        while (reader.Position() < endPosition)
+        size_t endPosition = position + size;
+        position += 4;
+        while (position < endPosition)
         {
-            readElement (reader, form.get());
+            if (!readElement (position, endPosition, form.get()))
+            {
+                break;
+            }
         }
+        position = endPosition;
 
         parent->addChild (std::move (form));
     }
     else
     {
-        auto chunk = std::make_unique<LWO3Chunk> (mace::swap32 (id), elementOffset);
-        std::vector<uint8_t> data (size);
-        reader.ReadToMemory (data.data(), size);
-        chunk->setData (std::move (data));
+        auto chunk = std::make_unique<LWO3Chunk> (id, elementOffset);
+        chunk->setData (file_->view (position, size), file_);
         parent->addChild (std::move (chunk));
 
-        if (size % 2 != 0)
+        position += size;
+        if (size % 2 != 0 && position < end)
         {
-            reader.Skip (1);
+            position += 1;
         }
     }
+
+    return true;
 }
@@ -13,14 +13,16 @@
 // - Constructs a hierarchical representation of the LWO3 file content
 // - Handles byte-swapping for cross-platform compatibility
 // - Ensures proper alignment by skipping padding bytes when necessary
+// - Reads straight out of a memory mapped file, chunks are views into the mapping
+//   so payloads are never copied
 //
 // Usage:
 //   LWO3Tree reader;
 //   std::unique_ptr<LWO3Form> rootForm = reader.read("path/to/file.lwo");
 //
 // Note: This class assumes that the input file is a valid LWO3 file. It performs
-// basic validation on the file header but relies on correct internal structure
-// for successful parsing.
+// basic validation on the file header and stops at elements that run past the
+// end of their parent, but relies on correct internal structure for successful parsing.
 
 
 class LWO3Tree
@@ -41,10 +43,17 @@ class LWO3Tree
     std::shared_ptr<LWO3Form> read (const fs::path& lwoPath);
 
  private:
+    LWO3MappedFilePtr file_;
+
+    // Big endian uint32 at 'position', the caller checks the range
+    uint32_t readU32 (size_t position) const;
+
     // Recursively reads and constructs the hierarchical structure of FORM and chunk elements
     // Parameters:
-    //   reader: The BinaryReader object positioned at the start of an element
+    //   position: Offset of the element in the file, advanced past it on return
+    //   end: End of the enclosing element
     //   parent: Pointer to the parent LWO3Form to which the read element will be added
+    // Returns false if the element is truncated, nothing more can be read from the parent then
     // This method handles both FORM (which may contain nested elements) and chunk elements
-    void readElement (BinaryReader& reader, LWO3Form* parent);
+    bool readElement (size_t& position, size_t end, LWO3Form* parent);
 };
\ No newline at end of file
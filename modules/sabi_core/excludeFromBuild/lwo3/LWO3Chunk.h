@@ -4,6 +4,9 @@
 //
 // Chunks are leaf nodes in the LWO3 file structure tree. They contain actual data.
 // This class is part of the Composite Pattern, representing the "Leaf" role.
+//
+// The data is a view into storage the chunk shares ownership of, normally the
+// memory mapped file, so nothing is copied or decoded until it is used.
 
 //#include "LWO3Element.h"
 //#include "LWO3Visitor.h"
@@ -11,6 +14,8 @@
 class LWO3Chunk : public LWO3Element
 {
  public:
+    using Bytes = std::span<const uint8_t>;
+
     LWO3Chunk (uint32_t id, size_t offset = 0) :
         LWO3Element (id, offset) {}
 
@@ -21,9 +26,24 @@ class LWO3Chunk : public LWO3Element
 
     bool isForm() const override { return false; }
 
-    const std::vector<uint8_t>& getData() const { return data_; }
-    void setData (const std::vector<uint8_t>& data) { data_ = data; }
+    // Valid for as long as the chunk is
+    Bytes getData() const { return data_; }
+
+    // Points the chunk at bytes owned by 'storage'
+    void setData (Bytes data, std::shared_ptr<const void> storage)
+    {
+        data_ = data;
+        storage_ = std::move (storage);
+    }
+
+    // Copies the bytes, for chunks that don't come from a file
+    void setData (const std::vector<uint8_t>& data)
+    {
+        auto owned = std::make_shared<const std::vector<uint8_t>> (data);
+        setData (Bytes (owned->data(), owned->size()), owned);
+    }
 
  private:
-    std::vector<uint8_t> data_;
-};
\ No newline at end of file
+    Bytes data_;
+    std::shared_ptr<const void> storage_;
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+// LWO3MappedFile: Read only memory map of an LWO3 file
+//
+// LWO3Tree parses directly out of the mapping and every LWO3Chunk is a non owning
+// view into it, so chunk payloads are never copied and their pages are only read
+// from disk when something decodes them. Chunks share ownership of the mapping,
+// which stays valid for as long as any part of the tree is alive.
+
+using LWO3MappedFilePtr = std::shared_ptr<class LWO3MappedFile>;
+
+class LWO3MappedFile
+{
+ public:
+    // Maps the whole file, returns nullptr if it is empty or can't be mapped
+    static LWO3MappedFilePtr open (const fs::path& path)
+    {
+        LWO3MappedFilePtr file (new LWO3MappedFile());
+        if (!file->map (path)) return nullptr;
+        return file;
+    }
+
+    ~LWO3MappedFile() { unmap(); }
+
+    LWO3MappedFile (const LWO3MappedFile&) = delete;
+    LWO3MappedFile& operator= (const LWO3MappedFile&) = delete;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // Bytes [offset, offset + count), the caller checks the range
+    std::span<const uint8_t> view (size_t offset, size_t count) const
+    {
+        return std::span<const uint8_t> (data_ + offset, count);
+    }
+
+ private:
+    LWO3MappedFile() = default;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+
+    bool map (const fs::path& path)
+    {
+        file_ = CreateFileW (path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+        {
+            LOG (WARNING) << "Could not open " << path.generic_string();
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx (file_, &fileSize) || fileSize.QuadPart == 0)
+        {
+            LOG (WARNING) << "Empty or unreadable file " << path.generic_string();
+            return false;
+        }
+
+        mapping_ = CreateFileMappingW (file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_)
+        {
+            LOG (WARNING) << "Could not map " << path.generic_string() << ", error " << GetLastError();
+            return false;
+        }
+
+        data_ = static_cast<const uint8_t*> (MapViewOfFile (mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (!data_)
+        {
+            LOG (WARNING) << "Could not map " << path.generic_string() << ", error " << GetLastError();
+            return false;
+        }
+
+        size_ = static_cast<size_t> (fileSize.QuadPart);
+        return true;
+    }
+
+    void unmap()
+    {
+        if (data_) UnmapViewOfFile (data_);
+        if (mapping_) CloseHandle (mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle (file_);
+        data_ = nullptr;
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+        size_ = 0;
+    }
+#else
+    bool map (const fs::path& path)
+    {
+        const int fd = ::open (path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            LOG (WARNING) << "Could not open " << path.generic_string();
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat (fd, &info) != 0 || info.st_size == 0)
+        {
+            LOG (WARNING) << "Empty or unreadable file " << path.generic_string();
+            ::close (fd);
+            return false;
+        }
+
+        // the mapping holds its own reference to the file
+        void* mapped = ::mmap (nullptr, static_cast<size_t> (info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close (fd);
+        if (mapped == MAP_FAILED)
+        {
+            LOG (WARNING) << "Could not map " << path.generic_string();
+            return false;
+        }
+
+        data_ = static_cast<const uint8_t*> (mapped);
+        size_ = static_cast<size_t> (info.st_size);
+        return true;
+    }
+
+    void unmap()
+    {
+        if (data_) ::munmap (const_cast<uint8_t*> (data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+#endif
+};
@@ -41,7 +41,7 @@ class Renderable : public std::enable_shared_from_this<Renderable>,
  public:
     virtual ~Renderable()
     {
-        LOG (DBUG) << getName() << "::" << getID();
+        LOG_EVERY_MS (DBUG, 1000) << "Destroyed " << getName() << "::" << getID();
     }
 
     const ItemID getID() const { return id(); }
@@ -0,0 +1,277 @@
+#pragma once
+
+// SceneChangeJournal records structural and transform edits to the scene as they
+// happen and hands the renderer one coalesced SceneDelta per frame.
+//
+// Producers (Model, World, Physics, the socket server...) may record from any
+// thread. Records go into a lock free moodycamel queue so recording never blocks
+// and never touches renderer state. The queue only keeps FIFO order per producer,
+// so every record also takes a sequence number from a shared counter.
+//
+// The consumer (the render thread) calls consume() once per frame. All pending
+// records are drained in bulk, sorted by sequence number and folded per node. A
+// record whose call returned before another call started always folds first, so a
+// remove on one thread followed by an add on another replaces the node:
+//   - add followed by remove cancels out, the renderer never sees the node
+//   - remove followed by add is reported as both so the renderer can replace it
+//   - repeated transforms collapse to the latest value
+//   - transforms on a node that is added or removed this frame are dropped since
+//     the add/remove already covers them
+//
+// Material edits are not recorded: ModelHandler bakes materials into the cached
+// geometry group and has no way to update them in place yet.
+//
+// Acceleration structure rebuilds can then happen once per frame instead of once
+// per message.
+
+struct SceneTransformChange
+{
+    ItemID nodeID = INVALID_ID;
+    RenderableWeakRef weakNode;
+    Eigen::Affine3f worldTransform = Eigen::Affine3f::Identity();
+};
+
+struct SceneDelta
+{
+    // applied in this order: removed, added, transforms
+    std::vector<ItemID> removed;
+    WeakRenderableList added;
+    std::vector<SceneTransformChange> transforms;
+
+    // number of raw records that were folded into this delta
+    size_t recordCount = 0;
+
+    bool empty() const
+    {
+        return removed.empty() && added.empty() && transforms.empty();
+    }
+
+    bool hasStructuralChanges() const { return !removed.empty() || !added.empty(); }
+
+    void clear()
+    {
+        removed.clear();
+        added.clear();
+        transforms.clear();
+        recordCount = 0;
+    }
+};
+
+class SceneChangeJournal
+{
+ public:
+    enum class ChangeType : uint8_t
+    {
+        Add,
+        Remove,
+        Transform
+    };
+
+ public:
+    SceneChangeJournal() = default;
+    ~SceneChangeJournal() = default;
+
+    SceneChangeJournal (const SceneChangeJournal&) = delete;
+    SceneChangeJournal& operator= (const SceneChangeJournal&) = delete;
+
+    // producer side, safe to call from any thread
+    void recordAdd (RenderableWeakRef weakNode)
+    {
+        if (RenderableNode node = weakNode.lock())
+            push (Record{ChangeType::Add, node->getID(), std::move (weakNode)});
+    }
+
+    void recordRemove (RenderableWeakRef weakNode)
+    {
+        if (RenderableNode node = weakNode.lock())
+            push (Record{ChangeType::Remove, node->getID(), std::move (weakNode)});
+    }
+
+    void recordRemove (ItemID nodeID)
+    {
+        if (nodeID != INVALID_ID)
+            push (Record{ChangeType::Remove, nodeID, {}});
+    }
+
+    void recordTransform (RenderableWeakRef weakNode)
+    {
+        if (RenderableNode node = weakNode.lock())
+        {
+            Record r{ChangeType::Transform, node->getID(), std::move (weakNode)};
+            r.setTransform (node->getSpaceTime().worldTransform);
+            push (std::move (r));
+        }
+    }
+
+    void recordTransform (RenderableWeakRef weakNode, const Eigen::Affine3f& worldTransform)
+    {
+        if (RenderableNode node = weakNode.lock())
+        {
+            Record r{ChangeType::Transform, node->getID(), std::move (weakNode)};
+            r.setTransform (worldTransform);
+            push (std::move (r));
+        }
+    }
+
+    // approximate, the queue may be modified concurrently
+    size_t pendingCount() const { return records.size_approx(); }
+    bool hasPendingChanges() const { return records.size_approx() > 0; }
+
+    // consumer side, call from a single thread once per frame
+    // the returned reference stays valid until the next call to consume()
+    const SceneDelta& consume()
+    {
+        delta.clear();
+        drain();
+        if (scratch.empty()) return delta;
+
+        delta.recordCount = scratch.size();
+        fold();
+        emit();
+
+        scratch.clear();
+        nodes.clear();
+        order.clear();
+
+        return delta;
+    }
+
+ private:
+    struct Record
+    {
+        ChangeType type = ChangeType::Add;
+        ItemID nodeID = INVALID_ID;
+        RenderableWeakRef weakNode;
+        uint64_t sequence = 0;
+
+        // kept as plain floats, the queue's block allocator makes
+        // no promises about Eigen's alignment requirements
+        std::array<float, 16> pose = {};
+
+        void setTransform (const Eigen::Affine3f& t)
+        {
+            std::copy_n (t.matrix().data(), 16, pose.data());
+        }
+
+        Eigen::Affine3f getTransform() const
+        {
+            Eigen::Affine3f t;
+            t.matrix() = Eigen::Map<const Eigen::Matrix4f> (pose.data());
+            return t;
+        }
+    };
+
+    // net effect of all records for a single node this frame
+    struct NodeChange
+    {
+        RenderableWeakRef weakNode;
+        RenderableWeakRef transformNode;
+        Eigen::Affine3f worldTransform = Eigen::Affine3f::Identity();
+        bool removed = false;  // node must be taken out of the renderer
+        bool added = false;    // node must be put into the renderer
+        bool cancelled = false; // added and removed again, renderer never saw it
+        bool transform = false;
+    };
+
+    static constexpr size_t drainBatchSize = 256;
+
+    moodycamel::ConcurrentQueue<Record> records;
+    std::atomic<uint64_t> nextSequence = 0;
+
+    // consumer only scratch space, reused every frame to avoid allocations
+    std::vector<Record> scratch;
+    std::unordered_map<ItemID, NodeChange> nodes;
+    std::vector<ItemID> order;
+    SceneDelta delta;
+
+    void push (Record&& r)
+    {
+        r.sequence = nextSequence.fetch_add (1, std::memory_order_relaxed);
+        records.enqueue (std::move (r));
+    }
+
+    void drain()
+    {
+        // dequeue in batches, size_approx() can be stale by the time we get here
+        size_t count = 0;
+        do
+        {
+            scratch.resize (scratch.size() + drainBatchSize);
+            count = records.try_dequeue_bulk (scratch.end() - drainBatchSize, drainBatchSize);
+            scratch.resize (scratch.size() - (drainBatchSize - count));
+        } while (count == drainBatchSize);
+
+        // back into recording order across producers
+        std::sort (scratch.begin(), scratch.end(), [] (const Record& a, const Record& b)
+                   { return a.sequence < b.sequence; });
+    }
+
+    void fold()
+    {
+        for (Record& r : scratch)
+        {
+            auto [it, inserted] = nodes.try_emplace (r.nodeID);
+            if (inserted) order.push_back (r.nodeID);
+
+            NodeChange& c = it->second;
+
+            switch (r.type)
+            {
+                case ChangeType::Add:
+                    // adding a node that is already pending add is a no-op
+                    c.added = true;
+                    c.cancelled = false;
+                    c.weakNode = r.weakNode;
+                    c.transform = false;
+                    break;
+
+                case ChangeType::Remove:
+                    if (c.added)
+                    {
+                        // add then remove in the same frame cancels out, but a
+                        // remove recorded before the add still has to go through
+                        c.added = false;
+                        c.cancelled = !c.removed;
+                    }
+                    else
+                    {
+                        c.removed = true;
+                    }
+                    c.transform = false;
+                    break;
+
+                case ChangeType::Transform:
+                    // a pending add picks up the current transform on its own
+                    if (c.added || c.removed || c.cancelled) break;
+                    c.transform = true;
+                    c.transformNode = r.weakNode;
+                    c.worldTransform = r.getTransform();
+                    break;
+            }
+        }
+    }
+
+    void emit()
+    {
+        // walk in first-recorded order so the delta is deterministic
+        for (ItemID id : order)
+        {
+            NodeChange& c = nodes[id];
+
+            if (c.removed) delta.removed.push_back (id);
+
+            if (c.added)
+            {
+                // the node may have died before the render thread got to it
+                if (!c.weakNode.expired())
+                    delta.added.push_back (c.weakNode);
+                continue;
+            }
+
+            if (c.transform && !c.transformNode.expired())
+                delta.transforms.push_back (SceneTransformChange{id, c.transformNode, c.worldTransform});
+        }
+    }
+};
+
+using SceneChangeJournalPtr = std::shared_ptr<SceneChangeJournal>;
@@ -38,6 +38,7 @@ constexpr float epsilon = 1e-6;
 // Prepare mesh for flat shading by duplicating vertices at edges
 void MeshOps::prepareForFlatShading (CgModelPtr& model)
 {
+    TRACE_SCOPE_CAT ("mesh", "MeshOps::prepareForFlatShading");
     MatrixXf originalV = model->V;
     MatrixXf newV;
     MatrixXf originalUV0;
@@ -146,6 +147,7 @@ void MeshOps::prepareForFlatShading (CgModelPtr& model)
 void MeshOps::generate_normals (const MatrixXu& F, const MatrixXf& V, MatrixXf& N, MatrixXf& FN,
                                 bool deterministic, bool flatShaded)
 {
+    TRACE_SCOPE_CAT ("mesh", "MeshOps::generate_normals");
     std::atomic<uint32_t> badFaces (0);
 
     N.resize (V.rows(), V.cols());
@@ -334,6 +336,7 @@ void MeshOps::generate_normals (CgModelPtr& cgModel, bool flatShaded)
 
 void MeshOps::processCgModel (RenderableNode& node, MeshOptions meshOptions, LoadStrategyPtr loadStrategy)
 {
+    TRACE_SCOPE_CAT ("mesh", "MeshOps::processCgModel");
     CgModelPtr model = node->getModel();
     if (!model)
     {
@@ -388,6 +391,7 @@ void MeshOps::processCgModel (RenderableNode& node, MeshOptions meshOptions, Loa
 
 void MeshOps::unweldMesh (CgModelPtr& model)
 {
+    TRACE_SCOPE_CAT ("mesh", "MeshOps::unweldMesh");
     // model->triangleCount might need to be computed
     MatrixXu allTris;
     if (!model->triangleCount())
@@ -543,6 +547,7 @@ CgModelPtr MeshOps::createTexturedTriangle (const fs::path& pngImagePath)
     CgImage image;
     image.uri = pngImagePath.generic_string(); // Replace with actual texture path
     image.mimeType = "image/png";              // Adjust based on your image type
+    image.source = CgImageSource::fromFile (pngImagePath);
     triangle->cgImages.push_back (image);
 
     // Set the base color texture
@@ -0,0 +1,199 @@
+#pragma once
+
+// PolygonTriangulator: Splits planar or near planar polygons into triangles
+//
+// - Triangles pass through untouched
+// - Quads are split along the diagonal that keeps both halves facing the same way
+//   as the polygon, so concave quads stay inside their outline. When both work the
+//   shorter diagonal is used
+// - Larger polygons are projected onto the plane of their Newell normal and ear
+//   clipped with earcut, which handles concave outlines
+// - A polygon with n corners always gives n - 2 triangles. If ear clipping gives up
+//   on a degenerate outline the polygon falls back to a fan so counts stay predictable
+// - Triangles keep the winding of the source polygon
+//
+// Each polygon's output columns come from a prefix sum of the triangle counts, so the
+// polygons are triangulated in parallel straight into the index matrix.
+//
+// Usage:
+//   MatrixXu F = PolygonTriangulator::triangulate (points, polygons.size(), [&] (size_t i)
+//                { return std::span<const uint32_t> (polygons[i].indices); });
+
+class PolygonTriangulator
+{
+ public:
+    // below this many polygons the work stays on the calling thread
+    static constexpr size_t ParallelThreshold = 4096;
+
+    // points: vertex positions
+    // polygonCount: number of polygons
+    // corners: returns the corner indices of polygon i as a std::span<const uint32_t>
+    // pool: optional, a temporary pool is used for large meshes when none is given
+    //       Called from a pool thread, the work stays on that thread instead of nesting pools
+    // Returns 3 x N triangle indices, polygons with fewer than 3 corners are skipped
+    template <typename CornerFunc>
+    static MatrixXu triangulate (const std::vector<Eigen::Vector3f>& points, size_t polygonCount,
+                                 CornerFunc&& corners, BS::thread_pool* pool = nullptr)
+    {
+        // first column of each polygon's triangles
+        std::vector<uint32_t> offsets (polygonCount + 1, 0);
+        for (size_t i = 0; i < polygonCount; ++i)
+        {
+            const size_t n = corners (i).size();
+            offsets[i + 1] = offsets[i] + (n >= 3 ? static_cast<uint32_t> (n - 2) : 0);
+        }
+
+        MatrixXu F (3, offsets.back());
+
+        auto triangulateRange = [&] (size_t start, size_t end)
+        {
+            Scratch scratch;
+            for (size_t i = start; i < end; ++i)
+            {
+                const std::span<const uint32_t> polygon = corners (i);
+                if (polygon.size() < 3) continue;
+                triangulatePolygon (points, polygon, F, offsets[i], scratch);
+            }
+        };
+
+        if (polygonCount < ParallelThreshold || BS::this_thread::get_pool())
+        {
+            triangulateRange (0, polygonCount);
+        }
+        else if (pool)
+        {
+            // the pool may be shared, wait for these polygons only
+            pool->submit_blocks (size_t (0), polygonCount, triangulateRange).wait();
+        }
+        else
+        {
+            BS::thread_pool localPool;
+            localPool.detach_blocks (size_t (0), polygonCount, triangulateRange);
+            localPool.wait();
+        }
+
+        return F;
+    }
+
+    // Newell normal, not normalized, its length is twice the polygon's area
+    static Eigen::Vector3f polygonNormal (const std::vector<Eigen::Vector3f>& points, std::span<const uint32_t> polygon)
+    {
+        Eigen::Vector3f normal = Eigen::Vector3f::Zero();
+        for (size_t i = 0; i < polygon.size(); ++i)
+        {
+            const Eigen::Vector3f& a = points[polygon[i]];
+            const Eigen::Vector3f& b = points[polygon[(i + 1) % polygon.size()]];
+            normal.x() += (a.y() - b.y()) * (a.z() + b.z());
+            normal.y() += (a.z() - b.z()) * (a.x() + b.x());
+            normal.z() += (a.x() - b.x()) * (a.y() + b.y());
+        }
+        return normal;
+    }
+
+ private:
+    using Point2 = std::array<float, 2>;
+
+    // per thread buffers for earcut
+    struct Scratch
+    {
+        std::vector<std::vector<Point2>> rings = std::vector<std::vector<Point2>> (1);
+        std::vector<uint32_t> triangles;
+    };
+
+    static Eigen::Vector3f triangleNormal (const std::vector<Eigen::Vector3f>& points, uint32_t a, uint32_t b, uint32_t c)
+    {
+        return (points[b] - points[a]).cross (points[c] - points[a]);
+    }
+
+    static void triangulatePolygon (const std::vector<Eigen::Vector3f>& points, std::span<const uint32_t> polygon,
+                                    MatrixXu& F, uint32_t column, Scratch& scratch)
+    {
+        const size_t n = polygon.size();
+        if (n == 3)
+        {
+            F.col (column) = Vector3u (polygon[0], polygon[1], polygon[2]);
+            return;
+        }
+
+        const Eigen::Vector3f normal = polygonNormal (points, polygon);
+
+        if (n == 4)
+        {
+            triangulateQuad (points, polygon, normal, F, column);
+            return;
+        }
+
+        if (!earClip (points, polygon, normal, F, column, scratch))
+        {
+            // degenerate outline, a fan keeps the count right
+            for (size_t i = 1; i + 1 < n; ++i)
+                F.col (column + i - 1) = Vector3u (polygon[0], polygon[i], polygon[i + 1]);
+        }
+    }
+
+    static void triangulateQuad (const std::vector<Eigen::Vector3f>& points, std::span<const uint32_t> q,
+                                 const Eigen::Vector3f& normal, MatrixXu& F, uint32_t column)
+    {
+        // diagonal 0-2 or diagonal 1-3, valid when both halves face along the polygon normal
+        const bool valid02 = triangleNormal (points, q[0], q[1], q[2]).dot (normal) > 0.0f &&
+                             triangleNormal (points, q[0], q[2], q[3]).dot (normal) > 0.0f;
+        const bool valid13 = triangleNormal (points, q[0], q[1], q[3]).dot (normal) > 0.0f &&
+                             triangleNormal (points, q[1], q[2], q[3]).dot (normal) > 0.0f;
+
+        bool use02 = valid02;
+        if (valid02 == valid13)
+        {
+            use02 = (points[q[0]] - points[q[2]]).squaredNorm() <= (points[q[1]] - points[q[3]]).squaredNorm();
+        }
+
+        if (use02)
+        {
+            F.col (column) = Vector3u (q[0], q[1], q[2]);
+            F.col (column + 1) = Vector3u (q[0], q[2], q[3]);
+        }
+        else
+        {
+            F.col (column) = Vector3u (q[0], q[1], q[3]);
+            F.col (column + 1) = Vector3u (q[1], q[2], q[3]);
+        }
+    }
+
+    // returns false unless earcut produced all n - 2 triangles
+    static bool earClip (const std::vector<Eigen::Vector3f>& points, std::span<const uint32_t> polygon,
+                         const Eigen::Vector3f& normal, MatrixXu& F, uint32_t column, Scratch& scratch)
+    {
+        const size_t n = polygon.size();
+        if (normal.squaredNorm() == 0.0f) return false;
+
+        // drop the dominant axis of the normal
+        int axis = 0;
+        normal.cwiseAbs().maxCoeff (&axis);
+        const int u = (axis + 1) % 3;
+        const int v = (axis + 2) % 3;
+
+        auto& ring = scratch.rings[0];
+        ring.clear();
+        for (uint32_t index : polygon)
+        {
+            const Eigen::Vector3f& p = points[index];
+            ring.push_back ({p[u], p[v]});
+        }
+
+        scratch.triangles = mapbox::earcut<uint32_t> (scratch.rings);
+        if (scratch.triangles.size() != (n - 2) * 3) return false;
+
+        for (size_t t = 0; t < n - 2; ++t)
+        {
+            uint32_t a = polygon[scratch.triangles[t * 3]];
+            uint32_t b = polygon[scratch.triangles[t * 3 + 1]];
+            uint32_t c = polygon[scratch.triangles[t * 3 + 2]];
+
+            // earcut picks its own winding
+            if (triangleNormal (points, a, b, c).dot (normal) < 0.0f)
+                std::swap (b, c);
+
+            F.col (column + t) = Vector3u (a, b, c);
+        }
+        return true;
+    }
+};
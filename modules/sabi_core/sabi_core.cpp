@@ -13,6 +13,9 @@ namespace sabi
 #include "excludeFromBuild/scene/WorldComposite.cpp"
 #include "excludeFromBuild/scene/WorldItem.cpp"
 
+// cgmodel
+#include "excludeFromBuild/cgmodel/CgImageCache.cpp"
+
 // tools
 #include "excludeFromBuild/tools/MeshOps.cpp"
 #include "excludeFromBuild/tools/NormalizedClump.cpp"
@@ -23,9 +26,9 @@ namespace sabi
 #include "excludeFromBuild/io/LWO3Tree.cpp"
 #include "excludeFromBuild/io/LWO3Layer.cpp"
 #include "excludeFromBuild/io/LWO3Reader.cpp"
-//#include "excludeFromBuild/io/LWO3ToCgModelConverter.cpp"
 #include "excludeFromBuild/io/LWO3Material.cpp"
 #include "excludeFromBuild/io/LWO3MaterialManager.cpp"
+#include "excludeFromBuild/io/LWO3ToCgModelConverter.cpp"
 } // namespace sabi
 
 #include "excludeFromBuild/io/GLTFImporter.cpp"
@@ -11,6 +11,31 @@
 #include <cereal/types/vector.hpp>
 #include <cereal/types/string.hpp>
 
+#include <span>
+#include <bit>
+#include <list>
+
+// decoding embedded images, declared at global scope
+#include <stb_image/stb_image.h>
+
+// bulk big endian decoding for LWO3
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+// n-gon triangulation
+#include <earcut.hpp>
+
+// memory mapped LWO3 files
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 constexpr float DEFAULT_ZOOM_FACTOR = 0.5f;
 constexpr float DEFAULT_ZOOM_MULTIPLIER = 200.0f;
 
@@ -92,6 +117,7 @@ namespace sabi
 #include "excludeFromBuild/camera/CameraBody.h"
 
     // cppGltf
+#include "excludeFromBuild/cgmodel/CgImageCache.h"
 #include "excludeFromBuild/io/GLTFUtil.h"
 #include "excludeFromBuild/cgmodel/CgMaterial.h"
 #include "excludeFromBuild/cgmodel/CgModelSurface.h"
@@ -103,6 +129,7 @@ namespace sabi
 #include "excludeFromBuild/scene/RenderableState.h"
 #include "excludeFromBuild/scene/RenderableDesc.h"
 #include "excludeFromBuild/scene/Renderable.h"
+#include "excludeFromBuild/scene/SceneChangeJournal.h"
 #include "excludeFromBuild/scene/WorldItem.h"
 #include "excludeFromBuild/scene/WorldComposite.h"
 #include "excludeFromBuild/scene/SceneOptions.h"
@@ -112,29 +139,34 @@ namespace sabi
 #include "excludeFromBuild/tools/MeshOps.h"
 #include "excludeFromBuild/tools/NormalizedClump.h"
 #include "excludeFromBuild/tools/RadialFlower.h"
+#include "excludeFromBuild/tools/PolygonTriangulator.h"
 
 #include "excludeFromBuild/lwo3/LWO3Defs.h"
+#include "excludeFromBuild/lwo3/LWO3Decoder.h"
 #include "excludeFromBuild/lwo3/LWO3Element.h"
 #include "excludeFromBuild/lwo3/LWO3Visitor.h"
+#include "excludeFromBuild/lwo3/LWO3MappedFile.h"
 #include "excludeFromBuild/lwo3/LWO3Chunk.h"
 #include "excludeFromBuild/lwo3/LWO3Form.h"
 
 #include "excludeFromBuild/io/LWO3Navigator.h"
+#include "excludeFromBuild/io/LWO3ChunkIndex.h"
 #include "excludeFromBuild/io/LWO3Tree.h"
 #include "excludeFromBuild/io/LWO3NodeData.h"
 #include "excludeFromBuild/io/LWO3NodeGraph.h"
 #include "excludeFromBuild/io/LWO3Surface.h"
 #include "excludeFromBuild/io/LWO3Layer.h"
 #include "excludeFromBuild/io/LWO3Reader.h"
-#include "excludeFromBuild/io/LWO3ToCgModelConverter.h"
 #include "excludeFromBuild/io/LWO3Material.h"
 #include "excludeFromBuild/io/LWO3MaterialManager.h"
+#include "excludeFromBuild/io/LWO3ToCgModelConverter.h"
 } // namespace sabi
 
 // must be outside sabi
 #include "excludeFromBuild/io/GltfAnimationExporter.h"
 #include "excludeFromBuild/io/GLTFImporter.h"
 #include "excludeFromBuild/animation/AnimationBuilder.h"
+#include "excludeFromBuild/animation/AnimationEvaluator.h"
 
 #include "excludeFromBuild/io/AssetPathManager.h"
 
@@ -22,7 +22,7 @@ end
     }
 	vectorextensions "AVX2"
 	filter "configurations:Debug"    defines { "DEBUG" }  symbols  "On"
-    filter "configurations:Release"  defines { "NDEBUG" } optimize "On"
+    filter "configurations:Release"  defines { "NDEBUG", "MACE_LOG_MIN_LEVEL=300" } optimize "On"
     
 	outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 	
@@ -146,5 +146,6 @@ project "AppCore"
 	-- add projects here
 	include "appSandbox/HelloWorld"
 	include "appSandbox/RenderDog"
+	include "appSandbox/RenderDogBatch"
 
 	
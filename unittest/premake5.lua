@@ -25,3 +25,11 @@ end
 
 	
 	include "tests/HelloTest"
+	include "tests/EnvImportanceTest"
+	include "tests/KernelCacheTest"
+	include "tests/TriangulateTest"
+	include "tests/LWO3UVTest"
+	include "tests/LWO3DecodeTest"
+	include "tests/CgImageCacheTest"
+	include "tests/CpuRenderTest"
+	include "tests/AnimationEvaluatorTest"
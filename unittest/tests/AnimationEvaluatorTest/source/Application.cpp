@@ -0,0 +1,319 @@
+#include "Jahley.h"
+
+const std::string APP_NAME = "AnimationEvaluatorTest";
+
+#ifdef CHECK
+#undef CHECK
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <doctest/doctest.h>
+
+#include <sabi_core/sabi_core.h>
+
+using sabi::RenderableNode;
+using sabi::WorldItem;
+
+namespace
+{
+    using Path = fastgltf::AnimationPath;
+
+    // x = k * k at key k, so a wrong bracketing key gives a wrong value
+    AnimationChannel squareChannel (uint32_t keyCount)
+    {
+        AnimationChannel channel{"square", Path::Translation, {}};
+        for (uint32_t k = 0; k < keyCount; ++k)
+        {
+            KeyFrame key;
+            key.time = static_cast<float> (k);
+            key.translation = Eigen::Vector3f (static_cast<float> (k * k), 0.0f, 0.0f);
+            channel.keyFrames.push_back (key);
+        }
+        return channel;
+    }
+
+    float expectedSquare (float t)
+    {
+        const float k = std::floor (t);
+        return k * k + (t - k) * ((k + 1.0f) * (k + 1.0f) - k * k);
+    }
+
+    AnimationChannel translationChannel (std::vector<std::pair<float, Eigen::Vector3f>> keys)
+    {
+        AnimationChannel channel{"translation", Path::Translation, {}};
+        for (const auto& [time, value] : keys)
+        {
+            KeyFrame key;
+            key.time = time;
+            key.translation = value;
+            channel.keyFrames.push_back (key);
+        }
+        return channel;
+    }
+
+    AnimationChannel rotationChannel (std::vector<std::pair<float, Eigen::Quaternionf>> keys)
+    {
+        AnimationChannel channel{"rotation", Path::Rotation, {}};
+        for (const auto& [time, value] : keys)
+        {
+            KeyFrame key;
+            key.time = time;
+            key.rotation = value;
+            channel.keyFrames.push_back (key);
+        }
+        return channel;
+    }
+
+    Eigen::Quaternionf aboutY (float degrees)
+    {
+        return Eigen::Quaternionf (Eigen::AngleAxisf (degrees * std::numbers::pi_v<float> / 180.0f, Eigen::Vector3f::UnitY()));
+    }
+
+    Eigen::Quaternionf rotationOf (const RenderableNode& node)
+    {
+        return Eigen::Quaternionf (node->getSpaceTime().worldTransform.rotation());
+    }
+
+    float x (const RenderableNode& node)
+    {
+        return node->getSpaceTime().worldTransform.translation().x();
+    }
+
+    // a node with random translation, rotation and scale keys
+    RenderableNode randomNode (std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> u (-1.0f, 1.0f);
+        const uint32_t keyCount = 2 + rng() % 12;
+
+        AnimationChannel t{"t", Path::Translation, {}};
+        AnimationChannel r{"r", Path::Rotation, {}};
+        AnimationChannel s{"s", Path::Scale, {}};
+        float time = 0.0f;
+        for (uint32_t k = 0; k < keyCount; ++k)
+        {
+            KeyFrame key;
+            key.time = time;
+            key.translation = Eigen::Vector3f (u (rng), u (rng), u (rng)) * 10.0f;
+            key.rotation = Eigen::Quaternionf (u (rng), u (rng), u (rng), u (rng)).normalized();
+            key.scale = Eigen::Vector3f (u (rng), u (rng), u (rng)).cwiseAbs() + Eigen::Vector3f::Constant (0.5f);
+            t.keyFrames.push_back (key);
+            r.keyFrames.push_back (key);
+            s.keyFrames.push_back (key);
+            time += 0.1f + 0.5f * std::abs (u (rng));
+        }
+
+        RenderableNode node = WorldItem::create();
+        node->getSpaceTime().animation = {t, r, s};
+        return node;
+    }
+} // namespace
+
+TEST_CASE ("Playback finds the right keys forwards, backwards and across jumps")
+{
+    RenderableNode node = WorldItem::create();
+    AnimationEvaluator evaluator;
+    evaluator.setLooping (false);
+    evaluator.addNode (node, {squareChannel (40)});
+
+    // small steps move the cursor one key at a time
+    for (float t = 0.0f; t <= 39.0f; t += 0.25f)
+    {
+        evaluator.evaluate (t);
+        CHECK (x (node) == doctest::Approx (expectedSquare (t)));
+    }
+
+    // scrubbing back, then far ahead, falls back to a search
+    for (float t : {30.5f, 29.75f, 2.1f, 0.5f, 25.25f, 26.0f, 26.5f, 3.0f, 38.9f})
+    {
+        evaluator.evaluate (t);
+        CHECK (x (node) == doctest::Approx (expectedSquare (t)));
+    }
+
+    // outside the clip holds the first or last key
+    evaluator.evaluate (-3.0f);
+    CHECK (x (node) == doctest::Approx (0.0f));
+    evaluator.evaluate (100.0f);
+    CHECK (x (node) == doctest::Approx (39.0f * 39.0f));
+}
+
+TEST_CASE ("Looping wraps time into the clip")
+{
+    RenderableNode node = WorldItem::create();
+    AnimationEvaluator evaluator;
+    evaluator.addNode (node, {translationChannel ({{1.0f, Eigen::Vector3f (0.0f, 0.0f, 0.0f)},
+                                                   {3.0f, Eigen::Vector3f (8.0f, 0.0f, 0.0f)}})});
+
+    evaluator.evaluate (1.0f);
+    CHECK (evaluator.getStartTime() == 1.0f);
+    CHECK (evaluator.getEndTime() == 3.0f);
+    CHECK (evaluator.getDuration() == 2.0f);
+    CHECK (x (node) == doctest::Approx (0.0f));
+
+    evaluator.evaluate (3.5f); // 1.5
+    CHECK (x (node) == doctest::Approx (2.0f));
+
+    evaluator.evaluate (-0.5f); // 1.5 from the other side
+    CHECK (x (node) == doctest::Approx (2.0f));
+
+    // a whole number of loops lands on the last key, not back on the first
+    evaluator.evaluate (5.0f);
+    CHECK (x (node) == doctest::Approx (8.0f));
+
+    evaluator.evaluate (6.5f); // 2.5
+    CHECK (x (node) == doctest::Approx (6.0f));
+
+    evaluator.setLooping (false);
+    evaluator.evaluate (6.5f);
+    CHECK (x (node) == doctest::Approx (8.0f));
+    evaluator.evaluate (0.0f);
+    CHECK (x (node) == doctest::Approx (0.0f));
+}
+
+TEST_CASE ("Rotation keys in opposite hemispheres blend the short way")
+{
+    // the second key is stored negated, the same orientation from the other hemisphere
+    const Eigen::Quaternionf q0 = aboutY (0.0f);
+    const Eigen::Quaternionf q1 = aboutY (90.0f);
+    const Eigen::Quaternionf q1Flipped (-q1.w(), -q1.x(), -q1.y(), -q1.z());
+
+    RenderableNode slerpNode = WorldItem::create();
+    RenderableNode nlerpNode = WorldItem::create();
+
+    AnimationEvaluator slerp;
+    slerp.setRotationBlend (AnimationEvaluator::RotationBlend::Slerp);
+    slerp.addNode (slerpNode, {rotationChannel ({{0.0f, q0}, {1.0f, q1Flipped}})});
+
+    AnimationEvaluator nlerp;
+    nlerp.setRotationBlend (AnimationEvaluator::RotationBlend::Nlerp);
+    nlerp.addNode (nlerpNode, {rotationChannel ({{0.0f, q0}, {1.0f, q1Flipped}})});
+
+    for (float t : {0.0f, 0.25f, 0.5f, 0.75f, 1.0f})
+    {
+        CAPTURE (t);
+        slerp.evaluate (t);
+        nlerp.evaluate (t);
+
+        // slerp turns at a constant rate, 90 * t degrees about y
+        CHECK (rotationOf (slerpNode).angularDistance (aboutY (90.0f * t)) < 1e-4f);
+
+        // nlerp stays on the same arc, it matches slerp at the ends and the middle and lags or leads in between
+        const float gap = rotationOf (nlerpNode).angularDistance (rotationOf (slerpNode));
+        if (t == 0.25f || t == 0.75f)
+            CHECK (gap > 5e-3f);
+        else
+            CHECK (gap < 1e-4f);
+        CHECK (rotationOf (nlerpNode).angularDistance (aboutY (90.0f * t)) < 0.03f);
+    }
+
+    // nearly equal keys fall back to a normalized lerp rather than dividing by sin(theta) ~ 0
+    RenderableNode close = WorldItem::create();
+    AnimationEvaluator tiny;
+    tiny.setRotationBlend (AnimationEvaluator::RotationBlend::Slerp);
+    tiny.addNode (close, {rotationChannel ({{0.0f, aboutY (0.0f)}, {1.0f, aboutY (0.5f)}})});
+    tiny.evaluate (0.5f);
+    CHECK (close->getSpaceTime().worldTransform.matrix().allFinite());
+    CHECK (rotationOf (close).angularDistance (aboutY (0.25f)) < 1e-4f);
+}
+
+TEST_CASE ("Parallel evaluation matches serial evaluation")
+{
+    constexpr uint32_t NodeCount = 600;
+
+    std::mt19937 serialRng (42);
+    std::mt19937 parallelRng (42);
+    std::vector<RenderableNode> serialNodes;
+    std::vector<RenderableNode> parallelNodes;
+
+    AnimationEvaluator serial;
+    AnimationEvaluator parallel;
+    parallel.setParallelThreshold (0);
+    for (auto* e : {&serial, &parallel})
+        e->setRotationBlend (AnimationEvaluator::RotationBlend::Slerp);
+
+    for (uint32_t i = 0; i < NodeCount; ++i)
+    {
+        serialNodes.push_back (randomNode (serialRng));
+        parallelNodes.push_back (randomNode (parallelRng));
+        serial.addNode (serialNodes.back());
+        parallel.addNode (parallelNodes.back());
+    }
+    CHECK (parallel.nodeCount() == NodeCount);
+
+    // the pool's threads record into the journal, so they must finish first
+    sabi::SceneChangeJournal journal;
+    BS::thread_pool pool (4);
+
+    for (float t : {0.0f, 0.3f, 0.31f, 1.7f, 0.9f, 4.2f, 11.0f})
+    {
+        CAPTURE (t);
+        serial.evaluate (t);
+        parallel.evaluate (t, &pool, &journal);
+
+        uint32_t mismatches = 0;
+        for (uint32_t i = 0; i < NodeCount; ++i)
+        {
+            const Eigen::Matrix4f& a = serialNodes[i]->getSpaceTime().worldTransform.matrix();
+            const Eigen::Matrix4f& b = parallelNodes[i]->getSpaceTime().worldTransform.matrix();
+            if (!a.isApprox (b, 1e-5f)) ++mismatches;
+        }
+        CHECK (mismatches == 0);
+
+        // every animated node is reported once per frame
+        CHECK (journal.consume().transforms.size() == NodeCount);
+    }
+}
+
+TEST_CASE ("Children are composed on top of their parent")
+{
+    RenderableNode parent = WorldItem::create();
+    RenderableNode child = WorldItem::create();
+    child->setParent (parent);
+
+    // added child first, the evaluator still composes the parent before it
+    AnimationEvaluator evaluator;
+    evaluator.addNode (child, {translationChannel ({{0.0f, Eigen::Vector3f (0.0f, 1.0f, 0.0f)},
+                                                    {1.0f, Eigen::Vector3f (0.0f, 1.0f, 0.0f)}}),
+                               rotationChannel ({{0.0f, aboutY (90.0f)}, {1.0f, aboutY (90.0f)}})});
+    evaluator.addNode (parent, {translationChannel ({{0.0f, Eigen::Vector3f (0.0f, 0.0f, 0.0f)},
+                                                     {1.0f, Eigen::Vector3f (10.0f, 0.0f, 0.0f)}}),
+                                rotationChannel ({{0.0f, aboutY (0.0f)}, {1.0f, aboutY (90.0f)}})});
+
+    evaluator.evaluate (0.5f);
+    const Eigen::Affine3f& parentWorld = parent->getSpaceTime().worldTransform;
+    const Eigen::Affine3f& childWorld = child->getSpaceTime().worldTransform;
+    CHECK (parentWorld.translation().isApprox (Eigen::Vector3f (5.0f, 0.0f, 0.0f), 1e-5f));
+    CHECK (childWorld.translation().isApprox (Eigen::Vector3f (5.0f, 1.0f, 0.0f), 1e-5f));
+    CHECK (rotationOf (child).angularDistance (aboutY (135.0f)) < 1e-3f);
+
+    // a still parent moves its child, and the child's rest pose is kept relative to it
+    RenderableNode stage = WorldItem::create();
+    stage->getSpaceTime().startTransform = Eigen::Translation3f (0.0f, 0.0f, 3.0f) * Eigen::Affine3f::Identity();
+    stage->getSpaceTime().worldTransform = stage->getSpaceTime().startTransform;
+
+    RenderableNode actor = WorldItem::create();
+    actor->setParent (stage);
+    actor->getSpaceTime().startTransform = Eigen::Translation3f (1.0f, 0.0f, 3.0f) * Eigen::Affine3f::Identity();
+
+    AnimationEvaluator staged;
+    staged.addNode (actor, {rotationChannel ({{0.0f, aboutY (0.0f)}, {1.0f, aboutY (90.0f)}})});
+    staged.evaluate (1.0f);
+    CHECK (actor->getSpaceTime().worldTransform.translation().isApprox (Eigen::Vector3f (1.0f, 0.0f, 3.0f), 1e-5f));
+    CHECK (rotationOf (actor).angularDistance (aboutY (90.0f)) < 1e-4f);
+}
+
+class Application : public Jahley::App
+{
+ public:
+    Application (DesktopWindowSettings settings = DesktopWindowSettings(), bool windowApp = false) :
+        Jahley::App()
+    {
+        doctest::Context().run();
+    }
+
+ private:
+};
+
+Jahley::App* Jahley::CreateApplication()
+{
+    return new Application();
+}
@@ -0,0 +1,227 @@
+#include "Jahley.h"
+
+const std::string APP_NAME = "CgImageCacheTest";
+
+#ifdef CHECK
+#undef CHECK
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <doctest/doctest.h>
+
+#include <sabi_core/sabi_core.h>
+#include <stb_image/stb_image_write.h>
+
+using sabi::CgImageCache;
+using sabi::CgImageSource;
+using sabi::CgImageSourcePtr;
+using sabi::CgPixelsPtr;
+
+namespace
+{
+    struct TestImage
+    {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::vector<unsigned char> pixels;
+        std::vector<unsigned char> png;
+    };
+
+    TestImage makeImage (int width, int height, int channels, uint32_t seed)
+    {
+        TestImage image{width, height, channels};
+        std::mt19937 rng (seed);
+        image.pixels.resize (size_t (width) * height * channels);
+        for (auto& p : image.pixels)
+            p = static_cast<unsigned char> (rng());
+
+        stbi_write_png_to_func ([] (void* context, void* data, int size)
+                                {
+                                    auto* png = static_cast<std::vector<unsigned char>*> (context);
+                                    png->insert (png->end(), static_cast<unsigned char*> (data), static_cast<unsigned char*> (data) + size);
+                                },
+                                &image.png, width, height, channels, image.pixels.data(), width * channels);
+        return image;
+    }
+
+    bool samePixels (const CgPixelsPtr& pixels, const TestImage& image)
+    {
+        if (!pixels) return false;
+        const OIIO::ImageSpec& spec = pixels->spec();
+        if (spec.width != image.width || spec.height != image.height || spec.nchannels != image.channels) return false;
+        return std::memcmp (pixels->localpixels(), image.pixels.data(), image.pixels.size()) == 0;
+    }
+} // namespace
+
+TEST_CASE ("Pixels are decoded on first use")
+{
+    CgImageCache& cache = CgImageCache::get();
+    cache.clear();
+
+    const TestImage image = makeImage (37, 21, 3, 1);
+    CgImageSourcePtr source = CgImageSource::fromEncoded (image.png);
+
+    CHECK (source->isEmbedded());
+    CHECK_FALSE (source->isResident());
+
+    // the spec comes from the header alone
+    CHECK (source->spec().width == image.width);
+    CHECK (source->spec().height == image.height);
+    CHECK (source->spec().nchannels == image.channels);
+    CHECK_FALSE (source->isResident());
+
+    CgPixelsPtr pixels = source->pixels();
+    CHECK (samePixels (pixels, image));
+    CHECK (source->isResident());
+    CHECK (source->pixels() == pixels);
+    CHECK (cache.getResidentBytes() == image.pixels.size());
+
+    // a destroyed source takes its pixels out of the cache
+    source.reset();
+    CHECK (cache.getResidentCount() == 0);
+    CHECK (cache.getResidentBytes() == 0);
+}
+
+TEST_CASE ("The least recently used images are dropped to stay within the budget")
+{
+    CgImageCache& cache = CgImageCache::get();
+    cache.clear();
+
+    std::vector<TestImage> images;
+    std::vector<CgImageSourcePtr> sources;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        images.push_back (makeImage (32, 32, 4, i));
+        sources.push_back (CgImageSource::fromEncoded (images.back().png));
+    }
+
+    const size_t imageBytes = images[0].pixels.size();
+    cache.setBudget (imageBytes * 3);
+
+    CgPixelsPtr held = sources[0]->pixels();
+    for (auto& source : sources)
+        source->pixels();
+
+    CHECK (cache.getResidentCount() == 3);
+    CHECK (cache.getResidentBytes() <= cache.getBudget());
+    CHECK_FALSE (sources[0]->isResident());
+    CHECK (sources[7]->isResident());
+
+    // dropping never frees pixels that are still being read
+    CHECK (samePixels (held, images[0]));
+
+    // asking again decodes again
+    CgPixelsPtr again = sources[0]->pixels();
+    CHECK (again != held);
+    CHECK (samePixels (again, images[0]));
+
+    // touching an image keeps it when the next one comes in
+    sources[6]->pixels();
+    sources[1]->pixels();
+    CHECK (sources[6]->isResident());
+    CHECK_FALSE (sources[7]->isResident());
+
+    sources[6]->release();
+    CHECK_FALSE (sources[6]->isResident());
+
+    cache.trim (imageBytes);
+    CHECK (cache.getResidentCount() == 1);
+    CHECK (sources[1]->isResident());
+
+    cache.setBudget (CgImageCache::DefaultBudget);
+    cache.clear();
+    CHECK (cache.getResidentBytes() == 0);
+}
+
+TEST_CASE ("An image larger than the budget stays until the next one")
+{
+    CgImageCache& cache = CgImageCache::get();
+    cache.clear();
+    cache.setBudget (16);
+
+    const TestImage a = makeImage (16, 16, 1, 11);
+    const TestImage b = makeImage (16, 16, 1, 12);
+    CgImageSourcePtr sourceA = CgImageSource::fromEncoded (a.png);
+    CgImageSourcePtr sourceB = CgImageSource::fromEncoded (b.png);
+
+    CHECK (samePixels (sourceA->pixels(), a));
+    CHECK (sourceA->isResident());
+
+    CHECK (samePixels (sourceB->pixels(), b));
+    CHECK_FALSE (sourceA->isResident());
+    CHECK (sourceB->isResident());
+
+    cache.setBudget (CgImageCache::DefaultBudget);
+    cache.clear();
+}
+
+TEST_CASE ("Concurrent first use decodes once")
+{
+    CgImageCache& cache = CgImageCache::get();
+    cache.clear();
+
+    const TestImage image = makeImage (64, 64, 4, 21);
+    CgImageSourcePtr source = CgImageSource::fromEncoded (image.png);
+
+    std::vector<CgPixelsPtr> results (8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i)
+        threads.emplace_back ([&, i]
+                              { results[i] = source->pixels(); });
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const auto& pixels : results)
+        CHECK (pixels == results[0]);
+    CHECK (samePixels (results[0], image));
+    CHECK (cache.getResidentCount() == 1);
+
+    cache.clear();
+}
+
+TEST_CASE ("Files are read lazily and bad sources fail quietly")
+{
+    CgImageCache& cache = CgImageCache::get();
+    cache.clear();
+
+    const TestImage image = makeImage (20, 10, 3, 31);
+    const fs::path path = fs::temp_directory_path() / "CgImageCacheTest.png";
+    std::ofstream (path, std::ios::binary).write (reinterpret_cast<const char*> (image.png.data()), image.png.size());
+
+    CgImageSourcePtr file = CgImageSource::fromFile (path);
+    CHECK_FALSE (file->isEmbedded());
+    CHECK (file->getPath() == path);
+    CHECK (file->spec().width == image.width);
+    CHECK_FALSE (file->isResident());
+    CHECK (samePixels (file->pixels(), image));
+
+    CgImageSourcePtr missing = CgImageSource::fromFile (fs::temp_directory_path() / "CgImageCacheTest_missing.png");
+    CHECK (missing->spec().width == 0);
+    CHECK_FALSE (missing->pixels());
+
+    CgImageSourcePtr garbage = CgImageSource::fromEncoded ({1, 2, 3, 4});
+    CHECK_FALSE (garbage->pixels());
+    CHECK_FALSE (garbage->isResident());
+
+    file.reset();
+    CHECK (cache.getResidentCount() == 0);
+    fs::remove (path);
+}
+
+class Application : public Jahley::App
+{
+ public:
+    Application (DesktopWindowSettings settings = DesktopWindowSettings(), bool windowApp = false) :
+        Jahley::App()
+    {
+        doctest::Context().run();
+    }
+
+ private:
+};
+
+Jahley::App* Jahley::CreateApplication()
+{
+    return new Application();
+}
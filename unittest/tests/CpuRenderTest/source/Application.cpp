@@ -0,0 +1,270 @@
+#include "Jahley.h"
+
+const std::string APP_NAME = "CpuRenderTest";
+
+#ifdef CHECK
+#undef CHECK
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <doctest/doctest.h>
+
+#include <cpu_render_core/cpu_render_core.h>
+
+namespace
+{
+    constexpr float Inf = std::numeric_limits<float>::infinity();
+
+    struct Soup
+    {
+        std::vector<Eigen::Vector3f> v0;
+        std::vector<Eigen::Vector3f> v1;
+        std::vector<Eigen::Vector3f> v2;
+    };
+
+    // small random triangles scattered through [-1, 1]^3
+    Soup makeSoup (uint32_t count, uint32_t seed)
+    {
+        std::mt19937 rng (seed);
+        std::uniform_real_distribution<float> u (-1.0f, 1.0f);
+        auto point = [&]
+        { return Eigen::Vector3f (u (rng), u (rng), u (rng)); };
+
+        Soup soup;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const Eigen::Vector3f p = point();
+            soup.v0.push_back (p);
+            soup.v1.push_back (p + 0.2f * point());
+            soup.v2.push_back (p + 0.2f * point());
+        }
+        return soup;
+    }
+
+    // closest hit by testing every triangle, InvalidID on a miss
+    uint32_t bruteForce (const Soup& soup, const Eigen::Vector3f& origin, const Eigen::Vector3f& dir, float* closest)
+    {
+        uint32_t best = Bvh4::InvalidID;
+        *closest = Inf;
+        for (uint32_t i = 0; i < soup.v0.size(); ++i)
+        {
+            const Eigen::Vector3f edge1 = soup.v1[i] - soup.v0[i];
+            const Eigen::Vector3f edge2 = soup.v2[i] - soup.v0[i];
+            const Eigen::Vector3f pvec = dir.cross (edge2);
+            const float det = edge1.dot (pvec);
+            if (std::abs (det) < 1e-12f) continue;
+
+            const Eigen::Vector3f tvec = origin - soup.v0[i];
+            const float b1 = tvec.dot (pvec) / det;
+            const Eigen::Vector3f qvec = tvec.cross (edge1);
+            const float b2 = dir.dot (qvec) / det;
+            const float t = edge2.dot (qvec) / det;
+            if (b1 < 0.0f || b2 < 0.0f || b1 + b2 > 1.0f || t <= 0.0f || t >= *closest) continue;
+
+            *closest = t;
+            best = i;
+        }
+        return best;
+    }
+
+    // every ray either starts inside the soup or comes from the -x -y -z corner,
+    // half of them point along +x +y +z where infinite empty slots used to pass the slab test
+    void checkAgainstBruteForce (const Bvh4& bvh, const Soup& soup, uint32_t rayCount, uint32_t seed)
+    {
+        std::mt19937 rng (seed);
+        std::uniform_real_distribution<float> u (-1.0f, 1.0f);
+
+        uint32_t mismatches = 0;
+        uint32_t hits = 0;
+        for (uint32_t i = 0; i < rayCount; ++i)
+        {
+            Eigen::Vector3f dir (u (rng), u (rng), u (rng));
+            if (i & 1) dir = dir.cwiseAbs();
+            dir.normalize();
+
+            const Eigen::Vector3f jitter (u (rng), u (rng), u (rng));
+            const Eigen::Vector3f origin = (i & 2) ? Eigen::Vector3f (Eigen::Vector3f::Constant (-2.0f) + 0.5f * jitter) : jitter;
+
+            float expectedT;
+            const uint32_t expected = bruteForce (soup, origin, dir, &expectedT);
+
+            Bvh4::Hit hit;
+            const bool found = bvh.intersect (origin, dir, Inf, &hit);
+            if (found != (expected != Bvh4::InvalidID))
+                ++mismatches;
+            else if (found && hit.primID != expected && std::abs (hit.t - expectedT) > 1e-5f)
+                ++mismatches;
+
+            if (bvh.occluded (origin, dir, Inf) != (expected != Bvh4::InvalidID))
+                ++mismatches;
+
+            hits += found ? 1 : 0;
+        }
+
+        CHECK (mismatches == 0);
+        CHECK (hits > 0);
+    }
+
+    sabi::RenderableNode makeCubeNode()
+    {
+        sabi::RenderableNode node = sabi::WorldItem::create();
+        node->setName ("cube");
+        node->setModel (sabi::MeshOps::createCube (1.0f));
+        return node;
+    }
+
+    sabi::CameraHandle makeCamera (uint32_t width, uint32_t height, const Eigen::Vector3f& eye)
+    {
+        sabi::CameraHandle camera = std::make_shared<sabi::CameraBody>();
+        camera->getSensor()->setPixelResolution (width, height);
+        camera->setFocalLength (0.055f);
+        camera->lookAt (eye, Eigen::Vector3f::Zero(), Eigen::Vector3f::UnitY());
+        return camera;
+    }
+
+    const float* pixel (const CpuRendererPtr& renderer, uint32_t x, uint32_t y)
+    {
+        return &renderer->getPixels()[(static_cast<size_t> (y) * renderer->getResolution().x() + x) * 4];
+    }
+} // namespace
+
+TEST_CASE ("Bvh4 skips empty child slots")
+{
+    // one triangle is a single leaf under the root, the other three slots are empty
+    Soup soup;
+    soup.v0.push_back (Eigen::Vector3f (0.0f, 0.0f, 0.0f));
+    soup.v1.push_back (Eigen::Vector3f (1.0f, 0.0f, 0.0f));
+    soup.v2.push_back (Eigen::Vector3f (0.0f, 1.0f, 0.0f));
+
+    Bvh4 bvh;
+    bvh.build (soup.v0, soup.v1, soup.v2);
+    CHECK (bvh.nodeCount() == 1);
+    CHECK (bvh.triangleCount() == 1);
+
+    // +x +y +z with no limit on t used to walk into the empty slots
+    const Eigen::Vector3f diagonal = Eigen::Vector3f::Ones().normalized();
+    Bvh4::Hit hit;
+    CHECK_FALSE (bvh.intersect (Eigen::Vector3f (5.0f, 5.0f, 5.0f), diagonal, Inf, &hit));
+    CHECK_FALSE (bvh.occluded (Eigen::Vector3f (5.0f, 5.0f, 5.0f), diagonal, Inf));
+
+    const Eigen::Vector3f up = Eigen::Vector3f (0.01f, 0.01f, 1.0f).normalized();
+    REQUIRE (bvh.intersect (Eigen::Vector3f (0.25f, 0.25f, -1.0f), up, Inf, &hit));
+    CHECK (hit.primID == 0);
+    CHECK (hit.t == doctest::Approx (1.0f / up.z()));
+    CHECK (bvh.occluded (Eigen::Vector3f (0.25f, 0.25f, -1.0f), up, Inf));
+    CHECK_FALSE (bvh.occluded (Eigen::Vector3f (0.25f, 0.25f, -1.0f), up, 0.5f));
+}
+
+TEST_CASE ("Bvh4 finds the same closest hit as a brute force search")
+{
+    // small counts leave partly filled nodes, the large one is split across the pool
+    for (uint32_t count : {2u, 3u, 5u, 9u, 50u})
+    {
+        CAPTURE (count);
+        const Soup soup = makeSoup (count, count);
+        Bvh4 bvh;
+        bvh.build (soup.v0, soup.v1, soup.v2);
+        checkAgainstBruteForce (bvh, soup, 4000, count + 100);
+    }
+
+    const Soup soup = makeSoup (20000, 7);
+    BS::thread_pool pool (4);
+    Bvh4 bvh;
+    bvh.build (soup.v0, soup.v1, soup.v2, &pool);
+    CHECK (bvh.triangleCount() == soup.v0.size());
+    checkAgainstBruteForce (bvh, soup, 500, 8);
+}
+
+TEST_CASE ("Bvh4 with no triangles never hits")
+{
+    Bvh4 bvh;
+    bvh.build ({}, {}, {});
+    CHECK (bvh.empty());
+
+    Bvh4::Hit hit;
+    CHECK_FALSE (bvh.intersect (Eigen::Vector3f::Zero(), Eigen::Vector3f::UnitZ(), Inf, &hit));
+    CHECK_FALSE (bvh.occluded (Eigen::Vector3f::Zero(), Eigen::Vector3f::UnitZ(), Inf));
+}
+
+TEST_CASE ("CpuRenderer shades the cube and shows the environment around it")
+{
+    CpuScenePtr scene = CpuScene::create();
+    scene->addRenderable (makeCubeNode());
+    scene->setEnvironmentColor (RGBf::Constant (1.0f));
+    CHECK (scene->triangleCount() == 12);
+
+    CpuRenderer::Settings settings;
+    settings.threadCount = 2;
+    settings.tileSize = 8;
+    CpuRendererPtr renderer = CpuRenderer::create (settings);
+    renderer->setScene (scene);
+
+    // camera rays from the -x -y -z side all travel along +x +y +z
+    sabi::CameraHandle camera = makeCamera (24, 16, Eigen::Vector3f (-3.0f, -3.0f, -3.0f));
+    CHECK (renderer->render (camera, 4) == 4);
+    CHECK (renderer->getResolution() == Eigen::Vector2i (24, 16));
+
+    for (float value : renderer->getPixels())
+        CHECK (std::isfinite (value));
+
+    // a corner misses and sees the constant environment unweighted
+    const float* corner = pixel (renderer, 0, 0);
+    CHECK (corner[0] == doctest::Approx (1.0f));
+    CHECK (corner[3] == 1.0f);
+
+    // the middle of the frame is the grey cube, darker than the light it reflects
+    const float* centre = pixel (renderer, 12, 8);
+    CHECK (centre[0] > 0.0f);
+    CHECK (centre[0] < 0.95f);
+}
+
+TEST_CASE ("CpuRenderer restarts accumulation when the camera moves")
+{
+    CpuScenePtr scene = CpuScene::create();
+    scene->addRenderable (makeCubeNode());
+    scene->setEnvironmentColor (RGBf::Constant (1.0f));
+
+    CpuRenderer::Settings settings;
+    settings.threadCount = 2;
+    CpuRendererPtr renderer = CpuRenderer::create (settings);
+    renderer->setScene (scene);
+
+    sabi::CameraHandle camera = makeCamera (16, 16, Eigen::Vector3f (2.0f, 1.5f, 3.0f));
+    CHECK (renderer->render (camera, 3) == 3);
+    CHECK (renderer->renderPass (camera) == 4);
+
+    camera->lookAt (Eigen::Vector3f (-2.0f, 1.5f, 3.0f), Eigen::Vector3f::Zero(), Eigen::Vector3f::UnitY());
+    CHECK (renderer->renderPass (camera) == 1);
+
+    camera->getSensor()->setPixelResolution (8, 8);
+    CHECK (renderer->renderPass (camera) == 1);
+    CHECK (renderer->getPixels().size() == 8 * 8 * 4);
+
+    std::atomic<bool> cancel = true;
+    CHECK (renderer->render (camera, 10, &cancel) == 1);
+}
+
+TEST_CASE ("CpuRenderer without a scene does nothing")
+{
+    CpuRendererPtr renderer = CpuRenderer::create();
+    sabi::CameraHandle camera = makeCamera (8, 8, Eigen::Vector3f (0.0f, 0.0f, 5.0f));
+    CHECK (renderer->renderPass (camera) == 0);
+    CHECK (renderer->getPixels().empty());
+}
+
+class Application : public Jahley::App
+{
+ public:
+    Application (DesktopWindowSettings settings = DesktopWindowSettings(), bool windowApp = false) :
+        Jahley::App()
+    {
+        doctest::Context().run();
+    }
+
+ private:
+};
+
+Jahley::App* Jahley::CreateApplication()
+{
+    return new Application();
+}
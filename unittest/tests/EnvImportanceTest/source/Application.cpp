@@ -0,0 +1,273 @@
+#include "Jahley.h"
+
+const std::string APP_NAME = "EnvImportanceTest";
+
+#ifdef CHECK
+#undef CHECK
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <doctest/doctest.h>
+
+#include <mace_core/mace_core.h>
+#include <dog_core/excludeFromBuild/tools/EnvImportanceMap.h>
+
+// deterministic RGBA test map with a few bright spots over a dim gradient
+static std::vector<float> makeEnvMap (uint32_t width, uint32_t height, uint32_t seed = 7)
+{
+    std::mt19937 rng (seed);
+    std::uniform_real_distribution<float> noise (0.0f, 0.25f);
+
+    std::vector<float> texels (static_cast<size_t> (width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            float* t = &texels[(static_cast<size_t> (y) * width + x) * 4];
+            const float base = 0.05f + 0.5f * static_cast<float> (y) / height + noise (rng);
+            t[0] = base;
+            t[1] = base * 0.8f;
+            t[2] = base * 0.6f;
+            t[3] = 1.0f;
+        }
+    }
+
+    // a sun and a couple of softer lights
+    auto spot = [&] (uint32_t x, uint32_t y, float value)
+    {
+        float* t = &texels[(static_cast<size_t> (y) * width + x) * 4];
+        t[0] = t[1] = t[2] = value;
+    };
+    spot (width / 4, height / 3, 500.0f);
+    spot (width / 2, height / 2, 50.0f);
+    spot (3 * width / 4, height / 5, 20.0f);
+
+    // negative texels must be ignored
+    texels[0] = -10.0f;
+
+    return texels;
+}
+
+// straightforward serial build of the luminance * sin(theta) weights, in double
+static std::vector<double> referenceWeights (const std::vector<float>& texels, uint32_t width, uint32_t height)
+{
+    std::vector<double> weights (static_cast<size_t> (width) * height);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const double sinTheta = std::sin (std::numbers::pi * (y + 0.5) / height);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            const float* t = &texels[(static_cast<size_t> (y) * width + x) * 4];
+            const double lum = 0.2126729 * std::max (t[0], 0.0f) +
+                               0.7151522 * std::max (t[1], 0.0f) +
+                               0.0721750 * std::max (t[2], 0.0f);
+            weights[static_cast<size_t> (y) * width + x] = lum * sinTheta;
+        }
+    }
+    return weights;
+}
+
+TEST_CASE ("Parallel build matches a serial reference")
+{
+    const uint32_t width = 256;
+    const uint32_t height = 128;
+    std::vector<float> texels = makeEnvMap (width, height);
+    std::vector<double> reference = referenceWeights (texels, width, height);
+
+    EnvImportanceMap map;
+    map.build (texels.data(), width, height);
+
+    REQUIRE (map.width() == width);
+    REQUIRE (map.height() == height);
+    CHECK (map.reductionFactor() == 1);
+
+    double total = 0.0;
+    for (double w : reference)
+        total += w;
+    const double integral = total / (static_cast<double> (width) * height);
+    CHECK (map.integral() == doctest::Approx (integral).epsilon (1e-4));
+
+    // the joint PDF of every cell is weight / integral
+    for (uint32_t y = 0; y < height; y += 7)
+    {
+        for (uint32_t x = 0; x < width; x += 5)
+        {
+            const float d0 = (x + 0.5f) / width;
+            const float d1 = (y + 0.5f) / height;
+            const double expected = reference[static_cast<size_t> (y) * width + x] / integral;
+            CHECK (map.evaluatePDF (d0, d1) == doctest::Approx (expected).epsilon (1e-3));
+        }
+    }
+}
+
+TEST_CASE ("Distributions are normalized")
+{
+    const uint32_t width = 512;
+    const uint32_t height = 256;
+    std::vector<float> texels = makeEnvMap (width, height);
+
+    EnvImportanceMap map;
+    map.build (texels.data(), width, height);
+
+    // PDFs average to one over their domain and CDFs run from 0 to 1 without going backwards
+    auto checkDistribution = [] (const float* pdf, const float* cdf, uint32_t n)
+    {
+        double sum = 0.0;
+        for (uint32_t i = 0; i < n; ++i)
+            sum += pdf[i];
+        CHECK (sum / n == doctest::Approx (1.0).epsilon (1e-4));
+
+        CHECK (cdf[0] == 0.0f);
+        CHECK (cdf[n] == 1.0f);
+        bool monotonic = true;
+        for (uint32_t i = 0; i < n; ++i)
+            monotonic = monotonic && cdf[i] <= cdf[i + 1];
+        CHECK (monotonic);
+    };
+
+    checkDistribution (map.rowMarginalPDF().data(), map.rowMarginalCDF().data(), map.height());
+    for (uint32_t row = 0; row < map.height(); row += 17)
+        checkDistribution (map.rowPDF (row), map.rowCDF (row), map.width());
+}
+
+TEST_CASE ("Sampling agrees with evaluatePDF and the texel weights")
+{
+    const uint32_t width = 64;
+    const uint32_t height = 32;
+    std::vector<float> texels = makeEnvMap (width, height, 11);
+    std::vector<double> reference = referenceWeights (texels, width, height);
+
+    EnvImportanceMap map;
+    map.build (texels.data(), width, height);
+
+    double total = 0.0;
+    for (double w : reference)
+        total += w;
+
+    const uint32_t numSamples = 1 << 20;
+    std::vector<uint32_t> histogram (static_cast<size_t> (width) * height, 0);
+
+    std::mt19937 rng (1234);
+    std::uniform_real_distribution<float> uniform (0.0f, 1.0f);
+    uint32_t pdfMismatches = 0;
+    for (uint32_t i = 0; i < numSamples; ++i)
+    {
+        float d0, d1, pdf;
+        map.sample (uniform (rng), uniform (rng), &d0, &d1, &pdf);
+
+        REQUIRE (d0 >= 0.0f);
+        REQUIRE (d0 <= 1.0f);
+        REQUIRE (d1 >= 0.0f);
+        REQUIRE (d1 <= 1.0f);
+
+        const float evaluated = map.evaluatePDF (d0, d1);
+        if (std::abs (evaluated - pdf) > 1e-4f * std::max (1.0f, pdf))
+            ++pdfMismatches;
+
+        const uint32_t x = std::min (static_cast<uint32_t> (d0 * width), width - 1);
+        const uint32_t y = std::min (static_cast<uint32_t> (d1 * height), height - 1);
+        ++histogram[static_cast<size_t> (y) * width + x];
+    }
+    // float rounding can land a sample exactly on the next cell's edge, same as on the device
+    CHECK (pdfMismatches <= numSamples / 10000);
+
+    // every cell with a meaningful share of the energy is hit in proportion to it
+    for (size_t i = 0; i < histogram.size(); ++i)
+    {
+        const double expected = reference[i] / total;
+        if (expected * numSamples < 200.0) continue;
+
+        const double observed = static_cast<double> (histogram[i]) / numSamples;
+        CHECK (observed == doctest::Approx (expected).epsilon (0.15));
+    }
+}
+
+TEST_CASE ("Reduced maps keep the integral and the bright regions")
+{
+    const uint32_t width = 1024;
+    const uint32_t height = 512;
+    std::vector<float> texels = makeEnvMap (width, height);
+
+    EnvImportanceMap full;
+    full.build (texels.data(), width, height);
+
+    BS::thread_pool pool;
+    EnvImportanceMap reduced;
+    reduced.build (texels.data(), width, height, 4, 256, &pool);
+
+    CHECK (reduced.reductionFactor() == 4);
+    CHECK (reduced.width() == 256);
+    CHECK (reduced.height() == 128);
+    CHECK (reduced.integral() == doctest::Approx (full.integral()).epsilon (1e-3));
+
+    // the sun's cell must be the most likely one
+    const auto& weights = reduced.weights();
+    const size_t brightest = std::max_element (weights.begin(), weights.end()) - weights.begin();
+    CHECK (brightest % reduced.width() == (width / 4) / 4);
+    CHECK (brightest / reduced.width() == (height / 3) / 4);
+}
+
+TEST_CASE ("Black maps fall back to uniform sampling")
+{
+    const uint32_t width = 32;
+    const uint32_t height = 16;
+    std::vector<float> texels (static_cast<size_t> (width) * height * 4, 0.0f);
+
+    EnvImportanceMap map;
+    map.build (texels.data(), width, height);
+
+    CHECK (map.integral() == 0.0f);
+
+    std::mt19937 rng (99);
+    std::uniform_real_distribution<float> uniform (0.0f, 1.0f);
+    for (int i = 0; i < 1000; ++i)
+    {
+        float d0, d1, pdf;
+        map.sample (uniform (rng), uniform (rng), &d0, &d1, &pdf);
+        REQUIRE (std::isfinite (d0));
+        REQUIRE (std::isfinite (d1));
+        CHECK (pdf == doctest::Approx (1.0f));
+    }
+}
+
+TEST_CASE ("A single bright texel takes every sample")
+{
+    const uint32_t width = 128;
+    const uint32_t height = 64;
+    std::vector<float> texels (static_cast<size_t> (width) * height * 4, 0.0f);
+    const uint32_t sx = 37;
+    const uint32_t sy = 21;
+    float* t = &texels[(static_cast<size_t> (sy) * width + sx) * 4];
+    t[0] = t[1] = t[2] = 1000.0f;
+
+    EnvImportanceMap map;
+    map.build (texels.data(), width, height);
+
+    std::mt19937 rng (5);
+    std::uniform_real_distribution<float> uniform (0.0f, 1.0f);
+    for (int i = 0; i < 1000; ++i)
+    {
+        float d0, d1, pdf;
+        map.sample (uniform (rng), uniform (rng), &d0, &d1, &pdf);
+        CHECK (std::min (static_cast<uint32_t> (d0 * width), width - 1) == sx);
+        CHECK (std::min (static_cast<uint32_t> (d1 * height), height - 1) == sy);
+        CHECK (pdf == doctest::Approx (static_cast<float> (width) * height));
+    }
+}
+
+class Application : public Jahley::App
+{
+ public:
+    Application (DesktopWindowSettings settings = DesktopWindowSettings(), bool windowApp = false) :
+        Jahley::App()
+    {
+        doctest::Context().run();
+    }
+
+ private:
+};
+
+Jahley::App* Jahley::CreateApplication()
+{
+    return new Application();
+}
@@ -0,0 +1,230 @@
+#include "Jahley.h"
+
+const std::string APP_NAME = "KernelCacheTest";
+
+#ifdef CHECK
+#undef CHECK
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <doctest/doctest.h>
+
+#include <mace_core/mace_core.h>
+#include <dog_core/excludeFromBuild/nvcc/KernelBuildCache.h>
+
+namespace
+{
+    // a throw away kernel tree: a.cu -> a.h -> shared.h, b.cu -> shared.h, c.cu stands alone
+    struct KernelTree
+    {
+        fs::path root = fs::temp_directory_path() / ("kernel_cache_" + std::to_string (std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::path out = root / "out";
+
+        KernelTree()
+        {
+            fs::create_directories (root / "include");
+            fs::create_directories (out);
+            write ("a.cu", "\xEF\xBB\xBF#include \"a.h\"\n__global__ void a() {}\n");
+            write ("include/a.h", "#pragma once\n#  include <shared.h>\n");
+            write ("include/shared.h", "#pragma once\n#include <cuda.h>\n// #include \"missing.h\"\n");
+            write ("b.cu", "#include <shared.h>\n__global__ void b() {}\n");
+            write ("c.cu", "__global__ void c() {}\n");
+        }
+
+        ~KernelTree()
+        {
+            std::error_code ec;
+            fs::remove_all (root, ec);
+        }
+
+        void write (const std::string& name, const std::string& text) const
+        {
+            std::ofstream (root / name, std::ios::binary) << text;
+        }
+
+        std::vector<KernelBuildCache::Job> jobs (const std::string& flag = "-O3") const
+        {
+            std::vector<KernelBuildCache::Job> result;
+            for (const char* name : {"a", "b", "c"})
+            {
+                KernelBuildCache::Job job;
+                job.source = root / (std::string (name) + ".cu");
+                job.output = out / (std::string (name) + ".ptx");
+                job.args = {"nvcc", job.source.string(), flag, "--output-file", job.output.string()};
+                result.push_back (job);
+            }
+            return result;
+        }
+
+        void open (KernelBuildCache& cache) const
+        {
+            cache.setIncludeFolders ({root / "include"});
+            cache.load (out / "build_cache.json");
+        }
+    };
+
+    // stand in compiler, writes the output and remembers what it was asked to build
+    struct FakeCompiler
+    {
+        std::mutex mutex;
+        std::set<std::string> built;
+        std::atomic<int> running = 0;
+        std::atomic<int> peak = 0;
+        std::string failOn;
+
+        int operator() (const KernelBuildCache::Job& job)
+        {
+            const int now = ++running;
+            int expected = peak.load();
+            while (now > expected && !peak.compare_exchange_weak (expected, now))
+            {
+            }
+            std::this_thread::sleep_for (std::chrono::milliseconds (20));
+            --running;
+
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+                built.insert (job.source.stem().string());
+            }
+            if (job.source.stem().string() == failOn) return 1;
+
+            std::ofstream (job.output) << "ptx";
+            return 0;
+        }
+
+        KernelBuildCache::Launcher launcher()
+        {
+            return [this] (const KernelBuildCache::Job& job)
+            { return (*this) (job); };
+        }
+    };
+} // namespace
+
+TEST_CASE ("Includes are followed through quoted and angle includes")
+{
+    KernelTree tree;
+    KernelBuildCache cache;
+    tree.open (cache);
+
+    const auto includes = cache.scanIncludes (tree.root / "a.cu");
+    REQUIRE (includes.size() == 1);
+    CHECK (includes[0].filename() == "a.h");
+
+    // <shared.h> resolves through the include folder, <cuda.h> and commented includes are ignored
+    const auto nested = cache.scanIncludes (includes[0]);
+    REQUIRE (nested.size() == 1);
+    CHECK (nested[0].filename() == "shared.h");
+    CHECK (cache.scanIncludes (nested[0]).empty());
+}
+
+TEST_CASE ("Only stale kernels are rebuilt")
+{
+    KernelTree tree;
+
+    {
+        FakeCompiler nvcc;
+        KernelBuildCache cache;
+        tree.open (cache);
+        auto stats = cache.run (tree.jobs(), nvcc.launcher());
+        CHECK (stats.built == 3);
+        CHECK (stats.upToDate == 0);
+    }
+
+    SUBCASE ("nothing changed")
+    {
+        FakeCompiler nvcc;
+        KernelBuildCache cache;
+        tree.open (cache);
+        auto stats = cache.run (tree.jobs(), nvcc.launcher());
+        CHECK (stats.built == 0);
+        CHECK (stats.upToDate == 3);
+        CHECK (nvcc.built.empty());
+    }
+
+    SUBCASE ("an edit to a nested header rebuilds every kernel that includes it")
+    {
+        tree.write ("include/shared.h", "#pragma once\n#define SHARED 2\n");
+        FakeCompiler nvcc;
+        KernelBuildCache cache;
+        tree.open (cache);
+        auto stats = cache.run (tree.jobs(), nvcc.launcher());
+        CHECK (stats.built == 2);
+        CHECK (nvcc.built == std::set<std::string> {"a", "b"});
+    }
+
+    SUBCASE ("a touched file with the same content is not rebuilt")
+    {
+        fs::last_write_time (tree.root / "c.cu", fs::file_time_type::clock::now());
+        FakeCompiler nvcc;
+        KernelBuildCache cache;
+        tree.open (cache);
+        CHECK (cache.run (tree.jobs(), nvcc.launcher()).built == 0);
+    }
+
+    SUBCASE ("different flags rebuild everything")
+    {
+        FakeCompiler nvcc;
+        KernelBuildCache cache;
+        tree.open (cache);
+        CHECK (cache.run (tree.jobs ("-G"), nvcc.launcher()).built == 3);
+    }
+
+    SUBCASE ("a missing output is rebuilt")
+    {
+        fs::remove (tree.out / "c.ptx");
+        FakeCompiler nvcc;
+        KernelBuildCache cache;
+        tree.open (cache);
+        cache.run (tree.jobs(), nvcc.launcher());
+        CHECK (nvcc.built == std::set<std::string> {"c"});
+    }
+}
+
+TEST_CASE ("Failed kernels are retried on the next run")
+{
+    KernelTree tree;
+    {
+        FakeCompiler nvcc;
+        nvcc.failOn = "b";
+        KernelBuildCache cache;
+        tree.open (cache);
+        auto stats = cache.run (tree.jobs(), nvcc.launcher());
+        CHECK (stats.built == 2);
+        CHECK (stats.failed == 1);
+    }
+
+    FakeCompiler nvcc;
+    KernelBuildCache cache;
+    tree.open (cache);
+    auto stats = cache.run (tree.jobs(), nvcc.launcher());
+    CHECK (stats.built == 1);
+    CHECK (nvcc.built == std::set<std::string> {"b"});
+}
+
+TEST_CASE ("Jobs run in parallel up to the limit")
+{
+    KernelTree tree;
+    FakeCompiler nvcc;
+    KernelBuildCache cache;
+    tree.open (cache);
+    cache.run (tree.jobs(), nvcc.launcher(), 2);
+    CHECK (nvcc.peak.load() <= 2);
+    CHECK (nvcc.built.size() == 3);
+}
+
+class Application : public Jahley::App
+{
+ public:
+    Application (DesktopWindowSettings settings = DesktopWindowSettings(), bool windowApp = false) :
+        Jahley::App()
+    {
+        doctest::Context().run();
+    }
+
+ private:
+};
+
+Jahley::App* Jahley::CreateApplication()
+{
+    return new Application();
+}
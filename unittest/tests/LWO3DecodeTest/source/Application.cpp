@@ -0,0 +1,153 @@
+#include "Jahley.h"
+
+const std::string APP_NAME = "LWO3DecodeTest";
+
+#ifdef CHECK
+#undef CHECK
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <doctest/doctest.h>
+
+#include <sabi_core/sabi_core.h>
+
+using sabi::LWO3Decoder;
+
+namespace
+{
+    // the scalar path the decoder replaces
+    BinaryReader readerFor (std::vector<uint8_t>& bytes)
+    {
+        return BinaryReader (reinterpret_cast<char*> (bytes.data()), static_cast<uint32_t> (bytes.size()));
+    }
+
+    std::vector<uint8_t> randomBytes (size_t count, uint32_t seed)
+    {
+        std::mt19937 rng (seed);
+        std::vector<uint8_t> bytes (count);
+        for (auto& b : bytes)
+            b = static_cast<uint8_t> (rng());
+        return bytes;
+    }
+
+    void putVX (std::vector<uint8_t>& out, uint32_t index)
+    {
+        if (index < 0xFF00)
+        {
+            out.push_back (static_cast<uint8_t> (index >> 8));
+            out.push_back (static_cast<uint8_t> (index));
+        }
+        else
+        {
+            out.push_back (0xFF);
+            out.push_back (static_cast<uint8_t> (index >> 16));
+            out.push_back (static_cast<uint8_t> (index >> 8));
+            out.push_back (static_cast<uint8_t> (index));
+        }
+    }
+} // namespace
+
+TEST_CASE ("Bulk float decode matches swapFloat bit for bit")
+{
+    // every length around the vector widths, random bits include NaNs and denormals
+    for (size_t count = 0; count < 40; ++count)
+    {
+        CAPTURE (count);
+        std::vector<uint8_t> bytes = randomBytes (count * 4 + 3, static_cast<uint32_t> (count));
+
+        // unaligned source
+        std::span<const uint8_t> data (bytes.data() + 3, count * 4);
+        std::vector<float> bulk (count);
+        LWO3Decoder decoder (data);
+        decoder.floats (bulk.data(), count);
+        CHECK (decoder.atEnd());
+        CHECK_FALSE (decoder.overrun());
+
+        std::vector<uint8_t> copy (data.begin(), data.end());
+        BinaryReader reader = readerFor (copy);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float scalar = mace::swapFloat (reader.ReadFloat());
+            CHECK (std::bit_cast<uint32_t> (bulk[i]) == std::bit_cast<uint32_t> (scalar));
+        }
+
+        // in place, as the vertex maps use it
+        std::vector<float> inPlace (count);
+        std::memcpy (inPlace.data(), data.data(), count * 4);
+        LWO3Decoder::swapFloats (inPlace.data(), inPlace.data(), count);
+        CHECK (std::memcmp (inPlace.data(), bulk.data(), count * 4) == 0);
+    }
+}
+
+TEST_CASE ("Bulk VX decode matches readVX")
+{
+    std::mt19937 rng (7);
+    for (int longEvery : {0, 3, 17})
+    {
+        CAPTURE (longEvery);
+
+        // runs of 2 byte indices broken up by 4 byte ones
+        std::vector<uint32_t> indices;
+        for (int i = 0; i < 200; ++i)
+        {
+            const bool isLong = longEvery && i % longEvery == 0;
+            indices.push_back (isLong ? 0xFF00 + rng() % 0xF00000 : rng() % 0xFF00);
+        }
+
+        std::vector<uint8_t> bytes;
+        for (uint32_t index : indices)
+            putVX (bytes, index);
+
+        std::vector<uint32_t> bulk (indices.size());
+        LWO3Decoder decoder (bytes);
+        decoder.vxIndices (bulk.data(), bulk.size());
+        CHECK (decoder.atEnd());
+        CHECK (bulk == indices);
+
+        BinaryReader reader = readerFor (bytes);
+        for (size_t i = 0; i < indices.size(); ++i)
+            CHECK (mace::readVX (reader) == bulk[i]);
+    }
+}
+
+TEST_CASE ("Reads past the end stop at the end")
+{
+    std::vector<uint8_t> bytes = {0x00, 0x05, 0xFF, 0x01};
+    LWO3Decoder decoder (bytes);
+
+    uint32_t out[4] = {};
+    decoder.vxIndices (out, 2);
+    CHECK (out[0] == 5);
+    CHECK (out[1] == 0);
+    CHECK (decoder.overrun());
+    CHECK (decoder.atEnd());
+    CHECK (decoder.u32() == 0);
+}
+
+TEST_CASE ("Strings skip their padding")
+{
+    std::vector<uint8_t> bytes = {'u', 'v', 0, 0, 'a', 'b', 'c', 0, 0x12, 0x34};
+    LWO3Decoder decoder (bytes);
+    CHECK (decoder.string() == "uv");
+    CHECK (decoder.position() == 4);
+    CHECK (decoder.string() == "abc");
+    CHECK (decoder.u16() == 0x1234);
+    CHECK (decoder.atEnd());
+}
+
+class Application : public Jahley::App
+{
+ public:
+    Application (DesktopWindowSettings settings = DesktopWindowSettings(), bool windowApp = false) :
+        Jahley::App()
+    {
+        doctest::Context().run();
+    }
+
+ private:
+};
+
+Jahley::App* Jahley::CreateApplication()
+{
+    return new Application();
+}
@@ -0,0 +1,296 @@
+#include "Jahley.h"
+
+const std::string APP_NAME = "LWO3UVTest";
+
+#ifdef CHECK
+#undef CHECK
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <doctest/doctest.h>
+
+#include <sabi_core/sabi_core.h>
+
+using sabi::LWO3Reader;
+using sabi::LWO3ToCgModelConverter;
+namespace LWO = sabi::LWO;
+
+namespace
+{
+    // Writes just enough big endian LWO3 for one layer with UV maps
+    class LwoWriter
+    {
+     public:
+        static void u16 (std::string& out, uint32_t v)
+        {
+            out.push_back (char ((v >> 8) & 0xff));
+            out.push_back (char (v & 0xff));
+        }
+
+        static void u32 (std::string& out, uint32_t v)
+        {
+            u16 (out, v >> 16);
+            u16 (out, v);
+        }
+
+        static void f32 (std::string& out, float f) { u32 (out, std::bit_cast<uint32_t> (f)); }
+
+        // null terminated and padded to an even length
+        static void str (std::string& out, const std::string& s)
+        {
+            out += s;
+            out.push_back (0);
+            if (s.size() % 2 == 0) out.push_back (0);
+        }
+
+        void chunk (uint32_t id, const std::string& payload)
+        {
+            u32 (body_, id);
+            u32 (body_, static_cast<uint32_t> (payload.size()));
+            body_ += payload;
+            if (payload.size() % 2) body_.push_back (0);
+        }
+
+        fs::path save (const std::string& name) const
+        {
+            std::string file;
+            u32 (file, LWO::FORM);
+            u32 (file, static_cast<uint32_t> (body_.size() + 4));
+            u32 (file, LWO::LWO3);
+            file += body_;
+
+            const fs::path path = fs::temp_directory_path() / name;
+            std::ofstream (path, std::ios::binary).write (file.data(), file.size());
+            return path;
+        }
+
+     private:
+        std::string body_;
+    };
+
+    struct UV
+    {
+        uint32_t vertex;
+        float u, v;
+    };
+
+    struct CornerUV
+    {
+        uint32_t polygon;
+        uint32_t vertex;
+        float u, v;
+    };
+
+    // 3 x 2 grid of points and two quads, like a strip wrapped around a cylinder
+    struct Strip
+    {
+        std::vector<Eigen::Vector3f> points;
+        std::vector<std::vector<uint32_t>> polygons = {{0, 1, 4, 3}, {1, 2, 5, 4}};
+
+        // per vertex and per corner values for each named map, as written to the file
+        std::vector<std::pair<std::string, std::vector<UV>>> vmaps;
+        std::vector<std::pair<std::string, std::vector<CornerUV>>> vmads;
+
+        Strip()
+        {
+            for (int row = 0; row < 2; ++row)
+                for (int col = 0; col < 3; ++col)
+                    points.emplace_back (float (col), float (row), 0.0f);
+        }
+
+        fs::path save (const std::string& name) const
+        {
+            LwoWriter lwo;
+
+            std::string layr;
+            LwoWriter::u16 (layr, 0);
+            LwoWriter::u16 (layr, 0);
+            for (int i = 0; i < 3; ++i)
+                LwoWriter::f32 (layr, 0.0f);
+            LwoWriter::str (layr, "Strip");
+            lwo.chunk (LWO::LAYR, layr);
+
+            std::string pnts;
+            for (const auto& p : points)
+                for (int i = 0; i < 3; ++i)
+                    LwoWriter::f32 (pnts, p[i]);
+            lwo.chunk (LWO::PNTS, pnts);
+
+            std::string pols;
+            LwoWriter::u32 (pols, LWO::FACE);
+            for (const auto& polygon : polygons)
+            {
+                LwoWriter::u16 (pols, static_cast<uint32_t> (polygon.size()));
+                for (uint32_t index : polygon)
+                    LwoWriter::u16 (pols, index);
+            }
+            lwo.chunk (LWO::POLS, pols);
+
+            for (const auto& [mapName, values] : vmaps)
+            {
+                std::string vmap;
+                LwoWriter::u32 (vmap, LWO::TXUV);
+                LwoWriter::u16 (vmap, 2);
+                LwoWriter::str (vmap, mapName);
+                for (const auto& uv : values)
+                {
+                    LwoWriter::u16 (vmap, uv.vertex);
+                    LwoWriter::f32 (vmap, uv.u);
+                    LwoWriter::f32 (vmap, uv.v);
+                }
+                lwo.chunk (LWO::VMAP, vmap);
+            }
+
+            for (const auto& [mapName, values] : vmads)
+            {
+                std::string vmad;
+                LwoWriter::u32 (vmad, LWO::TXUV);
+                LwoWriter::u16 (vmad, 2);
+                LwoWriter::str (vmad, mapName);
+                for (const auto& uv : values)
+                {
+                    LwoWriter::u16 (vmad, uv.vertex);
+                    LwoWriter::u16 (vmad, uv.polygon);
+                    LwoWriter::f32 (vmad, uv.u);
+                    LwoWriter::f32 (vmad, uv.v);
+                }
+                lwo.chunk (LWO::VMAD, vmad);
+            }
+
+            return lwo.save (name);
+        }
+
+        // the UV a corner should end up with, V is flipped on import
+        Eigen::Vector2f expected (size_t map, uint32_t polygon, uint32_t vertex) const
+        {
+            const std::string& mapName = vmaps[map].first;
+            for (const auto& [vmadName, values] : vmads)
+            {
+                if (vmadName != mapName) continue;
+                for (const auto& uv : values)
+                    if (uv.polygon == polygon && uv.vertex == vertex) return {uv.u, 1.0f - uv.v};
+            }
+            for (const auto& uv : vmaps[map].second)
+                if (uv.vertex == vertex) return {uv.u, 1.0f - uv.v};
+            return Eigen::Vector2f::Zero();
+        }
+    };
+
+    sabi::CgModelPtr load (const Strip& strip, const std::string& name)
+    {
+        const fs::path path = strip.save (name);
+
+        LWO3Reader reader;
+        REQUIRE (reader.read (path));
+        REQUIRE (reader.getLayers().size() == 1);
+
+        LWO3ToCgModelConverter converter (LWO3ToCgModelConverter::ConversionFlags::StandardGeometry);
+        sabi::CgModelPtr model = converter.convert (reader.getLayers()[0].get());
+        REQUIRE (model);
+        REQUIRE (model->S.size() == 1);
+        REQUIRE (model->S[0].F.cols() == 4);
+        return model;
+    }
+
+    // every triangle corner carries the UVs of its source polygon corner
+    void checkCorners (const Strip& strip, const sabi::CgModelPtr& model)
+    {
+        const MatrixXu& F = model->S[0].F;
+        for (Eigen::Index t = 0; t < F.cols(); ++t)
+        {
+            const uint32_t polygon = static_cast<uint32_t> (t / 2); // quads give 2 triangles each, in order
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint32_t index = F (k, t);
+                CAPTURE (t);
+                CAPTURE (k);
+
+                // split vertices are copies, so the position finds the source vertex
+                const auto& corners = strip.polygons[polygon];
+                auto source = std::find_if (corners.begin(), corners.end(), [&] (uint32_t v)
+                                            { return model->V.col (index).isApprox (strip.points[v]); });
+                REQUIRE (source != corners.end());
+
+                CHECK (model->UV0.col (index).isApprox (strip.expected (0, polygon, *source)));
+                if (strip.vmaps.size() > 1)
+                    CHECK (model->UV1.col (index).isApprox (strip.expected (1, polygon, *source)));
+            }
+        }
+    }
+
+    std::vector<UV> gridUVs (float uScale, float vScale)
+    {
+        std::vector<UV> uvs;
+        for (uint32_t i = 0; i < 6; ++i)
+            uvs.push_back ({i, (i % 3) * uScale, (i / 3) * vScale});
+        return uvs;
+    }
+} // namespace
+
+TEST_CASE ("Continuous UVs keep the vertex count")
+{
+    Strip strip;
+    strip.vmaps.push_back ({"base", gridUVs (0.5f, 1.0f)});
+
+    const auto model = load (strip, "lwo3_uv_continuous.lwo");
+
+    CHECK (model->V.cols() == 6);
+    CHECK (model->UV0.cols() == 6);
+    CHECK (model->UV1.size() == 0);
+    checkCorners (strip, model);
+}
+
+TEST_CASE ("Discontinuous UVs split vertices only at seams")
+{
+    Strip strip;
+    strip.vmaps.push_back ({"base", gridUVs (0.5f, 1.0f)});
+    strip.vmads.push_back ({"base", {
+                                        {1, 1, 1.0f, 0.0f}, // the seam runs along vertices 1 and 4
+                                        {1, 4, 1.0f, 1.0f},
+                                        {0, 0, 0.0f, 0.0f}, // same as the VMAP, no split
+                                    }});
+
+    const auto model = load (strip, "lwo3_uv_seam.lwo");
+
+    CHECK (model->V.cols() == 8);
+    CHECK (model->UV0.cols() == 8);
+    checkCorners (strip, model);
+}
+
+TEST_CASE ("A second UV map goes to UV1")
+{
+    Strip strip;
+    strip.vmaps.push_back ({"base", gridUVs (0.5f, 1.0f)});
+    strip.vmaps.push_back ({"detail", gridUVs (4.0f, 8.0f)});
+    strip.vmads.push_back ({"base", {{1, 1, 1.0f, 0.0f}, {1, 4, 1.0f, 1.0f}}});
+    strip.vmads.push_back ({"detail", {
+                                          {0, 3, 9.0f, 9.0f}, // only polygon 0 uses vertex 3, no split
+                                          {1, 2, 7.0f, 7.0f}, // only polygon 1 uses vertex 2, no split
+                                          {0, 4, 6.0f, 6.0f}, // vertex 4 splits between the polygons
+                                      }});
+
+    const auto model = load (strip, "lwo3_uv_two_maps.lwo");
+
+    // vertex 1 splits for UV0, vertex 4 for both maps at once
+    CHECK (model->V.cols() == 8);
+    CHECK (model->UV0.cols() == 8);
+    CHECK (model->UV1.cols() == 8);
+    checkCorners (strip, model);
+}
+
+class Application : public Jahley::App
+{
+ public:
+    Application (DesktopWindowSettings settings = DesktopWindowSettings(), bool windowApp = false) :
+        Jahley::App()
+    {
+        doctest::Context().run();
+    }
+
+ private:
+};
+
+Jahley::App* Jahley::CreateApplication()
+{
+    return new Application();
+}
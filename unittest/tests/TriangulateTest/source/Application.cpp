@@ -0,0 +1,215 @@
+#include "Jahley.h"
+
+const std::string APP_NAME = "TriangulateTest";
+
+#ifdef CHECK
+#undef CHECK
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <doctest/doctest.h>
+
+#include <sabi_core/sabi_core.h>
+
+using sabi::PolygonTriangulator;
+
+namespace
+{
+    // polygons as corner lists into one shared point list
+    struct PolygonSoup
+    {
+        std::vector<Eigen::Vector3f> points;
+        std::vector<std::vector<uint32_t>> polygons;
+
+        // adds a polygon from 2D outline points, placed on a plane by 'frame'
+        void add (const std::vector<Eigen::Vector2f>& outline, const Eigen::Affine3f& frame = Eigen::Affine3f::Identity())
+        {
+            std::vector<uint32_t> polygon;
+            for (const auto& p : outline)
+            {
+                polygon.push_back (static_cast<uint32_t> (points.size()));
+                points.push_back (frame * Eigen::Vector3f (p.x(), p.y(), 0.0f));
+            }
+            polygons.push_back (polygon);
+        }
+
+        MatrixXu triangulate (BS::thread_pool* pool = nullptr) const
+        {
+            return PolygonTriangulator::triangulate (points, polygons.size(), [&] (size_t i)
+                                                     { return std::span<const uint32_t> (polygons[i]); }, pool);
+        }
+
+        float polygonArea (size_t i) const
+        {
+            return 0.5f * PolygonTriangulator::polygonNormal (points, polygons[i]).norm();
+        }
+
+        Eigen::Vector3f triangleNormal (const MatrixXu& F, Eigen::Index t) const
+        {
+            const Eigen::Vector3f& a = points[F (0, t)];
+            return (points[F (1, t)] - a).cross (points[F (2, t)] - a);
+        }
+    };
+
+    std::vector<Eigen::Vector2f> star (int spikes, float outer, float inner)
+    {
+        std::vector<Eigen::Vector2f> outline;
+        for (int i = 0; i < spikes * 2; ++i)
+        {
+            const float angle = std::numbers::pi_v<float> * i / spikes;
+            const float r = (i % 2) ? inner : outer;
+            outline.emplace_back (r * std::cos (angle), r * std::sin (angle));
+        }
+        return outline;
+    }
+
+    // concave, counter clockwise
+    const std::vector<Eigen::Vector2f> lShape = {{0, 0}, {2, 0}, {2, 1}, {1, 1}, {1, 3}, {0, 3}};
+    const std::vector<Eigen::Vector2f> dart = {{0, 0}, {2, 1}, {0, 2}, {0.5f, 1}};
+
+    Eigen::Affine3f tilted()
+    {
+        Eigen::Affine3f frame = Eigen::Affine3f::Identity();
+        frame.translate (Eigen::Vector3f (3.0f, -1.0f, 2.0f));
+        frame.rotate (Eigen::AngleAxisf (1.1f, Eigen::Vector3f (1.0f, 2.0f, -0.5f).normalized()));
+        return frame;
+    }
+
+    // every triangle uses the polygon's corners, keeps its winding, and the areas add up
+    void checkPolygon (const PolygonSoup& soup, const MatrixXu& F, size_t polygon, Eigen::Index firstColumn)
+    {
+        const auto& corners = soup.polygons[polygon];
+        const Eigen::Vector3f normal = PolygonTriangulator::polygonNormal (soup.points, corners);
+
+        float area = 0.0f;
+        for (Eigen::Index t = firstColumn; t < firstColumn + static_cast<Eigen::Index> (corners.size() - 2); ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+                CHECK (std::find (corners.begin(), corners.end(), F (k, t)) != corners.end());
+
+            const Eigen::Vector3f n = soup.triangleNormal (F, t);
+            CHECK (n.dot (normal) >= 0.0f);
+            area += 0.5f * n.norm();
+        }
+
+        CHECK (area == doctest::Approx (soup.polygonArea (polygon)).epsilon (1e-4));
+    }
+} // namespace
+
+TEST_CASE ("Every polygon gives n - 2 triangles")
+{
+    PolygonSoup soup;
+    soup.add ({{0, 0}, {1, 0}, {0, 1}});
+    soup.add ({{0, 0}, {1, 0}, {1, 1}, {0, 1}});
+    soup.add (star (5, 2.0f, 0.8f));
+    soup.add ({{0, 0}, {1, 0}}); // not a polygon, skipped
+    soup.add (lShape);
+
+    const MatrixXu F = soup.triangulate();
+    CHECK (F.rows() == 3);
+    CHECK (F.cols() == 1 + 2 + 8 + 0 + 4);
+}
+
+TEST_CASE ("Triangles cover the source polygons")
+{
+    for (const bool tilt : {false, true})
+    {
+        CAPTURE (tilt);
+        const Eigen::Affine3f frame = tilt ? tilted() : Eigen::Affine3f::Identity();
+
+        PolygonSoup soup;
+        soup.add ({{0, 0}, {1, 0}, {1, 1}, {0, 1}}, frame); // convex quad
+        soup.add (dart, frame);                              // concave quad
+        soup.add ({{0, 0}, {1, 0.2f}, {0.5f, 1}, {-0.2f, 1}}, frame);
+        soup.add (lShape, frame);
+        soup.add (star (7, 3.0f, 1.0f), frame);
+
+        // the same outline wound the other way
+        std::vector<Eigen::Vector2f> reversed (lShape.rbegin(), lShape.rend());
+        soup.add (reversed, frame);
+
+        const MatrixXu F = soup.triangulate();
+
+        Eigen::Index column = 0;
+        for (size_t i = 0; i < soup.polygons.size(); ++i)
+        {
+            CAPTURE (i);
+            checkPolygon (soup, F, i, column);
+            column += soup.polygons[i].size() - 2;
+        }
+        CHECK (column == F.cols());
+    }
+}
+
+TEST_CASE ("Near planar polygons are triangulated")
+{
+    PolygonSoup soup;
+    soup.add (star (6, 2.0f, 0.7f));
+
+    // lift the corners a little off the plane
+    for (size_t i = 0; i < soup.points.size(); ++i)
+        soup.points[i].z() = (i % 2 ? 0.01f : -0.01f);
+
+    const MatrixXu F = soup.triangulate();
+    REQUIRE (F.cols() == 10);
+
+    const Eigen::Vector3f normal = PolygonTriangulator::polygonNormal (soup.points, soup.polygons[0]);
+    for (Eigen::Index t = 0; t < F.cols(); ++t)
+        CHECK (soup.triangleNormal (F, t).dot (normal) > 0.0f);
+}
+
+TEST_CASE ("Parallel triangulation matches serial")
+{
+    PolygonSoup soup;
+    for (int i = 0; i < 3 * static_cast<int> (PolygonTriangulator::ParallelThreshold); ++i)
+    {
+        Eigen::Affine3f frame = Eigen::Affine3f::Identity();
+        frame.translate (Eigen::Vector3f (float (i % 100) * 4.0f, float (i / 100) * 4.0f, 0.0f));
+        switch (i % 3)
+        {
+            case 0:
+                soup.add (lShape, frame);
+                break;
+            case 1:
+                soup.add (dart, frame);
+                break;
+            default:
+                soup.add (star (4, 1.5f, 0.5f), frame);
+                break;
+        }
+    }
+
+    BS::thread_pool pool;
+    const MatrixXu parallel = soup.triangulate (&pool);
+    const MatrixXu local = soup.triangulate();
+
+    // the serial reference, one polygon at a time
+    MatrixXu serial (3, 0);
+    for (const auto& polygon : soup.polygons)
+    {
+        const MatrixXu one = PolygonTriangulator::triangulate (soup.points, 1, [&] (size_t)
+                                                               { return std::span<const uint32_t> (polygon); });
+        serial.conservativeResize (3, serial.cols() + one.cols());
+        serial.rightCols (one.cols()) = one;
+    }
+
+    CHECK (parallel == serial);
+    CHECK (local == serial);
+}
+
+class Application : public Jahley::App
+{
+ public:
+    Application (DesktopWindowSettings settings = DesktopWindowSettings(), bool windowApp = false) :
+        Jahley::App()
+    {
+        doctest::Context().run();
+    }
+
+ private:
+};
+
+Jahley::App* Jahley::CreateApplication()
+{
+    return new Application();
+}